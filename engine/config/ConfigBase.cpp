@@ -997,11 +997,16 @@ void ConfVarTable::Save(std::ostream &o) const
 }
 
 bool ConfVarTable::Load(FS::MemMap &data, const char *name)
+{
+	return Load(static_cast<const char *>(data.GetData()), data.GetSize(), name);
+}
+
+bool ConfVarTable::Load(const char *data, size_t size, const char *name)
 {
 	std::unique_ptr<lua_State, LuaStateDeleter> L(luaL_newstate());
 
 	// try to read and execute the file
-	if( luaL_loadbuffer(L.get(), static_cast<const char *>(data.GetData()), data.GetSize(), name) ||
+	if( luaL_loadbuffer(L.get(), data, size, name) ||
 		lua_pcall(L.get(), 0, 0, 0) )
 	{
 		throw std::runtime_error(lua_tostring(L.get(), -1));
@@ -213,6 +213,7 @@ public:
 
 	void Save(std::ostream &o) const;
 	bool Load(FS::MemMap &data, const char *name);
+	bool Load(const char *data, size_t size, const char *name);
 
 	// Lua binding
 	void InitConfigLuaBinding(lua_State *L, const char *globName);
@@ -0,0 +1,150 @@
+#include "inc/fs/ZlibStream.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+
+using namespace FS;
+
+static const size_t c_chunkSize = 64 * 1024;
+
+DeflateStream::DeflateStream(Stream &target, int level)
+	: _target(target)
+	, _z(new z_stream_s())
+{
+	assert(level >= 1 && level <= 9);
+	if (Z_OK != deflateInit(_z.get(), level))
+		throw std::runtime_error("failed to initialize compression");
+	_in.reserve(c_chunkSize);
+	_out.resize(c_chunkSize);
+}
+
+DeflateStream::~DeflateStream()
+{
+	deflateEnd(_z.get());
+}
+
+void DeflateStream::Finish()
+{
+	assert(!_finished);
+	Deflate(true);
+	_finished = true;
+}
+
+void DeflateStream::Deflate(bool finish)
+{
+	_z->next_in = _in.data();
+	_z->avail_in = static_cast<uInt>(_in.size());
+	int result;
+	do
+	{
+		_z->next_out = _out.data();
+		_z->avail_out = static_cast<uInt>(_out.size());
+		result = deflate(_z.get(), finish ? Z_FINISH : Z_NO_FLUSH);
+		if (Z_STREAM_ERROR == result)
+			throw std::runtime_error("compression failed");
+		size_t produced = _out.size() - _z->avail_out;
+		if (produced)
+			_target.Write(_out.data(), produced);
+	} while (finish ? Z_STREAM_END != result : 0 == _z->avail_out);
+	assert(0 == _z->avail_in);
+	_in.clear();
+}
+
+size_t DeflateStream::Read(void *dst, size_t size, size_t count)
+{
+	throw std::runtime_error("compression stream is write only");
+}
+
+void DeflateStream::Write(const void *src, size_t size)
+{
+	assert(!_finished);
+	auto bytes = static_cast<const unsigned char*>(src);
+	_written += size;
+	while (size)
+	{
+		size_t n = std::min(size, c_chunkSize - _in.size());
+		_in.insert(_in.end(), bytes, bytes + n);
+		bytes += n;
+		size -= n;
+		if (_in.size() == c_chunkSize)
+			Deflate(false);
+	}
+}
+
+void DeflateStream::Seek(long long amount, unsigned int origin)
+{
+	throw std::runtime_error("compression stream is not seekable");
+}
+
+long long DeflateStream::Tell() const
+{
+	return _written;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+InflateStream::InflateStream(Stream &source)
+	: _source(source)
+	, _z(new z_stream_s())
+{
+	if (Z_OK != inflateInit(_z.get()))
+		throw std::runtime_error("failed to initialize decompression");
+	_in.resize(c_chunkSize);
+}
+
+InflateStream::~InflateStream()
+{
+	inflateEnd(_z.get());
+}
+
+size_t InflateStream::Read(void *dst, size_t size, size_t count)
+{
+	if (!size)
+		return 0;
+
+	_z->next_out = static_cast<Bytef*>(dst);
+	_z->avail_out = static_cast<uInt>(size * count);
+	while (_z->avail_out && !_ended)
+	{
+		if (!_z->avail_in)
+		{
+			_z->next_in = _in.data();
+			_z->avail_in = static_cast<uInt>(_source.Read(_in.data(), 1, _in.size()));
+			if (!_z->avail_in)
+				throw std::runtime_error("unexpected end of compressed data");
+		}
+
+		int result = inflate(_z.get(), Z_NO_FLUSH);
+		if (Z_STREAM_END == result)
+		{
+			_ended = true;
+			if (_z->avail_in)
+				_source.Seek(_source.Tell() - _z->avail_in, SEEK_SET);
+		}
+		else if (Z_OK != result && Z_BUF_ERROR != result)
+		{
+			throw std::runtime_error("compressed data is corrupted");
+		}
+	}
+
+	size_t bytes = size * count - _z->avail_out;
+	_read += bytes;
+	return bytes / size;
+}
+
+void InflateStream::Write(const void *src, size_t size)
+{
+	throw std::runtime_error("decompression stream is read only");
+}
+
+void InflateStream::Seek(long long amount, unsigned int origin)
+{
+	throw std::runtime_error("decompression stream is not seekable");
+}
+
+long long InflateStream::Tell() const
+{
+	return _read;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "FileSystem.h"
+#include <memory>
+#include <vector>
+
+struct z_stream_s;
+
+namespace FS
+{
+	// Compresses everything written to it into the target stream.
+	// Finish must be called once all data is written.
+	class DeflateStream final : public Stream
+	{
+	public:
+		// level is 1 (fastest) to 9 (smallest)
+		DeflateStream(Stream &target, int level);
+		~DeflateStream();
+
+		void Finish();
+
+		// Stream
+		size_t Read(void *dst, size_t size, size_t count) override;
+		void Write(const void *src, size_t size) override;
+		void Seek(long long amount, unsigned int origin) override;
+		long long Tell() const override;
+
+	private:
+		Stream &_target;
+		std::unique_ptr<z_stream_s> _z;
+		std::vector<unsigned char> _in;
+		std::vector<unsigned char> _out;
+		long long _written = 0;
+		bool _finished = false;
+
+		void Deflate(bool finish);
+	};
+
+	// Reads back what DeflateStream wrote. Stops at the end of the compressed
+	// data and leaves the source positioned right after it.
+	class InflateStream final : public Stream
+	{
+	public:
+		explicit InflateStream(Stream &source);
+		~InflateStream();
+
+		// Stream
+		size_t Read(void *dst, size_t size, size_t count) override;
+		void Write(const void *src, size_t size) override;
+		void Seek(long long amount, unsigned int origin) override;
+		long long Tell() const override;
+
+	private:
+		Stream &_source;
+		std::unique_ptr<z_stream_s> _z;
+		std::vector<unsigned char> _in;
+		long long _read = 0;
+		bool _ended = false;
+	};
+}
@@ -0,0 +1,35 @@
+#include <fsmem/FileSystemMemory.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+
+TEST(MemoryStream, ReadReturnsWholeElementsLeft)
+{
+	FS::MemoryStream stream;
+	const char data[] = "0123456789";
+	stream.Write(data, 10);
+	stream.Seek(0, SEEK_SET);
+
+	// like fread, a short read returns what is there
+	char buf[8] = {};
+	EXPECT_EQ(8, stream.Read(buf, 1, 8));
+	EXPECT_EQ(1, stream.Read(buf, 2, 4));
+	EXPECT_EQ('8', buf[0]);
+	EXPECT_EQ('9', buf[1]);
+	EXPECT_EQ(10, stream.Tell());
+	EXPECT_EQ(0, stream.Read(buf, 1, 8));
+}
+
+TEST(MemoryStream, ReadDoesNotSplitElements)
+{
+	FS::MemoryStream stream;
+	const char data[] = "01234";
+	stream.Write(data, 5);
+	stream.Seek(0, SEEK_SET);
+
+	int value = 0;
+	char buf[4];
+	EXPECT_EQ(1, stream.Read(&value, 4, 1));
+	EXPECT_EQ(0, stream.Read(buf, 4, 1));
+	EXPECT_EQ(4, stream.Tell()); // the odd byte is still there
+	EXPECT_EQ(1, stream.Read(buf, 1, 4));
+}
@@ -0,0 +1,83 @@
+#include <fs/ZlibStream.h>
+#include <fsmem/FileSystemMemory.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+static std::vector<unsigned char> MakeData(size_t size)
+{
+	std::vector<unsigned char> data(size);
+	for (size_t i = 0; i < size; ++i)
+		data[i] = static_cast<unsigned char>((i * 7) % 13 + (i / 1000) % 5);
+	return data;
+}
+
+TEST(ZlibStream, RoundTripsAcrossChunks)
+{
+	auto data = MakeData(200000); // several compression chunks
+	FS::MemoryStream stream;
+	{
+		FS::DeflateStream deflate(stream, 6);
+		for (size_t pos = 0; pos < data.size(); pos += 1000)
+			deflate.Write(&data[pos], 1000);
+		deflate.Finish();
+		EXPECT_EQ((long long) data.size(), deflate.Tell());
+	}
+	EXPECT_LT(stream.Tell() * 10, (long long) data.size());
+
+	stream.Seek(0, SEEK_SET);
+	FS::InflateStream inflate(stream);
+	std::vector<unsigned char> result(data.size());
+	for (size_t pos = 0; pos < result.size(); pos += 3000)
+		ASSERT_EQ(1, inflate.Read(&result[pos], std::min<size_t>(3000, result.size() - pos), 1));
+	EXPECT_EQ(data, result);
+	EXPECT_EQ((long long) data.size(), inflate.Tell());
+}
+
+TEST(ZlibStream, LeavesSourceAfterCompressedData)
+{
+	auto data = MakeData(1000);
+	FS::MemoryStream stream;
+	{
+		FS::DeflateStream deflate(stream, 1);
+		deflate.Write(data.data(), data.size());
+		deflate.Finish();
+	}
+	const int trailer = 12345;
+	stream.Write(&trailer, sizeof(trailer));
+
+	stream.Seek(0, SEEK_SET);
+	{
+		FS::InflateStream inflate(stream);
+		std::vector<unsigned char> result(data.size());
+		ASSERT_EQ(data.size(), inflate.Read(result.data(), 1, result.size()));
+		char more;
+		EXPECT_EQ(0, inflate.Read(&more, 1, 1));
+	}
+	int value = 0;
+	ASSERT_EQ(1, stream.Read(&value, sizeof(value), 1));
+	EXPECT_EQ(trailer, value);
+}
+
+TEST(ZlibStream, ThrowsOnTruncatedData)
+{
+	auto data = MakeData(10000);
+	FS::MemoryStream compressed;
+	{
+		FS::DeflateStream deflate(compressed, 9);
+		deflate.Write(data.data(), data.size());
+		deflate.Finish();
+	}
+	FS::MemoryStream truncated;
+	std::vector<char> bytes((size_t) compressed.Tell() / 2);
+	compressed.Seek(0, SEEK_SET);
+	compressed.Read(bytes.data(), 1, bytes.size());
+	truncated.Write(bytes.data(), bytes.size());
+
+	truncated.Seek(0, SEEK_SET);
+	FS::InflateStream inflate(truncated);
+	std::vector<unsigned char> result(data.size());
+	EXPECT_THROW(inflate.Read(result.data(), 1, result.size()), std::runtime_error);
+}
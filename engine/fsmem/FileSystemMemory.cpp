@@ -1,4 +1,5 @@
 #include "inc/fsmem/FileSystemMemory.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -6,10 +7,11 @@ using namespace FS;
 
 size_t MemoryStream::Read(void *dst, size_t size, size_t count)
 {
-	size_t bytes = size * count;
-	if (_streamPos + bytes > _data.size())
+	if (!size)
 		return 0;
-	memcpy(dst, &_data[_streamPos], bytes);
+	count = std::min(count, (_data.size() - _streamPos) / size);
+	size_t bytes = size * count;
+	memcpy(dst, _data.data() + _streamPos, bytes);
 	_streamPos += bytes;
 	return count;
 }
@@ -12,6 +12,8 @@ namespace FS
 		void Seek(long long amount, unsigned int origin)  override;
 		long long Tell() const  override;
 
+		const std::vector<char>& GetData() const { return _data; }
+
 	private:
 		std::vector<char> _data;
 		size_t _streamPos = 0;
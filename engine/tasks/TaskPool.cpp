@@ -0,0 +1,56 @@
+#include "inc/tasks/TaskPool.h"
+#include <algorithm>
+
+TaskPool::TaskPool(unsigned int threadCount)
+{
+	if (0 == threadCount)
+	{
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = std::max(hardwareThreads, 2u) - 1;
+	}
+
+	_threads.reserve(threadCount);
+	for (unsigned int i = 0; i != threadCount; ++i)
+	{
+		_threads.emplace_back(&TaskPool::WorkerMain, this);
+	}
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_exit = true;
+	}
+	_cv.notify_all();
+	for (auto &thread: _threads)
+	{
+		thread.join();
+	}
+}
+
+void TaskPool::Enqueue(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_queue.push_back(std::move(task));
+	}
+	_cv.notify_one();
+}
+
+void TaskPool::WorkerMain()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_cv.wait(lock, [this] { return _exit || !_queue.empty(); });
+			if (_queue.empty())
+				return; // exiting and nothing left to do
+			task = std::move(_queue.front());
+			_queue.pop_front();
+		}
+		task();
+	}
+}
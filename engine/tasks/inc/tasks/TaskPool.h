@@ -0,0 +1,46 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads executing submitted tasks in FIFO order.
+// Results and exceptions are delivered through std::future so that the
+// owning thread decides where the dependent work runs.
+class TaskPool final
+{
+public:
+	// 0 means one thread less than the number of hardware threads, at least 1
+	explicit TaskPool(unsigned int threadCount = 0);
+	~TaskPool();
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(_threads.size()); }
+
+	template <class F>
+	auto Submit(F &&func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+	{
+		using Result = std::invoke_result_t<std::decay_t<F>>;
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(func));
+		auto result = task->get_future();
+		Enqueue([task] { (*task)(); });
+		return result;
+	}
+
+private:
+	std::vector<std::thread> _threads;
+	std::deque<std::function<void()>> _queue;
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	bool _exit = false;
+
+	void Enqueue(std::function<void()> task);
+	void WorkerMain();
+};
@@ -0,0 +1,80 @@
+#include <tasks/TaskPool.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(TaskPool, DefaultHasAtLeastOneThread)
+{
+	TaskPool pool;
+	EXPECT_GE(pool.GetThreadCount(), 1u);
+}
+
+TEST(TaskPool, ReturnsResultsFromWorkerThreads)
+{
+	TaskPool pool(4);
+	ASSERT_EQ(4u, pool.GetThreadCount());
+
+	std::vector<std::future<int>> results;
+	std::vector<std::future<std::thread::id>> threads;
+	for (int i = 0; i < 100; ++i)
+	{
+		results.push_back(pool.Submit([i] { return i * i; }));
+		threads.push_back(pool.Submit([] { return std::this_thread::get_id(); }));
+	}
+
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(i * i, results[i].get());
+		EXPECT_NE(std::this_thread::get_id(), threads[i].get());
+	}
+}
+
+TEST(TaskPool, SingleThreadRunsInSubmitOrder)
+{
+	TaskPool pool(1);
+	std::vector<int> order;
+	std::vector<std::future<void>> done;
+	for (int i = 0; i < 50; ++i)
+		done.push_back(pool.Submit([&order, i] { order.push_back(i); }));
+	for (auto &f: done)
+		f.get();
+
+	ASSERT_EQ(50, order.size());
+	for (int i = 0; i < 50; ++i)
+		EXPECT_EQ(i, order[i]);
+}
+
+TEST(TaskPool, ExceptionReachesFuture)
+{
+	TaskPool pool(2);
+	auto failed = pool.Submit([]() -> int { throw std::runtime_error("task failed"); });
+	auto fine = pool.Submit([] { return 7; });
+
+	EXPECT_THROW(failed.get(), std::runtime_error);
+	EXPECT_EQ(7, fine.get()); // the worker survives
+}
+
+TEST(TaskPool, CapturesAreReleased)
+{
+	auto data = std::make_shared<int>(5);
+	std::weak_ptr<int> watch = data;
+	{
+		TaskPool pool(1);
+		auto result = pool.Submit([data = std::move(data)] { return *data; });
+		EXPECT_EQ(5, result.get());
+	}
+	EXPECT_TRUE(watch.expired());
+}
+
+TEST(TaskPool, DestructorFinishesQueuedTasks)
+{
+	std::atomic<int> count(0);
+	{
+		TaskPool pool(2);
+		for (int i = 0; i < 200; ++i)
+			pool.Submit([&count] { ++count; });
+	}
+	EXPECT_EQ(200, count.load());
+}
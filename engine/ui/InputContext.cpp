@@ -248,7 +248,11 @@ bool InputContext::ProcessPointer(
 		if ((Plat::Msg::PointerDown == msg || Plat::Msg::TAP == msg) && NeedsFocus(texman, *target, targetLC, dc))
 		{
 			PropagateFocus(sinkPath);
-			targetLC = RestoreLayoutContext(texman, lc, dc, sinkPath); // layout may have changed due to focus change
+
+			// layout may have changed due to focus change, start a new layout pass
+			LayoutContext newPassLC(lc.GetOpacityCombined(), lc.GetScaleCombined(), lc.GetPixelOffsetCombined(),
+			                        lc.GetPixelSize(), lc.GetEnabledCombined(), lc.GetFocusedCombined());
+			targetLC = RestoreLayoutContext(texman, newPassLC, dc, sinkPath);
 		}
 
 		PointerInfo pi;
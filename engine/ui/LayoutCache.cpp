@@ -0,0 +1,56 @@
+#include "inc/ui/LayoutCache.h"
+#include "inc/ui/LayoutContext.h"
+#include <cassert>
+
+using namespace UI;
+
+bool ChildLayoutCache::IsValid(const LayoutContext &lc, const DataContext &dc, unsigned int childrenCount) const
+{
+	return _passId == lc.GetPassId() &&
+		_pxSize == lc.GetPixelSize() &&
+		_scale == lc.GetScaleCombined() &&
+		_dc == &dc &&
+		_layouts.size() == childrenCount;
+}
+
+void ChildLayoutCache::Reset(const LayoutContext &lc, const DataContext &dc)
+{
+	_passId = lc.GetPassId();
+	_pxSize = lc.GetPixelSize();
+	_scale = lc.GetScaleCombined();
+	_dc = &dc;
+	_layouts.clear();
+	_cursor = 0;
+}
+
+void ChildLayoutCache::Add(const Window &child, const WindowLayout &layout)
+{
+	_layouts.emplace_back(&child, layout);
+}
+
+const WindowLayout& ChildLayoutCache::Get(const Window &child) const
+{
+	assert(!_layouts.empty());
+
+	// check the neighbors of the last hit first, then fall back to a full scan
+	size_t count = _layouts.size();
+	for (size_t probe: { _cursor, _cursor + 1, _cursor + count - 1 })
+	{
+		if (_layouts[probe % count].first == &child)
+		{
+			_cursor = probe % count;
+			return _layouts[_cursor].second;
+		}
+	}
+	for (size_t i = 0; i != count; ++i)
+	{
+		if (_layouts[i].first == &child)
+		{
+			_cursor = i;
+			return _layouts[i].second;
+		}
+	}
+
+	assert(false);
+	return _layouts.front().second;
+}
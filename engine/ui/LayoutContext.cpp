@@ -4,8 +4,11 @@
 
 using namespace UI;
 
+static unsigned int s_lastPassId = 0;
+
 LayoutContext::LayoutContext(float opacity, float scale, vec2d pxOffset, vec2d pxSize, bool enabled, bool focused)
-	: _pxOffsetCombined(pxOffset)
+	: _passId(++s_lastPassId)
+	, _pxOffsetCombined(pxOffset)
 	, _pxSize(pxSize)
 	, _scaleCombined(scale)
 	, _opacityCombined(opacity)
@@ -16,7 +19,8 @@ LayoutContext::LayoutContext(float opacity, float scale, vec2d pxOffset, vec2d p
 }
 
 LayoutContext::LayoutContext(const Window &parentWindow, const LayoutContext &parentLC, const Window &childWindow, const WindowLayout &childLayout)
-	: _pxOffsetCombined(parentLC.GetPixelOffsetCombined() + Offset(childLayout.rect))
+	: _passId(parentLC.GetPassId())
+	, _pxOffsetCombined(parentLC.GetPixelOffsetCombined() + Offset(childLayout.rect))
 	, _pxSize(Size(childLayout.rect))
 	, _scaleCombined(parentLC.GetScaleCombined())
 	, _opacityCombined(parentLC.GetOpacityCombined() * childLayout.opacity)
@@ -6,20 +6,27 @@ using namespace UI;
 
 WindowLayout ScanlineLayout::GetChildLayout(TextureManager &texman, const LayoutContext &lc, const DataContext &dc, const Window &child) const
 {
-	auto childIt = std::find(begin(*this), end(*this), &child);
-	assert(childIt != end(*this));
+	if (!_layoutCache.IsValid(lc, dc, GetChildrenCount()))
+	{
+		_layoutCache.Reset(lc, dc);
 
-	vec2d pxElementSize = ToPx(_elementSize, lc);
+		vec2d pxElementSize = ToPx(_elementSize, lc);
+		auto numColumns = std::max(1, int(lc.GetPixelSize().x / pxElementSize.x));
+		float pxContentWidth = (float)numColumns * pxElementSize.x;
+		float pxAlignCenterOffset = std::floor((lc.GetPixelSize().x - pxContentWidth) / 2);
 
-	auto childIndex = std::distance(begin(*this), childIt);
-	auto numColumns = std::max(1, int(lc.GetPixelSize().x / pxElementSize.x));
-	int row = childIndex / numColumns;
-	int column = childIndex - row * numColumns;
+		int childIndex = 0;
+		for (auto item : *this)
+		{
+			int row = childIndex / numColumns;
+			int column = childIndex - row * numColumns;
+			auto offset = vec2d{ pxAlignCenterOffset + (float)column * pxElementSize.x, (float)row * pxElementSize.y };
+			_layoutCache.Add(*item, WindowLayout{ MakeRectWH(offset, pxElementSize), 1, true });
+			childIndex++;
+		}
+	}
 
-	float pxContentWidth = (float)numColumns * pxElementSize.x;
-	float pxAlignCenterOffset = std::floor((lc.GetPixelSize().x - pxContentWidth) / 2);
-	auto offset = vec2d{ pxAlignCenterOffset + (float)column * pxElementSize.x, (float)row * pxElementSize.y };
-	return WindowLayout{ MakeRectWH(offset, pxElementSize), 1, true };
+	return _layoutCache.Get(child);
 }
 
 vec2d ScanlineLayout::GetContentSize(TextureManager &texman, const DataContext &dc, float scale, const LayoutConstraints &layoutConstraints) const
@@ -8,53 +8,51 @@ using namespace UI;
 
 WindowLayout StackLayout::GetChildLayout(TextureManager &texman, const LayoutContext &lc, const DataContext &dc, const Window &child) const
 {
-	float scale = lc.GetScaleCombined();
-	vec2d size = lc.GetPixelSize();
-
-	// FIXME: O(n^2) complexity
-	float pxOffset = 0;
-	float pxSpacing = std::floor(_spacing * scale);
-	LayoutConstraints constraints = DefaultLayoutConstraints(lc);
-	if (FlowDirection::Vertical == _flowDirection)
+	if (!_layoutCache.IsValid(lc, dc, GetChildrenCount()))
 	{
-		for (auto item : *this)
+		_layoutCache.Reset(lc, dc);
+
+		float scale = lc.GetScaleCombined();
+		vec2d size = lc.GetPixelSize();
+
+		float pxOffset = 0;
+		float pxSpacing = std::floor(_spacing * scale);
+		LayoutConstraints constraints = DefaultLayoutConstraints(lc);
+		if (FlowDirection::Vertical == _flowDirection)
 		{
-			if (item == &child)
+			for (auto item : *this)
 			{
-				break;
+				vec2d pxItemSize = item->GetContentSize(texman, dc, scale, constraints);
+				if (_align == Align::LT)
+				{
+					_layoutCache.Add(*item, WindowLayout{ FRECT{ 0.f, pxOffset, size.x, pxOffset + pxItemSize.y }, 1, true });
+				}
+				else
+				{
+					assert(_align == Align::CT); // TODO: support others
+					float pxMargin = std::floor((size.x - pxItemSize.x) / 2);
+					_layoutCache.Add(*item, WindowLayout{ MakeRectWH(vec2d{pxMargin, pxOffset}, pxItemSize), 1, true });
+				}
+				float pxSpaceTaken = pxItemSize.y + pxSpacing;
+				pxOffset += pxSpaceTaken;
+				constraints.maxPixelSize.y = std::max(constraints.maxPixelSize.y - pxSpaceTaken, 0.f);
 			}
-			float pxSpaceTaken = item->GetContentSize(texman, dc, scale, constraints).y + pxSpacing;
-			pxOffset += pxSpaceTaken;
-			constraints.maxPixelSize.y = std::max(constraints.maxPixelSize.y - pxSpaceTaken, 0.f);
-		}
-		vec2d pxChildSize = child.GetContentSize(texman, dc, scale, constraints);
-		if (_align == Align::LT)
-		{
-			return WindowLayout{ FRECT{ 0.f, pxOffset, size.x, pxOffset + pxChildSize.y }, 1, true };
 		}
 		else
 		{
-			assert(_align == Align::CT); // TODO: support others
-			float pxMargin = std::floor((size.x - pxChildSize.x) / 2);
-			return WindowLayout{ MakeRectWH(vec2d{pxMargin, pxOffset}, pxChildSize), 1, true };
-		}
-	}
-	else
-	{
-		assert(FlowDirection::Horizontal == _flowDirection);
-		for (auto item : *this)
-		{
-			if (item == &child)
+			assert(FlowDirection::Horizontal == _flowDirection);
+			for (auto item : *this)
 			{
-				break;
+				vec2d pxItemSize = item->GetContentSize(texman, dc, scale, constraints);
+				_layoutCache.Add(*item, WindowLayout{ FRECT{ pxOffset, 0.f, pxOffset + pxItemSize.x, size.y }, 1, true });
+				float pxSpaceTaken = pxItemSize.x + pxSpacing;
+				constraints.maxPixelSize.x = std::max(constraints.maxPixelSize.x - pxSpaceTaken, 0.f);
+				pxOffset += pxSpaceTaken;
 			}
-			float pxSpaceTaken = item->GetContentSize(texman, dc, scale, constraints).x + pxSpacing;
-			constraints.maxPixelSize.x = std::max(constraints.maxPixelSize.x - pxSpaceTaken, 0.f);
-			pxOffset += pxSpaceTaken;
 		}
-		vec2d pxChildSize = child.GetContentSize(texman, dc, scale, constraints);
-		return WindowLayout{ FRECT{ pxOffset, 0.f, pxOffset + pxChildSize.x, size.y }, 1, true };
 	}
+
+	return _layoutCache.Get(child);
 }
 
 vec2d StackLayout::GetContentSize(TextureManager &texman, const DataContext &dc, float scale, const LayoutConstraints &layoutConstraints) const
@@ -0,0 +1,29 @@
+#pragma once
+#include "Window.h"
+#include <utility>
+#include <vector>
+
+namespace UI
+{
+	class DataContext;
+	class LayoutContext;
+
+	// Child layouts of a container computed in a single pass. Valid for one
+	// pass over the window tree with the same container size, scale and data.
+	class ChildLayoutCache
+	{
+	public:
+		bool IsValid(const LayoutContext &lc, const DataContext &dc, unsigned int childrenCount) const;
+		void Reset(const LayoutContext &lc, const DataContext &dc);
+		void Add(const Window &child, const WindowLayout &layout);
+		const WindowLayout& Get(const Window &child) const;
+
+	private:
+		unsigned int _passId = 0;
+		vec2d _pxSize = {};
+		float _scale = 0;
+		const DataContext *_dc = nullptr;
+		std::vector<std::pair<const Window*, WindowLayout>> _layouts;
+		mutable size_t _cursor = 0; // children are mostly queried in order
+	};
+}
@@ -25,7 +25,12 @@ namespace UI
 		float GetScaleCombined() const { return _scaleCombined; }
 		float GetOpacityCombined() const { return _opacityCombined; }
 
+		// Unique per root context. Layouts computed within one pass over the
+		// window tree may be cached under this id.
+		unsigned int GetPassId() const { return _passId; }
+
 	private:
+		unsigned int _passId;
 		vec2d _pxOffsetCombined;
 		vec2d _pxSize;
 		float _scaleCombined;
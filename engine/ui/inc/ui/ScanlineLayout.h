@@ -1,4 +1,5 @@
 #pragma once
+#include "LayoutCache.h"
 #include "Navigation.h"
 #include "Window.h"
 
@@ -19,6 +20,7 @@ namespace UI
 
 	private:
 		vec2d _elementSize;
+		mutable ChildLayoutCache _layoutCache;
 
 		Window* GetNavigateTarget(TextureManager& texman, const LayoutContext &lc, const DataContext& dc, Navigate navigate);
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "LayoutCache.h"
 #include "Navigation.h"
 #include "Window.h"
 
@@ -34,6 +35,7 @@ namespace UI
 		float _spacing = 0.f;
 		FlowDirection _flowDirection = FlowDirection::Vertical;
 		Align _align = Align::LT;
+		mutable ChildLayoutCache _layoutCache;
 
 		Window* GetNavigateTarget(TextureManager& texman, const LayoutContext& lc, const DataContext& dc, Navigate navigate);
 
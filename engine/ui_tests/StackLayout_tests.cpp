@@ -75,3 +75,31 @@ TEST(StackLayout, ChildrenLayout)
         EXPECT_EQ(-2, childLayout3.rect.left); // rounded left
     }
 }
+
+TEST(StackLayout, LayoutCachedPerPass)
+{
+    TextureManager texman;
+    UI::StackLayout stackLayout;
+
+    auto child1 = std::make_shared<UI::Window>();
+    auto child2 = std::make_shared<UI::Window>();
+    child1->Resize(0, 10);
+    child2->Resize(0, 20);
+    stackLayout.AddFront(child1);
+    stackLayout.AddFront(child2);
+
+    UI::DataContext dc;
+    UI::LayoutContext lc(1, 1, vec2d{}, vec2d{ 100, 100 }, true, true);
+    EXPECT_EQ(10, stackLayout.GetChildLayout(texman, lc, dc, *child2).rect.top);
+
+    // content changes are picked up by the next pass
+    child1->Resize(0, 15);
+    EXPECT_EQ(10, stackLayout.GetChildLayout(texman, lc, dc, *child2).rect.top);
+    UI::LayoutContext nextPassLC(1, 1, vec2d{}, vec2d{ 100, 100 }, true, true);
+    EXPECT_EQ(15, stackLayout.GetChildLayout(texman, nextPassLC, dc, *child2).rect.top);
+
+    // so are new children
+    auto child3 = std::make_shared<UI::Window>();
+    stackLayout.AddFront(child3);
+    EXPECT_EQ(35, stackLayout.GetChildLayout(texman, nextPassLC, dc, *child3).rect.top);
+}
@@ -651,14 +651,17 @@ static float sintable[SINTABLE_SIZE] = {
 	-0.707106f,-0.555570f,-0.382683f,-0.195090f,
 };
 
-void RenderContext::DrawPointLight(float intensity, float radius, vec2d pos)
+// Light writers take a fan allocator so that the same geometry can go either
+// straight to the render or to a LightFans recording.
+
+template <class FanAllocator>
+static void WritePointLight(FanAllocator &&drawFan, float intensity, float radius, vec2d pos)
 {
 	SpriteColor color;
 	color.color = 0x00000000;
 	color.a = (unsigned char) std::max(0, std::min(255, int(255.0f * intensity)));
 
-	IRender &render = _render;
-	MyVertex *v = render.DrawFan(SINTABLE_SIZE>>1);
+	MyVertex *v = drawFan(SINTABLE_SIZE>>1);
 	v[0].color = color;
 	v[0].x = pos.x;
 	v[0].y = pos.y;
@@ -670,14 +673,14 @@ void RenderContext::DrawPointLight(float intensity, float radius, vec2d pos)
 	}
 }
 
-void RenderContext::DrawSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect)
+template <class FanAllocator>
+static void WriteSpotLight(FanAllocator &&drawFan, float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect)
 {
 	SpriteColor color;
 	color.color = 0x00000000;
 	color.a = (unsigned char) std::max(0, std::min(255, int(255.0f * intensity)));
 
-	IRender &render = _render;
-	MyVertex *v = render.DrawFan(SINTABLE_SIZE);
+	MyVertex *v = drawFan(SINTABLE_SIZE);
 	v[0].color = color;
 	v[0].x = pos.x;
 	v[0].y = pos.y;
@@ -691,14 +694,14 @@ void RenderContext::DrawSpotLight(float intensity, float radius, vec2d pos, vec2
 	}
 }
 
-void RenderContext::DrawDirectLight(float intensity, float radius, vec2d pos, vec2d dir, float length)
+template <class FanAllocator>
+static void WriteDirectLight(FanAllocator &&drawFan, float intensity, float radius, vec2d pos, vec2d dir, float length)
 {
 	SpriteColor color;
 	color.color = 0x00000000;
 	color.a = (unsigned char) std::max(0, std::min(255, int(255.0f * intensity)));
 
-	IRender &render = _render;
-	MyVertex *v = render.DrawFan((SINTABLE_SIZE>>2)+4);
+	MyVertex *v = drawFan((SINTABLE_SIZE>>2)+4);
 	v[0].color = color;
 	v[0].x = pos.x;
 	v[0].y = pos.y;
@@ -723,7 +726,7 @@ void RenderContext::DrawDirectLight(float intensity, float radius, vec2d pos, ve
 	v[(SINTABLE_SIZE>>2)+4].x = pos.x + length * dir.x - radius*dir.y;
 	v[(SINTABLE_SIZE>>2)+4].y = pos.y + length * dir.y + radius*dir.x;
 
-	v = render.DrawFan((SINTABLE_SIZE>>2)+1);
+	v = drawFan((SINTABLE_SIZE>>2)+1);
 	v[0].color = color;
 	v[0].x = pos.x + length * dir.x;
 	v[0].y = pos.y + length * dir.y;
@@ -737,6 +740,64 @@ void RenderContext::DrawDirectLight(float intensity, float radius, vec2d pos, ve
 	}
 }
 
+void RenderContext::DrawPointLight(float intensity, float radius, vec2d pos)
+{
+	WritePointLight([this](unsigned int nEdges) { return _render.DrawFan(nEdges); }, intensity, radius, pos);
+}
+
+void RenderContext::DrawSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect)
+{
+	WriteSpotLight([this](unsigned int nEdges) { return _render.DrawFan(nEdges); }, intensity, radius, pos, dir, offset, aspect);
+}
+
+void RenderContext::DrawDirectLight(float intensity, float radius, vec2d pos, vec2d dir, float length)
+{
+	WriteDirectLight([this](unsigned int nEdges) { return _render.DrawFan(nEdges); }, intensity, radius, pos, dir, length);
+}
+
+void RenderContext::DrawLightFans(const LightFans &fans)
+{
+	const MyVertex *src = fans._vertices.data();
+	for (unsigned int nEdges: fans._edges)
+	{
+		MyVertex *v = _render.DrawFan(nEdges);
+		std::copy(src, src + nEdges + 1, v);
+		src += nEdges + 1;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void LightFans::AddPointLight(float intensity, float radius, vec2d pos)
+{
+	WritePointLight([this](unsigned int nEdges) { return AddFan(nEdges); }, intensity, radius, pos);
+}
+
+void LightFans::AddSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect)
+{
+	WriteSpotLight([this](unsigned int nEdges) { return AddFan(nEdges); }, intensity, radius, pos, dir, offset, aspect);
+}
+
+void LightFans::AddDirectLight(float intensity, float radius, vec2d pos, vec2d dir, float length)
+{
+	WriteDirectLight([this](unsigned int nEdges) { return AddFan(nEdges); }, intensity, radius, pos, dir, length);
+}
+
+void LightFans::Clear()
+{
+	_vertices.clear();
+	_edges.clear();
+}
+
+MyVertex* LightFans::AddFan(unsigned int nEdges)
+{
+	// the pointer stays valid until the next fan is added
+	size_t first = _vertices.size();
+	_vertices.resize(first + nEdges + 1);
+	_edges.push_back(nEdges);
+	return &_vertices[first];
+}
+
 void RenderContext::SetAmbient(float ambient)
 {
 	_render.SetAmbient(ambient);
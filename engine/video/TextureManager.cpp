@@ -3,7 +3,9 @@
 #include "inc/video/TgaImage.h"
 
 #include <fs/FileSystem.h>
+#include <tasks/TaskPool.h>
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -28,6 +30,57 @@ ImageView ImageCache::GetImage(FS::FileSystem& fs, std::string_view filePath)
 	return imageIt->second.GetData();
 }
 
+void ImageCache::Preload(FS::FileSystem& fs, TaskPool& taskPool, const std::vector<std::string_view>& filePaths)
+{
+	struct Pending
+	{
+		std::string_view filePath;
+		std::future<TgaImage> image;
+	};
+	std::vector<Pending> pending;
+
+	// sprites often share a texture
+	std::vector<std::string_view> uniquePaths(filePaths);
+	std::sort(uniquePaths.begin(), uniquePaths.end());
+	uniquePaths.erase(std::unique(uniquePaths.begin(), uniquePaths.end()), uniquePaths.end());
+
+	// the file system is not thread safe, only decoding goes to the pool
+	for (auto filePath : uniquePaths)
+	{
+		if (_loadedImages.count(filePath))
+			continue;
+
+		// the map is released here too, workers only see the copy
+		std::vector<char> file;
+		try
+		{
+			auto map = fs.Open(filePath)->QueryMap();
+			const char *data = static_cast<const char*>(map->GetData());
+			file.assign(data, data + map->GetSize());
+		}
+		catch (const std::exception&)
+		{
+			continue;
+		}
+
+		pending.push_back({ filePath, taskPool.Submit([file = std::move(file)]
+		{
+			return TgaImage(file.data(), file.size());
+		}) });
+	}
+
+	for (auto& p : pending)
+	{
+		try
+		{
+			_loadedImages.emplace(p.filePath, p.image.get());
+		}
+		catch (const std::exception&)
+		{
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 TextureManager::TextureManager()
@@ -83,8 +136,16 @@ static LogicalTexture LogicalTextureFromSpriteDefinition(const PackageSpriteDesc
 	return lt;
 }
 
-void TextureManager::LoadPackage(FS::FileSystem& fs, ImageCache &imageCache, const std::vector<PackageSpriteDesc>& packageSpriteDescs)
+void TextureManager::LoadPackage(FS::FileSystem& fs, ImageCache &imageCache, const std::vector<PackageSpriteDesc>& packageSpriteDescs, TaskPool* taskPool)
 {
+	if (taskPool)
+	{
+		std::vector<std::string_view> filePaths;
+		for (auto& psd : packageSpriteDescs)
+			filePaths.push_back(psd.textureFilePath);
+		imageCache.Preload(fs, *taskPool, filePaths);
+	}
+
 	for (auto& psd : packageSpriteDescs)
 	{
 		auto image = imageCache.GetImage(fs, psd.textureFilePath);
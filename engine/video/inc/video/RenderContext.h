@@ -2,6 +2,7 @@
 #include "RenderBase.h"
 #include <stack>
 #include <string>
+#include <vector>
 
 class RenderBinding;
 class TextureManager;
@@ -12,6 +13,24 @@ enum enumAlignText {
 	alignTextLB = 6, alignTextCB = 7, alignTextRB = 8,
 };
 
+// Light geometry recorded once and replayed with RenderContext::DrawLightFans,
+// for lights that do not change between frames.
+class LightFans final
+{
+public:
+	void AddPointLight(float intensity, float radius, vec2d pos);
+	void AddSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect);
+	void AddDirectLight(float intensity, float radius, vec2d pos, vec2d dir, float length);
+	void Clear();
+	bool Empty() const { return _edges.empty(); }
+
+private:
+	friend class RenderContext;
+	std::vector<MyVertex> _vertices;
+	std::vector<unsigned int> _edges; // per fan; a fan takes edges + 1 vertices
+	MyVertex* AddFan(unsigned int nEdges);
+};
+
 class RenderContext final
 {
 public:
@@ -40,6 +59,7 @@ public:
 	void DrawPointLight(float intensity, float radius, vec2d pos);
 	void DrawSpotLight(float intensity, float radius, vec2d pos, vec2d dir, float offset, float aspect);
 	void DrawDirectLight(float intensity, float radius, vec2d pos, vec2d dir, float length);
+	void DrawLightFans(const LightFans &fans);
 
 	void SetAmbient(float ambient);
 	void SetMode(const RenderMode mode);
@@ -7,6 +7,8 @@
 #include <vector>
 #include <string>
 
+class TaskPool;
+
 namespace FS
 {
 	struct MemMap;
@@ -43,6 +45,10 @@ public:
 	~ImageCache();
 	ImageView GetImage(FS::FileSystem& fs, std::string_view filePath);
 
+	// Decodes images on the pool ahead of GetImage. Files that fail to load are
+	// skipped here and reported by GetImage as before.
+	void Preload(FS::FileSystem& fs, TaskPool& taskPool, const std::vector<std::string_view>& filePaths);
+
 private:
 	std::map<std::string, class TgaImage, std::less<>> _loadedImages;
 };
@@ -54,7 +60,7 @@ public:
 	TextureManager();
 	~TextureManager();
 
-	void LoadPackage(FS::FileSystem& fs, ImageCache& imageCache, const std::vector<PackageSpriteDesc>& packageSpriteDescs);
+	void LoadPackage(FS::FileSystem& fs, ImageCache& imageCache, const std::vector<PackageSpriteDesc>& packageSpriteDescs, TaskPool* taskPool = nullptr);
 	void UnloadAllTextures() noexcept;
 
 	size_t FindSprite(std::string_view name) const;
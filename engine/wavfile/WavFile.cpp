@@ -83,3 +83,27 @@ void LoadWavPcm(FS::Stream& stream, unsigned int& outFrequency, std::vector<char
 	outFrequency = fmt.SampleRate;
 }
 
+
+void WriteWavPcmHeader(FS::Stream &stream, unsigned int frequency, unsigned int channels, uint32_t dataSize)
+{
+	SubchunkFmt fmt;
+	fmt.AudioFormat = 1;
+	fmt.NumChannels = channels;
+	fmt.SampleRate = frequency;
+	fmt.BitsPerSample = 16;
+	fmt.BlockAlign = channels * fmt.BitsPerSample / 8;
+	fmt.ByteRate = frequency * fmt.BlockAlign;
+
+	RiffHeader riffHeader;
+	riffHeader.ChunkID = 0x46464952; // RIFF
+	riffHeader.ChunkSize = sizeof(riffHeader.Format) + sizeof(SubHeader) * 2 + sizeof(SubchunkFmt) + dataSize;
+	riffHeader.Format = 0x45564157; // WAVE
+	stream.Write(&riffHeader, sizeof(RiffHeader));
+
+	SubHeader fmtHeader = { 0x20746d66, sizeof(SubchunkFmt) }; // fmt
+	stream.Write(&fmtHeader, sizeof(SubHeader));
+	stream.Write(&fmt, sizeof(SubchunkFmt));
+
+	SubHeader dataHeader = { 0x61746164, dataSize }; // data
+	stream.Write(&dataHeader, sizeof(SubHeader));
+}
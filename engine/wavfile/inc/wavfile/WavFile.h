@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 
 namespace FS
@@ -6,3 +7,6 @@ namespace FS
 	struct Stream;
 }
 void LoadWavPcm(FS::Stream &stream, unsigned int &outFrequency, std::vector<char> &outData);
+
+// Writes a 16 bit PCM header; rewrite it with the final dataSize once all samples are written.
+void WriteWavPcmHeader(FS::Stream &stream, unsigned int frequency, unsigned int channels, uint32_t dataSize);
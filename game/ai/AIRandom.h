@@ -0,0 +1,19 @@
+#pragma once
+#include <math/MyMath.h>
+
+// Same generator as World::net_rand. Each bot owns one so that bots can make
+// decisions concurrently; AIManager reseeds them from the world in a fixed
+// order every step.
+class AIRandom final
+{
+public:
+	void Seed(unsigned long seed) { _seed = seed; }
+
+	int Rand() { return ((_seed = _seed * 214013L + 2531011L) >> 16) & RAND_MAX_VALUE; }
+	float Frand(float max) { return (float) Rand() / (float) RAND_MAX_VALUE * max; }
+	vec2d Vrand(float len) { return Vec2dDirection(Frand(PI2)) * len; }
+
+private:
+	static const int RAND_MAX_VALUE = 0xffff;
+	unsigned long _seed = 1;
+};
@@ -1,4 +1,5 @@
 #include "DrivingAgent.h"
+#include "AIRandom.h"
 #include <gc/Field.h>
 #include <gc/SaveFile.h>
 #include <gc/Turrets.h>
@@ -8,6 +9,7 @@
 #include <gc/World.h>
 #include <gc/WorldCfg.h>
 
+#include <algorithm>
 #include <functional>
 
 static void CatmullRom(const vec2d &p1, const vec2d &p2, const vec2d &p3, const vec2d &p4, vec2d &out, float s)
@@ -23,7 +25,75 @@ static void CatmullRom(const vec2d &p1, const vec2d &p2, const vec2d &p3, const
 #define GRID_ALIGN(x, sz)    ((x)-(x)/(sz)*(sz)<(sz)/2)?((x)/(sz)):((x)/(sz)+1)
 
 
-void DrivingAgent::Serialize(SaveFile &f)
+// A* state kept per agent rather than in the shared field cells
+struct DrivingAgent::PathSearch
+{
+	struct Node
+	{
+		unsigned int session = 0;
+		int before; // actual path cost to this node
+		int8_t prev;
+	};
+
+	struct OpenListNode
+	{
+		RefFieldCell cellRef;
+		int totalEstimate;
+
+		bool operator<(OpenListNode other) const
+		{
+			return totalEstimate > other.totalEstimate;
+		}
+	};
+
+	std::vector<Node> nodes;
+	std::vector<OpenListNode> open; // binary heap, lowest estimate on top
+	unsigned int session = 0;
+	int width = 0;
+
+	void Begin(const Field &field)
+	{
+		size_t size = (size_t) field.GetWidth() * field.GetHeight();
+		if (nodes.size() != size)
+		{
+			nodes.assign(size, Node());
+			session = 0;
+		}
+		width = field.GetWidth();
+		++session;
+		open.clear();
+	}
+
+	Node& operator()(RefFieldCell ref)
+	{
+		return nodes[ref.x + ref.y * width];
+	}
+
+	bool IsChecked(const Node &node) const { return node.session == session; }
+	void Check(Node &node) const { node.session = session; }
+
+	void Push(OpenListNode node)
+	{
+		open.push_back(node);
+		std::push_heap(open.begin(), open.end());
+	}
+	void Pop()
+	{
+		std::pop_heap(open.begin(), open.end());
+		open.pop_back();
+	}
+};
+
+DrivingAgent::DrivingAgent()
+	: _search(new PathSearch())
+{
+}
+
+DrivingAgent::~DrivingAgent()
+{
+}
+
+void DrivingAgent::Serialize(World &world, SaveFile &f)
 {
 	f.Serialize(_backTime);
 	f.Serialize(_attackFriendlyTurrets);
@@ -34,8 +104,9 @@ void DrivingAgent::Serialize(SaveFile &f)
 		f.Serialize(size);
 		while (size--)
 		{
-			_attackList.push_back(AttackListType::value_type());
-			f.Serialize(_attackList.back());
+			ObjPtr<GC_RigidBodyStatic> object;
+			f.Serialize(object);
+			_attackList.push_back(world.GetHandle(object));
 		}
 	}
 	else
@@ -44,7 +115,8 @@ void DrivingAgent::Serialize(SaveFile &f)
 		f.Serialize(size);
 		for (AttackListType::iterator it = _attackList.begin(); _attackList.end() != it; ++it)
 		{
-			f.Serialize(*it);
+			ObjPtr<GC_RigidBodyStatic> object = static_cast<GC_RigidBodyStatic*>(world.GetObject(*it));
+			f.Serialize(object);
 		}
 	}
 }
@@ -85,7 +157,7 @@ static int EstimatePathLength(RefFieldCell begin, RefFieldCell end)
 	return std::max(dx, dy) * BLOCK_MULTIPLIER + std::min(dx, dy) * (BLOCK_MULTIPLIER_DIAG - BLOCK_MULTIPLIER);
 }
 
-float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws)
+float DrivingAgent::CreatePath(const World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws)
 {
 	int maxRelativeDepth = int(max_depth * (float)BLOCK_MULTIPLIER);
 
@@ -96,105 +168,88 @@ float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, in
 	to -= Offset(bounds);
 	from -= Offset(bounds);
 
-	Field::NewSession();
-	Field &field = *world._field;
-
-	struct OpenListNode
-	{
-		RefFieldCell cellRef;
-		int totalEstimate;
-
-		bool operator<(OpenListNode other) const
-		{
-			return totalEstimate > other.totalEstimate;
-		}
-	};
-	struct OpenList : public std::priority_queue<OpenListNode>
-	{
-		void clear() { c.clear(); }
-	};
-	static OpenList open;
-	open.clear();
+	const Field &field = *world._field;
+	PathSearch &search = *_search;
+	search.Begin(field);
 
 	RefFieldCell startRef = { (int)std::floor(from.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(from.y / WORLD_BLOCK_SIZE + 0.5f) };
 	RefFieldCell endRef = { (int)std::floor(to.x / WORLD_BLOCK_SIZE + 0.5f), (int)std::floor(to.y / WORLD_BLOCK_SIZE + 0.5f) };
 
-	FieldCell &start = field(startRef.x, startRef.y);
-
 	// if have weapon can pass through walls, turrets, etc. but now concrete or water
 	const uint8_t passabilityMask = ~(ws ? 1u : 0u);
 
-	if( start.ObstacleFlags() & passabilityMask )
+	if( field(startRef.x, startRef.y).ObstacleFlags() & passabilityMask )
 		return -1;
 
-	start.Check();
-	start._before = 0;
-	start._prev = int(dir.Angle() / PI2 * 8 + 0.5f) & 7;
+	PathSearch::Node &start = search(startRef);
+	search.Check(start);
+	start.before = 0;
+	start.prev = int(dir.Angle() / PI2 * 8 + 0.5f) & 7;
 
-	open.push({ startRef, EstimatePathLength(startRef, endRef) });
-	while( !open.empty() )
+	search.Push({ startRef, EstimatePathLength(startRef, endRef) });
+	while( !search.open.empty() )
 	{
-		OpenListNode currentNode = open.top();
+		PathSearch::OpenListNode currentNode = search.open.front();
 		if (currentNode.cellRef == endRef)
 			break; // guaranteed to be optimal when taken from the top of priority queue
-		open.pop();
+		search.Pop();
 
-		FieldCell &current = field(currentNode.cellRef.x, currentNode.cellRef.y);
+		const PathSearch::Node &current = search(currentNode.cellRef);
 
 		for( int i = 0; i < 8; ++i )
 		{
 			RefFieldCell nextRef = { currentNode.cellRef.x + per_x[i], currentNode.cellRef.y + per_y[i] };
-			FieldCell &next = field(nextRef.x, nextRef.y);
-			auto nextObstacleFlags = next.ObstacleFlags();
+			auto nextObstacleFlags = field(nextRef.x, nextRef.y).ObstacleFlags();
 			if( 0 == (nextObstacleFlags & passabilityMask) )
 			{
 				// increase path cost when travel through obstacles
 				int dist_mult = nextObstacleFlags ? ws->distanceMultipler : 1;
 
 				// total cost to 'next' including penalty for turns
-				int nextBefore = current.Before() + dist[i] * dist_mult + turn_cost[(i - current._prev) & 7];
+				int nextBefore = current.before + dist[i] * dist_mult + turn_cost[(i - current.prev) & 7];
 
 				// never visited or found a better path to node
-				if( !next.IsChecked() || nextBefore < next._before)
+				PathSearch::Node &next = search(nextRef);
+				if( !search.IsChecked(next) || nextBefore < next.before)
 				{
-					next.Check();
-					next._before = nextBefore;
-					next._prev = i;
+					search.Check(next);
+					next.before = nextBefore;
+					next.prev = i;
 
 					int nextTotal = nextBefore + EstimatePathLength(nextRef, endRef);
 					if (nextTotal < maxRelativeDepth)
 					{
 						// may add same cell ref with a different total
-						open.push({ nextRef, nextTotal });
+						search.Push({ nextRef, nextTotal });
 					}
 				}
 			}
 		}
 	}
 
-	if( field(endRef.x, endRef.y).IsChecked() )
+	if( search.IsChecked(search(endRef)) )
 	{
-		float distance = (float)field(endRef.x, endRef.y).Before() / (float)BLOCK_MULTIPLIER;
+		float distance = (float)search(endRef).before / (float)BLOCK_MULTIPLIER;
 
 		if( !bTest )
 		{
 			ClearPath();
 
 			RefFieldCell currentRef = endRef;
-			const FieldCell *current = &field(currentRef.x, currentRef.y);
 
 			_path.push_back(to + Offset(bounds));
 
 			while( currentRef != startRef )
 			{
 				// trace back
-				currentRef.x -= per_x[current->_prev];
-				currentRef.y -= per_y[current->_prev];
-				current = &field(currentRef.x, currentRef.y);
+				int prev = search(currentRef).prev;
+				currentRef.x -= per_x[prev];
+				currentRef.y -= per_y[prev];
+				const FieldCell &current = field(currentRef.x, currentRef.y);
 
-				for( unsigned int i = 0; i < current->GetObjectsCount(); ++i )
+				for( unsigned int i = 0; i < current.GetObjectsCount(); ++i )
 				{
-					auto object = static_cast<GC_RigidBodyStatic*>(world.GetList(GlobalListID::LIST_objects).at(current->GetObject(i)));
+					auto object = static_cast<GC_RigidBodyStatic*>(world.GetList(GlobalListID::LIST_objects).at(current.GetObject(i)));
 					if( team && !_attackFriendlyTurrets)
 					{
 						auto turret = dynamic_cast<GC_Turret*>(object);
@@ -203,7 +258,7 @@ float DrivingAgent::CreatePath(World &world, vec2d from, vec2d dir, vec2d to, in
 							continue;
 						}
 					}
-					_attackList.push_front(object);
+					_attackList.push_front(world.GetHandle(object));
 				}
 
 				// skip first node, will use exact 'from' location instead
@@ -402,11 +457,21 @@ static void RotateTo(const GC_Vehicle &vehicle, VehicleState *outState, const ve
 	outState->steering = newDirection;
 }
 
-void DrivingAgent::ComputeState(World &world, const GC_Vehicle &vehicle, float dt, VehicleState &vs)
+void DrivingAgent::RemoveDeadTargets(const World &world)
 {
-	// clean the attack list
-	_attackList.remove_if([](auto &arg){ return !arg; });
+	_attackList.remove_if([&world](ObjectHandle handle){ return !world.GetObject(handle); });
+}
 
+GC_RigidBodyStatic* DrivingAgent::GetAttackTarget(const World &world) const
+{
+	for (ObjectHandle handle: _attackList)
+		if (GC_Object *object = world.GetObject(handle))
+			return static_cast<GC_RigidBodyStatic*>(object);
+	return nullptr;
+}
+
+void DrivingAgent::ComputeState(const World &world, AIRandom &random, const GC_Vehicle &vehicle, float dt, VehicleState &vs)
+{
 	vec2d arrivalPoint = {};
 
 	vec2d brake = vehicle.GetBrakingLength();
@@ -598,7 +663,7 @@ void DrivingAgent::ComputeState(World &world, const GC_Vehicle &vehicle, float d
 
 	if (_backTime <= 0 && world.GetTime() - _lastProgressTime > 0.6f)
 	{
-		_backTime = world.net_frand(0.5f);
+		_backTime = random.Frand(0.5f);
 	}
 }
 
@@ -1,10 +1,11 @@
 #pragma once
-#include <gc/ObjPtr.h>
+#include <gc/ObjectHandle.h>
 #include <math/MyMath.h>
 #include <list>
+#include <memory>
 #include <vector>
 
-class FieldCell;
+class AIRandom;
 class SaveFile;
 class GC_RigidBodyStatic;
 class GC_Vehicle;
@@ -15,7 +16,10 @@ struct VehicleState;
 class DrivingAgent final
 {
 public:
-	typedef std::list<ObjPtr<GC_RigidBodyStatic> > AttackListType;
+	typedef std::list<ObjectHandle> AttackListType; // GC_RigidBodyStatic
+
+	DrivingAgent();
+	~DrivingAgent();
 
 	//-------------------------------------------------------------------------
 	//  to           - coordinates of the arrival point
@@ -23,7 +27,7 @@ public:
 	//  bTest        - if true then path cost is evaluated only; current path remains unchanged
 	// Return: path cost or -1 if path was not found
 	//-------------------------------------------------------------------------
-	float CreatePath(World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws);
+	float CreatePath(const World &world, vec2d from, vec2d dir, vec2d to, int team, float max_depth, bool bTest, const AIWEAPSETTINGS *ws);
 	bool HasPath() const { return !_path.empty(); }
 	const std::vector<vec2d>& GetPath() const { return _path; }
 
@@ -38,13 +42,22 @@ public:
 
 	void StayAway(vec2d fromCenter, float radius);
 
-	void ComputeState(World &world, const GC_Vehicle &vehicle, float dt, VehicleState &vs);
-	void Serialize(SaveFile &f);
+	// drops handles of dead objects
+	void RemoveDeadTargets(const World &world);
+
+	// the first live object in the way, or null
+	GC_RigidBodyStatic* GetAttackTarget(const World &world) const;
+
+	void ComputeState(const World &world, AIRandom &random, const GC_Vehicle &vehicle, float dt, VehicleState &vs);
+	void Serialize(World &world, SaveFile &f);
 
 	void SetAttackFriendlyTurrets(bool value) { _attackFriendlyTurrets = value; }
 
 	AttackListType _attackList;
 private:
+	struct PathSearch;
+	std::unique_ptr<PathSearch> _search;
+
 	std::vector<vec2d> _path;
 	int _pathProgress = -1;
 	float _lastProgressTime = 0;
@@ -1,4 +1,5 @@
 #include "ShootingAgent.h"
+#include "AIRandom.h"
 #include <gc/SaveFile.h>
 #include <gc/Vehicle.h>
 #include <gc/WeaponBase.h>
@@ -33,7 +34,7 @@ static void TowerTo(const GC_Vehicle &vehicle, VehicleState *outState, const vec
 	}
 }
 
-void ShootingAgent::AttackTarget(World &world, const GC_Vehicle &myVehicle, const GC_RigidBodyStatic &target, float dt, VehicleState &outVehicleState)
+void ShootingAgent::AttackTarget(const World &world, AIRandom &random, const GC_Vehicle &myVehicle, const GC_RigidBodyStatic &target, float dt, VehicleState &outVehicleState)
 {
 	auto targetAsVehicle = PtrDynCast<const GC_Vehicle>(&target);
 
@@ -46,7 +47,7 @@ void ShootingAgent::AttackTarget(World &world, const GC_Vehicle &myVehicle, cons
 		{
 			_currentOffset = _desiredOffset;
 
-			static float d_array[5] = { 0.5f, 0.5f, 0.00f };
+			static const float d_array[5] = { 0.5f, 0.5f, 0.00f };
 
 			float d = d_array[_accuracy];
 
@@ -55,7 +56,7 @@ void ShootingAgent::AttackTarget(World &world, const GC_Vehicle &myVehicle, cons
 				d = d_array[_accuracy] * (fabs(targetAsVehicle->_lv.len()) / targetAsVehicle->GetMaxSpeed() / 2 + 0.5f);
 			}
 
-			_desiredOffset = (d > 0) ? (world.net_frand(d) - d * 0.5f) : 0;
+			_desiredOffset = (d > 0) ? (random.Frand(d) - d * 0.5f) : 0;
 		}
 		else
 		{
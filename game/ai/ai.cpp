@@ -1,4 +1,5 @@
 #include "inc/ai/ai.h"
+#include "AIRandom.h"
 #include "DrivingAgent.h"
 #include "ShootingAgent.h"
 #include <gc/Pickup.h>
@@ -19,6 +20,7 @@
 AIController::AIController()
   : _drivingAgent(new DrivingAgent())
   , _shootingAgent(new ShootingAgent())
+  , _random(new AIRandom())
   , _favoriteWeaponType(INVALID_OBJECT_TYPE)
   , _difficulty(AIDiffuculty::Medium)
   , _isActive(true)
@@ -28,6 +30,7 @@ AIController::AIController()
 }
 
 AIController::AIController(FromFile)
+  : _random(new AIRandom())
 {
 }
 
@@ -35,32 +38,46 @@ AIController::~AIController()
 {
 }
 
-void AIController::Serialize(SaveFile &f)
+static void SerializeHandle(World &world, SaveFile &f, ObjectHandle &handle)
 {
-	_drivingAgent->Serialize(f);
+	ObjPtr<GC_Object> ptr = world.GetObject(handle);
+	f.Serialize(ptr);
+	if( f.loading() )
+		handle = world.GetHandle(ptr);
+}
+
+void AIController::Serialize(World &world, SaveFile &f)
+{
+	_drivingAgent->Serialize(world, f);
 	_shootingAgent->Serialize(f);
 
 	f.Serialize(_difficulty);
 	f.Serialize(_aiState_l1);
 	f.Serialize(_aiState_l2);
 	f.Serialize(_favoriteWeaponType);
-	f.Serialize(_pickupCurrent);
-	f.Serialize(_target);
+	SerializeHandle(world, f, _pickupCurrent);
+	SerializeHandle(world, f, _target);
 	f.Serialize(_isActive);
 }
 
-void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle &vehicle, VehicleState &outVehicleState, bool allowExtraCalc)
+void AIController::PrepareStep(const World &world, unsigned long seed)
+{
+	_random->Seed(seed);
+	_drivingAgent->RemoveDeadTargets(world);
+}
+
+void AIController::ReadControllerState(const World &world, float dt, const GC_Vehicle &vehicle, VehicleState &outVehicleState, bool allowExtraCalc)
 {
 	memset(&outVehicleState, 0, sizeof(VehicleState));
 
-	if( _pickupCurrent )
+	if( GC_Pickup *pickup = GetPickupCurrent(world) )
 	{
-		if( !_pickupCurrent->GetVisible() )
+		if( !pickup->GetVisible() )
 		{
-			_pickupCurrent = nullptr;
+			_pickupCurrent = {};
 		}
-		else if( (_pickupCurrent->GetPos() - vehicle.GetPos()).sqr() <
-		         std::pow(_pickupCurrent->GetRadius() + vehicle.GetRadius(), 2) )
+		else if( (pickup->GetPos() - vehicle.GetPos()).sqr() <
+		         std::pow(pickup->GetRadius() + vehicle.GetRadius(), 2) )
 		{
 			outVehicleState.pickup = true;
 		}
@@ -78,29 +95,31 @@ void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle
 
 	if (L1_NONE == _aiState_l1)
 	{
-		_drivingAgent->ComputeState(world, vehicle, dt, outVehicleState);
+		_drivingAgent->ComputeState(world, *_random, vehicle, dt, outVehicleState);
 
 		if (!vehicle.GetWeapon())
 		{
 			// no targets if no weapon
-			_target = nullptr;
+			_target = {};
 			_drivingAgent->_attackList.clear();
 		}
 
-		if (_target && IsTargetVisible(world, vehicle, _target))
+		GC_RigidBodyStatic *target = GetTarget(world);
+		if (target && IsTargetVisible(world, vehicle, target))
 		{
 			// attack the primary target
-			_shootingAgent->AttackTarget(world, vehicle, *_target, dt, outVehicleState);
-			_drivingAgent->StayAway(_target->GetPos(), weapSettings.fAttackRadius_min);
+			_shootingAgent->AttackTarget(world, *_random, vehicle, *target, dt, outVehicleState);
+			_drivingAgent->StayAway(target->GetPos(), weapSettings.fAttackRadius_min);
 		}
 		else
 		{
 			_drivingAgent->StayAway({}, 0);
 
-			if (!_drivingAgent->_attackList.empty() && IsTargetVisible(world, vehicle, _drivingAgent->_attackList.front()))
+			GC_RigidBodyStatic *secondary = _drivingAgent->GetAttackTarget(world);
+			if (secondary && IsTargetVisible(world, vehicle, secondary))
 			{
 				// attack secondary targets
-				_shootingAgent->AttackTarget(world, vehicle, *_drivingAgent->_attackList.front(), dt, outVehicleState);
+				_shootingAgent->AttackTarget(world, *_random, vehicle, *secondary, dt, outVehicleState);
 			}
 		}
 
@@ -114,7 +133,7 @@ void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle
 		outVehicleState.light = true;
 		break;
 	case AIDiffuculty::Medium:
-		outVehicleState.light = (nullptr != _target);
+		outVehicleState.light = (nullptr != GetTarget(world));
 		break;
 	case AIDiffuculty::Hard:
 		outVehicleState.light = false;
@@ -122,6 +141,16 @@ void AIController::ReadControllerState(World &world, float dt, const GC_Vehicle
 	}
 }
 
+GC_Pickup* AIController::GetPickupCurrent(const World &world) const
+{
+	return static_cast<GC_Pickup*>(world.GetObject(_pickupCurrent));
+}
+
+GC_RigidBodyStatic* AIController::GetTarget(const World &world) const
+{
+	return static_cast<GC_RigidBodyStatic*>(world.GetObject(_target));
+}
+
 const std::vector<vec2d>& AIController::GetPath() const
 {
 	return _drivingAgent->GetPath();
@@ -146,7 +175,7 @@ AIPRIORITY AIController::GetTargetRank(const GC_Vehicle &vehicle, GC_Vehicle &ta
 	return p;
 }
 
-AIITEMINFO AIController::FindTarget(World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws)
+AIITEMINFO AIController::FindTarget(const World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws)
 {
 	if (!vehicle.GetWeapon())
 		return { };
@@ -204,11 +233,11 @@ AIITEMINFO AIController::FindTarget(World &world, const GC_Vehicle &vehicle, con
 	return bestTarget;
 }
 
-bool AIController::FindItem(World &world, const GC_Vehicle &vehicle, /*out*/ AIITEMINFO &info, const AIWEAPSETTINGS *ws)
+bool AIController::FindItem(const World &world, const GC_Vehicle &vehicle, /*out*/ AIITEMINFO &info, const AIWEAPSETTINGS *ws)
 {
 	std::vector<GC_Pickup *> applicants;
 
-    std::vector<ObjectList*> receive;
+	std::vector<const ObjectList*> receive;
 	FRECT rt = {
 		(vehicle.GetPos().x - AI_MAX_SIGHT) / WORLD_LOCATION_SIZE,
 		(vehicle.GetPos().y - AI_MAX_SIGHT) / WORLD_LOCATION_SIZE,
@@ -218,7 +247,7 @@ bool AIController::FindItem(World &world, const GC_Vehicle &vehicle, /*out*/ AII
 	world.grid_pickup.OverlapRect(receive, rt);
 	for( auto i = receive.begin(); i != receive.end(); ++i )
 	{
-        ObjectList *ls = *i;
+		const ObjectList *ls = *i;
 		for( auto it = ls->begin(); it != ls->end(); it = ls->next(it) )
 		{
 			GC_Pickup *pItem = (GC_Pickup *) ls->at(it);
@@ -241,8 +270,8 @@ bool AIController::FindItem(World &world, const GC_Vehicle &vehicle, /*out*/ AII
 	if( !applicants.empty() )
 	{
 		GC_Pickup *items[2] = {
-			_pickupCurrent,
-			applicants[world.net_rand() % applicants.size()]
+			GetPickupCurrent(world),
+			applicants[_random->Rand() % applicants.size()]
 		};
 		for( int i = 0; i < 2; ++i )
 		{
@@ -345,7 +374,7 @@ void AIController::SetL2(aiState_l2 new_state)
 	_aiState_l2 = new_state;
 }
 
-void AIController::ProcessAction(World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws)
+void AIController::ProcessAction(const World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws)
 {
 	AIITEMINFO ii_item{};
 	if (_difficulty != AIDiffuculty::Easy || !vehicle.GetWeapon()) // easy only look for weapons
@@ -354,44 +383,44 @@ void AIController::ProcessAction(World &world, const GC_Vehicle &vehicle, const
 	if( AIITEMINFO ii_target = FindTarget(world, vehicle, ws) )
 	{
 		assert(vehicle.GetWeapon());
-		_target = PtrCast<GC_RigidBodyStatic>(ii_target.object);
+		_target = world.GetHandle(ii_target.object);
 
 		if( ii_target.priority > ii_item.priority )
 		{
-			if(_drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), _target->GetPos(), vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, false, ws) > 0 )
+			if(_drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), ii_target.object->GetPos(), vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, false, ws) > 0 )
 			{
 				_drivingAgent->SmoothPath();
 			}
-			_pickupCurrent = nullptr;
+			_pickupCurrent = {};
 			SetL2(L2_ATTACK);
 			SetL1(L1_NONE);
 		}
 		else
 		{
-			Pickup(world, vehicle, PtrCast<GC_Pickup>(ii_item.object));
+			Pickup(world, vehicle, static_cast<GC_Pickup*>(ii_item.object));
 		}
 	}
 	else
 	{
-		_target = nullptr;
+		_target = {};
 
 		if( ii_item.priority > AIP_NOTREQUIRED )
 		{
 			assert(ii_item.object);
-			if( _pickupCurrent != ii_item.object )
+			if( _pickupCurrent != world.GetHandle(ii_item.object) )
 			{
 				if(_drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), ii_item.object->GetPos(), vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, false, ws) > 0 )
 				{
 					_drivingAgent->SmoothPath();
 				}
-				_pickupCurrent = PtrCast<GC_Pickup>(ii_item.object);
+				_pickupCurrent = world.GetHandle(ii_item.object);
 			}
 			SetL2(L2_PICKUP);
 			SetL1(L1_NONE);
 		}
 		else
 		{
-			_pickupCurrent = nullptr;
+			_pickupCurrent = {};
 			SetL2(L2_PATH_SELECT);
 		}
 	}
@@ -404,7 +433,7 @@ void AIController::SetDifficulty(AIDiffuculty diffuculty)
 	_shootingAgent->SetAccuracy((int)diffuculty);
 }
 
-bool AIController::March(World &world, const GC_Vehicle &vehicle, float x, float y)
+bool AIController::March(const World &world, const GC_Vehicle &vehicle, float x, float y)
 {
     AIWEAPSETTINGS ws;
     if( vehicle.GetWeapon() )
@@ -418,21 +447,21 @@ bool AIController::March(World &world, const GC_Vehicle &vehicle, float x, float
 	return false;
 }
 
-bool AIController::Attack(World &world, const GC_Vehicle &vehicle, GC_RigidBodyStatic *target)
+bool AIController::Attack(const World &world, const GC_Vehicle &vehicle, GC_RigidBodyStatic *target)
 {
 	if( vehicle.GetWeapon() )
 	{
-		_target = target;
+		_target = world.GetHandle(target);
 		return true;
 	}
 	return false;
 }
 
 
-bool AIController::Pickup(World &world, const GC_Vehicle &vehicle, GC_Pickup *p)
+bool AIController::Pickup(const World &world, const GC_Vehicle &vehicle, GC_Pickup *p)
 {
 	assert(p);
-    if( _pickupCurrent != p )
+    if( _pickupCurrent != world.GetHandle(p) )
     {
         AIWEAPSETTINGS ws;
         if( vehicle.GetWeapon() )
@@ -441,7 +470,7 @@ bool AIController::Pickup(World &world, const GC_Vehicle &vehicle, GC_Pickup *p)
         if(_drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), p->GetPos(), vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, false, &ws) > 0 )
         {
 			_drivingAgent->SmoothPath();
-            _pickupCurrent = p;
+            _pickupCurrent = world.GetHandle(p);
             SetL2(L2_PICKUP);
             SetL1(L1_NONE);
             return true;
@@ -456,11 +485,11 @@ bool AIController::Pickup(World &world, const GC_Vehicle &vehicle, GC_Pickup *p)
 
 void AIController::Stop()
 {
-	_target = nullptr;
+	_target = {};
 	_drivingAgent->ClearPath();
 }
 
-void AIController::SelectState(World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws)
+void AIController::SelectState(const World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws)
 {
 	if( !_isActive )
 	{
@@ -477,10 +506,10 @@ void AIController::SelectState(World &world, const GC_Vehicle &vehicle, const AI
 		assert(_target);
 		break;
 	case L2_PATH_SELECT:
-		assert(nullptr == _target);
+		assert(!_target);
 		if( !_drivingAgent->HasPath() )
 		{
-			vec2d t = vehicle.GetPos() + world.net_vrand(sqrtf(world.net_frand(1.0f))) * AI_MAX_SIGHT;
+			vec2d t = vehicle.GetPos() + _random->Vrand(sqrtf(_random->Frand(1.0f))) * AI_MAX_SIGHT;
 			t = Vec2dClamp(t, world.GetBounds());
 
 			if (_drivingAgent->CreatePath(world, vehicle.GetPos(), vehicle.GetDirection(), t, vehicle.GetOwner()->GetTeam(), AI_MAX_DEPTH, false, ws) > 0)
@@ -538,7 +567,7 @@ void AIController::OnRespawn(World &world, const GC_Vehicle &vehicle)
 
 void AIController::OnDie()
 {
-	_pickupCurrent = nullptr;
-	_target = nullptr;
+	_pickupCurrent = {};
+	_target = {};
 	_drivingAgent->ClearPath();
 }
@@ -1,6 +1,6 @@
 #pragma once
 #include <gc/Object.h>
-#include <gc/ObjPtr.h>
+#include <gc/ObjectHandle.h>
 #include <math/MyMath.h>
 #include <list>
 
@@ -14,6 +14,7 @@ class GC_Vehicle;
 class SaveFile;
 class World;
 
+class AIRandom;
 class DrivingAgent;
 class ShootingAgent;
 
@@ -23,7 +24,7 @@ typedef float AIPRIORITY;
 
 struct AIITEMINFO
 {
-	ObjPtr<GC_MovingObject> object;
+	GC_MovingObject *object; // only valid during the step that found it
 	AIPRIORITY priority;
 	operator bool() const { return !!object; }
 };
@@ -42,7 +43,7 @@ public:
 	AIController(FromFile);
 	~AIController();
 
-	void Serialize(SaveFile &f);
+	void Serialize(World &world, SaveFile &f);
 
 	void OnRespawn(World &world, const GC_Vehicle &vehicle);
 	void OnDie();
@@ -50,12 +51,17 @@ public:
 	void SetDifficulty(AIDiffuculty diffuculty);
 	AIDiffuculty GetDiffuculty() const { return _difficulty; }
 
-	bool March(World &world, const GC_Vehicle &vehicle, float x, float y);
-	bool Attack(World &world, const GC_Vehicle &vehicle, GC_RigidBodyStatic *target);
-	bool Pickup(World &world, const GC_Vehicle &vehicle, GC_Pickup *p);
+	bool March(const World &world, const GC_Vehicle &vehicle, float x, float y);
+	bool Attack(const World &world, const GC_Vehicle &vehicle, GC_RigidBodyStatic *target);
+	bool Pickup(const World &world, const GC_Vehicle &vehicle, GC_Pickup *p);
 	void Stop();
 
-	void ReadControllerState(World &world, float dt, const GC_Vehicle &vehicle, VehicleState &vs, bool allowExtraCalc);
+	// Runs on the owning thread before ReadControllerState. Drops handles
+	// of dead objects.
+	void PrepareStep(const World &world, unsigned long seed);
+
+	// Only reads the world; different controllers may run concurrently.
+	void ReadControllerState(const World &world, float dt, const GC_Vehicle &vehicle, VehicleState &vs, bool allowExtraCalc);
 
 	const std::vector<vec2d>& GetPath() const;
 
@@ -78,8 +84,8 @@ private:
 	void SetL1(aiState_l1 new_state);
 	void SetL2(aiState_l2 new_state);
 
-	void ProcessAction(World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws);
-	void SelectState(World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws);
+	void ProcessAction(const World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws);
+	void SelectState(const World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws);
 
 	void SetActive(bool active);
 	bool GetActive() const { return _isActive; }
@@ -87,8 +93,8 @@ private:
 	bool IsTargetVisible(const World &world, const GC_Vehicle &vehicle, GC_RigidBodyStatic *target, GC_RigidBodyStatic** ppObstacle = nullptr);
 	AIPRIORITY GetTargetRank(const GC_Vehicle &vehicle, GC_Vehicle &target);
 
-	AIITEMINFO FindTarget(World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws);
-	bool FindItem(World &world, const GC_Vehicle &vehicle, AIITEMINFO &info, const AIWEAPSETTINGS *ws);     // return true if something was found
+	AIITEMINFO FindTarget(const World &world, const GC_Vehicle &vehicle, const AIWEAPSETTINGS *ws);
+	bool FindItem(const World &world, const GC_Vehicle &vehicle, AIITEMINFO &info, const AIWEAPSETTINGS *ws);     // return true if something was found
 
 	void SelectFavoriteWeapon(World &world);
 
@@ -100,9 +106,13 @@ private:
 
 	std::unique_ptr<DrivingAgent> _drivingAgent;
 	std::unique_ptr<ShootingAgent> _shootingAgent;
+	std::unique_ptr<AIRandom> _random;
+
+	ObjectHandle _pickupCurrent; // GC_Pickup
+	ObjectHandle _target;        // GC_RigidBodyStatic, current target
 
-	ObjPtr<GC_Pickup>          _pickupCurrent;
-	ObjPtr<GC_RigidBodyStatic> _target;  // current target
+	GC_Pickup* GetPickupCurrent(const World &world) const;
+	GC_RigidBodyStatic* GetTarget(const World &world) const;
 
 	ObjectType _favoriteWeaponType;
 	AIDiffuculty _difficulty;
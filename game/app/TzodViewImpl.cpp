@@ -5,16 +5,17 @@
 #include <shell/Config.h>
 #include <shell/Desktop.h>
 #include <plat/ConsoleBuffer.h>
+#include <tasks/TaskPool.h>
 #ifndef NOSOUND
 # include <audio/SoundView.h>
 #endif
 
-static auto InitTextureManager(FS::FileSystem &fs, ImageCache &imageCache)
+static auto InitTextureManager(FS::FileSystem &fs, ImageCache &imageCache, TaskPool &taskPool)
 {
 	TextureManager textureManager;
 	try
 	{
-		textureManager.LoadPackage(fs, imageCache, ParseDirectory(fs, DIR_SPRITES));
+		textureManager.LoadPackage(fs, imageCache, ParseDirectory(fs, DIR_SPRITES), &taskPool);
 	}
 	catch(const std::runtime_error&)
 	{
@@ -25,7 +26,7 @@ static auto InitTextureManager(FS::FileSystem &fs, ImageCache &imageCache)
 }
 
 TzodViewImpl::TzodViewImpl(FS::FileSystem &fs, Plat::AppWindowCommandClose* cmdClose, Plat::ConsoleBuffer &logger, TzodApp &app)
-	: textureManager(InitTextureManager(fs, imageCache))
+	: textureManager(InitTextureManager(fs, imageCache, app.GetTaskPool()))
 	, timeStepManager()
 	, desktop(std::make_shared<Desktop>(
 		timeStepManager,
@@ -42,7 +43,7 @@ TzodViewImpl::TzodViewImpl(FS::FileSystem &fs, Plat::AppWindowCommandClose* cmdC
 		cmdClose))
 	, uiInputRenderingController(fs, textureManager, timeStepManager, desktop)
 #ifndef NOSOUND
-	, soundView(app.GetShellConfig().s_enabled.Get() ? std::make_unique<SoundView>(*fs.GetFileSystem(DIR_SOUND), logger, app.GetAppState()) : nullptr)
+	, soundView(app.GetShellConfig().s_enabled.Get() ? std::make_unique<SoundView>(*fs.GetFileSystem(DIR_SOUND), logger, app.GetAppState(), app.GetTaskPool()) : nullptr)
 #endif
 {
 }
@@ -21,6 +21,7 @@ class ShellConfig;
 class LangCache;
 class MapCollection;
 class DMCampaign;
+class TaskPool;
 
 class TzodApp final
 {
@@ -35,6 +36,7 @@ public:
 	ShellConfig& GetShellConfig();
 	LangCache& GetLang();
 	DMCampaign &GetDMCampaign();
+	TaskPool& GetTaskPool();
 
 	void Step(float dt);
 	void SaveConfig();
@@ -43,4 +45,6 @@ private:
 	FS::FileSystem &_fs;
 	Plat::ConsoleBuffer &_logger;
 	std::unique_ptr<struct TzodAppImpl> _impl;
+
+	void StepAutosave(float dt);
 };
@@ -3,14 +3,19 @@
 #include <as/AppController.h>
 #include <as/AppState.h>
 #include <as/MapCollection.h>
-#include <ctx/GameContextBase.h>
+#include <ctx/Autosave.h>
+#include <ctx/GameContext.h>
 #include <fs/FileSystem.h>
 #include <fs/StreamWrapper.h>
 #include <loc/Language.h>
 #include <plat/ConsoleBuffer.h>
+#include <tasks/TaskPool.h>
+#include <stdexcept>
+#include <vector>
 
 #define FILE_CONFIG      "user/config.cfg"
 #define FILE_DMCAMPAIGN  "dmcampaign.cfg"
+#define FILE_AUTOSAVE    "user/autosave%d.sav"
 
 static std::map<std::string, std::string> s_localizations = {
 	{"ru", "data/lang.cfg"}
@@ -20,22 +25,53 @@ struct TzodAppImpl
 {
 	explicit TzodAppImpl(FS::FileSystem &fs)
 		: mapCollection(fs)
-		, appController(fs)
+		, appController(fs, taskPool)
+		, autosave(taskPool)
 	{}
 
+	TaskPool taskPool;
 	CombinedConfig combinedConfig;
 	DMCampaign dmCampaign;
 	LangCache lang;
 	MapCollection mapCollection;
 	AppState appState;
 	AppController appController;
+	Autosave autosave;
+	float autosaveTime = 0;
+	int autosaveSlot = 0;
 };
 
+// Reads the file right away since the file system is not thread safe,
+// parsing goes to the pool. Read errors are reported through the future.
 template <class T>
-static void LoadConfigNoThrow(FS::FileSystem &fs, T &confRoot, Plat::ConsoleBuffer &logger, const std::string &filename)
+static std::future<bool> LoadConfigAsync(FS::FileSystem &fs, TaskPool &taskPool, T &confRoot, const std::string &filename)
+{
+	std::vector<char> data;
+	try
+	{
+		std::shared_ptr<FS::Stream> stream = fs.Open(filename)->QueryStream();
+		stream->Seek(0, SEEK_END);
+		data.resize(static_cast<size_t>(stream->Tell()));
+		stream->Seek(0, SEEK_SET);
+		if (!data.empty() && 1 != stream->Read(data.data(), data.size(), 1))
+			throw std::runtime_error("unexpected end of file");
+	}
+	catch (...)
+	{
+		std::promise<bool> failed;
+		failed.set_exception(std::current_exception());
+		return failed.get_future();
+	}
+	return taskPool.Submit([&confRoot, data = std::move(data), filename]
+	{
+		return confRoot->Load(data.data(), data.size(), filename.c_str());
+	});
+}
+
+static void WaitConfigNoThrow(std::future<bool> loaded, Plat::ConsoleBuffer &logger, const std::string &filename)
 try
 {
-	if (confRoot->Load(*fs.Open(filename)->QueryMap(), filename.c_str()))
+	if (loaded.get())
 	{
 		logger.Printf(0, "Config loaded: %s", filename.c_str());
 	}
@@ -54,15 +90,20 @@ TzodApp::TzodApp(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, const char *la
 	, _logger(logger)
 	, _impl(new TzodAppImpl(fs))
 {
-	LoadConfigNoThrow(fs, _impl->combinedConfig, logger, FILE_CONFIG);
-	LoadConfigNoThrow(fs, _impl->dmCampaign, logger, FILE_DMCAMPAIGN);
-	if (language)
+	auto config = LoadConfigAsync(fs, _impl->taskPool, _impl->combinedConfig, FILE_CONFIG);
+	auto dmCampaign = LoadConfigAsync(fs, _impl->taskPool, _impl->dmCampaign, FILE_DMCAMPAIGN);
+	auto langIt = language ? s_localizations.find(language) : s_localizations.end();
+	std::future<bool> lang;
+	if (s_localizations.end() != langIt)
+	{
+		lang = LoadConfigAsync(fs, _impl->taskPool, _impl->lang, langIt->second);
+	}
+
+	WaitConfigNoThrow(std::move(config), logger, FILE_CONFIG);
+	WaitConfigNoThrow(std::move(dmCampaign), logger, FILE_DMCAMPAIGN);
+	if (lang.valid())
 	{
-		auto it = s_localizations.find(language);
-		if (s_localizations.end() != it)
-		{
-			LoadConfigNoThrow(fs, _impl->lang, logger, it->second.c_str());
-		}
+		WaitConfigNoThrow(std::move(lang), logger, langIt->second);
 	}
 	setlocale(LC_CTYPE, std::string(_impl->lang.c_locale.Get()).c_str());
 }
@@ -106,6 +147,11 @@ DMCampaign& TzodApp::GetDMCampaign()
 	return _impl->dmCampaign;
 }
 
+TaskPool& TzodApp::GetTaskPool()
+{
+	return _impl->taskPool;
+}
+
 void TzodApp::Step(float dt)
 {
 	bool configChanged = false;
@@ -115,6 +161,38 @@ void TzodApp::Step(float dt)
 	{
 		SaveConfig();
 	}
+
+	StepAutosave(dt);
+}
+
+void TzodApp::StepAutosave(float dt)
+try
+{
+	_impl->autosave.Poll();
+
+	AppConfig &appConfig = _impl->combinedConfig.game;
+	float interval = appConfig.autosave_interval.GetFloat();
+	auto gameContext = std::dynamic_pointer_cast<GameContext>(_impl->appState.GetGameContext());
+	if (interval <= 0 || !gameContext || !gameContext->IsWorldActive())
+		return;
+
+	// writes finish in order, so the next slot is still being written
+	// when there are as many writes in flight as slots
+	int slots = std::max(1, appConfig.autosave_slots.GetInt());
+	_impl->autosaveTime += dt;
+	if (_impl->autosaveTime < interval || _impl->autosave.IsBusy() || _impl->autosave.GetPendingCount() >= (unsigned int) slots)
+		return;
+	_impl->autosaveTime = 0;
+
+	// the file system is not thread safe, so the file is opened here
+	char fileName[64];
+	snprintf(fileName, sizeof(fileName), FILE_AUTOSAVE, _impl->autosaveSlot);
+	_impl->autosaveSlot = (_impl->autosaveSlot + 1) % slots;
+	_impl->autosave.Save(*gameContext, _fs.Open(fileName, FS::ModeWrite)->QueryStream());
+}
+catch (const std::exception &e)
+{
+	_logger.Printf(1, "Autosave failed: %s", e.what());
 }
 
 void TzodApp::SaveConfig()
@@ -44,8 +44,9 @@ static DMSettings GetCampaignDMSettings(AppConfig &appConfig, DMCampaign &dmCamp
 	return settings;
 }
 
-AppController::AppController(FS::FileSystem &fs)
+AppController::AppController(FS::FileSystem &fs, TaskPool &taskPool)
 	: _fs(fs)
+	, _taskPool(taskPool)
 {
 }
 
@@ -79,7 +80,7 @@ void AppController::StartDMCampaignMap(AppState& appState, MapCollection &mapCol
 
 	auto world = mapCollection.ExtractCachedWorld(_fs, mapDesc.map_name.Get());
 	DMSettings settings = GetCampaignDMSettings(appConfig, dmCampaign, tier, map);
-	appState.PushGameContext(std::make_shared<GameContextCampaignDM>(std::move(world), settings, tier, map));
+	appState.PushGameContext(std::make_shared<GameContextCampaignDM>(std::move(world), settings, tier, map, &_taskPool));
 }
 
 void AppController::PlayCurrentMap(AppState &appState, MapCollection& mapCollection)
@@ -115,7 +116,7 @@ void AppController::PlayCurrentMap(AppState &appState, MapCollection& mapCollect
 	//settings.bots.push_back(bot);
 	settings.timeLimit = 300;
 
-	appState.PushGameContext(std::make_shared<GameContext>(std::move(world), settings));
+	appState.PushGameContext(std::make_shared<GameContext>(std::move(world), settings, &_taskPool));
 }
 
 void AppController::StartNewMapEditor(AppState& appState, MapCollection& mapCollection, int width, int height, std::string_view existingMapNameOptional)
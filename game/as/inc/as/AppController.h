@@ -7,6 +7,7 @@ class AppConfig;
 class DMCampaign;
 class MapCollection;
 class EditorContext;
+class TaskPool;
 
 namespace FS
 {
@@ -16,7 +17,7 @@ namespace FS
 class AppController final
 {
 public:
-	AppController(FS::FileSystem &fs);
+	AppController(FS::FileSystem &fs, TaskPool &taskPool);
 	~AppController();
 	void Step(AppState &appState, AppConfig &appConfig, float dt, bool *outConfigChanged);
 //	void NewGameDM(TzodApp &app, const std::string &mapName, const DMSettings &settings);
@@ -27,6 +28,7 @@ public:
 
 private:
 	FS::FileSystem &_fs;
+	TaskPool &_taskPool;
 
 	void SaveCurrentMap(EditorContext &editorContext, MapCollection& mapCollection);
 };
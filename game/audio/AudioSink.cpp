@@ -0,0 +1,34 @@
+#include "inc/audio/AudioSink.h"
+#include <fs/FileSystem.h>
+#include <wavfile/WavFile.h>
+#include <cstdio>
+
+NullAudioSink::NullAudioSink(unsigned int frequency, size_t framesPerStep)
+	: _frequency(frequency)
+	, _framesPerStep(framesPerStep)
+{
+}
+
+WavFileAudioSink::WavFileAudioSink(std::shared_ptr<FS::Stream> stream, unsigned int frequency, size_t framesPerStep)
+	: _stream(std::move(stream))
+	, _frequency(frequency)
+	, _framesPerStep(framesPerStep)
+	, _headerPos(_stream->Tell())
+{
+	WriteWavPcmHeader(*_stream, _frequency, 2, 0);
+}
+
+WavFileAudioSink::~WavFileAudioSink()
+{
+	long long endPos = _stream->Tell();
+	_stream->Seek(_headerPos, SEEK_SET);
+	WriteWavPcmHeader(*_stream, _frequency, 2, _dataSize);
+	_stream->Seek(endPos, SEEK_SET);
+}
+
+void WavFileAudioSink::Write(const int16_t *samples, size_t frameCount)
+{
+	size_t size = frameCount * 2 * sizeof(int16_t);
+	_stream->Write(samples, size);
+	_dataSize += static_cast<uint32_t>(size);
+}
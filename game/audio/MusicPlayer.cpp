@@ -1,4 +1,5 @@
 #include "inc/audio/MusicPlayer.h"
+#include "OggVorbis.h"
 #include <fs/FileSystem.h>
 #include <al.h>
 #include <cassert>
@@ -25,21 +26,28 @@ static void LogALError()
 }
 
 
+// decoding runs ahead on the stream thread, AL only gets short chunks
+static const unsigned int c_frequency = 44100;
+static const float c_streamSeconds = 4;
+static const size_t c_chunkFrames = 4096;
+
 MusicPlayer::MusicPlayer()
-  : _playing(false)
+  : _stream(c_frequency, c_streamSeconds)
+  , _chunk(c_chunkFrames * 2)
+  , _playing(false)
 {
-	memset(&_vorbisFile, 0, sizeof(OggVorbis_File));
     alGenBuffers(static_cast<ALsizei>(_buffers.size()), _buffers.data());
     ThrowIfALError();
     alGenSources(1, &_source);
     ThrowIfALError();
+    _freeBuffers.assign(_buffers.begin(), _buffers.end());
 //	g_conf.s_musicvolume.eventChange = std::bind(&MusicPlayer::OnChangeVolume, this);
 }
 
 MusicPlayer::~MusicPlayer()
 {
 //	g_conf.s_musicvolume.eventChange = nullptr;
-	Cleanup();
+    alSourceStop(_source);
     alDeleteSources(1, &_source);
     LogALError();
     alDeleteBuffers(static_cast<ALsizei>(_buffers.size()), _buffers.data());
@@ -54,119 +62,64 @@ void MusicPlayer::OnChangeVolume()
 //	}
 }
 
-void MusicPlayer::Cleanup()
+bool MusicPlayer::FillAndQueue(ALuint bufName)
 {
-	ov_clear(&_vorbisFile);
-    _state.file.reset();
-    _state.ptr = 0;
-}
+    size_t frameCount = _stream.Read(_chunk.data(), c_chunkFrames);
+    if (0 == frameCount)
+        return false; // decoder is behind, try again next time
 
-void MusicPlayer::FillAndQueue(ALuint bufName)
-{
-    char buf[16384];
-    
-	unsigned int nBytesRead  = 0;
-	int nBitStream           = 0; // used to specify logical bitstream 0
-
-	while( nBytesRead < sizeof(buf) )
-	{
-		long count = ov_read(
-			&_vorbisFile,
-			buf + nBytesRead,           // where to put the decoded data
-			sizeof(buf) - nBytesRead,   // how much data to read
-			0,                          // 0 specifies little endian decoding mode
-			2,                          // 2 specifies 16-bit samples
-			1,                          // 1 specifies signed data
-			&nBitStream
-		);
-
-		nBytesRead += count;
-
-        // seek back to the beginning if we reached the end of file
-		if( 0 == count )
-            ov_pcm_seek(&_vorbisFile, 0);
-	}
-
-    const vorbis_info *vi = ov_info(&_vorbisFile, -1);
-    alBufferData(bufName, vi->channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, buf, sizeof(buf), static_cast<ALsizei>(vi->rate));
+    alBufferData(bufName, AL_FORMAT_STEREO16, _chunk.data(), static_cast<ALsizei>(frameCount * 4), c_frequency);
     ThrowIfALError();
     alSourceQueueBuffers(_source, 1, &bufName);
     ThrowIfALError();
+    return true;
 }
 
-size_t MusicPlayer::read_func(void *ptr, size_t size, size_t nmemb, void *datasource)
+bool MusicPlayer::Load(std::shared_ptr<FS::Stream> file)
 {
-	State *s = (State *) datasource;
-	assert(s->ptr <= s->file->GetSize());
-	size_t rd = std::min(s->file->GetSize() - s->ptr, size*nmemb);
-    std::memcpy(ptr, (const char*)s->file->GetData() + s->ptr, rd);
-	s->ptr += rd;
-	return rd;
+    Stop();
+    if (!QueueNext(std::move(file), true))
+        return false;
+
+    OnChangeVolume();
+    return true;
 }
 
-int MusicPlayer::seek_func(void *datasource, ogg_int64_t offset, int whence)
+bool MusicPlayer::QueueNext(std::shared_ptr<FS::Stream> file, bool loop)
+try
 {
-	State *s = (State *) datasource;
-	switch( whence )
-	{
-	case SEEK_CUR:
-		s->ptr += offset;
-		break;
-	case SEEK_END:
-		s->ptr = s->file->GetSize() - offset;
-		break;
-	case SEEK_SET:
-		s->ptr = offset;
-	}
-	return 0; // TODO: validate input
+    _stream.Queue(OpenOggVorbis(std::move(file)), loop);
+    return true;
 }
-
-long MusicPlayer::tell_func(void *datasource)
+catch (const std::exception&)
 {
-	return ((State *) datasource)->ptr;
+    return false;
 }
 
-bool MusicPlayer::Load(std::shared_ptr<FS::MemMap> file)
+void MusicPlayer::Stop()
 {
-	Cleanup();
-
-	_state.file = file; // hold reference to file
-	_state.ptr = 0;
-
-	//open the file as an OGG file (allocates internal OGG buffers)
-	ov_callbacks cb;
-	cb.read_func  = &MusicPlayer::read_func;
-	cb.seek_func  = &MusicPlayer::seek_func;
-	cb.close_func = nullptr;
-	cb.tell_func  = &MusicPlayer::tell_func;
-	
-	if( (ov_open_callbacks(&_state, &_vorbisFile, nullptr, 0, cb)) != 0 )
-	{
-        Cleanup();
-		return false;
-	}
-
-	// get info
-	vorbis_info *vorbisInfo = ov_info(&_vorbisFile, -1);
-    if (vorbisInfo->channels != 1 && vorbisInfo->channels != 2)
+    _playing = false;
+    alSourceStop(_source);
+
+    // stopped source marks all its buffers processed
+    ALint value = 0;
+    alGetSourcei(_source, AL_BUFFERS_QUEUED, &value);
+    while (value-- > 0)
     {
-        Cleanup();
-        return false;
+        ALuint buffer = AL_NONE;
+        alSourceUnqueueBuffers(_source, 1, &buffer);
+        if (AL_NONE != buffer)
+            _freeBuffers.push_back(buffer);
     }
+    LogALError();
 
-	OnChangeVolume();
-
-    for (ALuint name: _buffers)
-        FillAndQueue(name);
-
-	return true;
+    _stream.Stop();
 }
 
 void MusicPlayer::Play()
 {
     _playing = true;
-    alSourcePlay(_source);
-    LogALError();
+    HandleBufferFilling();
 }
 
 void MusicPlayer::HandleBufferFilling()
@@ -175,18 +128,20 @@ void MusicPlayer::HandleBufferFilling()
     {
         ALint value = 0;
         alGetSourcei(_source, AL_BUFFERS_PROCESSED, &value);
-        if( value > 0 )
+        while (value-- > 0)
         {
             ALuint buffer = AL_NONE;
             alSourceUnqueueBuffers(_source, 1, &buffer);
             if (AL_NONE != buffer)
-            {
-                FillAndQueue(buffer);
-                // restart if it previously run out of buffers
-                alGetSourcei(_source, AL_SOURCE_STATE, &value);
-                if( AL_PLAYING != value )
-                    alSourcePlay(_source);
-            }
+                _freeBuffers.push_back(buffer);
         }
+
+        while (!_freeBuffers.empty() && FillAndQueue(_freeBuffers.back()))
+            _freeBuffers.pop_back();
+
+        // restart if it previously run out of buffers
+        alGetSourcei(_source, AL_SOURCE_STATE, &value);
+        if (AL_PLAYING != value && _freeBuffers.size() < _buffers.size())
+            alSourcePlay(_source);
     }
 }
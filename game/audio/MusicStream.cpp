@@ -0,0 +1,157 @@
+#include "inc/audio/MusicStream.h"
+#include <chrono>
+#include <stdexcept>
+
+static const size_t c_chunkFrames = 4096;
+
+MusicStream::MusicStream(unsigned int frequency, float bufferSeconds)
+	: _frequency(frequency)
+	, _ring(static_cast<size_t>(frequency * bufferSeconds))
+	, _thread(&MusicStream::DecoderMain, this)
+{
+}
+
+MusicStream::~MusicStream()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_exit = true;
+	}
+	_cv.notify_all();
+	_thread.join();
+}
+
+void MusicStream::Queue(std::unique_ptr<MusicDecoder> track, bool loop)
+{
+	if (0 == track->GetFrequency())
+		throw std::runtime_error("music track has no frequency");
+	if (track->GetChannels() != 1 && track->GetChannels() != 2)
+		throw std::runtime_error("only mono and stereo music is supported");
+
+	uint64_t step = (uint64_t(track->GetFrequency()) << 32) / _frequency;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_tracks.push_back({ std::move(track), loop, step, uint64_t(1) << 32, {} });
+	}
+	_cv.notify_all();
+}
+
+void MusicStream::Stop()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_stopRequested = true;
+	_cv.notify_all();
+
+	// once acknowledged the decoder does not write anything from the old tracks
+	_cv.wait(lock, [this] { return !_stopRequested; });
+	_ring.Read(nullptr, _ring.GetReadable());
+}
+
+size_t MusicStream::Read(int16_t *frames, size_t frameCount)
+{
+	return _ring.Read(frames, frameCount);
+}
+
+// Linear interpolation of a chunk of stereo frames; continues where the
+// previous chunk of the track ended. Returns the number of frames written.
+static size_t Resample(uint64_t step, uint64_t &phase, int16_t last[2],
+                       const int16_t *in, size_t inFrames, int16_t *out)
+{
+	size_t outFrames = 0;
+	for (; (phase >> 32) < inFrames; phase += step)
+	{
+		size_t k = static_cast<size_t>(phase >> 32);
+		int64_t frac = phase & 0xffffffff;
+		for (int c = 0; c != 2; ++c)
+		{
+			int64_t a = k ? in[(k - 1) * 2 + c] : last[c];
+			int64_t b = in[k * 2 + c];
+			out[outFrames * 2 + c] = static_cast<int16_t>(a + (((b - a) * frac) >> 32));
+		}
+		++outFrames;
+	}
+	if (inFrames)
+	{
+		phase -= uint64_t(inFrames) << 32;
+		last[0] = in[(inFrames - 1) * 2];
+		last[1] = in[(inFrames - 1) * 2 + 1];
+	}
+	return outFrames;
+}
+
+void MusicStream::DecoderMain()
+{
+	std::vector<int16_t> decoded(c_chunkFrames * 2);
+	std::vector<int16_t> stereo(c_chunkFrames * 2);
+	std::vector<int16_t> resampled;
+	const int16_t *pending = nullptr;
+	size_t pendingFrames = 0; // decoded but not yet accepted by the ring
+	size_t pendingOffset = 0;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (!_exit)
+	{
+		if (_stopRequested)
+		{
+			_tracks.clear();
+			pendingFrames = 0;
+			_stopRequested = false;
+			_cv.notify_all();
+			continue;
+		}
+
+		if (pendingFrames)
+		{
+			size_t written = _ring.Write(pending + pendingOffset * 2, pendingFrames);
+			pendingFrames -= written;
+			pendingOffset += written;
+			if (pendingFrames)
+			{
+				// the consumer does not signal, poll at a fraction of the buffer length
+				auto pollInterval = std::chrono::milliseconds(1000 * _ring.GetCapacity() / _frequency / 8 + 1);
+				_cv.wait_for(lock, pollInterval);
+			}
+			continue;
+		}
+
+		if (_tracks.empty())
+		{
+			_cv.wait(lock);
+			continue;
+		}
+
+		// decoding only touches the front track which is not removed by anyone else
+		Track &track = _tracks.front();
+		lock.unlock();
+		unsigned int channels = track.decoder->GetChannels();
+		size_t decodedCount = track.decoder->Decode(channels == 2 ? stereo.data() : decoded.data(), c_chunkFrames);
+		if (1 == channels)
+		{
+			for (size_t i = 0; i != decodedCount; ++i)
+				stereo[i * 2] = stereo[i * 2 + 1] = decoded[i];
+		}
+		size_t frameCount = decodedCount;
+		pending = stereo.data();
+		if (track.decoder->GetFrequency() != _frequency)
+		{
+			resampled.resize((static_cast<size_t>((uint64_t(decodedCount) << 32) / track.step) + 2) * 2);
+			frameCount = Resample(track.step, track.phase, track.last, stereo.data(), decodedCount, resampled.data());
+			pending = resampled.data();
+		}
+		lock.lock();
+
+		if (decodedCount)
+		{
+			pendingFrames = frameCount; // may be none when downsampling a short chunk
+			pendingOffset = 0;
+		}
+		else if (track.loop && _tracks.size() == 1)
+		{
+			_tracks.front().decoder->Rewind();
+		}
+		else
+		{
+			_tracks.pop_front(); // continue with the next track without a gap
+		}
+	}
+}
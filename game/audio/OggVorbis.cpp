@@ -1,4 +1,5 @@
 #include "OggVorbis.h"
+#include "inc/audio/MusicStream.h"
 #include "inc/audio/detail/FormatDesc.h"
 #include <fs/FileSystem.h>
 #include <vorbis/codec.h>
@@ -31,32 +32,96 @@ namespace
 		auto *state = (FileState *)datasource;
 		return static_cast<long>(state->s->Tell());
 	}
+	void OpenCallbacks(FileState &state, OggVorbis_File &vf)
+	{
+		ov_callbacks cb;
+		cb.read_func  = read_func;
+		cb.seek_func  = seek_func;
+		cb.close_func = nullptr;
+		cb.tell_func  = tell_func;
+
+		if( int result = ov_open_callbacks(&state, &vf, nullptr, 0, cb) )
+		{
+			switch( result )
+			{
+			case OV_EREAD: throw std::runtime_error("A read from media returned an error");
+			case OV_ENOTVORBIS: throw std::runtime_error("Bitstream does not contain any Vorbis data");
+			case OV_EVERSION: throw std::runtime_error("Vorbis version mismatch");
+			case OV_EBADHEADER: throw std::runtime_error("Invalid Vorbis bitstream header");
+			case OV_EFAULT: throw std::runtime_error("Internal logic fault; indicates a bug or heap/stack corruption");
+			}
+			throw std::runtime_error("unknown error opening ov stream");
+		}
+	}
+
+	// Pulls compressed data from the stream as it goes, only one page is resident
+	class OggVorbisDecoder final
+		: public MusicDecoder
+	{
+	public:
+		explicit OggVorbisDecoder(std::shared_ptr<FS::Stream> stream)
+		{
+			_state.s = std::move(stream);
+			OpenCallbacks(_state, _vf);
+			vorbis_info *pinfo = ov_info(&_vf, -1);
+			if( nullptr == pinfo )
+			{
+				ov_clear(&_vf);
+				throw std::runtime_error("could not get info from ov stream");
+			}
+			_channels = pinfo->channels;
+			_frequency = pinfo->rate;
+		}
+
+		~OggVorbisDecoder() override
+		{
+			ov_clear(&_vf);
+		}
+
+		unsigned int GetFrequency() const override { return _frequency; }
+		unsigned int GetChannels() const override { return _channels; }
+
+		size_t Decode(int16_t *frames, size_t maxFrames) override
+		{
+			size_t frameSize = _channels * 2;
+			size_t total = 0;
+			while( total < maxFrames * frameSize )
+			{
+				int bitstream = 0;
+				long ret = ov_read(&_vf, reinterpret_cast<char*>(frames) + total,
+				                   static_cast<int>(maxFrames * frameSize - total), 0, 2, 1, &bitstream);
+				if( ret <= 0 )
+					break; // end of track; a corrupt page ends it early
+				total += ret;
+			}
+			return total / frameSize;
+		}
+
+		void Rewind() override
+		{
+			ov_pcm_seek(&_vf, 0);
+		}
+
+	private:
+		FileState _state;
+		OggVorbis_File _vf;
+		unsigned int _channels;
+		unsigned int _frequency;
+	};
 } // unnamed namespace
 
+std::unique_ptr<MusicDecoder> OpenOggVorbis(std::shared_ptr<FS::Stream> stream)
+{
+	return std::make_unique<OggVorbisDecoder>(std::move(stream));
+}
+
 void LoadOggVorbis(std::shared_ptr<FS::Stream> stream, FormatDesc &outFormatDesc, std::vector<char> &outData)
 {
     FileState state;
     state.s = stream;
 
-	ov_callbacks cb;
-	cb.read_func  = read_func;
-	cb.seek_func  = seek_func;
-	cb.close_func = nullptr;
-	cb.tell_func  = tell_func;
-
 	OggVorbis_File vf;
-	if( int result = ov_open_callbacks(&state, &vf, nullptr, 0, cb) )
-	{
-		switch( result )
-		{
-		case OV_EREAD: throw std::runtime_error("A read from media returned an error");
-		case OV_ENOTVORBIS: throw std::runtime_error("Bitstream does not contain any Vorbis data");
-		case OV_EVERSION: throw std::runtime_error("Vorbis version mismatch");
-		case OV_EBADHEADER: throw std::runtime_error("Invalid Vorbis bitstream header");
-		case OV_EFAULT: throw std::runtime_error("Internal logic fault; indicates a bug or heap/stack corruption");
-		}
-		throw std::runtime_error("unknown error opening ov stream");
-	}
+	OpenCallbacks(state, vf);
 
 	try
 	{
@@ -7,4 +7,6 @@ namespace FS
 	struct Stream;
 }
 struct FormatDesc;
+struct MusicDecoder;
 void LoadOggVorbis(std::shared_ptr<FS::Stream> stream, FormatDesc &outFormatDesc, std::vector<char> &outData);
+std::unique_ptr<MusicDecoder> OpenOggVorbis(std::shared_ptr<FS::Stream> stream);
@@ -14,6 +14,10 @@
 #include <gc/WeapCfg.h>
 #include <gc/World.h>
 
+static bool IsAudibleContact(const ContactEvent &e)
+{
+	return (e.np + e.tp) / 60 > 3 || e.tp > 10;
+}
 
 SoundHarness::SoundHarness(SoundRender &soundRender, GameContextBase &gameContext, const Gameplay *gameplay)
 	: _gameContext(gameContext)
@@ -25,18 +29,18 @@ SoundHarness::SoundHarness(SoundRender &soundRender, GameContextBase &gameContex
 	_gameContext.GetWorld().eGC_ProjectileBasedWeapon.AddListener(*this);
 	_gameContext.GetWorld().eGC_pu_Shield.AddListener(*this);
 	_gameContext.GetWorld().eGC_RigidBodyStatic.AddListener(*this);
-	_gameContext.GetWorld().eGC_RigidBodyDynamic.AddListener(*this);
 	_gameContext.GetWorld().eGC_Turret.AddListener(*this);
 	_gameContext.GetWorld().eGC_Vehicle.AddListener(*this);
 	_gameContext.GetWorld().eWorld.AddListener(*this);
+	_gameContext.GetWorld().eContacts.AddListener(*this, &IsAudibleContact);
 }
 
 SoundHarness::~SoundHarness()
 {
+	_gameContext.GetWorld().eContacts.RemoveListener(*this);
 	_gameContext.GetWorld().eWorld.RemoveListener(*this);
 	_gameContext.GetWorld().eGC_Vehicle.RemoveListener(*this);
 	_gameContext.GetWorld().eGC_Turret.RemoveListener(*this);
-	_gameContext.GetWorld().eGC_RigidBodyDynamic.RemoveListener(*this);
 	_gameContext.GetWorld().eGC_RigidBodyStatic.RemoveListener(*this);
 	_gameContext.GetWorld().eGC_pu_Shield.RemoveListener(*this);
 	_gameContext.GetWorld().eGC_ProjectileBasedWeapon.RemoveListener(*this);
@@ -296,20 +300,24 @@ void SoundHarness::OnDamage(GC_RigidBodyStatic &obj, const DamageDesc &dd)
 	}
 }
 
-void SoundHarness::OnContact(vec2d pos, float np, float tp)
+void SoundHarness::OnEvents(const ContactEvent *events, size_t count)
 {
-	float nd = (np + tp)/60;
-
-	if( nd > 3 )
+	for (size_t i = 0; i < count; ++i)
 	{
-		if( nd > 10 )
-			_soundRender.PlayOnce(SoundTemplate::Impact2, pos);
-		else
-			_soundRender.PlayOnce(SoundTemplate::Impact1, pos);
-	}
-	else if( tp > 10 )
-	{
-		_soundRender.PlayOnce(SoundTemplate::Slide1, pos);
+		const ContactEvent &e = events[i];
+		float nd = (e.np + e.tp)/60;
+
+		if( nd > 3 )
+		{
+			if( nd > 10 )
+				_soundRender.PlayOnce(SoundTemplate::Impact2, e.pos);
+			else
+				_soundRender.PlayOnce(SoundTemplate::Impact1, e.pos);
+		}
+		else if( e.tp > 10 )
+		{
+			_soundRender.PlayOnce(SoundTemplate::Slide1, e.pos);
+		}
 	}
 }
 
@@ -389,6 +397,12 @@ void SoundHarness::OnKill(GC_Object &obj)
 		_vehicleMove.erase(static_cast<const GC_Vehicle*>(&obj));
 }
 
+void SoundHarness::OnClear()
+{
+	_attached.clear();
+	_vehicleMove.clear();
+}
+
 void SoundHarness::OnNewObject(GC_Object &obj)
 {
 	ObjectType type = obj.GetType();
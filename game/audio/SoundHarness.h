@@ -16,10 +16,10 @@ class SoundHarness final
 	, ObjectListener<GC_ProjectileBasedWeapon>
 	, ObjectListener<GC_pu_Shield>
 	, ObjectListener<GC_RigidBodyStatic>
-	, ObjectListener<GC_RigidBodyDynamic>
 	, ObjectListener<GC_Turret>
 	, ObjectListener<GC_Vehicle>
 	, ObjectListener<World>
+	, DeferredListener<ContactEvent>
 {
 public:
 	SoundHarness(SoundRender &soundRender, GameContextBase &gameContext, const Gameplay *gameplay);
@@ -59,9 +59,6 @@ private:
 	void OnDestroy(GC_RigidBodyStatic &obj, const DamageDesc &dd) override;
 	void OnDamage(GC_RigidBodyStatic &obj, const DamageDesc &dd) override;
 
-	// ObjectListener<GC_RigidBodyDynamic>
-	void OnContact(vec2d pos, float np, float tp) override;
-
 	// ObjectListener<GC_Turret>
 	void OnShoot(GC_Turret &obj) override;
 	void OnStateChange(GC_Turret &obj) override;
@@ -76,4 +73,8 @@ private:
 	void OnGameFinished() override;
 	void OnKill(GC_Object &obj) override;
 	void OnNewObject(GC_Object &obj) override;
+	void OnClear() override;
+
+	// DeferredListener<ContactEvent>
+	void OnEvents(const ContactEvent *events, size_t count) override;
 };
@@ -0,0 +1,80 @@
+#include "SoundPriority.h"
+#include "SoundTemplates.h"
+
+float GetSoundPriority(SoundTemplate sound)
+{
+	switch (sound)
+	{
+	// interface feedback
+	case SoundTemplate::Beep:
+	case SoundTemplate::Limit:
+	case SoundTemplate::Screenshot:
+	case SoundTemplate::LightSwitch:
+		return 100;
+
+	case SoundTemplate::BoomBig:
+	case SoundTemplate::BfgFlash:
+		return 80;
+
+	case SoundTemplate::BoomStandard:
+	case SoundTemplate::WallDestroy:
+	case SoundTemplate::BfgFire:
+	case SoundTemplate::BfgInit:
+		return 70;
+
+	case SoundTemplate::RocketShoot:
+	case SoundTemplate::Shoot:
+	case SoundTemplate::MinigunFire:
+	case SoundTemplate::ACShoot:
+	case SoundTemplate::Bolt:
+	case SoundTemplate::DiskFire:
+	case SoundTemplate::PlazmaFire:
+	case SoundTemplate::ShockActivate:
+		return 60;
+
+	case SoundTemplate::Pickup:
+	case SoundTemplate::w_Pickup:
+	case SoundTemplate::puRespawn:
+	case SoundTemplate::B_Start:
+	case SoundTemplate::B_End:
+	case SoundTemplate::Inv:
+	case SoundTemplate::InvEnd:
+	case SoundTemplate::TargetLock:
+	case SoundTemplate::TuretWakeUp:
+	case SoundTemplate::TuretWakeDown:
+		return 50;
+
+	case SoundTemplate::Hit1:
+	case SoundTemplate::Hit3:
+	case SoundTemplate::Hit5:
+	case SoundTemplate::AC_Hit1:
+	case SoundTemplate::AC_Hit2:
+	case SoundTemplate::AC_Hit3:
+	case SoundTemplate::DiskHit:
+	case SoundTemplate::PlazmaHit:
+	case SoundTemplate::BoomBullet:
+	case SoundTemplate::InvHit1:
+	case SoundTemplate::InvHit2:
+	case SoundTemplate::B_Loop:
+		return 40;
+
+	case SoundTemplate::RocketFly:
+	case SoundTemplate::RamEngine:
+	case SoundTemplate::WeapReload:
+	case SoundTemplate::AC_Reload:
+		return 30;
+
+	case SoundTemplate::Impact1:
+	case SoundTemplate::Impact2:
+	case SoundTemplate::Slide1:
+		return 20;
+
+	case SoundTemplate::TuretRotate:
+	case SoundTemplate::TowerRotate:
+		return 15;
+
+	case SoundTemplate::TankMove:
+	default:
+		return 10;
+	}
+}
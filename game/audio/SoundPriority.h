@@ -0,0 +1,7 @@
+#pragma once
+
+enum class SoundTemplate;
+
+// Relative importance used to pick which sounds keep a hardware voice
+// when there are more sounds than voices. Higher wins.
+float GetSoundPriority(SoundTemplate sound);
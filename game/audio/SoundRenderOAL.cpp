@@ -1,72 +1,75 @@
 #include "inc/audio/SoundRenderOAL.h"
 #include "SoundTemplates.h"
 #include <fs/FileSystem.h>
-#include <iterator>
-#include <utility>
+#include <cassert>
+#include <stdexcept>
+#include <string>
 
-namespace
-{
-
-class SoundDummy final
-	: public Sound
-{
-public:
-	virtual void SetPos(vec2d) {}
-	virtual void SetPlaying(bool) {}
-	virtual void SetVolume(float) {}
-	virtual void SetPitch(float) {}
-};
+// a bit below what most drivers can mix in hardware
+static const unsigned int c_maxSources = 32;
+static const float c_referenceDistance = 70;
+static const float c_listenerHeight = 500;
 
-class SoundImpl final
+class SoundOAL final
 	: public Sound
 {
 public:
-	SoundImpl(ALuint source)
-		: _source(source)
+	SoundOAL(SoundRenderOAL &render, unsigned int voice)
+		: _render(render)
+		, _voice(voice)
 	{
 	}
-	
-	virtual ~SoundImpl()
+
+	~SoundOAL() override
 	{
-		alDeleteSources(1, &_source);
+		_render._pool->Free(_voice);
 	}
 
 	void SetPos(vec2d pos) override
 	{
-		alSource3f(_source, AL_POSITION, pos.x, pos.y, 0.0f);
+		auto &voice = _render._pool->GetVoice(_voice);
+		voice.pos = pos;
+		if (voice.source >= 0)
+			alSource3f(_render._sources[voice.source], AL_POSITION, pos.x, pos.y, 0.0f);
 	}
-	
+
 	void SetPlaying(bool playing) override
 	{
-		if (playing)
-		{
-			ALint state = 0;
-			alGetSourcei(_source, AL_SOURCE_STATE, &state);
-			if (AL_PLAYING != state) // do not restart if already playing
-				alSourcePlay(_source);
-		}
-		else
+		auto &voice = _render._pool->GetVoice(_voice);
+		if (voice.playing != playing) // do not restart if already playing
 		{
-			alSourcePause(_source);
+			voice.playing = playing;
+			if (voice.source >= 0)
+			{
+				if (playing)
+					alSourcePlay(_render._sources[voice.source]);
+				else
+					alSourcePause(_render._sources[voice.source]);
+			}
 		}
 	}
-	
+
 	void SetVolume(float volume) override
 	{
-		alSourcef(_source, AL_GAIN, volume);
+		auto &voice = _render._pool->GetVoice(_voice);
+		voice.volume = volume;
+		if (voice.source >= 0)
+			alSourcef(_render._sources[voice.source], AL_GAIN, volume);
 	}
-	
+
 	void SetPitch(float pitch) override
 	{
-		alSourcef(_source, AL_PITCH, pitch /* * g_conf.sv_speed.GetFloat() * 0.01f*/);
+		auto &voice = _render._pool->GetVoice(_voice);
+		voice.pitch = pitch;
+		if (voice.source >= 0)
+			alSourcef(_render._sources[voice.source], AL_PITCH, pitch /* * g_conf.sv_speed.GetFloat() * 0.01f*/);
 	}
-	
+
 private:
-	ALuint _source;
+	SoundRenderOAL &_render;
+	unsigned int _voice;
 };
 
-} // namespace
-
 void SoundRenderOAL::LoadBuffer(SoundTemplate st, const void *data, size_t size, FormatDesc format)
 {
     ALenum formatAL = format.channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
@@ -79,10 +82,14 @@ void SoundRenderOAL::LoadBuffer(SoundTemplate st, const void *data, size_t size,
         throw std::runtime_error(std::string("failed to fill sound buffer with data: ") +
                                  (msg ? msg : "Unknown OpenAL error"));
     }
+
+	// virtual voices have no source to query
+	_pool->SetDuration(st, (float) size / (sizeof(int16_t) * format.channels * format.frequency));
 }
 
 SoundRenderOAL::SoundRenderOAL()
 	: _buffers(static_cast<unsigned int>(SoundTemplate::COUNT))
+	, _lastStep(std::chrono::steady_clock::now())
 {
 	alGenBuffers(_buffers.size(), &_buffers[0]);
 	ALenum e = alGetError();
@@ -92,75 +99,86 @@ SoundRenderOAL::SoundRenderOAL()
 		throw std::runtime_error(std::string("failed to create sound buffers: ") +
 								 (msg ? msg : "Unknown OpenAL error"));
 	}
+
+	// take as many sources as the driver gives us
+	while (_sources.size() < c_maxSources)
+	{
+		ALuint source = 0;
+		alGenSources(1, &source);
+		if (AL_NO_ERROR != alGetError())
+			break;
+		alSourcef(source, AL_REFERENCE_DISTANCE, c_referenceDistance);
+		_sources.push_back(source);
+	}
+
+	_pool.reset(new VoicePool(*this, (int) _sources.size()));
 }
 
 SoundRenderOAL::~SoundRenderOAL()
 {
+	_pool.reset();
 	if (!_sources.empty())
 	{
 		alDeleteSources((ALsizei) _sources.size(), &_sources[0]);
 	}
+	alDeleteBuffers((ALsizei) _buffers.size(), &_buffers[0]);
 }
 
 void SoundRenderOAL::SetListenerPos(vec2d pos)
 {
-    alListener3f(AL_POSITION, pos.x, pos.y, 500.0f);
+	_pool->SetListenerPos(pos);
+    alListener3f(AL_POSITION, pos.x, pos.y, c_listenerHeight);
+}
+
+void SoundRenderOAL::Play(int source, const PooledVoice &voice)
+{
+	ALuint s = _sources[source];
+	alSourcei(s, AL_BUFFER, _buffers[static_cast<unsigned int>(voice.sound)]);
+	alSourcei(s, AL_LOOPING, voice.looping ? AL_TRUE : AL_FALSE);
+	alSource3f(s, AL_POSITION, voice.pos.x, voice.pos.y, 0.0f);
+	alSourcef(s, AL_GAIN, voice.volume);
+	alSourcef(s, AL_PITCH, voice.pitch);
+	alSourcef(s, AL_SEC_OFFSET, voice.offset);
+	alSourcePlay(s);
+}
+
+void SoundRenderOAL::Stop(int source)
+{
+	ALuint s = _sources[source];
+	alSourceStop(s);
+	alSourcei(s, AL_BUFFER, 0);
+}
+
+bool SoundRenderOAL::IsStopped(int source)
+{
+	ALint state = AL_STOPPED;
+	alGetSourcei(_sources[source], AL_SOURCE_STATE, &state);
+	return AL_STOPPED == state;
+}
+
+float SoundRenderOAL::GetOffset(int source)
+{
+	ALfloat offset = 0;
+	alGetSourcef(_sources[source], AL_SEC_OFFSET, &offset);
+	return offset;
 }
 
 std::unique_ptr<Sound> SoundRenderOAL::CreateLooped(SoundTemplate sound)
 {
-	ALuint source = 0;
-	alGenSources(1, &source);
-	if (AL_NO_ERROR == alGetError())
-	{
-		alSourcei(source, AL_BUFFER, _buffers[static_cast<unsigned int>(sound)]);
-		alSourcei(source, AL_REFERENCE_DISTANCE, 70);
-		alSourcei(source, AL_LOOPING, AL_TRUE);
-		
-		try {
-			return std::unique_ptr<Sound>(new SoundImpl(source));
-		}
-		catch(...)
-		{
-			alDeleteSources(1, &source);
-			throw;
-		}
-	}
-	return std::unique_ptr<SoundDummy>(new SoundDummy());
+	// starts virtual, gets a source on the next Step if it is important enough
+	return std::make_unique<SoundOAL>(*this, _pool->Alloc(sound, true));
 }
 
 void SoundRenderOAL::PlayOnce(SoundTemplate sound, vec2d pos)
 {
-	ALuint source = 0;
-	alGenSources(1, &source);
-	if (AL_NO_ERROR == alGetError())
-	{
-		_sources.push_back(source);
-		alSourcei(source, AL_BUFFER, _buffers[static_cast<unsigned int>(sound)]);
-		alSourcei(source, AL_REFERENCE_DISTANCE, 70);
-		alSourcei(source, AL_LOOPING, AL_FALSE);
-		alSource3f(source, AL_POSITION, pos.x, pos.y, 0.0f);
-		alSourcePlay(source);
-	}
+	_pool->PlayOnce(sound, pos);
 }
 
 void SoundRenderOAL::Step()
 {
-	auto finished = _sources.end();
-	for (auto it = _sources.begin(); it != finished; )
-	{
-		ALint state = 0;
-		alGetSourcei(*it, AL_SOURCE_STATE, &state);
-		if( state != AL_PLAYING )
-			std::swap(*it, *--finished);
-		else
-			++it;
-	}
-	
-	if (finished != _sources.end())
-	{
-		ALsizei count = (ALsizei) std::distance(finished, _sources.end());
-		alDeleteSources(count, &*finished);
-		_sources.erase(finished, _sources.end());
-	}
+	auto now = std::chrono::steady_clock::now();
+	float dt = std::chrono::duration<float>(now - _lastStep).count();
+	_lastStep = now;
+
+	_pool->Step(dt);
 }
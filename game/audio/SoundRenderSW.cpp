@@ -0,0 +1,319 @@
+#include "inc/audio/AudioSink.h"
+#include "inc/audio/SoundRenderSW.h"
+#include "SoundTemplates.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define MIXER_SSE2
+#endif
+
+// match SoundRenderOAL: AL_REFERENCE_DISTANCE 70 with the default inverse
+// clamped distance model, listener hovering 500 units above the map
+static const float c_referenceDistance = 70;
+static const float c_listenerHeight = 500;
+static const size_t c_blockFrames = 256;
+
+class SoundSW final
+	: public Sound
+{
+public:
+	SoundSW(SoundRenderSW &render, unsigned int voice)
+		: _render(render)
+		, _voice(voice)
+	{
+	}
+
+	~SoundSW() override
+	{
+		_render.FreeVoice(_voice);
+	}
+
+	void SetPos(vec2d pos) override
+	{
+		_render._voices[_voice].pos = pos;
+	}
+
+	void SetPlaying(bool playing) override
+	{
+		_render._voices[_voice].playing = playing; // resumes where paused
+	}
+
+	void SetVolume(float volume) override
+	{
+		_render._voices[_voice].gain = volume;
+	}
+
+	void SetPitch(float pitch) override
+	{
+		_render._voices[_voice].pitch = pitch;
+	}
+
+private:
+	SoundRenderSW &_render;
+	unsigned int _voice;
+};
+
+SoundRenderSW::SoundRenderSW(std::unique_ptr<AudioSink> sink)
+	: _sink(std::move(sink))
+	, _buffers(static_cast<unsigned int>(SoundTemplate::COUNT))
+	, _accumulator(c_blockFrames * 2)
+	, _voiceBlock(c_blockFrames)
+{
+	assert(_sink && _sink->GetFrequency() > 0);
+}
+
+SoundRenderSW::~SoundRenderSW()
+{
+	assert(GetActiveVoiceCount() == 0 || !"looped sounds must be destroyed before the render");
+}
+
+void SoundRenderSW::LoadBuffer(SoundTemplate st, const void *data, size_t size, FormatDesc format)
+{
+	if (format.channels != 1 && format.channels != 2)
+		throw std::runtime_error("only mono and stereo sounds are supported");
+	if (0 == format.frequency)
+		throw std::runtime_error("invalid sound frequency");
+
+	Buffer &buffer = _buffers[static_cast<unsigned int>(st)];
+	buffer.samples.resize(size / sizeof(int16_t));
+	memcpy(buffer.samples.data(), data, buffer.samples.size() * sizeof(int16_t));
+	buffer.channels = format.channels;
+	buffer.frequency = format.frequency;
+}
+
+unsigned int SoundRenderSW::AllocVoice(SoundTemplate sound, bool looping)
+{
+	unsigned int index;
+	if (_freeVoices.empty())
+	{
+		index = static_cast<unsigned int>(_voices.size());
+		_voices.emplace_back();
+	}
+	else
+	{
+		index = _freeVoices.back();
+		_freeVoices.pop_back();
+	}
+
+	Voice &voice = _voices[index];
+	voice.buffer = static_cast<unsigned int>(sound);
+	voice.position = 0;
+	voice.pos = {};
+	voice.gain = 1;
+	voice.pitch = 1;
+	voice.looping = looping;
+	voice.playing = false;
+	voice.active = true;
+	return index;
+}
+
+void SoundRenderSW::FreeVoice(unsigned int index)
+{
+	assert(_voices[index].active);
+	_voices[index].active = false;
+	_voices[index].playing = false;
+	_freeVoices.push_back(index);
+}
+
+std::unique_ptr<Sound> SoundRenderSW::CreateLooped(SoundTemplate sound)
+{
+	return std::make_unique<SoundSW>(*this, AllocVoice(sound, true));
+}
+
+void SoundRenderSW::PlayOnce(SoundTemplate sound, vec2d pos)
+{
+	Voice &voice = _voices[AllocVoice(sound, false)];
+	voice.pos = pos;
+	voice.playing = true;
+}
+
+void SoundRenderSW::SetListenerPos(vec2d pos)
+{
+	_listenerPos = pos;
+}
+
+uint64_t SoundRenderSW::GetStep(const Voice &voice) const
+{
+	return static_cast<uint64_t>(
+		(double)voice.pitch * _buffers[voice.buffer].frequency / _sink->GetFrequency() * 4294967296.0);
+}
+
+void SoundRenderSW::MixVoice(Voice &voice, size_t frameCount)
+{
+	const Buffer &buffer = _buffers[voice.buffer];
+	size_t bufferFrames = buffer.samples.size() / buffer.channels;
+	if (0 == bufferFrames)
+	{
+		voice.playing = voice.looping;
+		return;
+	}
+
+	float gainLeft = voice.gain;
+	float gainRight = voice.gain;
+	if (1 == buffer.channels)
+	{
+		vec2d delta = voice.pos - _listenerPos;
+		float distance = std::sqrt(delta.sqr() + c_listenerHeight * c_listenerHeight);
+		float attenuation = c_referenceDistance / std::max(distance, c_referenceDistance);
+
+		// equal power panning, unity gain in the center
+		float angle = (delta.x / distance + 1) * PI / 4;
+		gainLeft *= attenuation * std::cos(angle) * std::sqrt(2.f);
+		gainRight *= attenuation * std::sin(angle) * std::sqrt(2.f);
+	}
+
+	uint64_t step = GetStep(voice);
+	uint64_t end = static_cast<uint64_t>(bufferFrames) << 32;
+
+	// resample to the output rate with linear interpolation
+	const int16_t *src = buffer.samples.data();
+	float *left = _voiceBlock.data();
+	size_t produced = 0;
+	for (; produced < frameCount; ++produced)
+	{
+		if (voice.position >= end)
+		{
+			if (!voice.looping)
+			{
+				voice.playing = false;
+				break;
+			}
+			voice.position %= end;
+		}
+
+		size_t index = static_cast<size_t>(voice.position >> 32);
+		size_t next = index + 1 < bufferFrames ? index + 1 : (voice.looping ? 0 : index);
+		float frac = static_cast<float>(voice.position & 0xffffffff) * (1.f / 4294967296.f);
+
+		if (1 == buffer.channels)
+		{
+			left[produced] = src[index] + (src[next] - src[index]) * frac;
+		}
+		else
+		{
+			// stereo sources are not positioned, mix them down to the accumulator directly
+			float l = src[index * 2] + (src[next * 2] - src[index * 2]) * frac;
+			float r = src[index * 2 + 1] + (src[next * 2 + 1] - src[index * 2 + 1]) * frac;
+			_accumulator[produced * 2] += l * gainLeft;
+			_accumulator[produced * 2 + 1] += r * gainRight;
+		}
+
+		voice.position += step;
+	}
+
+	if (1 == buffer.channels)
+	{
+		float *acc = _accumulator.data();
+		size_t i = 0;
+#ifdef MIXER_SSE2
+		__m128 gl = _mm_set1_ps(gainLeft);
+		__m128 gr = _mm_set1_ps(gainRight);
+		for (; i + 4 <= produced; i += 4)
+		{
+			__m128 mono = _mm_loadu_ps(left + i);
+			__m128 l = _mm_mul_ps(mono, gl);
+			__m128 r = _mm_mul_ps(mono, gr);
+			_mm_storeu_ps(acc + i * 2, _mm_add_ps(_mm_loadu_ps(acc + i * 2), _mm_unpacklo_ps(l, r)));
+			_mm_storeu_ps(acc + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(acc + i * 2 + 4), _mm_unpackhi_ps(l, r)));
+		}
+#endif
+		for (; i < produced; ++i)
+		{
+			acc[i * 2] += left[i] * gainLeft;
+			acc[i * 2 + 1] += left[i] * gainRight;
+		}
+	}
+}
+
+void SoundRenderSW::Mix(int16_t *samples, size_t frameCount)
+{
+	while (frameCount)
+	{
+		size_t blockFrames = std::min(frameCount, c_blockFrames);
+		std::fill(_accumulator.begin(), _accumulator.end(), 0.f);
+
+		for (unsigned int i = 0; i != _voices.size(); ++i)
+		{
+			Voice &voice = _voices[i];
+			if (voice.active && voice.playing)
+			{
+				MixVoice(voice, blockFrames);
+				if (!voice.playing && !voice.looping)
+					FreeVoice(i); // one-shot sound finished
+			}
+		}
+
+		const float *acc = _accumulator.data();
+		size_t sampleCount = blockFrames * 2;
+		size_t i = 0;
+#ifdef MIXER_SSE2
+		for (; i + 8 <= sampleCount; i += 8)
+		{
+			// cvtps rounds to nearest, packs saturates to int16
+			__m128i lo = _mm_cvtps_epi32(_mm_loadu_ps(acc + i));
+			__m128i hi = _mm_cvtps_epi32(_mm_loadu_ps(acc + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i), _mm_packs_epi32(lo, hi));
+		}
+#endif
+		for (; i < sampleCount; ++i)
+		{
+			float s = std::round(acc[i]);
+			samples[i] = static_cast<int16_t>(std::max(-32768.f, std::min(32767.f, s)));
+		}
+
+		samples += sampleCount;
+		frameCount -= blockFrames;
+	}
+}
+
+void SoundRenderSW::Skip(size_t frameCount)
+{
+	for (unsigned int i = 0; i != _voices.size(); ++i)
+	{
+		Voice &voice = _voices[i];
+		if (!voice.active || !voice.playing)
+			continue;
+
+		const Buffer &buffer = _buffers[voice.buffer];
+		uint64_t end = static_cast<uint64_t>(buffer.samples.size() / buffer.channels) << 32;
+		if (0 == end)
+		{
+			voice.playing = voice.looping;
+		}
+		else
+		{
+			voice.position += GetStep(voice) * frameCount;
+			if (voice.position >= end)
+			{
+				if (voice.looping)
+					voice.position %= end;
+				else
+					voice.playing = false;
+			}
+		}
+
+		if (!voice.playing && !voice.looping)
+			FreeVoice(i);
+	}
+}
+
+void SoundRenderSW::Step()
+{
+	size_t frameCount = _sink->GetFramesWanted();
+	if (!frameCount)
+		return;
+
+	if (_sink->IsAudible())
+	{
+		_output.resize(frameCount * 2);
+		Mix(_output.data(), frameCount);
+		_sink->Write(_output.data(), frameCount);
+	}
+	else
+	{
+		Skip(frameCount);
+	}
+}
@@ -3,79 +3,184 @@
 #include "inc/audio/SoundRender.h"
 #ifdef _WIN32
 #include "inc/audio/SoundRenderXA2.h"
-#else
+#elif defined(AUDIO_OPENAL)
 #include "inc/audio/SoundRenderOAL.h"
+#else
+#include "inc/audio/AudioSink.h"
+#include "inc/audio/SoundRenderSW.h"
 #endif
 #include "inc/audio/SoundView.h"
 #include <as/AppState.h>
 #include <ctx/GameContextBase.h>
 #include <fs/FileSystem.h>
 #include <plat/ConsoleBuffer.h>
+#include <tasks/TaskPool.h>
 #include <wavfile/WavFile.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+static const struct
+{
+	SoundTemplate st;
+	const char *fileName;
+} s_soundFiles[] =
+{
+	{ SoundTemplate::BoomStandard, "explosions/standard" },
+	{ SoundTemplate::BoomBig, "explosions/big" },
+	{ SoundTemplate::WallDestroy, "explosions/wall" },
+
+	{ SoundTemplate::Hit1, "projectiles/hit1" },
+	{ SoundTemplate::Hit3, "projectiles/hit2" },
+	{ SoundTemplate::Hit5, "projectiles/hit3" },
+	{ SoundTemplate::AC_Hit1, "projectiles/ac_hit_1" },
+	{ SoundTemplate::AC_Hit2, "projectiles/ac_hit_2" },
+	{ SoundTemplate::AC_Hit3, "projectiles/ac_hit_3" },
+	{ SoundTemplate::RocketFly, "projectiles/rocketfly" }, //
+	{ SoundTemplate::DiskHit, "projectiles/DiskHit" }, //
+	{ SoundTemplate::BfgFlash, "projectiles/bfgflash" }, //
+	{ SoundTemplate::PlazmaHit, "projectiles/plazmahit" },
+	{ SoundTemplate::BoomBullet, "projectiles/bullet" }, //
+
+	{ SoundTemplate::TargetLock, "turrets/activate" },
+	{ SoundTemplate::TuretRotate, "turrets/rotate" },
+	{ SoundTemplate::TuretWakeUp, "turrets/arming" },
+	{ SoundTemplate::TuretWakeDown, "turrets/unarming" },
+
+	{ SoundTemplate::RocketShoot, "pickup/rocketshoot" }, //
+	{ SoundTemplate::Shoot, "pickup/Shoot" }, //
+	{ SoundTemplate::MinigunFire, "pickup/MinigunFire" },
+	{ SoundTemplate::WeapReload, "pickup/reload" },
+	{ SoundTemplate::ACShoot, "pickup/ac_shoot" },
+	{ SoundTemplate::AC_Reload, "pickup/ac_reload" },
+	{ SoundTemplate::Pickup, "pickup/pickup" },
+	{ SoundTemplate::B_Start, "pickup/b_start" },
+	{ SoundTemplate::B_Loop, "pickup/b_loop" },
+	{ SoundTemplate::B_End, "pickup/b_end" },
+	{ SoundTemplate::w_Pickup, "pickup/w_pickup" }, //
+	{ SoundTemplate::Bolt, "pickup/boltshoot" },
+	{ SoundTemplate::DiskFire, "pickup/ripper" }, //
+	{ SoundTemplate::puRespawn, "pickup/puRespawn" },
+	{ SoundTemplate::TowerRotate, "pickup/tower_rotate" },
+	{ SoundTemplate::ShockActivate, "pickup/shockactivate" }, //
+	{ SoundTemplate::BfgInit, "pickup/bfginit" },
+	{ SoundTemplate::BfgFire, "pickup/bfgfire" },
+	{ SoundTemplate::PlazmaFire, "pickup/plazma1" },
+	{ SoundTemplate::RamEngine, "pickup/ram_engine" }, //
+	{ SoundTemplate::InvEnd, "pickup/inv_end" },
+	{ SoundTemplate::Inv, "pickup/inv" },
+	{ SoundTemplate::InvHit1, "pickup/inv_hit1" },
+	{ SoundTemplate::InvHit2, "pickup/inv_hit2" },
+
+	{ SoundTemplate::Impact1, "vehicle/impact1" },
+	{ SoundTemplate::Impact2, "vehicle/impact2" },
+	{ SoundTemplate::Slide1, "vehicle/slide1" },
+	{ SoundTemplate::TankMove, "vehicle/tank_move" },
+
+	{ SoundTemplate::Screenshot, "misc/screenshot" }, //
+	{ SoundTemplate::Limit, "misc/limit" },
+	{ SoundTemplate::LightSwitch, "misc/light1" }, //
+	{ SoundTemplate::Beep, "misc/beep" }, // http://soundbible.com/1133-Beep-Ping.html
+};
+
+namespace
+{
+	struct DecodedSound
+	{
+		FormatDesc format;
+		std::vector<char> data;
+	};
+
+	// read-only stream over a file read on the loading thread
+	class BufferStream final : public FS::Stream
+	{
+	public:
+		explicit BufferStream(std::vector<char> data) : _data(std::move(data)) {}
+
+		// FS::Stream
+		size_t Read(void *dst, size_t size, size_t count) override
+		{
+			size_t available = size ? (_data.size() - _pos) / size : 0;
+			count = std::min(count, available);
+			memcpy(dst, _data.data() + _pos, size * count);
+			_pos += size * count;
+			return count;
+		}
+		void Write(const void *src, size_t size) override
+		{
+			throw std::runtime_error("buffer stream is read only");
+		}
+		void Seek(long long amount, unsigned int origin) override
+		{
+			long long base = SEEK_SET == origin ? 0 : SEEK_CUR == origin ? _pos : _data.size();
+			_pos = static_cast<size_t>(std::max(0LL, std::min(base + amount, (long long) _data.size())));
+		}
+		long long Tell() const override
+		{
+			return _pos;
+		}
+
+	private:
+		std::vector<char> _data;
+		size_t _pos = 0;
+	};
+}
+
+static std::future<DecodedSound> DecodeAsync(FS::FileSystem &fs, TaskPool &taskPool, const char *fileName)
+{
+	std::vector<char> file;
+	try
+	{
+		auto map = fs.Open(std::string(fileName).append(".wav"))->QueryMap();
+		const char *data = static_cast<const char*>(map->GetData());
+		file.assign(data, data + map->GetSize());
+	}
+	catch (...)
+	{
+		std::promise<DecodedSound> failed;
+		failed.set_exception(std::current_exception());
+		return failed.get_future();
+	}
+	return taskPool.Submit([file = std::move(file)]() mutable
+	{
+		BufferStream stream(std::move(file));
+		DecodedSound sound;
+		sound.format.channels = 1;
+		LoadWavPcm(stream, sound.format.frequency, sound.data);
+		return sound;
+	});
+}
 
-SoundView::SoundView(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, AppState &appState)
+SoundView::SoundView(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, AppState &appState, TaskPool &taskPool)
 	: AppStateListener(appState)
 #ifdef _WIN32
 	, _soundRender(new SoundRenderXA2(logger)) // this may pump windows messages
-#else
+#elif defined(AUDIO_OPENAL)
 	, _soundRender(new SoundRenderOAL())
+#else
+	, _soundRender(new SoundRenderSW(std::make_unique<NullAudioSink>(44100, 44100 / 60)))
 #endif
 {
-	LoadBuffer(fs, logger, SoundTemplate::BoomStandard, "explosions/standard");
-	LoadBuffer(fs, logger, SoundTemplate::BoomBig, "explosions/big");
-	LoadBuffer(fs, logger, SoundTemplate::WallDestroy, "explosions/wall");
-
-	LoadBuffer(fs, logger, SoundTemplate::Hit1, "projectiles/hit1");
-	LoadBuffer(fs, logger, SoundTemplate::Hit3, "projectiles/hit2");
-	LoadBuffer(fs, logger, SoundTemplate::Hit5, "projectiles/hit3");
-	LoadBuffer(fs, logger, SoundTemplate::AC_Hit1, "projectiles/ac_hit_1");
-	LoadBuffer(fs, logger, SoundTemplate::AC_Hit2, "projectiles/ac_hit_2");
-	LoadBuffer(fs, logger, SoundTemplate::AC_Hit3, "projectiles/ac_hit_3");
-	LoadBuffer(fs, logger, SoundTemplate::RocketFly, "projectiles/rocketfly"); //
-	LoadBuffer(fs, logger, SoundTemplate::DiskHit, "projectiles/DiskHit"); //
-	LoadBuffer(fs, logger, SoundTemplate::BfgFlash, "projectiles/bfgflash"); //
-	LoadBuffer(fs, logger, SoundTemplate::PlazmaHit, "projectiles/plazmahit");
-	LoadBuffer(fs, logger, SoundTemplate::BoomBullet, "projectiles/bullet"); //
-
-	LoadBuffer(fs, logger, SoundTemplate::TargetLock, "turrets/activate");
-	LoadBuffer(fs, logger, SoundTemplate::TuretRotate, "turrets/rotate");
-	LoadBuffer(fs, logger, SoundTemplate::TuretWakeUp, "turrets/arming");
-	LoadBuffer(fs, logger, SoundTemplate::TuretWakeDown, "turrets/unarming");
-
-	LoadBuffer(fs, logger, SoundTemplate::RocketShoot, "pickup/rocketshoot"); //
-	LoadBuffer(fs, logger, SoundTemplate::Shoot, "pickup/Shoot"); //
-	LoadBuffer(fs, logger, SoundTemplate::MinigunFire, "pickup/MinigunFire");
-	LoadBuffer(fs, logger, SoundTemplate::WeapReload, "pickup/reload");
-	LoadBuffer(fs, logger, SoundTemplate::ACShoot, "pickup/ac_shoot");
-	LoadBuffer(fs, logger, SoundTemplate::AC_Reload, "pickup/ac_reload");
-	LoadBuffer(fs, logger, SoundTemplate::Pickup, "pickup/pickup");
-	LoadBuffer(fs, logger, SoundTemplate::B_Start, "pickup/b_start");
-	LoadBuffer(fs, logger, SoundTemplate::B_Loop, "pickup/b_loop");
-	LoadBuffer(fs, logger, SoundTemplate::B_End, "pickup/b_end");
-	LoadBuffer(fs, logger, SoundTemplate::w_Pickup, "pickup/w_pickup"); //
-	LoadBuffer(fs, logger, SoundTemplate::Bolt, "pickup/boltshoot");
-	LoadBuffer(fs, logger, SoundTemplate::DiskFire, "pickup/ripper"); //
-	LoadBuffer(fs, logger, SoundTemplate::puRespawn, "pickup/puRespawn");
-	LoadBuffer(fs, logger, SoundTemplate::TowerRotate, "pickup/tower_rotate");
-	LoadBuffer(fs, logger, SoundTemplate::ShockActivate, "pickup/shockactivate"); //
-	LoadBuffer(fs, logger, SoundTemplate::BfgInit, "pickup/bfginit");
-	LoadBuffer(fs, logger, SoundTemplate::BfgFire, "pickup/bfgfire");
-	LoadBuffer(fs, logger, SoundTemplate::PlazmaFire, "pickup/plazma1");
-	LoadBuffer(fs, logger, SoundTemplate::RamEngine, "pickup/ram_engine"); //
-	LoadBuffer(fs, logger, SoundTemplate::InvEnd, "pickup/inv_end");
-	LoadBuffer(fs, logger, SoundTemplate::Inv, "pickup/inv");
-	LoadBuffer(fs, logger, SoundTemplate::InvHit1, "pickup/inv_hit1");
-	LoadBuffer(fs, logger, SoundTemplate::InvHit2, "pickup/inv_hit2");
-
-	LoadBuffer(fs, logger, SoundTemplate::Impact1, "vehicle/impact1");
-	LoadBuffer(fs, logger, SoundTemplate::Impact2, "vehicle/impact2");
-	LoadBuffer(fs, logger, SoundTemplate::Slide1, "vehicle/slide1");
-	LoadBuffer(fs, logger, SoundTemplate::TankMove, "vehicle/tank_move");
-
-	LoadBuffer(fs, logger, SoundTemplate::Screenshot, "misc/screenshot"); //
-	LoadBuffer(fs, logger, SoundTemplate::Limit, "misc/limit");
-	LoadBuffer(fs, logger, SoundTemplate::LightSwitch, "misc/light1"); //
-	LoadBuffer(fs, logger, SoundTemplate::Beep, "misc/beep"); // http://soundbible.com/1133-Beep-Ping.html
+	// the file system is not thread safe; files are read here and decoded on the pool
+	std::vector<std::future<DecodedSound>> decoded;
+	for (auto &soundFile: s_soundFiles)
+	{
+		decoded.push_back(DecodeAsync(fs, taskPool, soundFile.fileName));
+	}
+
+	// buffers are created on this thread
+	for (size_t i = 0; i != std::size(s_soundFiles); ++i)
+	try
+	{
+		DecodedSound sound = decoded[i].get();
+		_soundRender->LoadBuffer(s_soundFiles[i].st, sound.data.data(), sound.data.size(), sound.format);
+	}
+	catch (const std::exception &e)
+	{
+		logger.Format(1) << "Could not load '" << s_soundFiles[i].fileName << ".wav' - " << e.what();
+	}
 
 	OnGameContextAdded();
 }
@@ -84,20 +189,6 @@ SoundView::~SoundView()
 {
 }
 
-void SoundView::LoadBuffer(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, SoundTemplate st, const char *fileName)
-try
-{
-	FormatDesc fd;
-	std::vector<char> data;
-	fd.channels = 1;
-	LoadWavPcm(*fs.Open(std::string(fileName).append(".wav"))->QueryStream(), fd.frequency, data);
-	_soundRender->LoadBuffer(st, data.data(), data.size(), fd);
-}
-catch (const std::exception &e)
-{
-	logger.Format(1) << "Could not load '" << fileName << ".wav' - " << e.what();
-}
-
 void SoundView::Step(vec2d listenerPos)
 {
 	_soundRender->SetListenerPos(listenerPos);
@@ -0,0 +1,187 @@
+#include "inc/audio/detail/VoicePool.h"
+#include "SoundPriority.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// match SoundRenderOAL: inverse clamped distance model, listener above the map
+static const float c_referenceDistance = 70;
+static const float c_listenerHeight = 500;
+static const float c_minAudibility = 1.0f / 256; // quieter voices go virtual
+
+VoicePool::VoicePool(VoiceSources &sources, int sourceCount)
+	: _sources(sources)
+	, _sourceCount(sourceCount)
+{
+	for (int source = sourceCount; source--; )
+		_freeSources.push_back(source);
+}
+
+void VoicePool::SetDuration(SoundTemplate sound, float seconds)
+{
+	unsigned int index = static_cast<unsigned int>(sound);
+	if (_durations.size() <= index)
+		_durations.resize(index + 1);
+	_durations[index] = seconds;
+}
+
+unsigned int VoicePool::Alloc(SoundTemplate sound, bool looping)
+{
+	unsigned int index;
+	if (_freeVoices.empty())
+	{
+		index = (unsigned int) _voices.size();
+		_voices.emplace_back();
+	}
+	else
+	{
+		index = _freeVoices.back();
+		_freeVoices.pop_back();
+	}
+
+	PooledVoice &voice = _voices[index];
+	voice.sound = sound;
+	voice.pos = {};
+	voice.volume = 1;
+	voice.pitch = 1;
+	voice.offset = 0;
+	voice.score = 0;
+	voice.source = -1;
+	voice.looping = looping;
+	voice.playing = false;
+	voice.active = true;
+	return index;
+}
+
+void VoicePool::Free(unsigned int index)
+{
+	PooledVoice &voice = _voices[index];
+	assert(voice.active);
+	Detach(voice);
+	voice.active = false;
+	voice.playing = false;
+	_freeVoices.push_back(index);
+}
+
+void VoicePool::Attach(PooledVoice &voice)
+{
+	assert(voice.source < 0 && !_freeSources.empty());
+	voice.source = _freeSources.back();
+	_freeSources.pop_back();
+	_sources.Play(voice.source, voice);
+}
+
+void VoicePool::Detach(PooledVoice &voice)
+{
+	if (voice.source >= 0)
+	{
+		if (voice.looping)
+			voice.offset = _sources.GetOffset(voice.source);
+		_sources.Stop(voice.source);
+		_freeSources.push_back(voice.source);
+		voice.source = -1;
+	}
+}
+
+float VoicePool::GetAudibility(const PooledVoice &voice) const
+{
+	vec2d delta = voice.pos - _listenerPos;
+	float distance = std::sqrt(delta.sqr() + c_listenerHeight * c_listenerHeight);
+	return voice.volume * c_referenceDistance / std::max(distance, c_referenceDistance);
+}
+
+void VoicePool::PlayOnce(SoundTemplate sound, vec2d pos)
+{
+	PooledVoice &voice = _voices[Alloc(sound, false)];
+	voice.pos = pos;
+	voice.playing = true;
+	voice.score = GetSoundPriority(sound) * GetAudibility(voice);
+
+	// Step may still steal the source
+	if (voice.score >= c_minAudibility && !_freeSources.empty())
+		Attach(voice);
+}
+
+void VoicePool::Step(float dt)
+{
+	_ranked.clear();
+	for (unsigned int i = 0; i != _voices.size(); ++i)
+	{
+		PooledVoice &voice = _voices[i];
+		if (!voice.active)
+			continue;
+		if (!voice.playing)
+		{
+			Detach(voice); // paused looped sounds do not hold a source
+			continue;
+		}
+
+		if (voice.source >= 0)
+		{
+			if (_sources.IsStopped(voice.source))
+			{
+				if (!voice.looping)
+				{
+					Free(i); // one-shot sound finished
+					continue;
+				}
+				voice.offset = 0;
+				Detach(voice); // restarted below
+			}
+			else
+			{
+				voice.offset = _sources.GetOffset(voice.source);
+			}
+		}
+		else
+		{
+			unsigned int sound = static_cast<unsigned int>(voice.sound);
+			float duration = sound < _durations.size() ? _durations[sound] : 0;
+			voice.offset += dt * voice.pitch;
+			if (voice.offset >= duration)
+			{
+				if (!voice.looping)
+				{
+					Free(i); // finished while virtual
+					continue;
+				}
+				voice.offset = duration > 0 ? std::fmod(voice.offset, duration) : 0;
+			}
+		}
+
+		float audibility = GetAudibility(voice);
+		if (audibility < c_minAudibility)
+		{
+			if (!voice.looping)
+				Free(i); // would never be heard
+			else
+				Detach(voice); // virtualize
+			continue;
+		}
+
+		voice.score = GetSoundPriority(voice.sound) * audibility;
+		_ranked.push_back(i);
+	}
+
+	// the most important voices get sources, the rest are virtualized or dropped
+	size_t budget = std::min(_ranked.size(), (size_t) _sourceCount);
+	std::nth_element(_ranked.begin(), _ranked.begin() + budget, _ranked.end(), [this](unsigned int a, unsigned int b)
+	{
+		return _voices[a].score > _voices[b].score;
+	});
+
+	for (size_t i = budget; i < _ranked.size(); ++i)
+	{
+		if (_voices[_ranked[i]].looping)
+			Detach(_voices[_ranked[i]]);
+		else
+			Free(_ranked[i]); // stolen
+	}
+
+	for (size_t i = 0; i < budget; ++i)
+	{
+		PooledVoice &voice = _voices[_ranked[i]];
+		if (voice.source < 0)
+			Attach(voice);
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace FS
+{
+	struct Stream;
+}
+
+// Destination of the software mixer output: 16 bit interleaved stereo.
+struct AudioSink
+{
+	virtual unsigned int GetFrequency() const = 0;
+
+	// number of frames the sink is ready to accept now
+	virtual size_t GetFramesWanted() = 0;
+
+	virtual void Write(const int16_t *samples, size_t frameCount) = 0;
+
+	// false if the written samples are never heard; the mixer then only advances the voices
+	virtual bool IsAudible() const { return true; }
+
+	virtual ~AudioSink() {}
+};
+
+// Accepts a fixed number of frames per step and discards them.
+class NullAudioSink final
+	: public AudioSink
+{
+public:
+	NullAudioSink(unsigned int frequency, size_t framesPerStep);
+
+	// AudioSink
+	unsigned int GetFrequency() const override { return _frequency; }
+	size_t GetFramesWanted() override { return _framesPerStep; }
+	void Write(const int16_t *samples, size_t frameCount) override {}
+	bool IsAudible() const override { return false; }
+
+private:
+	unsigned int _frequency;
+	size_t _framesPerStep;
+};
+
+// Accepts a fixed number of frames per step and writes them to a WAV file.
+class WavFileAudioSink final
+	: public AudioSink
+{
+public:
+	WavFileAudioSink(std::shared_ptr<FS::Stream> stream, unsigned int frequency, size_t framesPerStep);
+	~WavFileAudioSink();
+
+	// AudioSink
+	unsigned int GetFrequency() const override { return _frequency; }
+	size_t GetFramesWanted() override { return _framesPerStep; }
+	void Write(const int16_t *samples, size_t frameCount) override;
+
+private:
+	std::shared_ptr<FS::Stream> _stream;
+	unsigned int _frequency;
+	size_t _framesPerStep;
+	long long _headerPos;
+	uint32_t _dataSize = 0;
+};
@@ -1,36 +1,27 @@
 #pragma once
 
-#include <vorbis/codec.h>
-#include <vorbis/vorbisfile.h>
+#include "MusicStream.h"
 
 #include <array>
 #include <memory>
+#include <vector>
 
 namespace FS
 {
-	struct MemMap;
+	struct Stream;
 }
 
 
 class MusicPlayer
 {
-	struct State
-	{
-        std::shared_ptr<FS::MemMap> file; // TODO: use stream
-		unsigned long ptr = 0;
-	};
-	State _state;
-	OggVorbis_File _vorbisFile;
-    std::array<unsigned int, 3> _buffers;
+	MusicStream _stream;
+	std::vector<int16_t> _chunk;
+    std::array<unsigned int, 4> _buffers;
+    std::vector<unsigned int> _freeBuffers;
     unsigned int _source;
     bool _playing;
 
-	void Cleanup();
-	void FillAndQueue(unsigned int bufName);
-
-	static size_t read_func  (void *ptr, size_t size, size_t nmemb, void *datasource);
-	static int    seek_func  (void *datasource, ogg_int64_t offset, int whence);
-	static long   tell_func  (void *datasource);
+	bool FillAndQueue(unsigned int bufName);
 
 	void OnChangeVolume();
 
@@ -38,7 +29,11 @@ public:
 	MusicPlayer();
 	virtual ~MusicPlayer();
 
-	bool Load(std::shared_ptr<FS::MemMap> file); // TODO: use stream
+	// Replaces whatever is playing with a looped track.
+	bool Load(std::shared_ptr<FS::Stream> file);
+
+	// Starts the track right after the current one ends, without a gap.
+	bool QueueNext(std::shared_ptr<FS::Stream> file, bool loop);
 
 	void Stop();
 	void Play();
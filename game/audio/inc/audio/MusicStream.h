@@ -0,0 +1,65 @@
+#pragma once
+#include "detail/PcmRingBuffer.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+struct MusicDecoder
+{
+	virtual unsigned int GetFrequency() const = 0;
+	virtual unsigned int GetChannels() const = 0;
+
+	// Decodes up to maxFrames interleaved frames. Returns 0 at the end of the track.
+	virtual size_t Decode(int16_t *frames, size_t maxFrames) = 0;
+	virtual void Rewind() = 0;
+	virtual ~MusicDecoder() {}
+};
+
+// Decodes queued tracks on a background thread into a ring buffer
+// of 16 bit stereo frames. Tracks follow each other without a gap;
+// those with another frequency are resampled linearly on the way.
+// Queue, Stop and Read are called from the owning thread.
+class MusicStream final
+{
+public:
+	MusicStream(unsigned int frequency, float bufferSeconds);
+	~MusicStream();
+
+	unsigned int GetFrequency() const { return _frequency; }
+
+	// A looped track repeats until another one is queued after it.
+	void Queue(std::unique_ptr<MusicDecoder> track, bool loop);
+
+	// Drops the queued tracks and everything buffered so far.
+	void Stop();
+
+	// Consumer side, never blocks. Returns the number of frames read.
+	size_t Read(int16_t *frames, size_t frameCount);
+	size_t GetBufferedFrames() const { return _ring.GetReadable(); }
+
+private:
+	struct Track
+	{
+		std::unique_ptr<MusicDecoder> decoder;
+		bool loop;
+
+		// resampler state, 32.32 fixed point in track frames
+		uint64_t step;
+		uint64_t phase; // integer part k means between frame k-1 and k of the next chunk
+		int16_t last[2]; // frame -1 of the next chunk
+	};
+
+	unsigned int _frequency;
+	PcmRingBuffer _ring;
+
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	std::deque<Track> _tracks; // front is the one being decoded
+	bool _stopRequested = false;
+	bool _exit = false;
+	std::thread _thread;
+
+	void DecoderMain();
+};
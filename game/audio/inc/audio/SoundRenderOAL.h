@@ -1,10 +1,18 @@
 #pragma once
 #include "SoundRender.h"
 #include "detail/AudioContextOAL.h"
+#include "detail/VoicePool.h"
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <al.h>
 
-class SoundRenderOAL : public SoundRender
+// Plays sounds through a fixed pool of OpenAL sources. Each Step the most
+// important audible sounds get a source; inaudible looped sounds are kept
+// virtual and resume at the right offset once they get a source back.
+class SoundRenderOAL
+	: public SoundRender
+	, private VoiceSources
 {
 public:
 	SoundRenderOAL();
@@ -18,7 +26,17 @@ public:
 	void Step() override;
 
 private:
+	friend class SoundOAL;
+
 	OALInitHelper _initHelper;
-	std::vector<ALuint> _sources;
 	std::vector<ALuint> _buffers;
+	std::vector<ALuint> _sources;
+	std::unique_ptr<VoicePool> _pool;
+	std::chrono::steady_clock::time_point _lastStep;
+
+	// VoiceSources
+	void Play(int source, const PooledVoice &voice) override;
+	void Stop(int source) override;
+	bool IsStopped(int source) override;
+	float GetOffset(int source) override;
 };
@@ -0,0 +1,67 @@
+#pragma once
+#include "SoundRender.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct AudioSink;
+
+// Software mixer. Works without an audio device when paired with
+// NullAudioSink or WavFileAudioSink.
+class SoundRenderSW : public SoundRender
+{
+public:
+	explicit SoundRenderSW(std::unique_ptr<AudioSink> sink);
+	~SoundRenderSW();
+
+	// Mixes all playing voices into 16 bit interleaved stereo.
+	void Mix(int16_t *samples, size_t frameCount);
+
+	// Moves all playing voices forward as Mix would without producing samples.
+	void Skip(size_t frameCount);
+
+	size_t GetActiveVoiceCount() const { return _voices.size() - _freeVoices.size(); }
+
+	// SoundRender
+	std::unique_ptr<Sound> CreateLooped(SoundTemplate sound) override;
+	void LoadBuffer(SoundTemplate st, const void *data, size_t size, FormatDesc format) override;
+	void PlayOnce(SoundTemplate sound, vec2d pos) override;
+	void SetListenerPos(vec2d pos) override;
+	void Step() override;
+
+private:
+	friend class SoundSW;
+
+	struct Buffer
+	{
+		std::vector<int16_t> samples;
+		unsigned int channels = 1;
+		unsigned int frequency = 0;
+	};
+
+	struct Voice
+	{
+		unsigned int buffer;
+		uint64_t position; // 32.32 fixed point, in source frames
+		vec2d pos;
+		float gain;
+		float pitch;
+		bool looping;
+		bool playing;
+		bool active;
+	};
+
+	std::unique_ptr<AudioSink> _sink;
+	std::vector<Buffer> _buffers;
+	std::vector<Voice> _voices;
+	std::vector<unsigned int> _freeVoices;
+	std::vector<float> _accumulator;
+	std::vector<float> _voiceBlock;
+	std::vector<int16_t> _output;
+	vec2d _listenerPos = {};
+
+	unsigned int AllocVoice(SoundTemplate sound, bool looping);
+	void FreeVoice(unsigned int index);
+	uint64_t GetStep(const Voice &voice) const;
+	void MixVoice(Voice &voice, size_t frameCount);
+};
@@ -5,6 +5,7 @@
 enum class SoundTemplate;
 class SoundHarness;
 struct SoundRender;
+class TaskPool;
 
 namespace FS
 {
@@ -20,14 +21,13 @@ class SoundView final
 	: private AppStateListener
 {
 public:
-	SoundView(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, AppState &appState);
+	SoundView(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, AppState &appState, TaskPool &taskPool);
 	~SoundView();
 	void Step(vec2d listenerPos);
 
 private:
 	std::unique_ptr<SoundRender> _soundRender;
 	std::unique_ptr<SoundHarness> _soundHarness;
-	void LoadBuffer(FS::FileSystem &fs, Plat::ConsoleBuffer &logger, SoundTemplate st, const char *fileName);
 
 	// AppStateListener
 	void OnGameContextRemoving() override;
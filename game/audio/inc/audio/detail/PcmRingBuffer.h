@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Single producer, single consumer queue of 16 bit stereo frames.
+// Write is called by one thread and Read by another without locking.
+class PcmRingBuffer final
+{
+public:
+	explicit PcmRingBuffer(size_t minFrames)
+	{
+		size_t capacity = 1;
+		while (capacity < minFrames)
+			capacity <<= 1;
+		_frames.resize(capacity * 2);
+		_mask = capacity - 1;
+	}
+
+	size_t GetCapacity() const { return _mask + 1; }
+	size_t GetReadable() const { return _writePos.load(std::memory_order_acquire) - _readPos.load(std::memory_order_relaxed); }
+	size_t GetWritable() const { return GetCapacity() - (_writePos.load(std::memory_order_relaxed) - _readPos.load(std::memory_order_acquire)); }
+
+	// producer
+	size_t Write(const int16_t *frames, size_t frameCount)
+	{
+		size_t writePos = _writePos.load(std::memory_order_relaxed);
+		frameCount = std::min(frameCount, GetWritable());
+		CopyIn(frames, frameCount, writePos);
+		_writePos.store(writePos + frameCount, std::memory_order_release);
+		return frameCount;
+	}
+
+	// consumer; pass nullptr to discard
+	size_t Read(int16_t *frames, size_t frameCount)
+	{
+		size_t readPos = _readPos.load(std::memory_order_relaxed);
+		frameCount = std::min(frameCount, GetReadable());
+		if (frames)
+			CopyOut(frames, frameCount, readPos);
+		_readPos.store(readPos + frameCount, std::memory_order_release);
+		return frameCount;
+	}
+
+private:
+	std::vector<int16_t> _frames;
+	size_t _mask;
+	std::atomic<size_t> _writePos{ 0 };
+	std::atomic<size_t> _readPos{ 0 };
+
+	void CopyIn(const int16_t *src, size_t frameCount, size_t pos)
+	{
+		size_t offset = pos & _mask;
+		size_t first = std::min(frameCount, GetCapacity() - offset);
+		memcpy(&_frames[offset * 2], src, first * 4);
+		memcpy(_frames.data(), src + first * 2, (frameCount - first) * 4);
+	}
+
+	void CopyOut(int16_t *dst, size_t frameCount, size_t pos) const
+	{
+		size_t offset = pos & _mask;
+		size_t first = std::min(frameCount, GetCapacity() - offset);
+		memcpy(dst, &_frames[offset * 2], first * 4);
+		memcpy(dst + first * 2, _frames.data(), (frameCount - first) * 4);
+	}
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <math/MyMath.h>
+#include <cstddef>
+#include <vector>
+
+enum class SoundTemplate;
+
+struct PooledVoice
+{
+	SoundTemplate sound;
+	vec2d pos;
+	float volume;
+	float pitch;
+	float offset; // seconds
+	float score;
+	int source; // -1 if virtual
+	bool looping;
+	bool playing;
+	bool active;
+};
+
+// Hardware sources the pool hands out to voices.
+struct VoiceSources
+{
+	// binds the voice sound and parameters and starts playing from voice.offset
+	virtual void Play(int source, const PooledVoice &voice) = 0;
+	virtual void Stop(int source) = 0;
+	virtual bool IsStopped(int source) = 0;
+	virtual float GetOffset(int source) = 0; // seconds
+	virtual ~VoiceSources() {}
+};
+
+// Keeps any number of voices and gives a fixed set of sources to the most
+// important audible ones. Voices holding a source follow the source state;
+// virtual voices advance by the elapsed time and resume at the right offset
+// once they get a source back.
+class VoicePool final
+{
+public:
+	VoicePool(VoiceSources &sources, int sourceCount);
+
+	void SetDuration(SoundTemplate sound, float seconds);
+	void SetListenerPos(vec2d pos) { _listenerPos = pos; }
+
+	unsigned int Alloc(SoundTemplate sound, bool looping);
+	void Free(unsigned int index);
+	PooledVoice& GetVoice(unsigned int index) { return _voices[index]; }
+
+	// Starts right away if there is a free source to avoid a frame of latency.
+	void PlayOnce(SoundTemplate sound, vec2d pos);
+
+	void Step(float dt);
+
+	size_t GetActiveVoiceCount() const { return _voices.size() - _freeVoices.size(); }
+	size_t GetFreeSourceCount() const { return _freeSources.size(); }
+
+private:
+	VoiceSources &_sources;
+	std::vector<float> _durations;
+	std::vector<int> _freeSources;
+	std::vector<PooledVoice> _voices;
+	std::vector<unsigned int> _freeVoices;
+	std::vector<unsigned int> _ranked;
+	vec2d _listenerPos = {};
+	int _sourceCount;
+
+	void Attach(PooledVoice &voice);
+	void Detach(PooledVoice &voice);
+	float GetAudibility(const PooledVoice &voice) const;
+};
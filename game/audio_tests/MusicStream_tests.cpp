@@ -0,0 +1,123 @@
+#include <audio/MusicStream.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// produces frames counting up from 'first', one channel
+	class RampDecoder final
+		: public MusicDecoder
+	{
+	public:
+		RampDecoder(int16_t first, size_t length, unsigned int frequency = 1000)
+			: _first(first)
+			, _length(length)
+			, _frequency(frequency)
+		{}
+
+		unsigned int GetFrequency() const override { return _frequency; }
+		unsigned int GetChannels() const override { return 1; }
+
+		size_t Decode(int16_t *frames, size_t maxFrames) override
+		{
+			size_t count = std::min(maxFrames, _length - _position);
+			for (size_t i = 0; i != count; ++i)
+				frames[i] = static_cast<int16_t>(_first + _position + i);
+			_position += count;
+			return count;
+		}
+
+		void Rewind() override { _position = 0; }
+
+	private:
+		int16_t _first;
+		size_t _length;
+		unsigned int _frequency;
+		size_t _position = 0;
+	};
+
+	std::vector<int16_t> ReadFrames(MusicStream &stream, size_t frameCount)
+	{
+		std::vector<int16_t> result(frameCount * 2);
+		size_t done = 0;
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (done < frameCount && std::chrono::steady_clock::now() < deadline)
+		{
+			done += stream.Read(&result[done * 2], frameCount - done);
+			std::this_thread::yield();
+		}
+		result.resize(done * 2);
+		return result;
+	}
+}
+
+TEST(PcmRingBuffer, WrapsAround)
+{
+	PcmRingBuffer ring(3);
+	EXPECT_EQ(4, ring.GetCapacity());
+
+	int16_t in[] = { 1, 1, 2, 2, 3, 3 };
+	int16_t out[6] = {};
+	EXPECT_EQ(3, ring.Write(in, 3));
+	EXPECT_EQ(2, ring.Read(out, 2));
+	EXPECT_EQ(3, ring.Write(in, 3)); // wraps
+	EXPECT_EQ(0, ring.Write(in, 1));
+	EXPECT_EQ(4, ring.GetReadable());
+	EXPECT_EQ(1, ring.Read(out, 1));
+	EXPECT_EQ(3, out[0]);
+	EXPECT_EQ(3, ring.Read(out, 3));
+	EXPECT_EQ(1, out[0]);
+	EXPECT_EQ(3, out[5]);
+}
+
+TEST(MusicStream, GaplessTrackSwitch)
+{
+	MusicStream stream(1000, 0.5f);
+	stream.Queue(std::make_unique<RampDecoder>(0, 3000), false);
+	stream.Queue(std::make_unique<RampDecoder>(3000, 2000), false);
+
+	auto frames = ReadFrames(stream, 5000);
+	ASSERT_EQ(10000, frames.size());
+	for (size_t i = 0; i != 5000; ++i)
+	{
+		ASSERT_EQ(static_cast<int16_t>(i), frames[i * 2]);
+		ASSERT_EQ(frames[i * 2], frames[i * 2 + 1]); // mono is duplicated
+	}
+}
+
+TEST(MusicStream, LoopUntilNextAndStop)
+{
+	MusicStream stream(1000, 0.5f);
+	stream.Queue(std::make_unique<RampDecoder>(0, 100), true);
+
+	auto frames = ReadFrames(stream, 250);
+	ASSERT_EQ(500, frames.size());
+	EXPECT_EQ(0, frames[100 * 2]);
+	EXPECT_EQ(49, frames[249 * 2]);
+
+	stream.Stop();
+	EXPECT_EQ(0, stream.GetBufferedFrames());
+
+	stream.Queue(std::make_unique<RampDecoder>(500, 10), false);
+	frames = ReadFrames(stream, 10);
+	ASSERT_EQ(20, frames.size());
+	EXPECT_EQ(500, frames[0]);
+}
+
+TEST(MusicStream, ResamplesTrackOfOtherFrequency)
+{
+	// the shipped music is 22050 Hz while the stream runs at 44100
+	MusicStream stream(44100, 0.5f);
+	stream.Queue(std::make_unique<RampDecoder>(0, 10000, 22050), false);
+	stream.Queue(std::make_unique<RampDecoder>(10000, 100, 44100), false);
+
+	// every track frame but the last is followed by one interpolated frame
+	auto frames = ReadFrames(stream, 19998 + 100);
+	ASSERT_EQ((19998 + 100) * 2, frames.size());
+	for (size_t i = 0; i != 19998; ++i)
+		ASSERT_EQ(static_cast<int16_t>(i / 2), frames[i * 2]) << "frame " << i;
+	EXPECT_EQ(10000, frames[19998 * 2]);
+	EXPECT_EQ(10099, frames[(19998 + 99) * 2]);
+}
@@ -0,0 +1,93 @@
+#include <audio/AudioSink.h>
+#include <audio/SoundRenderSW.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+static const SoundTemplate c_sound = static_cast<SoundTemplate>(0);
+
+static void LoadConstant(SoundRenderSW &render, int16_t value, size_t frames)
+{
+	std::vector<int16_t> data(frames, value);
+	render.LoadBuffer(c_sound, data.data(), data.size() * sizeof(int16_t), FormatDesc{ 44100, 1 });
+}
+
+TEST(SoundRenderSW, OneShotAttenuatesAndFinishes)
+{
+	SoundRenderSW render(std::make_unique<NullAudioSink>(44100, 0));
+	LoadConstant(render, 10000, 100);
+
+	render.SetListenerPos({ 0, 0 });
+	render.PlayOnce(c_sound, { 0, 0 });
+	EXPECT_EQ(1, render.GetActiveVoiceCount());
+
+	// listener is 500 units above the map, reference distance is 70
+	std::vector<int16_t> out(200 * 2);
+	render.Mix(out.data(), 200);
+	EXPECT_NEAR(10000 * 70 / 500, out[0], 1);
+	EXPECT_EQ(out[0], out[1]); // centered
+	EXPECT_EQ(0, out[150 * 2]);
+	EXPECT_EQ(0, render.GetActiveVoiceCount());
+}
+
+TEST(SoundRenderSW, LoopedSaturatesAndPans)
+{
+	SoundRenderSW render(std::make_unique<NullAudioSink>(44100, 0));
+	LoadConstant(render, 32000, 64);
+
+	render.SetListenerPos({ 0, 0 });
+	auto a = render.CreateLooped(c_sound);
+	auto b = render.CreateLooped(c_sound);
+	for (auto *sound: { a.get(), b.get() })
+	{
+		sound->SetPos({ 1000, 0 }); // to the right
+		sound->SetVolume(10);
+		sound->SetPlaying(true);
+	}
+
+	std::vector<int16_t> out(1000 * 2);
+	render.Mix(out.data(), 1000);
+	EXPECT_LT(out[1998], out[1999]);
+	EXPECT_EQ(32767, out[1999]);
+	EXPECT_EQ(2, render.GetActiveVoiceCount());
+
+	a.reset();
+	b.reset();
+	EXPECT_EQ(0, render.GetActiveVoiceCount());
+}
+
+TEST(SoundRenderSW, NullSinkAdvancesVoicesWithoutMixing)
+{
+	SoundRenderSW render(std::make_unique<NullAudioSink>(44100, 60));
+	LoadConstant(render, 10000, 100);
+
+	auto looped = render.CreateLooped(c_sound);
+	looped->SetPlaying(true);
+	render.PlayOnce(c_sound, { 0, 0 });
+	EXPECT_EQ(2, render.GetActiveVoiceCount());
+
+	render.Step(); // 60 of 100 frames
+	EXPECT_EQ(2, render.GetActiveVoiceCount());
+	render.Step();
+	EXPECT_EQ(1, render.GetActiveVoiceCount()); // one-shot finished, looped wraps around
+	render.Step();
+	EXPECT_EQ(1, render.GetActiveVoiceCount());
+
+	looped.reset();
+	EXPECT_EQ(0, render.GetActiveVoiceCount());
+}
+
+TEST(SoundRenderSW, MonoMixHandlesBlockTails)
+{
+	SoundRenderSW render(std::make_unique<NullAudioSink>(44100, 0));
+	LoadConstant(render, 1000, 7); // not a multiple of the vector width
+
+	render.SetListenerPos({ 0, 0 });
+	render.PlayOnce(c_sound, { 0, 0 });
+
+	std::vector<int16_t> out(10 * 2);
+	render.Mix(out.data(), 10);
+	for (size_t i = 0; i < 7 * 2; ++i)
+		EXPECT_EQ(140, out[i]) << i; // 1000 * 70 / 500
+	for (size_t i = 7 * 2; i < out.size(); ++i)
+		EXPECT_EQ(0, out[i]) << i;
+}
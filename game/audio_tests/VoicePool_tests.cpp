@@ -0,0 +1,152 @@
+#include <audio/detail/VoicePool.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+	struct FakeSource
+	{
+		const PooledVoice *voice = nullptr;
+		float offset = 0;
+		bool stopped = true;
+	};
+
+	class FakeSources final
+		: public VoiceSources
+	{
+	public:
+		explicit FakeSources(int count) : sources(count) {}
+		std::vector<FakeSource> sources;
+		int plays = 0;
+
+		int GetBusyCount() const
+		{
+			int count = 0;
+			for (auto &source: sources)
+				count += !source.stopped;
+			return count;
+		}
+
+		// VoiceSources
+		void Play(int source, const PooledVoice &voice) override
+		{
+			sources[source] = { &voice, voice.offset, false };
+			++plays;
+		}
+		void Stop(int source) override { sources[source] = {}; }
+		bool IsStopped(int source) override { return sources[source].stopped; }
+		float GetOffset(int source) override { return sources[source].offset; }
+	};
+
+	// any two templates; priorities only matter when they differ
+	const SoundTemplate c_soundA = static_cast<SoundTemplate>(0);
+	const SoundTemplate c_soundB = static_cast<SoundTemplate>(1);
+}
+
+TEST(VoicePool, OneShotFollowsSourceStateNotClock)
+{
+	FakeSources sources(4);
+	VoicePool pool(sources, 4);
+	pool.SetDuration(c_soundA, 0.1f);
+
+	pool.PlayOnce(c_soundA, {});
+	EXPECT_EQ(1, pool.GetActiveVoiceCount());
+	EXPECT_EQ(3, pool.GetFreeSourceCount());
+
+	// longer than the sound but the source is still playing
+	pool.Step(1.0f);
+	EXPECT_EQ(1, pool.GetActiveVoiceCount());
+
+	for (auto &source: sources.sources)
+		source.stopped = true;
+	pool.Step(0);
+	EXPECT_EQ(0, pool.GetActiveVoiceCount());
+	EXPECT_EQ(4, pool.GetFreeSourceCount());
+}
+
+TEST(VoicePool, ExhaustedPoolVirtualizesLoopsAndDropsOneShots)
+{
+	FakeSources sources(2);
+	VoicePool pool(sources, 2);
+	pool.SetDuration(c_soundA, 10);
+
+	std::vector<unsigned int> loops;
+	for (int i = 0; i < 3; ++i)
+	{
+		loops.push_back(pool.Alloc(c_soundA, true));
+		pool.GetVoice(loops.back()).playing = true;
+	}
+	pool.GetVoice(loops[2]).pos = { 5000, 0 }; // least audible
+
+	pool.Step(0);
+	EXPECT_EQ(0, pool.GetFreeSourceCount());
+	EXPECT_EQ(2, sources.GetBusyCount());
+	EXPECT_GE(pool.GetVoice(loops[0]).source, 0);
+	EXPECT_GE(pool.GetVoice(loops[1]).source, 0);
+	EXPECT_EQ(-1, pool.GetVoice(loops[2]).source);
+
+	// no source left, one-shot does not start and is dropped on the next step
+	pool.PlayOnce(c_soundA, { 5000, 5000 });
+	EXPECT_EQ(4, pool.GetActiveVoiceCount());
+	pool.Step(0);
+	EXPECT_EQ(3, pool.GetActiveVoiceCount());
+
+	// virtual voice keeps time
+	pool.Step(0.5f);
+	EXPECT_FLOAT_EQ(0.5f, pool.GetVoice(loops[2]).offset);
+}
+
+TEST(VoicePool, FreedSourceResumesVirtualLoopAtOffset)
+{
+	FakeSources sources(1);
+	VoicePool pool(sources, 1);
+	pool.SetDuration(c_soundA, 10);
+
+	unsigned int nearLoop = pool.Alloc(c_soundA, true);
+	pool.GetVoice(nearLoop).playing = true;
+	unsigned int farLoop = pool.Alloc(c_soundA, true);
+	pool.GetVoice(farLoop).playing = true;
+	pool.GetVoice(farLoop).pos = { 3000, 0 };
+
+	pool.Step(0);
+	int source = pool.GetVoice(nearLoop).source;
+	ASSERT_EQ(0, source);
+	sources.sources[source].offset = 1.5f;
+
+	pool.Step(2.0f);
+	EXPECT_FLOAT_EQ(1.5f, pool.GetVoice(nearLoop).offset); // read back from the source
+	EXPECT_FLOAT_EQ(2.0f, pool.GetVoice(farLoop).offset);
+
+	pool.Free(nearLoop);
+	pool.Step(1.0f);
+	EXPECT_EQ(source, pool.GetVoice(farLoop).source);
+	EXPECT_EQ(&pool.GetVoice(farLoop), sources.sources[source].voice);
+	EXPECT_FLOAT_EQ(3.0f, sources.sources[source].offset);
+
+	// freed voice slot is reused
+	EXPECT_EQ(nearLoop, pool.Alloc(c_soundB, false));
+}
+
+TEST(VoicePool, PausedLoopReleasesSourceAndKeepsOffset)
+{
+	FakeSources sources(1);
+	VoicePool pool(sources, 1);
+	pool.SetDuration(c_soundA, 10);
+
+	unsigned int loop = pool.Alloc(c_soundA, true);
+	pool.GetVoice(loop).playing = true;
+	pool.Step(0);
+	ASSERT_EQ(0, pool.GetVoice(loop).source);
+	sources.sources[0].offset = 4;
+
+	pool.GetVoice(loop).playing = false;
+	pool.Step(1);
+	EXPECT_EQ(-1, pool.GetVoice(loop).source);
+	EXPECT_EQ(1, pool.GetFreeSourceCount());
+	EXPECT_FLOAT_EQ(4, pool.GetVoice(loop).offset);
+
+	pool.GetVoice(loop).playing = true;
+	pool.Step(0);
+	EXPECT_FLOAT_EQ(4, sources.sources[0].offset);
+	EXPECT_EQ(2, sources.plays);
+}
@@ -3,9 +3,13 @@
 #include <gc/Player.h>
 #include <gc/Vehicle.h>
 #include <gc/World.h>
+#include <tasks/TaskPool.h>
+#include <algorithm>
+#include <future>
 
-AIManager::AIManager(World &world)
+AIManager::AIManager(World &world, TaskPool *taskPool)
 	: _world(world)
+	, _taskPool(taskPool)
 {
 	_world.eGC_Player.AddListener(*this);
 	_world.eWorld.AddListener(*this);
@@ -24,30 +28,63 @@ void AIManager::AssignAI(GC_Player *player, AIDiffuculty diffuculty)
 	_aiControllers.emplace(player, std::move(ctrl));
 }
 
-AIManager::ControllerStateMap AIManager::ComputeAIState(World &world, float dt)
+AIManager::ControllerStates AIManager::ComputeAIState(World &world, float dt)
 {
-	ControllerStateMap result;
-
-	unsigned int numActionable = 0;
+	_jobs.clear();
 	for (auto &ai : _aiControllers)
-		if (ai.first->GetVehicle())
-			numActionable++;
+		if (auto vehicle = ai.first->GetVehicle())
+			_jobs.push_back({ ai.second.get(), vehicle, false });
+
+	ControllerStates result(_jobs.size());
+	if (_jobs.empty())
+		return result;
+
+	// controllers are keyed by address; run them in the order of object ids
+	std::sort(_jobs.begin(), _jobs.end(), [](const Job &a, const Job &b)
+	{
+		return a.vehicle->GetId() < b.vehicle->GetId();
+	});
+
+	// everything that touches shared state happens here, in a fixed order
+	_jobs[world.net_rand() % _jobs.size()].allowExtraCalc = true;
+	for (size_t i = 0; i < _jobs.size(); ++i)
+	{
+		_jobs[i].controller->PrepareStep(world, world.net_rand());
+		result[i].first = _jobs[i].vehicle->GetId();
+	}
+
+	const World &view = world;
+	auto think = [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+			_jobs[i].controller->ReadControllerState(view, dt, *_jobs[i].vehicle, result[i].second, _jobs[i].allowExtraCalc);
+	};
 
-	if (numActionable > 0)
+	size_t chunkCount = _taskPool ? std::min<size_t>(_jobs.size(), _taskPool->GetThreadCount() + 1) : 1;
+	std::vector<std::future<void>> chunks;
+	chunks.reserve(chunkCount - 1);
+	for (size_t chunk = 1; chunk < chunkCount; ++chunk)
 	{
-		unsigned int favorite = world.net_rand() % numActionable;
-		unsigned int index = 0;
-		for (auto &ai : _aiControllers)
-		{
-			if (auto vehicle = ai.first->GetVehicle())
-			{
-				VehicleState vs;
-				ai.second->ReadControllerState(world, dt, *vehicle, vs, index == favorite);
-				result.insert(std::make_pair(vehicle->GetId(), vs));
-				index++;
-			}
-		}
+		size_t begin = _jobs.size() * chunk / chunkCount;
+		size_t end = _jobs.size() * (chunk + 1) / chunkCount;
+		chunks.push_back(_taskPool->Submit([=] { think(begin, end); }));
 	}
+	try
+	{
+		think(0, _jobs.size() / chunkCount); // the calling thread takes the first chunk
+	}
+	catch (...)
+	{
+		for (auto &chunk : chunks)
+			chunk.wait();
+		throw;
+	}
+
+	for (auto &chunk : chunks)
+		chunk.wait();
+	for (auto &chunk : chunks)
+		chunk.get();
+
 	return result;
 }
 
@@ -80,3 +117,8 @@ void AIManager::OnKill(GC_Object &obj)
 	}
 }
 
+void AIManager::OnClear()
+{
+	_aiControllers.clear();
+}
+
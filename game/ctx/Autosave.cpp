@@ -0,0 +1,55 @@
+#include "inc/ctx/Autosave.h"
+#include "inc/ctx/GameContext.h"
+#include <fs/FileSystem.h>
+#include <tasks/TaskPool.h>
+#include <cassert>
+
+Autosave::Autosave(TaskPool &taskPool, unsigned int maxPending, int compressionLevel)
+	: _taskPool(taskPool)
+	, _maxPending(maxPending)
+	, _compressionLevel(compressionLevel)
+{
+	assert(maxPending > 0);
+}
+
+Autosave::~Autosave()
+{
+	for (auto &write: _pending)
+		write.wait();
+}
+
+bool Autosave::Save(GameContext &gameContext, std::shared_ptr<FS::Stream> stream)
+{
+	Poll();
+	if (IsBusy())
+		return false;
+
+	auto snapshot = std::make_shared<SaveSnapshot>(gameContext.TakeSnapshot());
+	int compressionLevel = _compressionLevel;
+	_pending.push_back(_taskPool.Submit([snapshot, stream, compressionLevel]
+	{
+		GameContext::WriteSnapshot(*snapshot, *stream, compressionLevel);
+	}));
+	return true;
+}
+
+void Autosave::Poll()
+{
+	// in submission order, a finished write behind a busy one waits for the next call
+	while (!_pending.empty() && std::future_status::ready == _pending.front().wait_for(std::chrono::seconds(0)))
+	{
+		auto write = std::move(_pending.front());
+		_pending.pop_front();
+		write.get();
+	}
+}
+
+void Autosave::Wait()
+{
+	while (!_pending.empty())
+	{
+		auto write = std::move(_pending.front());
+		_pending.pop_front();
+		write.get();
+	}
+}
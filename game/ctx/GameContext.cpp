@@ -3,6 +3,7 @@
 #include "inc/ctx/Deathmatch.h"
 #include "inc/ctx/GameContext.h"
 #include "inc/ctx/WorldController.h"
+#include <fs/ZlibStream.h>
 #include <gc/Player.h>
 #include <gc/SaveFile.h>
 #include <gc/World.h>
@@ -10,12 +11,13 @@
 #include <script/ScriptHarness.h>
 #include <climits>
 
-GameContext::GameContext(std::unique_ptr<World> world, const DMSettings &settings)
+GameContext::GameContext(std::unique_ptr<World> world, const DMSettings &settings, TaskPool *taskPool)
 	: _world(std::move(world))
-	, _aiManager(std::make_unique<AIManager>(*_world))
+	, _aiManager(std::make_unique<AIManager>(*_world, taskPool))
 	, _difficulty(settings.difficulty)
 {
 	_world->Seed(rand());
+	_world->SetTaskPool(taskPool);
 
 	for( const PlayerDesc &pd: settings.players )
 	{
@@ -86,38 +88,113 @@ bool GameContext::IsWorldActive() const
 	return (_world->GetTime() < _gameplay->GetGameEndTime()) && IsGameplayActive();
 }
 
-void GameContext::Serialize(FS::Stream &stream)
+// Kept in the high bits of the version field. Saves without flags are
+// uncompressed and start at the block origin.
+static const int SAVE_FLAG_COMPRESSED = 0x40000000;
+static const int SAVE_FLAG_ORIGIN = 0x20000000; // left and top follow the size
+static const int SAVE_FLAGS_MASK = 0x7f000000;
+
+static void WriteSave(FS::Stream &stream, const RectRB &blockBounds, int compressionLevel, const std::function<void(FS::Stream&)> &writeBody)
 {
-	SaveFile f(stream, false);
+	int version = VERSION | SAVE_FLAG_ORIGIN | (compressionLevel ? SAVE_FLAG_COMPRESSED : 0);
+	int width = WIDTH(blockBounds);
+	int height = HEIGHT(blockBounds);
+	int left = blockBounds.left;
+	int top = blockBounds.top;
+	SaveFile header(stream, false);
+	header.Serialize(version);
+	header.Serialize(width);
+	header.Serialize(height);
+	header.Serialize(left);
+	header.Serialize(top);
 
-	int version = VERSION;
-	int width = (int) WIDTH(_world->GetBounds()) / WORLD_BLOCK_SIZE;
-	int height = (int) HEIGHT(_world->GetBounds()) / WORLD_BLOCK_SIZE;
-	f.Serialize(version);
-	f.Serialize(width);
-	f.Serialize(height);
+	if( compressionLevel )
+	{
+		FS::DeflateStream deflate(stream, compressionLevel);
+		writeBody(deflate);
+		deflate.Finish();
+	}
+	else
+	{
+		writeBody(stream);
+	}
+}
 
+void GameContext::SerializeBody(FS::Stream &stream)
+{
+	SaveFile f(stream, false);
 	_world->Serialize(f);
 	_gameplay->Serialize(f);
 	_scriptHarness->Serialize(f);
 }
 
-void GameContext::Deserialize(FS::Stream &stream)
+void GameContext::Serialize(FS::Stream &stream, int compressionLevel)
 {
-	SaveFile f(stream, true);
+	WriteSave(stream, _world->GetBlockBounds(), compressionLevel, [this](FS::Stream &body)
+	{
+		SerializeBody(body);
+	});
+}
 
+SaveSnapshot GameContext::TakeSnapshot()
+{
+	SaveSnapshot snapshot;
+	snapshot.left = _world->GetBlockBounds().left;
+	snapshot.top = _world->GetBlockBounds().top;
+	snapshot.right = _world->GetBlockBounds().right;
+	snapshot.bottom = _world->GetBlockBounds().bottom;
+	SerializeBody(snapshot.body);
+	return snapshot;
+}
+
+void GameContext::WriteSnapshot(const SaveSnapshot &snapshot, FS::Stream &stream, int compressionLevel)
+{
+	RectRB blockBounds = { snapshot.left, snapshot.top, snapshot.right, snapshot.bottom };
+	WriteSave(stream, blockBounds, compressionLevel, [&snapshot](FS::Stream &body)
+	{
+		const std::vector<char> &data = snapshot.body.GetData();
+		body.Write(data.data(), data.size());
+	});
+}
+
+void GameContext::Deserialize(FS::Stream &stream)
+{
 	int version = 0;
 	int width = 0;
 	int height = 0;
-	f.Serialize(version);
-	f.Serialize(width);
-	f.Serialize(height);
+	int left = 0;
+	int top = 0;
+	SaveFile header(stream, true);
+	header.Serialize(version);
+	header.Serialize(width);
+	header.Serialize(height);
 
-	if( VERSION != version )
+	int flags = version & SAVE_FLAGS_MASK;
+	if( VERSION != (version & ~SAVE_FLAGS_MASK) || (flags & ~(SAVE_FLAG_COMPRESSED | SAVE_FLAG_ORIGIN)) )
 		throw std::runtime_error("invalid version");
 
-	_world.reset(new World(RectRB{ width, height }, true /* initField */));
-	_world->Serialize(f);
+	if( flags & SAVE_FLAG_ORIGIN )
+	{
+		header.Serialize(left);
+		header.Serialize(top);
+	}
+
+	std::unique_ptr<FS::InflateStream> inflate;
+	if( flags & SAVE_FLAG_COMPRESSED )
+		inflate = std::make_unique<FS::InflateStream>(stream);
+
+	SaveFile f(inflate ? *inflate : stream, true);
+	auto world = std::make_unique<World>(RectRB{ left, top, left + width, top + height }, true /* initField */);
+	world->SetTaskPool(_world->GetTaskPool());
+	world->Serialize(f);
+
+	// these listen to the old world and have to go before it does
+	_scriptHarness.reset();
+	_gameplay.reset();
+	_worldController.reset();
+	_aiManager.reset();
+	_world = std::move(world);
+	_aiManager = std::make_unique<AIManager>(*_world, _world->GetTaskPool());
 
 	// TODO: deserialize world controller
 	_worldController.reset(new WorldController(*_world));
@@ -132,8 +209,8 @@ void GameContext::Deserialize(FS::Stream &stream)
 
 ///////////////////////////////////////////////////////
 
-GameContextCampaignDM::GameContextCampaignDM(std::unique_ptr<World> world, const DMSettings &settings, int campaignTier, int campaignMap)
-	: GameContext(std::move(world), settings)
+GameContextCampaignDM::GameContextCampaignDM(std::unique_ptr<World> world, const DMSettings &settings, int campaignTier, int campaignMap, TaskPool *taskPool)
+	: GameContext(std::move(world), settings, taskPool)
 	, _campaignTier(campaignTier)
 	, _campaignMap(campaignMap)
 {
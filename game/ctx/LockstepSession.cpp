@@ -0,0 +1,258 @@
+#include "inc/ctx/LockstepSession.h"
+#include "inc/ctx/LockstepTransport.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+static const uint32_t c_magic = 0x534c5a54; // TZLS
+static const uint32_t c_maxInputsPerPacket = 64;
+static const uint32_t c_maxHashesPerPacket = 32; // with a full set of inputs still fits a 1500 byte datagram
+static const uint32_t c_hashHistory = 256;
+
+#pragma pack (push)
+#pragma pack (1)
+struct PacketHeader
+{
+	uint32_t magic;
+	uint8_t sender;
+	uint8_t inputCount;
+	uint8_t hashCount;
+	uint32_t ack;           // the receiver's inputs known to the sender, all ticks below
+	uint32_t hashAck;       // the receiver's hashes known to the sender, all ticks below
+	uint32_t firstTick;     // of the inputs that follow
+	uint32_t firstHashTick; // of the hashes that follow the inputs
+};
+
+struct PacketInput
+{
+	float steeringX;
+	float steeringY;
+	float gas;
+	float weaponAngle;
+	int32_t flags;
+};
+#pragma pack (pop)
+
+static PacketInput PackInput(const VehicleState &vs)
+{
+	return PacketInput{ vs.steering.x, vs.steering.y, vs.gas, vs.weaponAngle, vs.flags };
+}
+
+static VehicleState UnpackInput(const PacketInput &pi)
+{
+	VehicleState vs = {};
+	vs.steering = vec2d{ pi.steeringX, pi.steeringY };
+	vs.gas = pi.gas;
+	vs.weaponAngle = pi.weaponAngle;
+	vs.flags = pi.flags;
+	return vs;
+}
+
+LockstepSession::LockstepSession(LockstepTransport &transport, unsigned int playerCount, unsigned int localPlayer, unsigned int inputDelay)
+	: _transport(transport)
+	, _playerCount(playerCount)
+	, _localPlayer(localPlayer)
+	, _inputDelay(inputDelay)
+	, _localScheduled(inputDelay)
+	, _inputs(playerCount)
+	, _received(playerCount, inputDelay)
+	, _peerAck(playerCount, inputDelay)
+	, _hashReceived(playerCount)
+	, _peerHashAck(playerCount)
+	, _tickInputs(playerCount)
+{
+	assert(localPlayer < playerCount && playerCount <= 256);
+
+	// nobody can act before the delay has passed
+	for (auto &playerInputs: _inputs)
+		for (uint32_t tick = 0; tick != inputDelay; ++tick)
+			playerInputs[tick] = VehicleState{};
+}
+
+LockstepSession::~LockstepSession()
+{
+}
+
+bool LockstepSession::CanScheduleInput() const
+{
+	// never run further ahead than the delay; stall rather than let unacknowledged
+	// inputs fall out of the redundancy window
+	uint32_t minAck = GetMinPeerAck();
+	return _localScheduled <= _currentTick + _inputDelay &&
+		_localScheduled < minAck + c_maxInputsPerPacket;
+}
+
+void LockstepSession::ScheduleLocalInput(const VehicleState &state)
+{
+	assert(CanScheduleInput());
+	_inputs[_localPlayer][_localScheduled] = state;
+	_received[_localPlayer] = ++_localScheduled;
+}
+
+bool LockstepSession::IsTickReady() const
+{
+	for (uint32_t received: _received)
+		if (received <= _currentTick)
+			return false;
+	return true;
+}
+
+const std::vector<VehicleState>& LockstepSession::GetTickInputs()
+{
+	assert(IsTickReady());
+	for (unsigned int player = 0; player != _playerCount; ++player)
+		_tickInputs[player] = _inputs[player].at(_currentTick);
+	return _tickInputs;
+}
+
+void LockstepSession::AdvanceTick(uint32_t worldHash)
+{
+	assert(IsTickReady());
+	_localHashes[_currentTick] = worldHash;
+	CompareHash(_currentTick);
+
+	// remote inputs are never needed again; our own are kept until acknowledged
+	uint32_t minAck = GetMinPeerAck();
+	for (unsigned int player = 0; player != _playerCount; ++player)
+	{
+		uint32_t keepFrom = player == _localPlayer ? std::min(minAck, _currentTick + 1) : _currentTick + 1;
+		auto &playerInputs = _inputs[player];
+		playerInputs.erase(playerInputs.begin(), playerInputs.lower_bound(keepFrom));
+	}
+	PruneHashes();
+
+	++_currentTick;
+}
+
+void LockstepSession::PruneHashes()
+{
+	// a local hash is kept until every peer has it and has sent its own for the same tick
+	uint32_t keepFrom = _currentTick + 1;
+	for (unsigned int peer = 0; peer != _playerCount; ++peer)
+		if (peer != _localPlayer)
+			keepFrom = std::min(keepFrom, std::min(_peerHashAck[peer], _hashReceived[peer]));
+	if (_currentTick + 1 > c_hashHistory)
+		keepFrom = std::max(keepFrom, _currentTick + 1 - c_hashHistory);
+
+	_localHashes.erase(_localHashes.begin(), _localHashes.lower_bound(keepFrom));
+	_remoteHashes.erase(_remoteHashes.begin(), _remoteHashes.lower_bound(keepFrom));
+}
+
+uint32_t LockstepSession::GetMinPeerAck() const
+{
+	uint32_t minAck = _localScheduled;
+	for (unsigned int peer = 0; peer != _playerCount; ++peer)
+		if (peer != _localPlayer)
+			minAck = std::min(minAck, _peerAck[peer]);
+	return minAck;
+}
+
+void LockstepSession::Poll()
+{
+	std::vector<char> data;
+	unsigned int peer;
+	while (_transport.Receive(data, peer))
+		OnPacket(data, peer);
+}
+
+void LockstepSession::Flush()
+{
+	for (unsigned int peer = 0; peer != _playerCount; ++peer)
+	{
+		if (peer == _localPlayer)
+			continue;
+
+		// everything the peer has not confirmed yet, several ticks per packet
+		uint32_t firstTick = std::max(_peerAck[peer], _localScheduled > c_maxInputsPerPacket ? _localScheduled - c_maxInputsPerPacket : 0u);
+		uint32_t inputCount = _localScheduled > firstTick ? _localScheduled - firstTick : 0;
+
+		// hashes of all simulated ticks the peer does not have yet; a peer that falls
+		// too far behind skips the oldest ones
+		uint32_t firstHashTick = std::max(_peerHashAck[peer], _currentTick > c_maxHashesPerPacket ? _currentTick - c_maxHashesPerPacket : 0u);
+		firstHashTick = std::max(firstHashTick, _localHashes.empty() ? _currentTick : _localHashes.begin()->first);
+		uint32_t hashCount = _currentTick > firstHashTick ? _currentTick - firstHashTick : 0;
+
+		PacketHeader header;
+		header.magic = c_magic;
+		header.sender = static_cast<uint8_t>(_localPlayer);
+		header.inputCount = static_cast<uint8_t>(inputCount);
+		header.hashCount = static_cast<uint8_t>(hashCount);
+		header.ack = _received[peer];
+		header.hashAck = _hashReceived[peer];
+		header.firstTick = firstTick;
+		header.firstHashTick = firstHashTick;
+
+		size_t hashesOffset = sizeof(PacketHeader) + inputCount * sizeof(PacketInput);
+		_packet.resize(hashesOffset + hashCount * sizeof(uint32_t));
+		memcpy(_packet.data(), &header, sizeof(header));
+		auto &localInputs = _inputs[_localPlayer];
+		for (uint32_t i = 0; i != inputCount; ++i)
+		{
+			PacketInput input = PackInput(localInputs.at(firstTick + i));
+			memcpy(&_packet[sizeof(PacketHeader) + i * sizeof(PacketInput)], &input, sizeof(input));
+		}
+		for (uint32_t i = 0; i != hashCount; ++i)
+		{
+			uint32_t hash = _localHashes.at(firstHashTick + i);
+			memcpy(&_packet[hashesOffset + i * sizeof(uint32_t)], &hash, sizeof(hash));
+		}
+
+		_transport.Send(peer, _packet.data(), _packet.size());
+	}
+}
+
+void LockstepSession::OnPacket(const std::vector<char> &data, unsigned int peer)
+{
+	PacketHeader header;
+	if (data.size() < sizeof(header))
+		return;
+	memcpy(&header, data.data(), sizeof(header));
+	size_t hashesOffset = sizeof(header) + header.inputCount * sizeof(PacketInput);
+	if (header.magic != c_magic || header.sender >= _playerCount || header.sender == _localPlayer ||
+		data.size() != hashesOffset + header.hashCount * sizeof(uint32_t))
+	{
+		return; // not ours or truncated
+	}
+	if (header.sender != peer)
+		return; // claims to be another player
+
+	unsigned int sender = header.sender;
+	_peerAck[sender] = std::max(_peerAck[sender], header.ack);
+	_peerHashAck[sender] = std::max(_peerHashAck[sender], header.hashAck);
+
+	// packets may come out of order; only extend the contiguous range
+	auto &playerInputs = _inputs[sender];
+	for (uint32_t i = 0; i != header.inputCount; ++i)
+	{
+		uint32_t tick = header.firstTick + i;
+		if (tick < _received[sender])
+			continue; // already have it
+		PacketInput input;
+		memcpy(&input, &data[sizeof(header) + i * sizeof(PacketInput)], sizeof(input));
+		playerInputs[tick] = UnpackInput(input);
+	}
+	while (playerInputs.count(_received[sender]))
+		++_received[sender];
+
+	// the sender starts after our ack unless it had to skip ticks, so the range can only grow
+	for (uint32_t i = 0; i != header.hashCount; ++i)
+	{
+		uint32_t tick = header.firstHashTick + i;
+		uint32_t hash;
+		memcpy(&hash, &data[hashesOffset + i * sizeof(uint32_t)], sizeof(hash));
+		auto emplaced = _remoteHashes.emplace(tick, hash);
+		if (!emplaced.second && emplaced.first->second != hash)
+			_desyncTick = std::min(_desyncTick, tick); // peers disagree with each other
+		CompareHash(tick);
+	}
+	if (header.hashCount)
+		_hashReceived[sender] = std::max(_hashReceived[sender], header.firstHashTick + header.hashCount);
+}
+
+void LockstepSession::CompareHash(uint32_t tick)
+{
+	auto local = _localHashes.find(tick);
+	auto remote = _remoteHashes.find(tick);
+	if (_localHashes.end() != local && _remoteHashes.end() != remote && local->second != remote->second)
+		_desyncTick = std::min(_desyncTick, tick);
+}
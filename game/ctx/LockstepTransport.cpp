@@ -0,0 +1,69 @@
+#include "inc/ctx/LockstepTransport.h"
+#include <cassert>
+#include <utility>
+
+class LoopbackNetwork::Endpoint final
+	: public LockstepTransport
+{
+public:
+	Endpoint(LoopbackNetwork &network, unsigned int peer)
+		: _network(network)
+		, _peer(peer)
+	{}
+
+	void Enqueue(unsigned int from, const void *data, size_t size)
+	{
+		_queue.emplace_back(from, std::vector<char>(static_cast<const char*>(data), static_cast<const char*>(data) + size));
+	}
+
+	// LockstepTransport
+	void Send(unsigned int peer, const void *data, size_t size) override
+	{
+		_network.Deliver(_peer, peer, data, size);
+	}
+
+	bool Receive(std::vector<char> &outData, unsigned int &outPeer) override
+	{
+		if (_queue.empty())
+			return false;
+		outPeer = _queue.front().first;
+		outData = std::move(_queue.front().second);
+		_queue.pop_front();
+		return true;
+	}
+
+private:
+	LoopbackNetwork &_network;
+	unsigned int _peer;
+	std::deque<std::pair<unsigned int, std::vector<char>>> _queue;
+};
+
+LoopbackNetwork::LoopbackNetwork(unsigned int peerCount)
+{
+	for (unsigned int i = 0; i != peerCount; ++i)
+		_endpoints.push_back(std::make_unique<Endpoint>(*this, i));
+}
+
+LoopbackNetwork::~LoopbackNetwork()
+{
+}
+
+LockstepTransport& LoopbackNetwork::GetEndpoint(unsigned int peer)
+{
+	return *_endpoints[peer];
+}
+
+void LoopbackNetwork::SetLossRate(float lossRate, unsigned int seed)
+{
+	_lossRate = lossRate;
+	_random.seed(seed);
+}
+
+void LoopbackNetwork::Deliver(unsigned int from, unsigned int to, const void *data, size_t size)
+{
+	assert(to < _endpoints.size());
+	if (_lossRate > 0 && std::uniform_real_distribution<float>()(_random) < _lossRate)
+		++_dropped;
+	else
+		_endpoints[to]->Enqueue(from, data, size);
+}
@@ -0,0 +1,126 @@
+#include "inc/ctx/LockstepTransport.h"
+#include <cstring>
+#include <stdexcept>
+#ifdef _WIN32
+# include <winsock2.h>
+# include <ws2tcpip.h>
+typedef int socklen_t;
+#else
+# include <arpa/inet.h>
+# include <fcntl.h>
+# include <netdb.h>
+# include <netinet/in.h>
+# include <sys/socket.h>
+# include <unistd.h>
+# define INVALID_SOCKET (-1)
+# define closesocket close
+typedef int SOCKET;
+#endif
+
+static const size_t c_maxDatagram = 1500;
+
+static sockaddr_in ResolvePeer(const std::string &address)
+{
+	auto colon = address.rfind(':');
+	if (std::string::npos == colon)
+		throw std::runtime_error("peer address must be host:port - " + address);
+
+	addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	addrinfo *result = nullptr;
+	if (getaddrinfo(address.substr(0, colon).c_str(), address.substr(colon + 1).c_str(), &hints, &result) || !result)
+		throw std::runtime_error("could not resolve " + address);
+
+	sockaddr_in addr;
+	memcpy(&addr, result->ai_addr, sizeof(addr));
+	freeaddrinfo(result);
+	return addr;
+}
+
+struct UdpTransport::Impl
+{
+	SOCKET socket = INVALID_SOCKET;
+	std::vector<sockaddr_in> peers;
+	std::vector<char> buffer = std::vector<char>(c_maxDatagram);
+#ifdef _WIN32
+	bool wsaStarted = false;
+#endif
+
+	~Impl()
+	{
+		if (INVALID_SOCKET != socket)
+			closesocket(socket);
+#ifdef _WIN32
+		if (wsaStarted)
+			WSACleanup();
+#endif
+	}
+};
+
+UdpTransport::UdpTransport(uint16_t localPort, const std::vector<std::string> &peerAddresses)
+	: _impl(new Impl())
+{
+#ifdef _WIN32
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData))
+		throw std::runtime_error("WSAStartup failed");
+	_impl->wsaStarted = true;
+#endif
+
+	_impl->socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (INVALID_SOCKET == _impl->socket)
+		throw std::runtime_error("could not create UDP socket");
+
+#ifdef _WIN32
+	u_long nonBlocking = 1;
+	ioctlsocket(_impl->socket, FIONBIO, &nonBlocking);
+#else
+	fcntl(_impl->socket, F_SETFL, fcntl(_impl->socket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+	sockaddr_in local = {};
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = htonl(INADDR_ANY);
+	local.sin_port = htons(localPort);
+	if (bind(_impl->socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)))
+		throw std::runtime_error("could not bind UDP port " + std::to_string(localPort));
+
+	for (auto &address: peerAddresses)
+		_impl->peers.push_back(address.empty() ? sockaddr_in{} : ResolvePeer(address));
+}
+
+UdpTransport::~UdpTransport()
+{
+}
+
+void UdpTransport::Send(unsigned int peer, const void *data, size_t size)
+{
+	// lost packets are covered by the redundancy of the lockstep protocol
+	const sockaddr_in &addr = _impl->peers[peer];
+	sendto(_impl->socket, static_cast<const char*>(data), (int) size, 0, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+}
+
+bool UdpTransport::Receive(std::vector<char> &outData, unsigned int &outPeer)
+{
+	for (;;)
+	{
+		sockaddr_in from;
+		socklen_t fromLength = sizeof(from);
+		auto received = recvfrom(_impl->socket, _impl->buffer.data(), (int) _impl->buffer.size(), 0, reinterpret_cast<sockaddr*>(&from), &fromLength);
+		if (received < 0)
+			return false; // would block, or an ICMP error from an unreachable peer
+
+		// anyone can send to our port; only the configured peers are heard
+		for (unsigned int peer = 0; peer != _impl->peers.size(); ++peer)
+		{
+			const sockaddr_in &addr = _impl->peers[peer];
+			if (addr.sin_port && addr.sin_port == from.sin_port && addr.sin_addr.s_addr == from.sin_addr.s_addr)
+			{
+				outData.assign(_impl->buffer.data(), _impl->buffer.data() + received);
+				outPeer = peer;
+				return true;
+			}
+		}
+	}
+}
@@ -37,9 +37,9 @@ std::vector<GC_Player*> WorldController::GetAIPlayers() const
 	return players;
 }
 
-void WorldController::SendControllerStates(ControllerStateMap stateMap)
+void WorldController::SendControllerStates(const ControllerStates &states)
 {
-	for (auto playerState: stateMap)
+	for (auto &playerState: states)
 	{
 		auto vehicle = static_cast<GC_Vehicle*>(_world.GetList(LIST_objects).at(playerState.first));
 		vehicle->SetControllerState(playerState.second);
@@ -0,0 +1,57 @@
+#include "inc/ctx/WorldHash.h"
+#include <gc/RigidBody.h>
+#include <gc/World.h>
+#include <cstring>
+
+namespace
+{
+	class Fnv1a
+	{
+	public:
+		void Add(const void *data, size_t size)
+		{
+			for (size_t i = 0; i != size; ++i)
+				_hash = (_hash ^ static_cast<const uint8_t*>(data)[i]) * 16777619u;
+		}
+
+		void Add(float value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			Add(&bits, sizeof(bits));
+		}
+
+		uint32_t Get() const { return _hash; }
+
+	private:
+		uint32_t _hash = 2166136261u;
+	};
+}
+
+uint32_t ComputeWorldHash(const World &world)
+{
+	Fnv1a hash;
+	hash.Add(world.GetTime());
+
+	const auto &objects = world.GetList(LIST_objects);
+	for (auto it = objects.begin(); it != objects.end(); it = objects.next(it))
+	{
+		GC_Object *obj = objects.at(it);
+		ObjectType type = obj->GetType();
+		hash.Add(&type, sizeof(type));
+
+		if (auto mo = dynamic_cast<const GC_MovingObject*>(obj))
+		{
+			hash.Add(mo->GetPos().x);
+			hash.Add(mo->GetPos().y);
+			hash.Add(mo->GetDirection().x);
+			hash.Add(mo->GetDirection().y);
+		}
+		if (auto rb = dynamic_cast<const GC_RigidBodyStatic*>(obj))
+		{
+			hash.Add(rb->GetHealth());
+		}
+	}
+
+	return hash.Get();
+}
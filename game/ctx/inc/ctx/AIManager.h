@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 enum class AIDiffuculty;
@@ -12,6 +13,7 @@ class AIController;
 class GC_Object;
 class GC_Player;
 class GC_Vehicle;
+class TaskPool;
 class World;
 
 class AIManager final
@@ -19,18 +21,29 @@ class AIManager final
 	, private ObjectListener<World>
 {
 public:
-	AIManager(World &world);
+	// bots think on the task pool when one is given
+	AIManager(World &world, TaskPool *taskPool = nullptr);
 	~AIManager();
 	void AssignAI(GC_Player *player, AIDiffuculty diffuculty);
 
-	typedef std::map<PtrList<GC_Object>::id_type, VehicleState> ControllerStateMap;
-	ControllerStateMap ComputeAIState(World &world, float dt);
+	// in the order of controllers, which does not depend on the thread count
+	typedef std::vector<std::pair<PtrList<GC_Object>::id_type, VehicleState>> ControllerStates;
+	ControllerStates ComputeAIState(World &world, float dt);
 
 	void GetControllers(std::vector<const AIController*> &controllers) const;
 
 private:
 	std::map<GC_Player *, std::unique_ptr<AIController>> _aiControllers;
 	World &_world;
+	TaskPool *_taskPool;
+
+	struct Job
+	{
+		AIController *controller;
+		const GC_Vehicle *vehicle;
+		bool allowExtraCalc;
+	};
+	std::vector<Job> _jobs;
 
 	// ObjectListener<GC_Player>
 	void OnRespawn(GC_Player &obj, GC_Vehicle &vehicle) override;
@@ -39,6 +52,7 @@ private:
 	// ObjectListener<World>
 	void OnKill(GC_Object &obj) override;
 	void OnNewObject(GC_Object &) override {}
+	void OnClear() override;
 	void OnGameStarted() override {}
 	void OnGameFinished() override {}
 };
@@ -47,6 +47,8 @@ REFLECTION_BEGIN(AppConfig)
 	VAR_ARRAY(sp_tiersprogress, nullptr)
 	VAR_REFLECTION(sp_playerinfo, ConfPlayerLocal)
 	VAR_INT(sp_difficulty, 0)
+	VAR_FLOAT(autosave_interval, 0) // seconds of play, 0 disables
+	VAR_INT(autosave_slots, 3)
 REFLECTION_END()
 
 bool IsTierComplete(AppConfig &appConfig, const DMCampaign &dmCampaign, int tierIndex);
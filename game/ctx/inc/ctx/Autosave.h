@@ -0,0 +1,38 @@
+#pragma once
+#include <deque>
+#include <future>
+#include <memory>
+
+class GameContext;
+class TaskPool;
+
+namespace FS
+{
+	struct Stream;
+}
+
+// Saves a running game without stalling it. The state is copied into memory
+// between steps; compression and the write go to the task pool.
+class Autosave final
+{
+public:
+	Autosave(TaskPool &taskPool, unsigned int maxPending = 2, int compressionLevel = 1);
+	~Autosave(); // waits for the writes in flight
+
+	// Returns false without taking a snapshot while maxPending writes are
+	// still in flight. Rethrows the error of a failed earlier write.
+	bool Save(GameContext &gameContext, std::shared_ptr<FS::Stream> stream);
+
+	// Collects finished writes and rethrows the first error.
+	void Poll();
+	void Wait();
+
+	unsigned int GetPendingCount() const { return static_cast<unsigned int>(_pending.size()); }
+	bool IsBusy() const { return _pending.size() >= _maxPending; }
+
+private:
+	TaskPool &_taskPool;
+	std::deque<std::future<void>> _pending;
+	const unsigned int _maxPending;
+	const int _compressionLevel;
+};
@@ -2,6 +2,7 @@
 #include "ScriptMessageBroadcaster.h"
 #include "GameContextBase.h"
 #include "GameEvents.h"
+#include <fsmem/FileSystemMemory.h>
 #include <functional>
 #include <memory>
 #include <string>
@@ -10,14 +11,10 @@
 class World;
 struct Gameplay;
 
-namespace FS
-{
-	struct Stream;
-}
-
 class AIManager;
 class ScriptHarness;
 class ThemeManager;
+class TaskPool;
 class TextureManager;
 class WorldController;
 
@@ -40,11 +37,21 @@ struct DMSettings
 	float timeLimit{};
 };
 
+// The game state as Serialize writes it, before compression. Block bounds of the world.
+struct SaveSnapshot
+{
+	int left = 0;
+	int top = 0;
+	int right = 0;
+	int bottom = 0;
+	FS::MemoryStream body;
+};
+
 
 class GameContext : public GameContextBase
 {
 public:
-	GameContext(std::unique_ptr<World> world, const DMSettings &settings);
+	GameContext(std::unique_ptr<World> world, const DMSettings &settings, TaskPool *taskPool = nullptr);
 	virtual ~GameContext();
 	WorldController& GetWorldController() { return *_worldController; }
 	const WorldController& GetWorldController() const { return *_worldController; }
@@ -55,9 +62,15 @@ public:
 	float GetGameplayTime() const { return _gameplayTime; }
 	bool IsGameplayActive() const;
 
-	void Serialize(FS::Stream &stream);
+	// compressionLevel is 1 (fastest) to 9 (smallest), 0 writes an uncompressed save
+	void Serialize(FS::Stream &stream, int compressionLevel = 0);
 	void Deserialize(FS::Stream &stream);
 
+	// Splits Serialize in two: a plain copy into memory to be taken between
+	// steps, and the encoding that can run on any thread afterwards.
+	SaveSnapshot TakeSnapshot();
+	static void WriteSnapshot(const SaveSnapshot &snapshot, FS::Stream &stream, int compressionLevel = 0);
+
 	// GameContextBase
 	World& GetWorld() override { return *_world; }
 	Gameplay* GetGameplay() const override;
@@ -74,13 +87,15 @@ private:
 	std::unique_ptr<AIManager> _aiManager;
 	const AIDiffuculty _difficulty;
 	float _gameplayTime = 0;
+
+	void SerializeBody(FS::Stream &stream);
 };
 
 class GameContextCampaignDM final
 	: public GameContext
 {
 public:
-	GameContextCampaignDM(std::unique_ptr<World> world, const DMSettings &settings, int campaignTier, int campaignMap);
+	GameContextCampaignDM(std::unique_ptr<World> world, const DMSettings &settings, int campaignTier, int campaignMap, TaskPool *taskPool = nullptr);
 
 	int GetRating() const;
 
@@ -0,0 +1,71 @@
+#pragma once
+#include <gc/VehicleState.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+struct LockstepTransport;
+
+// Deterministic lockstep over an unreliable transport. Every peer simulates
+// the same fixed ticks and only player inputs are exchanged. Local input is
+// scheduled inputDelay ticks ahead to hide latency; each packet repeats all
+// inputs the receiver has not acknowledged yet, so a lost packet is covered
+// by the next one. Peers exchange the world hash of every tick to detect a
+// desync.
+//
+// Typical frame:
+//	session.Poll();
+//	while (session.CanScheduleInput()) session.ScheduleLocalInput(sample);
+//	while (session.IsTickReady()) { apply GetTickInputs(); step; session.AdvanceTick(hash); }
+//	session.Flush();
+class LockstepSession final
+{
+public:
+	LockstepSession(LockstepTransport &transport, unsigned int playerCount, unsigned int localPlayer, unsigned int inputDelay);
+	~LockstepSession();
+
+	unsigned int GetPlayerCount() const { return _playerCount; }
+	unsigned int GetLocalPlayer() const { return _localPlayer; }
+	uint32_t GetCurrentTick() const { return _currentTick; }
+
+	bool CanScheduleInput() const;
+	void ScheduleLocalInput(const VehicleState &state);
+
+	// true when inputs of all players for the current tick are known
+	bool IsTickReady() const;
+	const std::vector<VehicleState>& GetTickInputs(); // indexed by player
+
+	// hash of the world after simulating the current tick
+	void AdvanceTick(uint32_t worldHash);
+
+	void Poll();
+	void Flush();
+
+	bool IsDesynced() const { return _desyncTick != UINT32_MAX; }
+	uint32_t GetDesyncTick() const { return _desyncTick; }
+
+private:
+	LockstepTransport &_transport;
+	unsigned int _playerCount;
+	unsigned int _localPlayer;
+	unsigned int _inputDelay;
+	uint32_t _currentTick = 0;
+	uint32_t _localScheduled; // next tick to get local input
+	uint32_t _desyncTick = UINT32_MAX;
+
+	std::vector<std::map<uint32_t, VehicleState>> _inputs; // per player
+	std::vector<uint32_t> _received; // per player, all ticks below are known
+	std::vector<uint32_t> _peerAck;  // per player, how much of our input they have
+	std::vector<uint32_t> _hashReceived; // per player, hashes of all ticks below are known
+	std::vector<uint32_t> _peerHashAck;  // per player, how much of our hashes they have
+	std::vector<VehicleState> _tickInputs;
+
+	std::map<uint32_t, uint32_t> _localHashes;
+	std::map<uint32_t, uint32_t> _remoteHashes;
+	std::vector<char> _packet;
+
+	uint32_t GetMinPeerAck() const;
+	void OnPacket(const std::vector<char> &data, unsigned int peer);
+	void PruneHashes();
+	void CompareHash(uint32_t tick);
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Unreliable, unordered datagram delivery between lockstep peers.
+struct LockstepTransport
+{
+	virtual void Send(unsigned int peer, const void *data, size_t size) = 0;
+
+	// Returns false when there is nothing to receive. Datagrams that do not
+	// come from one of the peers are dropped.
+	virtual bool Receive(std::vector<char> &outData, unsigned int &outPeer) = 0;
+	virtual ~LockstepTransport() {}
+};
+
+// In-process network for tests and local sessions. Every endpoint is a peer
+// index; packets can be dropped to exercise the redundancy.
+class LoopbackNetwork final
+{
+public:
+	explicit LoopbackNetwork(unsigned int peerCount);
+	~LoopbackNetwork();
+
+	LockstepTransport& GetEndpoint(unsigned int peer);
+
+	// fraction of packets lost, deterministic for a given seed
+	void SetLossRate(float lossRate, unsigned int seed = 0);
+	size_t GetDroppedCount() const { return _dropped; }
+
+private:
+	class Endpoint;
+	std::vector<std::unique_ptr<Endpoint>> _endpoints;
+	std::mt19937 _random;
+	float _lossRate = 0;
+	size_t _dropped = 0;
+
+	void Deliver(unsigned int from, unsigned int to, const void *data, size_t size);
+};
+
+// Non-blocking UDP socket. Peers are given as "host:port", in peer index order;
+// the local peer's own entry is ignored.
+class UdpTransport final
+	: public LockstepTransport
+{
+public:
+	UdpTransport(uint16_t localPort, const std::vector<std::string> &peerAddresses);
+	~UdpTransport();
+
+	// LockstepTransport
+	void Send(unsigned int peer, const void *data, size_t size) override;
+	bool Receive(std::vector<char> &outData, unsigned int &outPeer) override;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> _impl;
+};
@@ -1,7 +1,7 @@
 #pragma once
 #include <gc/detail/PtrList.h> // fixme: detail
 #include <gc/VehicleState.h>
-#include <map>
+#include <utility>
 #include <vector>
 
 class World;
@@ -16,8 +16,8 @@ public:
 	std::vector<GC_Player*> GetLocalPlayers() const;
 	std::vector<GC_Player*> GetAIPlayers() const;
 
-	typedef std::map<PtrList<GC_Object>::id_type, VehicleState> ControllerStateMap;
-	void SendControllerStates(ControllerStateMap stateMap);
+	typedef std::vector<std::pair<PtrList<GC_Object>::id_type, VehicleState>> ControllerStates;
+	void SendControllerStates(const ControllerStates &states);
 
 private:
 	World &_world;
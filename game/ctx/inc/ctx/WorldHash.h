@@ -0,0 +1,8 @@
+#pragma once
+#include <cstdint>
+
+class World;
+
+// Hash of the simulation state that matters for lockstep desync detection:
+// world time and the type, position, direction and health of every object.
+uint32_t ComputeWorldHash(const World &world);
@@ -0,0 +1,85 @@
+#include <ai/ai.h>
+#include <ctx/AIManager.h>
+#include <ctx/WorldController.h>
+#include <ctx/WorldHash.h>
+#include <gc/Pickup.h>
+#include <gc/Player.h>
+#include <gc/SpawnPoint.h>
+#include <gc/Wall.h>
+#include <gc/Weapons.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <tasks/TaskPool.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct BotMatch
+	{
+		World world{ RectRB{ 0, 0, 24, 24 }, true /*initField*/ };
+		AIManager aiManager;
+		WorldController worldController{ world };
+
+		explicit BotMatch(TaskPool *taskPool)
+			: aiManager(world, taskPool)
+		{
+			world.Seed(7);
+			for (int i = 4; i < 20; ++i)
+			{
+				world.New<GC_Wall>(vec2d{ WORLD_BLOCK_SIZE * (i + 0.5f), WORLD_BLOCK_SIZE * 8.5f });
+				world.New<GC_Wall>(vec2d{ WORLD_BLOCK_SIZE * 12.5f, WORLD_BLOCK_SIZE * (i + 0.5f) });
+			}
+			world.New<GC_SpawnPoint>(vec2d{ WORLD_BLOCK_SIZE * 2, WORLD_BLOCK_SIZE * 2 });
+			world.New<GC_SpawnPoint>(vec2d{ WORLD_BLOCK_SIZE * 22, WORLD_BLOCK_SIZE * 2 });
+			world.New<GC_SpawnPoint>(vec2d{ WORLD_BLOCK_SIZE * 2, WORLD_BLOCK_SIZE * 22 });
+			world.New<GC_SpawnPoint>(vec2d{ WORLD_BLOCK_SIZE * 22, WORLD_BLOCK_SIZE * 22 });
+			world.New<GC_Weap_Cannon>(vec2d{ WORLD_BLOCK_SIZE * 6, WORLD_BLOCK_SIZE * 4 });
+			world.New<GC_Weap_Cannon>(vec2d{ WORLD_BLOCK_SIZE * 18, WORLD_BLOCK_SIZE * 20 });
+			world.New<GC_pu_Health>(vec2d{ WORLD_BLOCK_SIZE * 6, WORLD_BLOCK_SIZE * 20 });
+
+			for (int i = 0; i != 6; ++i)
+			{
+				auto &player = world.New<GC_Player>();
+				player.SetIsHuman(false);
+				player.SetClass("default");
+				player.SetNick("bot" + std::to_string(i));
+				aiManager.AssignAI(&player, AIDiffuculty::Hard);
+			}
+		}
+
+		void Step(float dt)
+		{
+			worldController.SendControllerStates(aiManager.ComputeAIState(world, dt));
+			world.Step(dt);
+		}
+	};
+
+	// world hash after every step
+	std::vector<uint32_t> RunBotMatch(TaskPool *taskPool)
+	{
+		srand(1); // effects such as shield sparks still use rand()
+		BotMatch match(taskPool);
+		std::vector<uint32_t> hashes;
+		for (int step = 0; step != 600; ++step)
+		{
+			match.Step(1.f / 60);
+			hashes.push_back(ComputeWorldHash(match.world));
+		}
+		EXPECT_LT(0u, match.world.GetList(LIST_vehicles).size());
+		return hashes;
+	}
+}
+
+TEST(AIManager, ResultDoesNotDependOnThreadCount)
+{
+	std::vector<uint32_t> serial = RunBotMatch(nullptr);
+	TaskPool taskPool(3);
+	std::vector<uint32_t> parallel = RunBotMatch(&taskPool);
+
+	EXPECT_NE(serial.front(), serial.back());
+	for (size_t step = 0; step != serial.size(); ++step)
+		ASSERT_EQ(serial[step], parallel[step]) << "step " << step;
+}
@@ -0,0 +1,141 @@
+#include <ctx/Autosave.h>
+#include <ctx/GameContext.h>
+#include <ctx/WorldHash.h>
+#include <fsmem/FileSystemMemory.h>
+#include <gc/Crate.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <tasks/TaskPool.h>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <vector>
+
+static std::unique_ptr<GameContext> MakeGameContext()
+{
+	auto world = std::make_unique<World>(RectRB{ -4, -4, 28, 28 }, true /*initField*/);
+	for (int y = 0; y < 32; ++y)
+	{
+		world->New<GC_Wall>(vec2d{ WORLD_BLOCK_SIZE / 2, WORLD_BLOCK_SIZE * (y + 0.5f) });
+		world->New<GC_Crate>(vec2d{ WORLD_BLOCK_SIZE * 4, WORLD_BLOCK_SIZE * (y + 0.5f) });
+	}
+	return std::make_unique<GameContext>(std::move(world), DMSettings{});
+}
+
+static long long GetSize(FS::Stream &stream)
+{
+	stream.Seek(0, SEEK_END);
+	long long size = stream.Tell();
+	stream.Seek(0, SEEK_SET);
+	return size;
+}
+
+static std::vector<char> ReadAll(FS::Stream &stream)
+{
+	std::vector<char> data(static_cast<size_t>(GetSize(stream)));
+	stream.Read(data.data(), 1, data.size());
+	stream.Seek(0, SEEK_SET);
+	return data;
+}
+
+TEST(GameContext, SavesRepeatedly)
+{
+	// each save used to leave the script stack one slot lower
+	auto context = MakeGameContext();
+	FS::MemoryStream first;
+	context->Serialize(first);
+	for (int i = 0; i < 1000; ++i)
+	{
+		FS::MemoryStream again;
+		context->Serialize(again);
+		ASSERT_EQ(GetSize(first), GetSize(again));
+	}
+}
+
+TEST(GameContext, SaveStoresWorldOrigin)
+{
+	auto context = MakeGameContext();
+	FS::MemoryStream stream;
+	context->Serialize(stream);
+
+	// version, then the bounds in blocks
+	stream.Seek(0, SEEK_SET);
+	int header[5] = {};
+	ASSERT_EQ(5, stream.Read(header, sizeof(int), 5));
+	EXPECT_EQ(32, header[1]);
+	EXPECT_EQ(32, header[2]);
+	EXPECT_EQ(-4, header[3]);
+	EXPECT_EQ(-4, header[4]);
+}
+
+TEST(GameContext, LoadReplacesWorld)
+{
+	auto original = MakeGameContext();
+	FS::MemoryStream stream;
+	original->Serialize(stream);
+
+	stream.Seek(0, SEEK_SET);
+	auto loaded = std::make_unique<GameContext>(std::make_unique<World>(RectRB{ 0, 0, 8, 8 }, true /*initField*/), DMSettings{});
+	loaded->Deserialize(stream);
+	EXPECT_EQ(original->GetWorld().GetBounds().left, loaded->GetWorld().GetBounds().left);
+	EXPECT_EQ(original->GetWorld().GetBounds().top, loaded->GetWorld().GetBounds().top);
+	EXPECT_EQ(original->GetWorld().GetBounds().right, loaded->GetWorld().GetBounds().right);
+	EXPECT_EQ(original->GetWorld().GetBounds().bottom, loaded->GetWorld().GetBounds().bottom);
+	EXPECT_EQ(original->GetWorld().GetList(LIST_objects).size(), loaded->GetWorld().GetList(LIST_objects).size());
+
+	// the listeners of the old world must not outlive it
+	loaded->GetWorld().Step(1.f / 60);
+	loaded.reset();
+}
+
+TEST(GameContext, CompressedSaveLoadsBack)
+{
+	auto original = MakeGameContext();
+
+	FS::MemoryStream plain;
+	FS::MemoryStream compressed;
+	original->Serialize(plain);
+	original->Serialize(compressed, 6);
+	EXPECT_LT(GetSize(compressed) * 2, GetSize(plain));
+
+	// loading reverses the object list, so compare against a plain load
+	auto fromPlain = MakeGameContext();
+	fromPlain->Deserialize(plain);
+	auto fromCompressed = MakeGameContext();
+	fromCompressed->Deserialize(compressed);
+
+	EXPECT_EQ(original->GetWorld().GetList(LIST_objects).size(), fromCompressed->GetWorld().GetList(LIST_objects).size());
+	EXPECT_EQ(ComputeWorldHash(fromPlain->GetWorld()), ComputeWorldHash(fromCompressed->GetWorld()));
+}
+
+TEST(GameContext, AutosaveWritesOnTaskPool)
+{
+	auto original = MakeGameContext();
+	FS::MemoryStream direct;
+	original->Serialize(direct, 1);
+
+	TaskPool taskPool(1);
+	auto stream = std::make_shared<FS::MemoryStream>();
+	{
+		// the only worker is busy, so the save stays in flight
+		std::promise<void> release;
+		auto blocker = taskPool.Submit([released = release.get_future()] { released.wait(); });
+
+		Autosave autosave(taskPool, 1 /*maxPending*/, 1 /*compressionLevel*/);
+		EXPECT_TRUE(autosave.Save(*original, stream));
+		EXPECT_TRUE(autosave.IsBusy());
+		EXPECT_FALSE(autosave.Save(*original, std::make_shared<FS::MemoryStream>()));
+		EXPECT_EQ(0, GetSize(*stream));
+
+		release.set_value();
+		autosave.Wait();
+		EXPECT_EQ(0, autosave.GetPendingCount());
+	}
+	EXPECT_EQ(ReadAll(direct), ReadAll(*stream));
+
+	auto loaded = MakeGameContext();
+	loaded->Deserialize(*stream);
+	EXPECT_EQ(original->GetWorld().GetList(LIST_objects).size(), loaded->GetWorld().GetList(LIST_objects).size());
+}
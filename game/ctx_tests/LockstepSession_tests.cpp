@@ -0,0 +1,190 @@
+#include <ctx/LockstepSession.h>
+#include <ctx/LockstepTransport.h>
+#include <ctx/WorldHash.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	VehicleState MakeInput(unsigned int player, uint32_t tick)
+	{
+		VehicleState vs = {};
+		vs.gas = static_cast<float>((tick * 7 + player) % 5) - 2;
+		vs.attack = (tick + player) % 3 == 0;
+		return vs;
+	}
+
+	// stands in for the world: folds every applied input into a hash
+	struct Replica
+	{
+		std::unique_ptr<LockstepSession> session;
+		uint32_t state = 0;
+		uint32_t corruptAt = UINT32_MAX;
+		uint32_t corruptHashAt = UINT32_MAX; // reports a wrong hash for a single tick
+
+		void Frame()
+		{
+			session->Poll();
+			while (session->CanScheduleInput())
+				session->ScheduleLocalInput(MakeInput(session->GetLocalPlayer(), session->GetCurrentTick()));
+			while (session->IsTickReady())
+			{
+				uint32_t tick = session->GetCurrentTick();
+				for (auto &input: session->GetTickInputs())
+					state = state * 31 + static_cast<uint32_t>(input.gas + 2) * 2 + input.attack;
+				if (tick == corruptAt)
+					state ^= 1;
+				session->AdvanceTick(tick == corruptHashAt ? ~state : state);
+			}
+			session->Flush();
+		}
+	};
+
+	std::vector<Replica> MakeReplicas(LoopbackNetwork &network, unsigned int playerCount, unsigned int inputDelay)
+	{
+		std::vector<Replica> replicas(playerCount);
+		for (unsigned int i = 0; i != playerCount; ++i)
+			replicas[i].session = std::make_unique<LockstepSession>(network.GetEndpoint(i), playerCount, i, inputDelay);
+		return replicas;
+	}
+}
+
+TEST(LockstepSession, AgreesDespitePacketLoss)
+{
+	LoopbackNetwork network(3);
+	network.SetLossRate(0.3f, 42);
+	auto replicas = MakeReplicas(network, 3, 4);
+
+	for (int frame = 0; frame != 500; ++frame)
+		for (auto &replica: replicas)
+			replica.Frame();
+
+	EXPECT_LT(0u, network.GetDroppedCount());
+	uint32_t minTick = UINT32_MAX;
+	for (auto &replica: replicas)
+	{
+		EXPECT_FALSE(replica.session->IsDesynced());
+		minTick = std::min(minTick, replica.session->GetCurrentTick());
+	}
+	EXPECT_LT(200u, minTick);
+
+	// replicas that simulated the same number of ticks are in the same state
+	for (auto &replica: replicas)
+	{
+		if (replica.session->GetCurrentTick() == replicas[0].session->GetCurrentTick())
+		{
+			EXPECT_EQ(replicas[0].state, replica.state);
+		}
+	}
+}
+
+TEST(LockstepSession, WaitsForRemoteInput)
+{
+	LoopbackNetwork network(2);
+	auto replicas = MakeReplicas(network, 2, 2);
+
+	// without the other peer only the delay ticks can run
+	for (int frame = 0; frame != 10; ++frame)
+		replicas[0].Frame();
+	EXPECT_EQ(2u, replicas[0].session->GetCurrentTick());
+
+	replicas[1].Frame();
+	replicas[0].Frame();
+	EXPECT_LT(2u, replicas[0].session->GetCurrentTick());
+}
+
+TEST(LockstepSession, DetectsDesync)
+{
+	LoopbackNetwork network(2);
+	auto replicas = MakeReplicas(network, 2, 2);
+	replicas[1].corruptAt = 20;
+
+	for (int frame = 0; frame != 100; ++frame)
+		for (auto &replica: replicas)
+			replica.Frame();
+
+	for (auto &replica: replicas)
+	{
+		EXPECT_TRUE(replica.session->IsDesynced());
+		EXPECT_EQ(20u, replica.session->GetDesyncTick());
+	}
+}
+
+TEST(LockstepSession, ComparesHashOfEveryTick)
+{
+	LoopbackNetwork network(2);
+	auto replicas = MakeReplicas(network, 2, 4);
+	replicas[1].corruptHashAt = 1; // the first frame simulates ticks 0 to 3 at once
+
+	for (int frame = 0; frame != 20; ++frame)
+		for (auto &replica: replicas)
+			replica.Frame();
+
+	for (auto &replica: replicas)
+	{
+		EXPECT_TRUE(replica.session->IsDesynced());
+		EXPECT_EQ(1u, replica.session->GetDesyncTick());
+	}
+}
+
+TEST(LockstepSession, IgnoresPacketsFromWrongPeer)
+{
+	// endpoint 2 pretends to be player 1 of a two player session
+	LoopbackNetwork network(3);
+	Replica victim;
+	victim.session = std::make_unique<LockstepSession>(network.GetEndpoint(0), 2, 0, 2);
+	Replica impostor;
+	impostor.session = std::make_unique<LockstepSession>(network.GetEndpoint(2), 2, 1, 2);
+
+	for (int frame = 0; frame != 10; ++frame)
+	{
+		victim.Frame();
+		impostor.Frame();
+	}
+	EXPECT_EQ(2u, victim.session->GetCurrentTick());
+}
+
+TEST(UdpTransport, DropsDatagramsFromUnknownSenders)
+{
+	UdpTransport a(47301, { "", "127.0.0.1:47302" });
+	UdpTransport b(47302, { "127.0.0.1:47301", "" });
+	UdpTransport stranger(47303, { "127.0.0.1:47301" });
+
+	const char hello[] = "hello";
+	stranger.Send(0, hello, sizeof(hello));
+	b.Send(0, hello, sizeof(hello));
+
+	std::vector<char> data;
+	unsigned int peer = 0;
+	bool received = false;
+	for (int attempt = 0; attempt != 100 && !received; ++attempt)
+	{
+		received = a.Receive(data, peer);
+		if (!received)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_TRUE(received);
+	EXPECT_EQ(1u, peer);
+	EXPECT_EQ(sizeof(hello), data.size());
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	EXPECT_FALSE(a.Receive(data, peer));
+}
+
+TEST(WorldHash, ChangesWithState)
+{
+	World world({ 0, 0, 4, 4 }, false /*initField*/);
+	uint32_t empty = ComputeWorldHash(world);
+
+	auto &wall = world.New<GC_Wall>(vec2d{ 40, 40 });
+	uint32_t withWall = ComputeWorldHash(world);
+	EXPECT_NE(empty, withWall);
+
+	wall.SetHealth(wall.GetHealth() / 2);
+	EXPECT_NE(withWall, ComputeWorldHash(world));
+}
@@ -128,23 +128,23 @@ void EditorWorldView::Select(GC_Object *object, bool bSelect)
 
 	if( bSelect )
 	{
-		if( _selectedObject != object )
+		if( GetSelectedObject() != object )
 		{
-			if( _selectedObject )
+			if( GC_Object *selected = GetSelectedObject() )
 			{
-				Select(_selectedObject, false);
+				Select(selected, false);
 			}
 
-			_selectedObject = object;
-			_propList->ConnectTo(_selectedObject->GetProperties(_world));
+			_selectedObject = _world.GetHandle(object);
+			_propList->ConnectTo(object->GetProperties(_world));
 			_propList->SetVisible(true);
 			SetFocus(_propList.get());
 		}
 	}
 	else
 	{
-		assert(object == _selectedObject);
-		_selectedObject = nullptr;
+		assert(object == GetSelectedObject());
+		_selectedObject = {};
 
 		_propList->ConnectTo(nullptr);
 		_propList->SetVisible(false);
@@ -154,17 +154,22 @@ void EditorWorldView::Select(GC_Object *object, bool bSelect)
 
 void EditorWorldView::SelectNone()
 {
-	if( _selectedObject )
+	if( GC_Object *selected = GetSelectedObject() )
 	{
-		Select(_selectedObject, false);
+		Select(selected, false);
 	}
 }
 
+GC_Object* EditorWorldView::GetSelectedObject() const
+{
+	return _world.GetObject(_selectedObject);
+}
+
 void EditorWorldView::EraseAt(vec2d worldPos)
 {
 	while (GC_Object *object = PickEdObject(_worldView.GetRenderScheme(), _world, worldPos))
 	{
-		if (_selectedObject == object)
+		if (GetSelectedObject() == object)
 		{
 			Select(object, false);
 		}
@@ -195,7 +200,7 @@ void EditorWorldView::CreateAt(vec2d worldPos, bool defaultProperties)
 			properties->Exchange(_world, true);
 		}
 
-		_recentlyCreatedObject = &newobj;
+		_recentlyCreatedObject = _world.GetHandle(&newobj);
 	}
 }
 
@@ -205,13 +210,13 @@ void EditorWorldView::ActionOrCreateAt(vec2d worldPos, bool defaultProperties)
 	{
 		_quickActions.DoAction(*mo);
 
-		if( _recentlyCreatedObject == mo )
+		if( _world.GetObject(_recentlyCreatedObject) == mo )
 		{
 			SaveToConfig(_conf, *mo->GetProperties(_world));
 		}
 		else
 		{
-			_recentlyCreatedObject = nullptr;
+			_recentlyCreatedObject = {};
 		}
 	}
 	else
@@ -224,7 +229,7 @@ void EditorWorldView::ActionOrSelectAt(vec2d worldPos)
 {
 	if (GC_Object *object = PickEdObject(_worldView.GetRenderScheme(), _world, worldPos))
 	{
-		if (_selectedObject == object)
+		if (GetSelectedObject() == object)
 		{
 			_quickActions.DoAction(*object);
 			_propList->DoExchange(false);
@@ -317,7 +322,7 @@ void EditorWorldView::OnTimeStep(const Plat::Input &input, bool focused, float d
 	_defaultCamera.HandleMovement(input, _world.GetBounds(), dt);
 
 	// Workaround: we do not get notifications when the object is killed
-	if (!_selectedObject)
+	if (!GetSelectedObject())
 	{
 		_propList->ConnectTo(nullptr);
 		_propList->SetVisible(false);
@@ -449,11 +454,10 @@ bool EditorWorldView::OnKeyPressed(const Plat::Input &input, const UI::InputCont
 		break;
 	case Plat::Key::Delete:
 	case Plat::Key::GamepadX:
-		if( _selectedObject )
+		if( GC_Object *selected = GetSelectedObject() )
 		{
-			GC_Object *o = _selectedObject;
-			Select(_selectedObject, false);
-			o->Kill(_world);
+			Select(selected, false);
+			selected->Kill(_world);
 		}
 		else
 		{
@@ -481,7 +485,7 @@ bool EditorWorldView::CanNavigate(TextureManager& texman, const UI::LayoutContex
 	switch (navigate)
 	{
 	case UI::Navigate::Back:
-		return !!_selectedObject;
+		return !!GetSelectedObject();
 	case UI::Navigate::Enter:
 	case UI::Navigate::Up:
 	case UI::Navigate::Down:
@@ -511,9 +515,9 @@ void EditorWorldView::OnNavigate(TextureManager& texman, const UI::LayoutContext
 		ActionOrCreateAt(_virtualPointer, true);
 		break;
 	case UI::Navigate::Back:
-		if (_selectedObject)
+		if (GC_Object *selected = GetSelectedObject())
 		{
-			Select(_selectedObject, false);
+			Select(selected, false);
 		}
 		break;
 	case UI::Navigate::Up:
@@ -577,7 +581,7 @@ void EditorWorldView::Draw(const UI::DataContext &dc, const UI::StateContext &sc
 	_worldView.Render(rc, _world, options);
 
 	// Selection
-	if( auto selectedObject = PtrDynCast<const GC_MovingObject>(_selectedObject) )
+	if( auto selectedObject = dynamic_cast<const GC_MovingObject*>(GetSelectedObject()) )
 	{
 		FRECT sel = GetSelectionRect(*selectedObject);
 
@@ -109,6 +109,11 @@ void ServiceListDataSource::OnKill(GC_Object &obj)
 	}
 }
 
+void ServiceListDataSource::OnClear()
+{
+	_listener->OnDeleteAllItems();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ServiceEditor::ServiceEditor(UI::LayoutManager &manager, TextureManager &texman, float x, float y, float w, float h, World &world, ShellConfig &conf, LangCache &lang)
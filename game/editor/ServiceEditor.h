@@ -33,6 +33,7 @@ public:
 	void OnGameFinished() override {}
 	void OnNewObject(GC_Object &obj) override;
 	void OnKill(GC_Object &obj) override;
+	void OnClear() override;
 
 public:
 	ServiceListDataSource(World &world, LangCache &lang);
@@ -57,6 +57,7 @@ private:
 		FRECT bounds;
 		Type cursorType;
 	};
+	GC_Object* GetSelectedObject() const;
 	vec2d CanvasToWorld(const UI::LayoutContext &lc, vec2d canvasPos) const;
 	FRECT CanvasToWorld(vec2d worldTransformOffset, float worldTransformScale, FRECT canvasRect) const;
 	vec2d WorldToCanvas(vec2d worldTransformOffset, float worldTransformScale, vec2d worldPos) const;
@@ -107,8 +108,8 @@ private:
 	UI::Texture _fontSmall = "font_small";
 	UI::Texture _texSelection = "ui/selection";
 
-	ObjPtr<GC_Object> _selectedObject;
-	ObjPtr<GC_Object> _recentlyCreatedObject;
+	ObjectHandle _selectedObject;
+	ObjectHandle _recentlyCreatedObject;
 	int  _capturedButton = 0;
 
 	ObjectType _currentType = INVALID_OBJECT_TYPE;
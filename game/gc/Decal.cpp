@@ -45,15 +45,3 @@ void GC_Decal::Serialize(World &world, SaveFile &f)
 	f.Serialize(_rotationSpeed);
 	f.Serialize(_dtype);
 }
-
-///////////////////////////////////////////////////////////////////////////////
-
-IMPLEMENT_SELF_REGISTRATION(GC_DecalExplosion)
-{
-	return true;
-}
-
-IMPLEMENT_SELF_REGISTRATION(GC_DecalGauss)
-{
-	return true;
-}
@@ -0,0 +1,106 @@
+#include "inc/gc/DecalStore.h"
+#include "inc/gc/SaveFile.h"
+#include "inc/gc/WorldCfg.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+void DecalStore::Resize(RectRB locationBounds)
+{
+	assert(WIDTH(locationBounds) > 0 && HEIGHT(locationBounds) > 0);
+	_bounds = locationBounds;
+	_cells.resize(WIDTH(_bounds) * HEIGHT(_bounds));
+	Clear();
+}
+
+void DecalStore::Clear()
+{
+	_records.clear();
+	std::fill(_cells.begin(), _cells.end(), Cell());
+	_begin = 0;
+	_end = 0;
+}
+
+int DecalStore::GetCellIndex(vec2d pos) const
+{
+	int x = std::max(_bounds.left, std::min((int) std::floor(pos.x / WORLD_LOCATION_SIZE), _bounds.right - 1));
+	int y = std::max(_bounds.top, std::min((int) std::floor(pos.y / WORLD_LOCATION_SIZE), _bounds.bottom - 1));
+	return GetCellIndex(x, y);
+}
+
+void DecalStore::Add(const Decal &decal)
+{
+	assert(!_cells.empty());
+	if( GetCount() == CAPACITY )
+		PopFront();
+
+	int index = _end % CAPACITY;
+	if( index == (int) _records.size() )
+		_records.emplace_back();
+	Record &record = _records[index];
+	record.decal = decal;
+	record.cell = GetCellIndex(decal.pos);
+	record.next = -1;
+
+	Cell &cell = _cells[record.cell];
+	if( -1 == cell.last )
+		cell.first = index;
+	else
+		_records[cell.last].next = index;
+	cell.last = index;
+
+	++_end;
+}
+
+void DecalStore::PopFront()
+{
+	assert(_begin != _end);
+	int index = _begin % CAPACITY;
+	Record &record = _records[index];
+
+	// the oldest record overall is also the oldest one in its cell
+	Cell &cell = _cells[record.cell];
+	assert(cell.first == index);
+	cell.first = record.next;
+	if( -1 == cell.first )
+		cell.last = -1;
+
+	++_begin;
+}
+
+void DecalStore::Expire(float time)
+{
+	while( _begin != _end )
+	{
+		const Decal &decal = GetDecal(_begin);
+		if( time - decal.timeCreated < decal.lifeTime )
+			break;
+		PopFront();
+	}
+}
+
+void DecalStore::Serialize(SaveFile &f)
+{
+	std::vector<Decal> decals;
+	uint32_t count = GetCount();
+	f.Serialize(count);
+	if( f.loading() )
+	{
+		if( count > CAPACITY )
+			throw std::runtime_error("Load error: too many decals");
+		decals.resize(count);
+		if( count )
+			f.SerializeArray(decals.data(), count);
+		Clear();
+		for( const Decal &decal: decals )
+			Add(decal);
+	}
+	else
+	{
+		decals.reserve(count);
+		for( uint32_t seq = _begin; seq != _end; ++seq )
+			decals.push_back(GetDecal(seq));
+		if( count )
+			f.SerializeArray(decals.data(), count);
+	}
+}
@@ -206,7 +206,7 @@ void GC_Explosion::Boom(World &world, float radius, float damage)
 					{
 						if( d > 1e-5 )
 						{
-							dyn->ApplyImpulse(dir * (dam / d), dyn->GetPos());
+							dyn->ApplyImpulse(world, dir * (dam / d), dyn->GetPos());
 						}
 					}
 					DamageDesc dd;
@@ -254,10 +254,10 @@ void GC_ExplosionBig::Init(World &world)
 	SetTimeout(world, 0.10f);
 
 	float duration = 0.72f;
-	world.New<GC_DecalExplosion>(GetPos(), PARTICLE_EXPLOSION2, duration).SetDirection(vrand(1));
+	world._decals.Add({ GetPos(), vrand(1), PARTICLE_EXPLOSION2, world.GetTime(), duration });
 
 	auto &light = world.New<GC_Light>(GetPos(), GC_Light::LIGHT_POINT);
-	light.SetRadius(128 * 5);
+	light.SetRadius(world, 128 * 5);
 	light.SetTimeout(world, duration * 1.5f);
 
 	for( int n = 0; n < 80; ++n )
@@ -283,9 +283,7 @@ void GC_ExplosionBig::Init(World &world)
 		world.New<GC_Particle>(GetPos() + a, SPEED_SMOKE + a * 0.5f, PARTICLE_SMOKE, 1.5f, frand(1.0f));
 	}
 
-	auto &p = world.New<GC_Decal>(GetPos(), PARTICLE_BIGBLAST, 20.0f);
-	p.SetDirection(vrand(1));
-	p.SetFade(true);
+	world._decals.Add({ GetPos(), vrand(1), PARTICLE_BIGBLAST, world.GetTime(), 20.0f });
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -314,10 +312,10 @@ void GC_ExplosionStandard::Init(World &world)
 	SetTimeout(world, 0.03f);
 
 	float duration = 0.32f;
-	world.New<GC_DecalExplosion>(GetPos(), PARTICLE_EXPLOSION1, duration).SetDirection(vrand(1));
+	world._decals.Add({ GetPos(), vrand(1), PARTICLE_EXPLOSION1, world.GetTime(), duration });
 
 	auto &light = world.New<GC_Light>(GetPos(), GC_Light::LIGHT_POINT);
-	light.SetRadius(70 * 5);
+	light.SetRadius(world, 70 * 5);
 	light.SetTimeout(world, duration * 1.5f);
 
 	for(int n = 0; n < 28; ++n)
@@ -332,7 +330,5 @@ void GC_ExplosionStandard::Init(World &world)
 
 		world.New<GC_Particle>(GetPos() + Vec2dDirection(ang) * d, SPEED_SMOKE, PARTICLE_SMOKE, 1.5f, frand(1.0f));
 	}
-	auto &p = world.New<GC_Decal>(GetPos(), PARTICLE_SMALLBLAST, 8.0f);
-	p.SetDirection(vrand(1));
-	p.SetFade(true);
+	world._decals.Add({ GetPos(), vrand(1), PARTICLE_SMALLBLAST, world.GetTime(), 8.0f });
 }
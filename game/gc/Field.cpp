@@ -4,7 +4,6 @@
 #include "inc/gc/WorldCfg.h"
 #include <cassert>
 
-unsigned int FieldCell::_sessionId;
 
 void FieldCell::UpdateProperties(const World& world)
 {
@@ -99,7 +98,6 @@ void Field::Resize(int width, int height)
 				(*this)(x, y)._obstacleFlags = 0xFF;
 		}
 	}
-	FieldCell::_sessionId = 0;
 }
 
 void Field::ProcessObject(const World& world, GC_RigidBodyStatic *object, bool add)
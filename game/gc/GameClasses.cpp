@@ -48,6 +48,17 @@ void GC_Wood::Kill(World &world)
 	GC_MovingObject::Kill(world);
 }
 
+void GC_Wood::Serialize(World &world, SaveFile &f)
+{
+	GC_MovingObject::Serialize(world, f);
+
+	int tileIndex = world.GetTileIndex(GetPos());
+	if (f.loading() && -1 != tileIndex)
+	{
+		world._woodTiles[tileIndex] = true;
+	}
+}
+
 
 static const int dx[8] = {   1,   1,   0,  -1,  -1,  -1,   0,   1 };
 static const int dy[8] = {   0,   1,   1,   1,   0,  -1,  -1,  -1 };
@@ -135,8 +146,7 @@ void GC_HealthDaemon::TimeStep(World &world, float dt)
 {
 	if (_victim)
 	{
-		// FIXME: depending on processing order this object
-		//        may one time step lag behind
+		// followers step after rigid bodies, so the victim has already moved
 		MoveTo(world, _victim->GetPos());
 
 		_time -= dt;
@@ -14,8 +14,22 @@ IMPLEMENT_SELF_REGISTRATION(GC_Light)
 
 IMPLEMENT_1LIST_MEMBER(GC_MovingObject, GC_Light, LIST_lights);
 
+static void LeaveCell(PtrList<GC_Object> &cell, GC_Light *light)
+{
+	for (auto id = cell.begin(); id != cell.end(); id = cell.next(id))
+	{
+		if (cell.at(id) == light)
+		{
+			cell.erase(id);
+			return;
+		}
+	}
+	assert(false);
+}
+
 GC_Light::GC_Light(vec2d pos, enumLightType type)
 	: GC_MovingObject(pos)
+	, _cells()
 	, _startTime(-FLT_MAX)
 	, _timeout(0)
 	, _aspect(1)
@@ -30,6 +44,7 @@ GC_Light::GC_Light(vec2d pos, enumLightType type)
 
 GC_Light::GC_Light(FromFile)
 	: GC_MovingObject(FromFile())
+	, _cells()
 {
 }
 
@@ -49,12 +64,90 @@ void GC_Light::Serialize(World &world, SaveFile &f)
 	f.Serialize(_timeout);
 	f.Serialize(_startTime);
 	f.Serialize(_type);
+
+	if (f.loading())
+		UpdateCells(world);
+}
+
+void GC_Light::Init(World &world)
+{
+	GC_MovingObject::Init(world);
+	UpdateCells(world);
+}
+
+void GC_Light::Kill(World &world)
+{
+	for (int y = _cells.top; y < _cells.bottom; ++y)
+	for (int x = _cells.left; x < _cells.right; ++x)
+		LeaveCell(world.grid_lights.element(x, y), this);
+	_cells = {};
+	GC_MovingObject::Kill(world);
+}
+
+void GC_Light::MoveTo(World &world, const vec2d &pos)
+{
+	GC_MovingObject::MoveTo(world, pos);
+	UpdateCells(world);
+}
+
+void GC_Light::SetRadius(World &world, float r)
+{
+	if( LIGHT_DIRECT == _type )
+		_offset = r;
+	else
+		_radius = r;
+	UpdateCells(world);
+}
+
+void GC_Light::SetOffset(World &world, float o)
+{
+	assert(LIGHT_DIRECT != _type);
+	_offset = o;
+	UpdateCells(world);
+}
+
+void GC_Light::SetLength(World &world, float l)
+{
+	assert(LIGHT_DIRECT == _type);
+	_radius = l;
+	UpdateCells(world);
+}
+
+void GC_Light::UpdateCells(World &world)
+{
+	float r = GetRenderRadius();
+	RectRB cells = RectClamp(RectRB{
+		(int)std::floor((GetPos().x - r) / WORLD_LOCATION_SIZE),
+		(int)std::floor((GetPos().y - r) / WORLD_LOCATION_SIZE),
+		(int)std::floor((GetPos().x + r) / WORLD_LOCATION_SIZE) + 1,
+		(int)std::floor((GetPos().y + r) / WORLD_LOCATION_SIZE) + 1 }, world.GetLocationBounds());
+
+	if (cells.left == _cells.left && cells.top == _cells.top &&
+	    cells.right == _cells.right && cells.bottom == _cells.bottom)
+	{
+		return;
+	}
+
+	// only touch the cells that actually changed
+	for (int y = _cells.top; y < _cells.bottom; ++y)
+	for (int x = _cells.left; x < _cells.right; ++x)
+	{
+		if (!PtInRect(cells, x, y))
+			LeaveCell(world.grid_lights.element(x, y), this);
+	}
+	for (int y = cells.top; y < cells.bottom; ++y)
+	for (int x = cells.left; x < cells.right; ++x)
+	{
+		if (!PtInRect(_cells, x, y))
+			world.grid_lights.element(x, y).insert(this);
+	}
+	_cells = cells;
 }
 
 void GC_Light::SetTimeout(World &world, float t)
 {
 	assert(t >= 0);
-	assert(!CheckFlags(GC_FLAG_LIGHT_FADE));
+	assert(!CheckFlags(GC_FLAG_LIGHT_FADE | GC_FLAG_LIGHT_STATIC));
 	SetFlags(GC_FLAG_LIGHT_FADE, true);
 	_startTime = world.GetTime();
 	_timeout = t;
@@ -71,6 +164,12 @@ void GC_Light::SetActive(bool activate)
 	SetFlags(GC_FLAG_LIGHT_ACTIVE, activate);
 }
 
+void GC_Light::SetStatic(bool isStatic)
+{
+	assert(!isStatic || !CheckFlags(GC_FLAG_LIGHT_FADE));
+	SetFlags(GC_FLAG_LIGHT_STATIC, isStatic);
+}
+
 /////////////////////////////////////////////////////////////
 
 IMPLEMENT_SELF_REGISTRATION(GC_Spotlight)
@@ -98,10 +197,11 @@ void GC_Spotlight::Init(World &world)
 {
 	GC_MovingObject::Init(world);
 	_light = &world.New<GC_Light>(GetPos() + GetDirection() * 7, GC_Light::LIGHT_SPOT);
+	_light->SetStatic(true);
 	_light->SetActive(CheckFlags(GC_FLAG_SPOTLIGHT_ACTIVE));
-	_light->SetRadius(200);
+	_light->SetRadius(world, 200);
 	_light->SetIntensity(1.0f);
-	_light->SetOffset(170);
+	_light->SetOffset(world, 170);
 	_light->SetAspect(0.5f);
 	_light->SetLightDirection(GetDirection());
 }
@@ -141,57 +241,25 @@ void GC_Spotlight::MapExchange(MapFile &f)
 	}
 }
 
-PropertySet* GC_Spotlight::NewPropertySet()
-{
-	return new MyPropertySet(this);
-}
-
-GC_Spotlight::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propActive( ObjectProperty::TYPE_INTEGER, "active"  )
-  , _propDir( ObjectProperty::TYPE_FLOAT, "dir" )
-{
-	_propActive.SetIntRange(0, 1);
-	_propDir.SetFloatRange(0, PI2);
-}
-
-int GC_Spotlight::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 2;
-}
-
-ObjectProperty* GC_Spotlight::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propActive;
-    case 1: return &_propDir;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Spotlight::MyPropertySet::MyExchange(World &world, bool applyToObject)
+IMPLEMENT_PROPERTY_TABLE(GC_MovingObject, GC_Spotlight)
 {
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Spotlight *tmp = static_cast<GC_Spotlight *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->_light->SetActive(0 != _propActive.GetIntValue());
-		tmp->SetFlags(GC_FLAG_SPOTLIGHT_ACTIVE, 0 != _propActive.GetIntValue());
-		tmp->SetDirection(Vec2dDirection(_propDir.GetFloatValue()));
-		tmp->_light->SetLightDirection(tmp->GetDirection());
-		tmp->_light->MoveTo(world, tmp->GetPos() + tmp->GetDirection() * 7);
-	}
-	else
-	{
-		_propActive.SetIntValue(tmp->_light->GetActive() ? 1 : 0);
-		_propDir.SetFloatValue(tmp->GetDirection().Angle());
-	}
+	return {
+		IntProperty("active", 0, 1,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Spotlight&>(obj)._light->GetActive() ? 1 : 0; },
+			[](GC_Object &obj, World &, int value)
+			{
+				auto &spotlight = static_cast<GC_Spotlight&>(obj);
+				spotlight._light->SetActive(0 != value);
+				spotlight.SetFlags(GC_FLAG_SPOTLIGHT_ACTIVE, 0 != value);
+			}),
+		FloatProperty("dir", 0, PI2,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Spotlight&>(obj).GetDirection().Angle(); },
+			[](GC_Object &obj, World &world, float value)
+			{
+				auto &spotlight = static_cast<GC_Spotlight&>(obj);
+				spotlight.SetDirection(Vec2dDirection(value));
+				spotlight._light->SetLightDirection(spotlight.GetDirection());
+				spotlight._light->MoveTo(world, spotlight.GetPos() + spotlight.GetDirection() * 7);
+			}),
+	};
 }
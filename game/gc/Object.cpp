@@ -4,48 +4,112 @@
 #include "inc/gc/SaveFile.h"
 #include <MapFile.h>
 
-PropertySet::PropertySet(GC_Object *object)
-	: _object(*object)
-	, _propName(ObjectProperty::TYPE_STRING, "name")
+PropertySet::PropertySet(GC_Object &object, const PropertyTable &table)
+	: _object(object)
+	, _table(table)
 {
+	_properties.reserve(table.GetCount());
+	for( int i = 0; i < table.GetCount(); ++i )
+	{
+		const PropertyDesc &desc = table.GetProperty(i);
+		_properties.emplace_back(desc.type, std::string(desc.name));
+		ObjectProperty &prop = _properties.back();
+		switch( desc.type )
+		{
+		case ObjectProperty::TYPE_INTEGER:
+			prop.SetIntRange(desc.intMin, desc.intMax);
+			break;
+		case ObjectProperty::TYPE_FLOAT:
+			prop.SetFloatRange(desc.floatMin, desc.floatMax);
+			break;
+		case ObjectProperty::TYPE_MULTISTRING:
+			for( unsigned int item = 0; desc.listItem(item); ++item )
+				prop.AddItem(desc.listItem(item));
+			break;
+		default:
+			break;
+		}
+	}
 }
 
 int PropertySet::GetCount() const
 {
-	return 1;  // name
+	return static_cast<int>(_properties.size());
 }
 
 ObjectProperty* PropertySet::GetProperty(int index)
 {
 	assert(index < GetCount());
-	return &_propName;
+	return &_properties[index];
 }
 
-void PropertySet::MyExchange(World &world, bool applyToObject)
+void PropertySet::Exchange(World &world, bool applyToObject)
 {
-	if( applyToObject )
+	for( int pass = 0; pass < 2; ++pass )
+	for( int i = 0; i < GetCount(); ++i )
 	{
-		auto newName = _propName.GetStringValue();
-		GC_Object* found = world.FindObject(newName);
-		if( found && GetObject() != found )
+		const PropertyDesc &desc = _table.GetProperty(i);
+		if( desc.applyLast != (pass == 1) )
+			continue;
+		ObjectProperty &prop = _properties[i];
+		switch( desc.type )
 		{
-//			_logger.Format(1) << "object with name \"" << newName << "\" already exists";
-		}
-		else
-		{
-			GetObject()->SetName(world, std::string(newName));
+		case ObjectProperty::TYPE_INTEGER:
+			if( applyToObject )
+				desc.setInt(_object, world, prop.GetIntValue());
+			else
+				prop.SetIntValue(desc.getInt(_object, world));
+			break;
+		case ObjectProperty::TYPE_FLOAT:
+			if( applyToObject )
+				desc.setFloat(_object, world, prop.GetFloatValue());
+			else
+				prop.SetFloatValue(desc.getFloat(_object, world));
+			break;
+		case ObjectProperty::TYPE_STRING:
+		case ObjectProperty::TYPE_SKIN:
+		case ObjectProperty::TYPE_TEXTURE:
+			if( applyToObject )
+				desc.setString(_object, world, prop.GetStringValue());
+			else
+				prop.SetStringValue(std::string(desc.getString(_object, world)));
+			break;
+		case ObjectProperty::TYPE_MULTISTRING:
+			if( applyToObject )
+				desc.setInt(_object, world, static_cast<int>(prop.GetCurrentIndex()));
+			else
+				prop.SetCurrentIndex(desc.getInt(_object, world));
+			break;
+		default:
+			assert(false);
 		}
 	}
-	else
-	{
-		auto name = GetObject()->GetName(world);
-		_propName.SetStringValue(std::string(name));
-	}
 }
 
-void PropertySet::Exchange(World &world, bool applyToObject)
+const PropertyTable& GC_Object::GetPropertyTableStatic()
+{
+	static const PropertyTable table(nullptr, {
+		StringProperty("name",
+			[](const GC_Object &obj, World &world) { return obj.GetName(world); },
+			[](GC_Object &obj, World &world, std::string_view value)
+			{
+				GC_Object* found = world.FindObject(value);
+				if( found && &obj != found )
+				{
+//					_logger.Format(1) << "object with name \"" << value << "\" already exists";
+				}
+				else
+				{
+					obj.SetName(world, std::string(value));
+				}
+			}),
+	});
+	return table;
+}
+
+const PropertyTable& GC_Object::GetPropertyTable() const
 {
-	MyExchange(world, applyToObject);
+	return GetPropertyTableStatic();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -55,10 +119,12 @@ ObjectList::id_type GC_Object::Register(World &world)
 {
 	assert(ObjectList::id_type() == _posLIST_objects);
 	_posLIST_objects = world.GetList(LIST_objects).insert(this);
+	world.OpenHandle(*this);
 	return _posLIST_objects;
 }
 void GC_Object::Unregister(World &world, ObjectList::id_type pos)
 {
+	world.CloseHandle(pos);
 	world.GetList(LIST_objects).erase(pos);
 }
 
@@ -133,16 +199,11 @@ void GC_Object::SetName(World &world, std::string name)
 
 std::shared_ptr<PropertySet> GC_Object::GetProperties(World &world)
 {
-	std::shared_ptr<PropertySet> ps(NewPropertySet());
+	auto ps = std::make_shared<PropertySet>(*this, GetPropertyTable());
 	ps->Exchange(world, false); // fill property set with data from object
 	return ps;
 }
 
-PropertySet* GC_Object::NewPropertySet()
-{
-	return new MyPropertySet(this);
-}
-
 void GC_Object::MapExchange(MapFile &f)
 {
 }
@@ -120,54 +120,16 @@ void GC_Pickup::MapExchange(MapFile &f)
 	MAP_EXCHANGE_STRING(on_pickup, _scriptOnPickup, "");
 }
 
-PropertySet* GC_Pickup::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_MovingObject, GC_Pickup)
 {
-	return new MyPropertySet(this);
-}
-
-GC_Pickup::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTimeRespawn(ObjectProperty::TYPE_INTEGER, "respawn_time")
-  , _propOnPickup(ObjectProperty::TYPE_STRING, "on_pickup")
-{
-	_propTimeRespawn.SetIntRange(0, 1000000);
-}
-
-int GC_Pickup::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 2;
-}
-
-ObjectProperty* GC_Pickup::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propTimeRespawn; break;
-	case 1: return &_propOnPickup;    break;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Pickup::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Pickup *obj = static_cast<GC_Pickup*>(GetObject());
-	if( applyToObject )
-	{
-		obj->_timeRespawn = (float) _propTimeRespawn.GetIntValue() / 1000.0f;
-		obj->_scriptOnPickup = _propOnPickup.GetStringValue();
-	}
-	else
-	{
-		_propTimeRespawn.SetIntValue(int(obj->_timeRespawn * 1000.0f + 0.5f));
-		_propOnPickup.SetStringValue(obj->_scriptOnPickup);
-	}
+	return {
+		IntProperty("respawn_time", 0, 1000000,
+			[](const GC_Object &obj, World &) { return int(static_cast<const GC_Pickup&>(obj)._timeRespawn * 1000.0f + 0.5f); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Pickup&>(obj)._timeRespawn = (float) value / 1000.0f; }),
+		StringProperty("on_pickup",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Pickup&>(obj)._scriptOnPickup; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Pickup&>(obj)._scriptOnPickup = value; }),
+	};
 }
 
 /////////////////////////////////////////////////////////////
@@ -189,7 +151,7 @@ GC_pu_Health::GC_pu_Health(FromFile)
 {
 }
 
-AIPRIORITY GC_pu_Health::GetPriority(World &world, const GC_Vehicle &veh) const
+AIPRIORITY GC_pu_Health::GetPriority(const World &world, const GC_Vehicle &veh) const
 {
 	if( veh.GetHealth() < veh.GetHealthMax() )
 		return AIP_HEALTH * (veh.GetHealth() / veh.GetHealthMax());
@@ -222,7 +184,7 @@ GC_pu_Mine::GC_pu_Mine(FromFile)
 {
 }
 
-AIPRIORITY GC_pu_Mine::GetPriority(World &world, const GC_Vehicle &veh) const
+AIPRIORITY GC_pu_Mine::GetPriority(const World &world, const GC_Vehicle &veh) const
 {
 	return AIP_NOTREQUIRED;
 }
@@ -259,7 +221,7 @@ GC_pu_Shield::~GC_pu_Shield()
 {
 }
 
-AIPRIORITY GC_pu_Shield::GetPriority(World &world, const GC_Vehicle &veh) const
+AIPRIORITY GC_pu_Shield::GetPriority(const World &world, const GC_Vehicle &veh) const
 {
 	return AIP_SHIELD;
 }
@@ -369,7 +331,7 @@ void GC_pu_Shock::Serialize(World &world, SaveFile &f)
 	f.Serialize(_targetPos);
 }
 
-AIPRIORITY GC_pu_Shock::GetPriority(World &world, const GC_Vehicle &veh) const
+AIPRIORITY GC_pu_Shock::GetPriority(const World &world, const GC_Vehicle &veh) const
 {
 	GC_Vehicle *tmp = FindNearVehicle(world, &veh);
 	if( !tmp ) return AIP_NOTREQUIRED;
@@ -395,7 +357,7 @@ void GC_pu_Shock::Detach(World &world)
 	GC_Pickup::Detach(world);
 }
 
-GC_Vehicle* GC_pu_Shock::FindNearVehicle(World &world, const GC_RigidBodyStatic *ignore) const
+GC_Vehicle* GC_pu_Shock::FindNearVehicle(const World &world, const GC_RigidBodyStatic *ignore) const
 {
 	float min_dist = 20 * WORLD_BLOCK_SIZE;
 
@@ -446,10 +408,10 @@ void GC_pu_Shock::TimeStep(World &world, float dt)
 						_targetPos = pNearTarget->GetPos();
 
 						_light = &world.New<GC_Light>(GetPos(), GC_Light::LIGHT_DIRECT);
-						_light->SetRadius(100);
+						_light->SetRadius(world, 100);
 
 						vec2d tmp = _targetPos - GetPos();
-						_light->SetLength(tmp.len());
+						_light->SetLength(world, tmp.len());
 						_light->SetLightDirection(tmp.Normalize());
 
 						pNearTarget->TakeDamage(world, DamageDesc{ 1000, pNearTarget->GetPos(), _vehicle->GetOwner() });
@@ -508,7 +470,7 @@ void GC_pu_Booster::Serialize(World &world, SaveFile &f)
 	f.Serialize(_weapon);
 }
 
-AIPRIORITY GC_pu_Booster::GetPriority(World &world, const GC_Vehicle &veh) const
+AIPRIORITY GC_pu_Booster::GetPriority(const World &world, const GC_Vehicle &veh) const
 {
 	if( !veh.GetWeapon() )
 	{
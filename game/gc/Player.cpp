@@ -192,107 +192,62 @@ void GC_Player::OnVehicleDestroy(World &world)
 	world.Timeout(*this, PLAYER_RESPAWN_DELAY);
 }
 
-PropertySet* GC_Player::NewPropertySet()
-{
-	return new MyPropertySet(this);
-}
-
-GC_Player::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTeam(      ObjectProperty::TYPE_INTEGER,     "team"    )
-  , _propScore(     ObjectProperty::TYPE_INTEGER,     "score"   )
-  , _propNick(      ObjectProperty::TYPE_STRING,      "nick"    )
-  , _propClass(     ObjectProperty::TYPE_MULTISTRING, "class"   )
-  , _propSkin(      ObjectProperty::TYPE_SKIN,        "skin"    )
-  , _propOnDie(     ObjectProperty::TYPE_STRING,      "on_die"  )
-  , _propOnRespawn( ObjectProperty::TYPE_STRING,      "on_respawn" )
-  , _propVehName(   ObjectProperty::TYPE_STRING,      "vehname" )
-{
-	_propTeam.SetIntRange(0, MAX_TEAMS);
-	_propScore.SetIntRange(INT_MIN, INT_MAX);
-
-	for (unsigned int i = 0; GetVehicleClassName(i); ++i)
-		_propClass.AddItem(GetVehicleClassName(i));
-}
-
-int GC_Player::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 8;
-}
-
-ObjectProperty* GC_Player::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-		case 0: return &_propTeam;
-		case 1: return &_propScore;
-		case 2: return &_propNick;
-		case 3: return &_propClass;
-		case 4: return &_propSkin;
-		case 5: return &_propVehName;
-		case 6: return &_propOnDie;
-		case 7: return &_propOnRespawn;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Player::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Player *player = static_cast<GC_Player *>(GetObject());
-
-	if( applyToObject )
-	{
-		player->SetTeam(_propTeam.GetIntValue());
-		player->SetScore(_propScore.GetIntValue());
-		player->SetNick(std::string(_propNick.GetStringValue()));
-		player->SetClass(std::string(_propClass.GetListValue(_propClass.GetCurrentIndex())));
-		player->SetSkin(std::string(_propSkin.GetStringValue()));
-		player->_scriptOnDie = _propOnDie.GetStringValue();
-		player->_scriptOnRespawn = _propOnRespawn.GetStringValue();
-
-		auto vehName = _propVehName.GetStringValue();
-		if(player->GetVehicle() )
-		{
-			GC_Object* found = world.FindObject(vehName);
-			if( found && player->GetVehicle() != found )
-			{
-//				_logger.Printf(1, "WARNING: object with name \"%s\" already exists", name);
-			}
-			else
+IMPLEMENT_PROPERTY_TABLE(GC_Service, GC_Player)
+{
+	return {
+		IntProperty("team", 0, MAX_TEAMS,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Player&>(obj).GetTeam(); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Player&>(obj).SetTeam(value); }),
+		IntProperty("score", INT_MIN, INT_MAX,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Player&>(obj).GetScore(); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Player&>(obj).SetScore(value); }),
+		StringProperty("nick",
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Player&>(obj).GetNick(); },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Player&>(obj).SetNick(std::string(value)); }),
+		ListProperty("class", GetVehicleClassName,
+			[](const GC_Object &obj, World &)
 			{
-				player->GetVehicle()->SetName(world, std::string(vehName));
-				player->_vehname = vehName;
-			}
-		}
-		else
-		{
-			player->_vehname = vehName;
-		}
-	}
-	else
-	{
-		_propOnRespawn.SetStringValue(player->_scriptOnRespawn);
-		_propOnDie.SetStringValue(player->_scriptOnDie);
-		_propTeam.SetIntValue(player->GetTeam());
-		_propScore.SetIntValue(player->GetScore());
-		_propNick.SetStringValue(std::string(player->GetNick()));
-		_propVehName.SetStringValue(player->_vehname);
-		_propSkin.SetStringValue(std::string(player->GetSkin()));
-
-		for( size_t i = 0; i < _propClass.GetListSize(); ++i )
-		{
-			if( player->GetClass() == _propClass.GetListValue(i) )
+				auto &player = static_cast<const GC_Player&>(obj);
+				for( unsigned int i = 0; GetVehicleClassName(i); ++i )
+				{
+					if( player.GetClass() == GetVehicleClassName(i) )
+						return (int) i;
+				}
+				return 0;
+			},
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Player&>(obj).SetClass(GetVehicleClassName(value)); }),
+		StringProperty("skin",
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Player&>(obj).GetSkin(); },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Player&>(obj).SetSkin(std::string(value)); },
+			ObjectProperty::TYPE_SKIN),
+		StringProperty("vehname",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Player&>(obj)._vehname; },
+			[](GC_Object &obj, World &world, std::string_view value)
 			{
-				_propClass.SetCurrentIndex(i);
-				break;
-			}
-		}
-	}
+				auto &player = static_cast<GC_Player&>(obj);
+				if( player.GetVehicle() )
+				{
+					GC_Object* found = world.FindObject(value);
+					if( found && player.GetVehicle() != found )
+					{
+//						_logger.Printf(1, "WARNING: object with name \"%s\" already exists", name);
+					}
+					else
+					{
+						player.GetVehicle()->SetName(world, std::string(value));
+						player._vehname = value;
+					}
+				}
+				else
+				{
+					player._vehname = value;
+				}
+			}),
+		StringProperty("on_die",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Player&>(obj)._scriptOnDie; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Player&>(obj)._scriptOnDie = value; }),
+		StringProperty("on_respawn",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Player&>(obj)._scriptOnRespawn; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Player&>(obj)._scriptOnRespawn = value; }),
+	};
 }
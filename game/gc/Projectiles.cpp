@@ -102,7 +102,7 @@ static void ApplyHitDamage(World &world, GC_RigidBodyStatic &target, const Damag
 {
 	if( GC_RigidBodyDynamic *dyn = dynamic_cast<GC_RigidBodyDynamic *>(&target) )
 	{
-		dyn->ApplyImpulse(impulse, dd.hit);
+		dyn->ApplyImpulse(world, impulse, dd.hit);
 	}
 	if( dd.damage >= 0 )
 	{
@@ -348,7 +348,7 @@ bool GC_Bullet::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d &hit
 	}
 
 	auto &light = world.New<GC_Light>(hit, GC_Light::LIGHT_POINT);
-	light.SetRadius(50);
+	light.SetRadius(world, 50);
 	light.SetIntensity(0.5f);
 	light.SetTimeout(world, 0.3f);
 
@@ -420,7 +420,7 @@ bool GC_TankBullet::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d
 		}
 
 		auto &light = world.New<GC_Light>(hit, GC_Light::LIGHT_POINT);
-		light.SetRadius(80);
+		light.SetRadius(world, 80);
 		light.SetIntensity(1.5f);
 		light.SetTimeout(world, 0.3f);
 
@@ -478,7 +478,7 @@ bool GC_PlazmaClod::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d
 	}
 
 	auto &light = world.New<GC_Light>(hit, GC_Light::LIGHT_POINT);
-	light.SetRadius(90);
+	light.SetRadius(world, 90);
 	light.SetIntensity(1.5f);
 	light.SetTimeout(world, 0.4f);
 
@@ -524,7 +524,7 @@ GC_BfgCore::~GC_BfgCore()
 void GC_BfgCore::Init(World &world)
 {
 	GC_Projectile::Init(world);
-	_light->SetRadius(WEAP_BFG_RADIUS * 2);
+	_light->SetRadius(world, WEAP_BFG_RADIUS * 2);
 	_target = FindTarget(world);
 }
 
@@ -575,7 +575,7 @@ bool GC_BfgCore::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d &hi
 
 
 	auto &light = world.New<GC_Light>(hit, GC_Light::LIGHT_POINT);
-	light.SetRadius(WEAP_BFG_RADIUS * 3);
+	light.SetRadius(world, WEAP_BFG_RADIUS * 3);
 	light.SetIntensity(1.5f);
 	light.SetTimeout(world, 0.5f);
 
@@ -671,7 +671,7 @@ GC_FireSpark::GC_FireSpark(FromFile)
 void GC_FireSpark::Init(World &world)
 {
 	GC_Projectile::Init(world);
-	_light->SetRadius(0);
+	_light->SetRadius(world, 0);
 	_light->SetIntensity(0.5f);
 }
 
@@ -762,7 +762,7 @@ void GC_FireSpark::SpawnTrailParticle(World &world, const vec2d &pos)
 void GC_FireSpark::TimeStep(World &world, float dt)
 {
 	float R = GetRadius();
-	_light->SetRadius(3*R);
+	_light->SetRadius(world, 3*R);
 
 	R *= 1.5; // for damage calculation
 
@@ -853,7 +853,7 @@ GC_ACBullet::GC_ACBullet(FromFile)
 void GC_ACBullet::Init(World &world)
 {
 	GC_Projectile::Init(world);
-	_light->SetRadius(30);
+	_light->SetRadius(world, 30);
 	_light->SetIntensity(0.6f);
 	_light->SetActive(GetAdvanced());
 }
@@ -870,7 +870,7 @@ bool GC_ACBullet::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d &h
 	}
 
 	auto &light = world.New<GC_Light>(hit + norm * 5.0f, GC_Light::LIGHT_POINT);
-	light.SetRadius(80);
+	light.SetRadius(world, 80);
 	light.SetIntensity(1.5f);
 	light.SetTimeout(world, 0.1f);
 
@@ -914,8 +914,8 @@ void GC_GaussRay::Init(World &world)
 
 	SAFE_KILL(world, _light);
 	_light = &world.New<GC_Light>(GetPos(), GC_Light::LIGHT_DIRECT);
-	_light->SetRadius(64);
-	_light->SetLength(0);
+	_light->SetRadius(world, 64);
+	_light->SetLength(world, 0);
 	_light->SetIntensity(1.5f);
 	_light->SetLightDirection(-GetDirection());
 }
@@ -935,11 +935,9 @@ void GC_GaussRay::Serialize(World &world, SaveFile &f)
 
 void GC_GaussRay::SpawnTrailParticle(World &world, const vec2d &pos)
 {
-	auto &p = world.New<GC_DecalGauss>(pos, GetAdvanced() ? PARTICLE_GAUSS2 : PARTICLE_GAUSS1, 0.2f);
-	p.SetDirection(GetDirection());
-	p.SetFade(true);
+	world._decals.Add({ pos, GetDirection(), GetAdvanced() ? PARTICLE_GAUSS2 : PARTICLE_GAUSS1, world.GetTime(), 0.2f });
 
-	_light->SetLength(_light->GetLength() + GetTrailDensity());
+	_light->SetLength(world, _light->GetLength() + GetTrailDensity());
 }
 
 bool GC_GaussRay::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d &hit, const vec2d &norm, float relativeDepth)
@@ -1038,7 +1036,7 @@ bool GC_Disk::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d &hit,
 		world.New<GC_Particle>(hit, vec2d{}, PARTICLE_EXPLOSION_E, 0.2f).SetDirection(vrand(1));
 
 		auto &light = world.New<GC_Light>(hit, GC_Light::LIGHT_POINT);
-		light.SetRadius(100);
+		light.SetRadius(world, 100);
 		light.SetIntensity(1.5f);
 		light.SetTimeout(world, 0.2f);
 
@@ -1067,7 +1065,7 @@ bool GC_Disk::OnHit(World &world, GC_RigidBodyStatic *object, const vec2d &hit,
 	}
 
 	auto &light = world.New<GC_Light>(hit + norm * 5.0f, GC_Light::LIGHT_POINT);
-	light.SetRadius(70);
+	light.SetRadius(world, 70);
 	light.SetIntensity(1.5f);
 	light.SetTimeout(world, 0.1f);
 
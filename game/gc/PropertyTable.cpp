@@ -0,0 +1,31 @@
+#include "inc/gc/PropertyTable.h"
+#include <algorithm>
+#include <cassert>
+
+PropertyTable::PropertyTable(const PropertyTable *base, std::vector<PropertyDesc> own)
+{
+	if( base )
+		_properties = base->_properties;
+	_properties.insert(_properties.end(), own.begin(), own.end());
+
+	_hashToIndex.reserve(_properties.size());
+	for( int i = 0; i < GetCount(); ++i )
+	{
+		assert(PropertyNameHash(_properties[i].name) == _properties[i].hash);
+		assert(-1 == Find(_properties[i].name)); // duplicate property name
+		auto value = std::make_pair(_properties[i].hash, i);
+		_hashToIndex.insert(std::upper_bound(_hashToIndex.begin(), _hashToIndex.end(), value), value);
+	}
+}
+
+int PropertyTable::Find(std::string_view name) const
+{
+	uint32_t hash = PropertyNameHash(name);
+	auto it = std::lower_bound(_hashToIndex.begin(), _hashToIndex.end(), std::make_pair(hash, -1));
+	for( ; it != _hashToIndex.end() && it->first == hash; ++it )
+	{
+		if( _properties[it->second].name == name )
+			return it->second;
+	}
+	return -1;
+}
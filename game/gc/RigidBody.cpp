@@ -403,62 +403,29 @@ void GC_RigidBodyStatic::Serialize(World &world, SaveFile &f)
 }
 
 
-PropertySet* GC_RigidBodyStatic::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_MovingObject, GC_RigidBodyStatic)
 {
-	return new MyPropertySet(this);
-}
-
-GC_RigidBodyStatic::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propOnDestroy( ObjectProperty::TYPE_STRING,   "on_destroy"  )
-  , _propOnDamage(  ObjectProperty::TYPE_STRING,   "on_damage"   )
-  , _propHealth(    ObjectProperty::TYPE_FLOAT,    "health"      )
-  , _propMaxHealth( ObjectProperty::TYPE_FLOAT,    "max_health"  )
-{
-	_propMaxHealth.SetFloatRange(0, 100000);
-	_propHealth.SetFloatRange(0, 100000);
-}
-
-int GC_RigidBodyStatic::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 4;
-}
-
-ObjectProperty* GC_RigidBodyStatic::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propOnDestroy;
-	case 1: return &_propOnDamage;
-	case 2: return &_propHealth;
-	case 3: return &_propMaxHealth;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_RigidBodyStatic::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_RigidBodyStatic *tmp = static_cast<GC_RigidBodyStatic *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->_scriptOnDestroy = _propOnDestroy.GetStringValue();
-		tmp->_scriptOnDamage  = _propOnDamage.GetStringValue();
-		tmp->SetHealth(std::min(_propMaxHealth.GetFloatValue(), _propHealth.GetFloatValue()),
-                       _propMaxHealth.GetFloatValue());
-	}
-	else
-	{
-		_propHealth.SetFloatValue(tmp->GetHealth());
-		_propMaxHealth.SetFloatValue(tmp->GetHealthMax());
-		_propOnDestroy.SetStringValue(tmp->_scriptOnDestroy);
-		_propOnDamage.SetStringValue(tmp->_scriptOnDamage);
-	}
+	return {
+		StringProperty("on_destroy",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_RigidBodyStatic&>(obj)._scriptOnDestroy; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_RigidBodyStatic&>(obj)._scriptOnDestroy = value; }),
+		StringProperty("on_damage",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_RigidBodyStatic&>(obj)._scriptOnDamage; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_RigidBodyStatic&>(obj)._scriptOnDamage = value; }),
+		// health is clamped to max_health, so it has to see the new maximum
+		ApplyLast(FloatProperty("health", 0, 100000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyStatic&>(obj).GetHealth(); },
+			[](GC_Object &obj, World &, float value)
+			{
+				auto &rbs = static_cast<GC_RigidBodyStatic&>(obj);
+				rbs.SetHealth(std::min(rbs.GetHealthMax(), value), rbs.GetHealthMax());
+			})),
+		FloatProperty("max_health", 0, 100000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyStatic&>(obj).GetHealthMax(); },
+			[](GC_Object &obj, World &, float value)
+			{
+				auto &rbs = static_cast<GC_RigidBodyStatic&>(obj);
+				rbs.SetHealth(std::min(value, rbs.GetHealth()), value);
+			}),
+	};
 }
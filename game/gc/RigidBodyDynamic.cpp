@@ -5,86 +5,66 @@
 #include "inc/gc/WorldEvents.h"
 #include "inc/gc/SaveFile.h"
 #include <MapFile.h>
+#include <tasks/TaskPool.h>
+#include <algorithm>
+#include <future>
 
-GC_RigidBodyDynamic::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propM(ObjectProperty::TYPE_FLOAT, "M")
-  , _propI(ObjectProperty::TYPE_FLOAT, "I")
-  , _propPercussion(ObjectProperty::TYPE_FLOAT, "percussion")
-  , _propFragility(ObjectProperty::TYPE_FLOAT, "fragility")
-  , _propNx(ObjectProperty::TYPE_FLOAT, "Nx")
-  , _propNy(ObjectProperty::TYPE_FLOAT, "Ny")
-  , _propNw(ObjectProperty::TYPE_FLOAT, "Nw")
-  , _propRotation(ObjectProperty::TYPE_FLOAT, "rotation")
+IMPLEMENT_PROPERTY_TABLE(GC_RigidBodyStatic, GC_RigidBodyDynamic)
 {
-	_propM.SetFloatRange(0, 10000);
-	_propI.SetFloatRange(0, 10000);
-	_propPercussion.SetFloatRange(0, 10000);
-	_propFragility.SetFloatRange(0, 10000);
-	_propNx.SetFloatRange(0, 10000);
-	_propNy.SetFloatRange(0, 10000);
-	_propNw.SetFloatRange(0, 10000);
-	_propRotation.SetFloatRange(0, PI2);
+	return {
+		FloatProperty("M", 0, 10000, // mass
+			[](const GC_Object &obj, World &) { auto &rbd = static_cast<const GC_RigidBodyDynamic&>(obj); return rbd._inv_m > 0 ? 1.0f / rbd._inv_m : 0; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._inv_m = value > 0 ? 1.0f / value : 0; }),
+		FloatProperty("I", 0, 10000, // scalar moment of inertia
+			[](const GC_Object &obj, World &) { auto &rbd = static_cast<const GC_RigidBodyDynamic&>(obj); return rbd._inv_i > 0 ? 1.0f / rbd._inv_i : 0; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._inv_i = value > 0 ? 1.0f / value : 0; }),
+		FloatProperty("percussion", 0, 10000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyDynamic&>(obj)._percussion; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._percussion = value; }),
+		FloatProperty("fragility", 0, 10000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyDynamic&>(obj)._fragility; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._fragility = value; }),
+		FloatProperty("Nx", 0, 10000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyDynamic&>(obj)._Nx; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._Nx = value; }),
+		FloatProperty("Ny", 0, 10000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyDynamic&>(obj)._Ny; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._Ny = value; }),
+		FloatProperty("Nw", 0, 10000,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyDynamic&>(obj)._Nw; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj)._Nw = value; }),
+		FloatProperty("rotation", 0, PI2,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_RigidBodyDynamic&>(obj).GetDirection().Angle(); },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_RigidBodyDynamic&>(obj).SetDirection(Vec2dDirection(value)); }),
+	};
 }
 
-int GC_RigidBodyDynamic::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 8;
-}
+///////////////////////////////////////////////////////////////////////////////
 
-ObjectProperty* GC_RigidBodyDynamic::MyPropertySet::GetProperty(int index)
+// sleeping bodies stay registered but leave LIST_timestep
+PtrList<GC_Object>::id_type GC_RigidBodyDynamic::Register(World &world)
 {
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propM;
-	case 1: return &_propI;
-	case 2: return &_propPercussion;
-	case 3: return &_propFragility;
-	case 4: return &_propNx;
-	case 5: return &_propNy;
-	case 6: return &_propNw;
-	case 7: return &_propRotation;
-	}
-
-	assert(false);
-	return nullptr;
+	auto pos = GC_RigidBodyStatic::Register(world);
+	world.ListInsert(LIST_timestep, *this, pos);
+	return pos;
 }
 
-void GC_RigidBodyDynamic::MyPropertySet::MyExchange(World &world, bool applyToObject)
+void GC_RigidBodyDynamic::Unregister(World &world, PtrList<GC_Object>::id_type pos)
 {
-	BASE::MyExchange(world, applyToObject);
-
-	GC_RigidBodyDynamic *tmp = static_cast<GC_RigidBodyDynamic *>(GetObject());
-	if( applyToObject )
-	{
-		tmp->_inv_m = _propM.GetFloatValue() > 0 ? 1.0f / _propM.GetFloatValue() : 0;
-		tmp->_inv_i = _propI.GetFloatValue() > 0 ? 1.0f / _propI.GetFloatValue() : 0;
-		tmp->_percussion = _propPercussion.GetFloatValue();
-		tmp->_fragility = _propFragility.GetFloatValue();
-		tmp->_Nx = _propNx.GetFloatValue();
-		tmp->_Ny = _propNy.GetFloatValue();
-		tmp->_Nw = _propNw.GetFloatValue();
-		tmp->SetDirection(Vec2dDirection(_propRotation.GetFloatValue()));
-	}
-	else
-	{
-		_propM.SetFloatValue(tmp->_inv_m > 0 ? 1.0f / tmp->_inv_m : 0);
-		_propI.SetFloatValue(tmp->_inv_i > 0 ? 1.0f / tmp->_inv_i : 0);
-		_propPercussion.SetFloatValue(tmp->_percussion);
-		_propFragility.SetFloatValue(tmp->_fragility);
-		_propNx.SetFloatValue(tmp->_Nx);
-		_propNy.SetFloatValue(tmp->_Ny);
-		_propNw.SetFloatValue(tmp->_Nw);
-		_propRotation.SetFloatValue(tmp->GetDirection().Angle());
-	}
+	if( !IsSleeping() )
+		world.ListErase(LIST_timestep, *this, pos);
+	GC_RigidBodyStatic::Unregister(world, pos);
 }
 
-///////////////////////////////////////////////////////////////////////////////
+static const float c_sleepLinearVelocity = 4;     // px/s
+static const float c_sleepAngularVelocity = 0.05f; // rad/s
+static const float c_timeToSleep = 1;              // s
 
-IMPLEMENT_1LIST_MEMBER(GC_RigidBodyStatic, GC_RigidBodyDynamic, LIST_timestep);
+static const int c_maxSolverPasses = 128;
+static const float c_solverTolerance = 1e-3f;  // largest impulse of a converged pass
+static const float c_warmStartFactor = 0.8f;   // share of the last frame impulse applied up front
+static const float c_warmStartMinCos = 0.9f;   // normals that turned further are new contacts
+static const float c_damageImpulse = 180;      // contacts with a larger normal impulse deal damage
 
 GC_RigidBodyDynamic::ContactList GC_RigidBodyDynamic::_contacts;
 std::stack<GC_RigidBodyDynamic::ContactList> GC_RigidBodyDynamic::_contactsStack;
@@ -108,6 +88,8 @@ GC_RigidBodyDynamic::GC_RigidBodyDynamic(vec2d pos)
 	, _external_momentum(0)
 	, _external_impulse()
 	, _external_torque(0)
+	, _restTime(0)
+	, _island(-1)
 {
 	if( _glob_parity )
 		SetFlags(GC_FLAG_RBDYMAMIC_PARITY, true);
@@ -115,14 +97,10 @@ GC_RigidBodyDynamic::GC_RigidBodyDynamic(vec2d pos)
 
 GC_RigidBodyDynamic::GC_RigidBodyDynamic(FromFile)
   : GC_RigidBodyStatic(FromFile())
+  , _island(-1)
 {
 }
 
-PropertySet* GC_RigidBodyDynamic::NewPropertySet()
-{
-	return new MyPropertySet(this);
-}
-
 void GC_RigidBodyDynamic::MapExchange(MapFile &f)
 {
 	GC_RigidBodyStatic::MapExchange(f);
@@ -162,6 +140,36 @@ void GC_RigidBodyDynamic::Serialize(World &world, SaveFile &f)
 	f.Serialize(_external_momentum);
 	f.Serialize(_external_impulse);
 	f.Serialize(_external_torque);
+	f.Serialize(_restTime);
+
+	if( f.loading() && IsSleeping() )
+		world.ListErase(LIST_timestep, *this, GetId());
+}
+
+void GC_RigidBodyDynamic::MoveTo(World &world, const vec2d &pos)
+{
+	if( IsSleeping() )
+		Wake(world);
+	GC_RigidBodyStatic::MoveTo(world, pos);
+}
+
+void GC_RigidBodyDynamic::Wake(World &world)
+{
+	if( IsSleeping() )
+	{
+		SetFlags(GC_FLAG_RBDYMAMIC_SLEEPING, false);
+		world.ListInsert(LIST_timestep, *this, GetId());
+	}
+	_restTime = 0;
+}
+
+void GC_RigidBodyDynamic::Sleep(World &world)
+{
+	assert(!IsSleeping());
+	SetFlags(GC_FLAG_RBDYMAMIC_SLEEPING, true);
+	world.ListErase(LIST_timestep, *this, GetId());
+	_lv = {};
+	_av = 0;
 }
 
 float GC_RigidBodyDynamic::GetSpinup() const
@@ -286,23 +294,27 @@ void GC_RigidBodyDynamic::TimeStep(World &world, float dt)
 	assert(!std::isnan(_av));
 	assert(std::isfinite(_av));
 
-	//------------------------------------
-	// collisions
+	if( CanSleep() && _lv.sqr() < c_sleepLinearVelocity * c_sleepLinearVelocity && std::fabs(_av) < c_sleepAngularVelocity )
+		_restTime += dt;
+	else
+		_restTime = 0;
 
-	std::vector<ObjectList*> receive;
-	world.grid_rigid_s.OverlapPoint(receive, GetPos() / WORLD_LOCATION_SIZE);
+	world._movedBodies.push_back(this);
+}
 
-	Contact contact;
-	contact.depth = 0;
-	contact.total_np = 0;
-	contact.total_tp = 0;
-	contact.obj1_d   = this;
+void GC_RigidBodyDynamic::CollectContacts(const World &world, std::vector<DetectedContact> &contacts)
+{
+	std::vector<const PtrList<GC_Object>*> receive;
+	world.grid_rigid_s.OverlapPoint(receive, GetPos() / WORLD_LOCATION_SIZE);
 
+	vec2d origin;
+	vec2d normal;
+	float depth = 0;
 	vec2d myHalfSize{ GetHalfLength(), GetHalfWidth() };
 
 	for( auto rit = receive.begin(); rit != receive.end(); ++rit )
 	{
-		ObjectList *ls = *rit;
+		const PtrList<GC_Object> *ls = *rit;
 		for( auto it = ls->begin(); it != ls->end(); it = ls->next(it) )
 		{
 			GC_RigidBodyStatic *object = (GC_RigidBodyStatic *) ls->at(it);
@@ -311,26 +323,116 @@ void GC_RigidBodyDynamic::TimeStep(World &world, float dt)
 				continue;
 			}
 
-			if( object->IntersectWithRect(myHalfSize, GetPos(), GetDirection(), contact.origin, contact.normal, contact.depth) )
+			if( object->IntersectWithRect(myHalfSize, GetPos(), GetDirection(), origin, normal, depth) )
 			{
-#ifndef NDEBUG
-//				for( int i = 0; i < 4; ++i )
-//				{
-//					DbgLine(object->GetVertex(i), object->GetVertex((i+1)&3));
-//				}
-//				DbgLine(c.o, c.o + c.n * 32, 0x00ff00ff);
-#endif
+				contacts.push_back({ this, object, origin, normal, depth });
+			}
+		}
+	}
+}
 
-				contact.obj2_s = object;
-				contact.obj2_d = PtrDynCast<GC_RigidBodyDynamic>(object);
+void GC_RigidBodyDynamic::DetectCollisions(World &world, TaskPool *taskPool)
+{
+	// Bodies are ordered by grid cell so that each chunk touches a compact part
+	// of the grid. The order depends on positions only, hence merging the chunks
+	// in sequence gives the same contact list for any number of threads.
+	const RectRB &bounds = world.GetLocationBounds();
+	std::vector<std::pair<int, GC_RigidBodyDynamic*>> bodies;
+	bodies.reserve(world._movedBodies.size());
+	for( GC_RigidBodyDynamic *body: world._movedBodies )
+	{
+		if( body )
+		{
+			int x = std::min(std::max((int) std::floor(body->GetPos().x / WORLD_LOCATION_SIZE), bounds.left), bounds.right - 1);
+			int y = std::min(std::max((int) std::floor(body->GetPos().y / WORLD_LOCATION_SIZE), bounds.top), bounds.bottom - 1);
+			bodies.emplace_back((y - bounds.top) * WIDTH(bounds) + (x - bounds.left), body);
+		}
+	}
+	std::stable_sort(bodies.begin(), bodies.end(), [](auto &a, auto &b) { return a.first < b.first; });
 
-				contact.tangent.x =  contact.normal.y;
-				contact.tangent.y = -contact.normal.x;
+	const size_t minBodiesPerChunk = 16;
+	size_t chunkCount = taskPool ? std::min<size_t>(bodies.size() / minBodiesPerChunk, taskPool->GetThreadCount() + 1) : 1;
+	chunkCount = std::max<size_t>(chunkCount, 1);
+	auto &chunkContacts = world._detectedContacts;
+	if( chunkContacts.size() < chunkCount )
+		chunkContacts.resize(chunkCount);
 
-				_contacts.push_back(contact);
-			}
-		}
+	// tasks fill plain pointers only; the ObjPtr columns are built below on this thread
+	auto detect = [&](size_t chunk)
+	{
+		size_t begin = bodies.size() * chunk / chunkCount;
+		size_t end = bodies.size() * (chunk + 1) / chunkCount;
+		std::vector<DetectedContact> &contacts = chunkContacts[chunk];
+		for( size_t i = begin; i < end; ++i )
+			bodies[i].second->CollectContacts(world, contacts);
+	};
+
+	std::vector<std::future<void>> chunks;
+	chunks.reserve(chunkCount - 1);
+	for( size_t chunk = 1; chunk < chunkCount; ++chunk )
+		chunks.push_back(taskPool->Submit([=] { detect(chunk); }));
+	try
+	{
+		detect(0); // the calling thread takes the first chunk
+	}
+	catch( ... )
+	{
+		for( auto &chunk: chunks )
+			chunk.wait();
+		throw;
 	}
+
+	for( auto &chunk: chunks )
+		chunk.wait();
+	for( auto &chunk: chunks )
+		chunk.get();
+
+	for( size_t chunk = 0; chunk < chunkCount; ++chunk )
+	{
+		for( const DetectedContact &dc: chunkContacts[chunk] )
+			_contacts.push_back(dc.obj1, dc.obj2, dc.origin, dc.normal, dc.depth);
+		chunkContacts[chunk].clear();
+	}
+}
+
+void GC_RigidBodyDynamic::ContactList::push_back(GC_RigidBodyDynamic *obj1, GC_RigidBodyStatic *obj2, vec2d origin_, vec2d normal_, float depth_)
+{
+	obj1_d.emplace_back(obj1);
+	obj2_s.emplace_back(obj2);
+	obj2_d.push_back(PtrDynCast<GC_RigidBodyDynamic>(obj2));
+	origin.push_back(origin_);
+	normal.push_back(normal_);
+	depth.push_back(depth_);
+}
+
+void GC_RigidBodyDynamic::ContactList::clear()
+{
+	obj1_d.clear();
+	obj2_s.clear();
+	obj2_d.clear();
+	origin.clear();
+	normal.clear();
+	depth.clear();
+	body1.clear();
+	body2.clear();
+	total_np.clear();
+	warm_np.clear();
+	warm_damage.clear();
+}
+
+void GC_RigidBodyDynamic::ContactList::swap(ContactList &other)
+{
+	obj1_d.swap(other.obj1_d);
+	obj2_s.swap(other.obj2_s);
+	obj2_d.swap(other.obj2_d);
+	origin.swap(other.origin);
+	normal.swap(other.normal);
+	depth.swap(other.depth);
+	body1.swap(other.body1);
+	body2.swap(other.body2);
+	total_np.swap(other.total_np);
+	warm_np.swap(other.warm_np);
+	warm_damage.swap(other.warm_damage);
 }
 
 float GC_RigidBodyDynamic::geta_s(const vec2d &n, const vec2d &c, const GC_RigidBodyStatic *obj) const
@@ -366,89 +468,254 @@ void GC_RigidBodyDynamic::PopState()
 	_contactsStack.pop();
 }
 
+static bool WarmStartLess(const PtrList<GC_Object>::id_type &a1, const PtrList<GC_Object>::id_type &a2,
+                          const PtrList<GC_Object>::id_type &b1, const PtrList<GC_Object>::id_type &b2)
+{
+	return a1 < b1 || (a1 == b1 && a2 < b2);
+}
+
+void GC_RigidBodyDynamic::WarmStartContacts(const World &world)
+{
+	ContactList &c = _contacts;
+	c.warm_np.assign(c.size(), 0);
+	c.warm_damage.assign(c.size(), 0);
+	const auto &cache = world._contactImpulses;
+	if( cache.empty() || !world._warmStartContacts )
+		return;
+
+	for( size_t k = 0; k < c.size(); ++k )
+	{
+		if( !c.body1[k] || !c.body2[k] )
+			continue;
+
+		auto id1 = c.body1[k]->GetId();
+		auto id2 = c.body2[k]->GetId();
+		auto ws = std::lower_bound(cache.begin(), cache.end(), 0, [=](const ContactImpulse &ci, int)
+		{
+			return WarmStartLess(ci.id1, ci.id2, id1, id2);
+		});
+		if( ws != cache.end() && ws->id1 == id1 && ws->id2 == id2 && Vec2dDot(ws->normal, c.normal[k]) > c_warmStartMinCos )
+		{
+			c.warm_np[k] = ws->np * c_warmStartFactor;
+			c.warm_damage[k] = std::max(0.f, c.warm_np[k] - c_damageImpulse);
+			vec2d delta_p = c.normal[k] * c.warm_np[k];
+			c.body1[k]->impulse(c.origin[k], delta_p);
+			if( c.obj2_d[k] )
+				c.obj2_d[k]->impulse(c.origin[k], -delta_p);
+		}
+	}
+}
+
+void GC_RigidBodyDynamic::UpdateWarmStart(World &world)
+{
+	const ContactList &c = _contacts;
+	auto &cache = world._contactImpulses;
+	cache.clear();
+	for( size_t k = 0; k < c.size(); ++k )
+	{
+		float np = c.total_np[k] + c.warm_np[k];
+		if( c.body1[k] && c.body2[k] && np > 0 )
+			cache.push_back({ c.body1[k]->GetId(), c.body2[k]->GetId(), c.normal[k], np });
+	}
+	std::sort(cache.begin(), cache.end(), [](const ContactImpulse &a, const ContactImpulse &b)
+	{
+		return WarmStartLess(a.id1, a.id2, b.id1, b.id2);
+	});
+}
+
 void GC_RigidBodyDynamic::ProcessResponse(World &world)
 {
-	for( int i = 0; i < 128; i++ )
+	ContactList &c = _contacts;
+	const size_t count = c.size();
+
+	for( size_t k = 0; k < count; ++k )
 	{
-		for( ContactList::iterator it = _contacts.begin(); it != _contacts.end(); ++it )
+		if( c.obj1_d[k] && c.obj2_s[k] && c.obj2_d[k] && c.obj2_d[k]->IsSleeping() )
 		{
-			if( !it->obj1_d || !it->obj2_s ) continue;
+			if( c.obj1_d[k]->_restTime > 0 )
+				c.obj2_d[k] = nullptr; // a resting body leans on a sleeping one as on a wall
+			else
+				c.obj2_d[k]->Wake(world);
+		}
+	}
+
+	// bodies die only from damage, so liveness is checked after it instead of on every pass
+	auto updateAlive = [&c, count]()
+	{
+		for( size_t k = 0; k < count; ++k )
+		{
+			c.body1[k] = c.obj1_d[k];
+			c.body2[k] = c.obj2_s[k];
+		}
+	};
+	c.body1.resize(count);
+	c.body2.resize(count);
+	c.total_np.assign(count, 0);
+	updateAlive();
+	WarmStartContacts(world);
+
+	// The warm start is part of the contact impulse, so it counts towards the
+	// damage threshold. Only its share above the threshold is dealt, once; a
+	// solver starting from zero would reach the threshold in small passes first.
+	auto dealDamage = [&world, &c](size_t k, float np)
+	{
+		GC_RigidBodyDynamic *obj1 = c.body1[k];
+		GC_RigidBodyStatic *obj2 = c.body2[k];
+		GC_RigidBodyDynamic *obj2_d = c.obj2_d[k];
+		np += c.warm_damage[k];
+		c.warm_damage[k] = 0;
+
+		// store some data since obj1 may die
+		GC_Player *owner1 = obj1->GetOwner();
+		float percussion1 = obj1->_percussion;
+		if( obj2_d )
+		{
+			GC_Player *owner2 = obj2_d->GetOwner();
+			obj1->TakeDamage(world, DamageDesc{np/60 * obj2_d->_percussion * obj1->_fragility, c.origin[k], owner2});
+			obj2_d->TakeDamage(world, DamageDesc{np/60 * percussion1 * obj2_d->_fragility, c.origin[k], owner1});
+		}
+		else
+		{
+			obj1->TakeDamage(world, DamageDesc{np/60 * obj1->_fragility, c.origin[k], owner1});
+			obj2->TakeDamage(world, DamageDesc{np/60 * percussion1, c.origin[k], owner1});
+		}
+	};
+
+	world._solverPasses = 0;
+	for( int i = 0; i < c_maxSolverPasses; i++ )
+	{
+		float maxImpulse = 0;
+		for( size_t k = 0; k < count; ++k )
+		{
+			GC_RigidBodyDynamic *obj1 = c.body1[k];
+			GC_RigidBodyStatic *obj2 = c.body2[k];
+			if( !obj1 || !obj2 ) continue;
+			GC_RigidBodyDynamic *obj2_d = c.obj2_d[k];
 
 			float a;
-			if( it->obj2_d )
-				a = 0.65f * it->obj1_d->geta_d(it->normal, it->origin, it->obj2_d);
+			if( obj2_d )
+				a = 0.65f * obj1->geta_d(c.normal[k], c.origin[k], obj2_d);
 			else
-				a = 0.65f * it->obj1_d->geta_s(it->normal, it->origin, it->obj2_s);
+				a = 0.65f * obj1->geta_s(c.normal[k], c.origin[k], obj2);
 
 			if( a >= 0 )
 			{
 				a = std::max(0.01f * (float) (i>>2), a);
-				it->total_np += a;
+				c.total_np[k] += a;
 
-				float nd = it->total_np/60;
-				if( nd > 3 )
+				if( c.total_np[k] + c.warm_np[k] > c_damageImpulse )
 				{
-					// store some data since obj1 may die
-					GC_Player *owner1 = it->obj1_d->GetOwner();
-					float percussion1 = it->obj1_d->_percussion;
-					if( it->obj2_d )
-					{
-						GC_Player *owner2 = it->obj2_d->GetOwner();
-						it->obj1_d->TakeDamage(world, DamageDesc{a/60 * it->obj2_d->_percussion * it->obj1_d->_fragility, it->origin, owner2});
-						it->obj2_d->TakeDamage(world, DamageDesc{a/60 * percussion1 * it->obj2_d->_fragility, it->origin, owner1});
-					}
-					else
-					{
-						it->obj1_d->TakeDamage(world, DamageDesc{a/60 * it->obj1_d->_fragility, it->origin, owner1});
-						it->obj2_s->TakeDamage(world, DamageDesc{a/60 * percussion1, it->origin, owner1});
-					}
+					dealDamage(k, a);
+					updateAlive();
 				}
 
-				if( !it->obj1_d || !it->obj2_s )
+				if( !c.body1[k] || !c.body2[k] )
 					a *= 0.1f;
 
-				vec2d delta_p = it->normal * (a + it->depth);
-				if( it->obj1_d )
-					it->obj1_d->impulse(it->origin, delta_p);
-				if( it->obj2_s && it->obj2_d )
-					it->obj2_d->impulse(it->origin, -delta_p);
-
-
-				//
-				// friction
-				//
-#if 0
-				const float N = 0.1f;
+				vec2d delta_p = c.normal[k] * (a + c.depth[k]);
+				if( c.body1[k] )
+					obj1->impulse(c.origin[k], delta_p);
+				if( c.body2[k] && obj2_d )
+					obj2_d->impulse(c.origin[k], -delta_p);
+				maxImpulse = std::max(maxImpulse, a + c.depth[k]);
+			}
+			else if( c.warm_np[k] > 0 && 0 == c.total_np[k] )
+			{
+				// take back the part of the warm start that the contact did not need;
+				// once a pass has pushed the contact, taking back would undo that push
+				float r = std::min(-a, c.warm_np[k]);
+				c.warm_np[k] -= r;
+				c.warm_damage[k] = std::max(0.f, c.warm_np[k] - c_damageImpulse);
+				vec2d delta_p = c.normal[k] * -r;
+				obj1->impulse(c.origin[k], delta_p);
+				if( obj2_d )
+					obj2_d->impulse(c.origin[k], -delta_p);
+				maxImpulse = std::max(maxImpulse, r);
+			}
+		}
 
-				float maxb;
-				if( it->obj2_d )
-					maxb = it->obj1_d->geta_d(it->t, it->o, it->obj2_d) / 2;
-				else
-					maxb = it->obj1_d->geta_s(it->t, it->o, it->obj2_s) / 2;
+		world._solverPasses = i + 1;
+		if( maxImpulse < c_solverTolerance )
+			break;
+	}
 
-				float signb = maxb > 0 ? 1.0f : -1.0f;
-				if( (maxb = fabsf(maxb)) > 0 )
-				{
-					float b = std::min(maxb, a*N);
-					it->total_tp += b;
-					delta_p = it->t * b * signb;
-					it->obj1_d->impulse(it->o,  delta_p);
-					if( it->obj2_d ) it->obj2_d->impulse(it->o, -delta_p);
-				}
-#endif
-			}
+	// contacts held by the warm start alone never reached the threshold in a pass
+	for( size_t k = 0; k < count; ++k )
+	{
+		if( c.warm_damage[k] > 0 && c.body1[k] && c.body2[k] )
+		{
+			dealDamage(k, 0);
+			updateAlive();
 		}
 	}
 
-	for( ContactList::const_iterator it = _contacts.begin(); it != _contacts.end(); ++it )
+	for( size_t k = 0; k < count; ++k )
 	{
+		// tangential impulses are not solved
+		float np = c.total_np[k] + c.warm_np[k];
 		for( auto ls: world.eGC_RigidBodyDynamic._listeners )
-			ls->OnContact(it->origin, it->total_np, it->total_tp);
+			ls->OnContact(c.origin[k], np, 0);
+		world.eContacts.Push(ContactEvent{ c.origin[k], np, 0 });
 	}
 
+	UpdateWarmStart(world);
+	UpdateIslands(world);
 	_contacts.clear();
 }
 
+void GC_RigidBodyDynamic::UpdateIslands(World &world)
+{
+	// union-find over the bodies stepped this frame, joined by their contacts
+	auto &moved = world._movedBodies;
+	std::vector<int> parent(moved.size());
+	for( size_t i = 0; i < moved.size(); ++i )
+	{
+		parent[i] = (int) i;
+		if( moved[i] )
+			moved[i]->_island = (int) i;
+	}
+
+	auto find = [&](int i)
+	{
+		while( parent[i] != i )
+			i = parent[i] = parent[parent[i]];
+		return i;
+	};
+
+	const ContactList &c = _contacts;
+	for( size_t k = 0; k < c.size(); ++k )
+	{
+		if( c.body1[k] && c.body2[k] && c.obj2_d[k] && c.body1[k]->_island >= 0 && c.obj2_d[k]->_island >= 0 )
+		{
+			int a = find(c.body1[k]->_island);
+			int b = find(c.obj2_d[k]->_island);
+			parent[std::max(a, b)] = std::min(a, b);
+		}
+	}
+
+	// an island falls asleep only when all of its bodies have been resting long enough
+	std::vector<bool> awake(moved.size());
+	for( size_t i = 0; i < moved.size(); ++i )
+	{
+		if( GC_RigidBodyDynamic *body = moved[i] )
+		{
+			if( body->_restTime < c_timeToSleep )
+				awake[find((int) i)] = true;
+		}
+	}
+
+	for( size_t i = 0; i < moved.size(); ++i )
+	{
+		if( GC_RigidBodyDynamic *body = moved[i] )
+		{
+			body->_island = -1;
+			if( !awake[find((int) i)] )
+				body->Sleep(world);
+		}
+	}
+	moved.clear();
+}
+
 void GC_RigidBodyDynamic::impulse(const vec2d &origin, const vec2d &impulse)
 {
 	_lv += impulse * _inv_m;
@@ -456,37 +723,43 @@ void GC_RigidBodyDynamic::impulse(const vec2d &origin, const vec2d &impulse)
 	assert(!std::isnan(_av) && std::isfinite(_av));
 }
 
-void GC_RigidBodyDynamic::ApplyTorque(float torque)
+void GC_RigidBodyDynamic::ApplyTorque(World &world, float torque)
 {
+	Wake(world);
 	_external_torque += torque;
 	assert(!std::isnan(_external_torque) && std::isfinite(_external_torque));
 }
 
-void GC_RigidBodyDynamic::ApplyForce(const vec2d &force)
+void GC_RigidBodyDynamic::ApplyForce(World &world, const vec2d &force)
 {
+	Wake(world);
 	_external_force += force;
 }
 
-void GC_RigidBodyDynamic::ApplyForce(const vec2d &force, const vec2d &origin)
+void GC_RigidBodyDynamic::ApplyForce(World &world, const vec2d &force, const vec2d &origin)
 {
+	Wake(world);
 	_external_force += force;
 	_external_torque += (origin.x-GetPos().x)*force.y-(origin.y-GetPos().y)*force.x;
 }
 
-void GC_RigidBodyDynamic::ApplyImpulse(const vec2d &impulse, const vec2d &origin)
+void GC_RigidBodyDynamic::ApplyImpulse(World &world, const vec2d &impulse, const vec2d &origin)
 {
+	Wake(world);
 	_external_impulse += impulse;
 	_external_momentum  += (origin.x-GetPos().x)*impulse.y-(origin.y-GetPos().y)*impulse.x;
 	assert(!std::isnan(_external_torque) && std::isfinite(_external_torque));
 }
 
-void GC_RigidBodyDynamic::ApplyImpulse(const vec2d &impulse)
+void GC_RigidBodyDynamic::ApplyImpulse(World &world, const vec2d &impulse)
 {
+	Wake(world);
 	_external_impulse += impulse;
 }
 
-void GC_RigidBodyDynamic::ApplyMomentum(float momentum)
+void GC_RigidBodyDynamic::ApplyMomentum(World &world, float momentum)
 {
+	Wake(world);
 	_external_momentum += momentum;
 	assert(!std::isnan(_external_momentum) && std::isfinite(_external_momentum));
 }
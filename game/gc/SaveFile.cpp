@@ -1,7 +1,8 @@
 #include "inc/gc/SaveFile.h"
 
 SaveFile::SaveFile(FS::Stream &s, bool loading)
-  : _stream(s)
+  : _indexToPtr(1) // id 0 is reserved for null
+  , _stream(s)
   , _load(loading)
 {
 }
@@ -9,8 +10,27 @@ SaveFile::SaveFile(FS::Stream &s, bool loading)
 void SaveFile::RegPointer(GC_Object *ptr)
 {
 	assert(!_ptrToIndex.count(ptr));
-	_ptrToIndex[ptr] = _indexToPtr.size();
-	_indexToPtr.push_back(ptr);
+	if( _freeIndices.empty() )
+	{
+		_ptrToIndex[ptr] = _indexToPtr.size();
+		_indexToPtr.push_back(ptr);
+	}
+	else
+	{
+		// both ends of a snapshot stream free and register in the same order
+		_ptrToIndex[ptr] = _freeIndices.back();
+		_indexToPtr[_freeIndices.back()] = ptr;
+		_freeIndices.pop_back();
+	}
+}
+
+void SaveFile::UnregPointer(GC_Object *ptr)
+{
+	auto it = _ptrToIndex.find(ptr);
+	assert(_ptrToIndex.end() != it);
+	_indexToPtr[it->second] = nullptr;
+	_freeIndices.push_back(it->second);
+	_ptrToIndex.erase(it);
 }
 
 size_t SaveFile::GetPointerId(GC_Object *ptr) const
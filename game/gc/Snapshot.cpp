@@ -0,0 +1,485 @@
+#include "inc/gc/Snapshot.h"
+#include "inc/gc/MovingObject.h"
+#include "inc/gc/RigidBodyDynamic.h"
+#include "inc/gc/SaveFile.h"
+#include "inc/gc/TypeSystem.h"
+#include "inc/gc/World.h"
+#include "inc/gc/WorldCfg.h"
+#include <fs/FileSystem.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+	enum SnapshotKind : uint8_t
+	{
+		KIND_BASELINE,
+		KIND_DELTA,
+	};
+
+	enum StateField : uint8_t
+	{
+		FIELD_POS       = 0x01,
+		FIELD_DIRECTION = 0x02,
+		FIELD_LV        = 0x04,
+		FIELD_AV        = 0x08,
+		FIELD_HEALTH    = 0x10,
+		FIELD_FLAGS     = 0x20,
+	};
+
+	// bookkeeping bits that each side maintains on its own
+	const uint32_t c_localFlags = GC_FLAG_OBJECT_NAMED | GC_FLAG_MO_INGRIDSET | GC_FLAG_RBDYMAMIC_SLEEPING;
+
+	const size_t c_headerSize = 9; // kind, sequence, raw size
+}
+
+struct SnapshotAccess
+{
+	static float& Time(World &world) { return world._time; }
+	static uint32_t GetFlags(const GC_Object &obj) { return obj._flags; }
+	static void SetFlags(GC_Object &obj, uint32_t flags) { obj._flags = flags; }
+	static void OnNewObject(World &world, GC_Object &obj) { world.OnNewObject(obj); }
+};
+
+namespace detail
+{
+	class SnapshotBuffer final : public FS::Stream
+	{
+	public:
+		std::vector<char> data;
+
+		void Reset()
+		{
+			data.clear();
+			_readPos = 0;
+		}
+
+		// FS::Stream
+		size_t Read(void *dst, size_t size, size_t count) override
+		{
+			size_t n = std::min(count, size ? (data.size() - _readPos) / size : 0);
+			if (n)
+				memcpy(dst, data.data() + _readPos, size * n);
+			_readPos += size * n;
+			return n;
+		}
+		void Write(const void *src, size_t size) override
+		{
+			data.insert(data.end(), static_cast<const char*>(src), static_cast<const char*>(src) + size);
+		}
+		void Seek(long long amount, unsigned int origin) override
+		{
+			assert(SEEK_SET == origin);
+			_readPos = static_cast<size_t>(amount);
+		}
+		long long Tell() const override
+		{
+			return _readPos;
+		}
+
+	private:
+		size_t _readPos = 0;
+	};
+}
+
+static void WriteVarint(FS::Stream &s, uint32_t value)
+{
+	uint8_t buf[5];
+	size_t len = 0;
+	while (value >= 0x80)
+	{
+		buf[len++] = static_cast<uint8_t>(value) | 0x80;
+		value >>= 7;
+	}
+	buf[len++] = static_cast<uint8_t>(value);
+	s.Write(buf, len);
+}
+
+static uint32_t ReadVarint(FS::Stream &s)
+{
+	uint32_t value = 0;
+	for (unsigned int shift = 0; shift < 35; shift += 7)
+	{
+		uint8_t byte;
+		if (1 != s.Read(&byte, 1, 1))
+			throw std::runtime_error("unexpected end of snapshot");
+		value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+	throw std::runtime_error("invalid snapshot varint");
+}
+
+static void WriteSigned(FS::Stream &s, int32_t value)
+{
+	WriteVarint(s, (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+}
+
+static int32_t ReadSigned(FS::Stream &s)
+{
+	uint32_t value = ReadVarint(s);
+	return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+static int32_t Quantize(float value, float scale)
+{
+	return static_cast<int32_t>(std::lround(value * scale));
+}
+
+static SnapshotState GetState(const GC_Object &obj)
+{
+	SnapshotState state = {};
+	state.flags = SnapshotAccess::GetFlags(obj) & ~c_localFlags;
+	if (auto mo = dynamic_cast<const GC_MovingObject*>(&obj))
+	{
+		state.posX = Quantize(mo->GetPos().x, 16);
+		state.posY = Quantize(mo->GetPos().y, 16);
+		float angle = mo->GetDirection().Angle(); // [0, 2pi)
+		state.angle = static_cast<uint16_t>(Quantize(angle, 65536 / PI2) & 0xffff);
+	}
+	if (auto rbs = dynamic_cast<const GC_RigidBodyStatic*>(&obj))
+	{
+		state.health = Quantize(rbs->GetHealth(), 16);
+	}
+	if (auto rbd = dynamic_cast<const GC_RigidBodyDynamic*>(&obj))
+	{
+		state.lvX = Quantize(rbd->_lv.x, 16);
+		state.lvY = Quantize(rbd->_lv.y, 16);
+		state.av = Quantize(rbd->_av, 256);
+	}
+	return state;
+}
+
+static uint8_t GetChangedFields(const SnapshotState &a, const SnapshotState &b)
+{
+	uint8_t mask = 0;
+	if (a.posX != b.posX || a.posY != b.posY)
+		mask |= FIELD_POS;
+	if (a.angle != b.angle)
+		mask |= FIELD_DIRECTION;
+	if (a.lvX != b.lvX || a.lvY != b.lvY)
+		mask |= FIELD_LV;
+	if (a.av != b.av)
+		mask |= FIELD_AV;
+	if (a.health != b.health)
+		mask |= FIELD_HEALTH;
+	if (a.flags != b.flags)
+		mask |= FIELD_FLAGS;
+	return mask;
+}
+
+static void WriteFields(FS::Stream &s, const SnapshotState &state, uint8_t mask)
+{
+	s.Write(&mask, 1);
+	if (mask & FIELD_POS)
+	{
+		WriteSigned(s, state.posX);
+		WriteSigned(s, state.posY);
+	}
+	if (mask & FIELD_DIRECTION)
+		WriteVarint(s, state.angle);
+	if (mask & FIELD_LV)
+	{
+		WriteSigned(s, state.lvX);
+		WriteSigned(s, state.lvY);
+	}
+	if (mask & FIELD_AV)
+		WriteSigned(s, state.av);
+	if (mask & FIELD_HEALTH)
+		WriteSigned(s, state.health);
+	if (mask & FIELD_FLAGS)
+		WriteVarint(s, state.flags);
+}
+
+static void ApplyFields(FS::Stream &s, World &world, GC_Object &obj)
+{
+	uint8_t mask;
+	if (1 != s.Read(&mask, 1, 1))
+		throw std::runtime_error("unexpected end of snapshot");
+
+	auto mo = dynamic_cast<GC_MovingObject*>(&obj);
+	auto rbs = dynamic_cast<GC_RigidBodyStatic*>(&obj);
+	auto rbd = dynamic_cast<GC_RigidBodyDynamic*>(&obj);
+	if (((mask & (FIELD_POS | FIELD_DIRECTION)) && !mo) ||
+	    ((mask & FIELD_HEALTH) && !rbs) ||
+	    ((mask & (FIELD_LV | FIELD_AV)) && !rbd))
+	{
+		throw std::runtime_error("snapshot field does not match object type");
+	}
+
+	if (mask & FIELD_POS)
+	{
+		float x = (float) ReadSigned(s) / 16;
+		float y = (float) ReadSigned(s) / 16;
+		mo->MoveTo(world, vec2d{ x, y });
+	}
+	if (mask & FIELD_DIRECTION)
+	{
+		float angle = (float) ReadVarint(s) * PI2 / 65536;
+		mo->SetDirection(vec2d{ std::cos(angle), std::sin(angle) });
+	}
+	if (mask & FIELD_LV)
+	{
+		float x = (float) ReadSigned(s) / 16;
+		float y = (float) ReadSigned(s) / 16;
+		rbd->_lv = vec2d{ x, y };
+	}
+	if (mask & FIELD_AV)
+		rbd->_av = (float) ReadSigned(s) / 256;
+	if (mask & FIELD_HEALTH)
+		rbs->SetHealth(std::min((float) ReadSigned(s) / 16, rbs->GetHealthMax()));
+	if (mask & FIELD_FLAGS)
+	{
+		uint32_t local = SnapshotAccess::GetFlags(obj) & c_localFlags;
+		SnapshotAccess::SetFlags(obj, (ReadVarint(s) & ~c_localFlags) | local);
+	}
+}
+
+static std::vector<char> Compress(const std::vector<char> &raw, uint8_t kind, uint32_t sequence)
+{
+	uLongf packedSize = compressBound(static_cast<uLong>(raw.size()));
+	std::vector<char> result(c_headerSize + packedSize);
+	uint32_t rawSize = static_cast<uint32_t>(raw.size());
+	result[0] = kind;
+	memcpy(&result[1], &sequence, 4);
+	memcpy(&result[5], &rawSize, 4);
+	if (Z_OK != compress2(reinterpret_cast<Bytef*>(&result[c_headerSize]), &packedSize,
+	                      reinterpret_cast<const Bytef*>(raw.data()), rawSize, Z_BEST_SPEED))
+	{
+		throw std::runtime_error("snapshot compression failed");
+	}
+	result.resize(c_headerSize + packedSize);
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SnapshotEncoder::SnapshotEncoder(World &world)
+	: _world(world)
+	, _buffer(new detail::SnapshotBuffer())
+{
+	_world.eWorld.AddListener(*this);
+}
+
+SnapshotEncoder::~SnapshotEncoder()
+{
+	_world.eWorld.RemoveListener(*this);
+}
+
+std::vector<char> SnapshotEncoder::EncodeBaseline()
+{
+	_buffer->Reset();
+	_pointers.reset(new SaveFile(*_buffer, false /*loading*/));
+
+	RectRB bounds = _world.GetBlockBounds();
+	_pointers->Serialize(bounds);
+	_world.Serialize(*_pointers);
+	_decalsEnd = _world._decals.GetEnd();
+
+	_sent.clear();
+	_new.clear();
+	_killed.clear();
+	ObjectList &objects = _world.GetList(LIST_objects);
+	for (auto it = objects.begin(); it != objects.end(); it = objects.next(it))
+	{
+		GC_Object *obj = objects.at(it);
+		_sent[obj] = GetState(*obj);
+	}
+
+	return Finish(KIND_BASELINE);
+}
+
+std::vector<char> SnapshotEncoder::EncodeDelta()
+{
+	assert(_pointers); // baseline first
+	_buffer->Reset();
+
+	_pointers->Serialize(SnapshotAccess::Time(_world));
+
+	// decals that were overwritten before they could be sent are lost
+	const DecalStore &decals = _world._decals;
+	uint32_t firstDecal = std::max(_decalsEnd, decals.GetBegin());
+	WriteVarint(*_buffer, decals.GetEnd() - firstDecal);
+	for (uint32_t seq = firstDecal; seq != decals.GetEnd(); ++seq)
+		_buffer->Write(&decals.GetDecal(seq), sizeof(Decal));
+	_decalsEnd = decals.GetEnd();
+
+	WriteVarint(*_buffer, static_cast<uint32_t>(_killed.size()));
+	for (uint32_t id: _killed)
+		WriteVarint(*_buffer, id);
+	_killed.clear();
+
+	WriteVarint(*_buffer, static_cast<uint32_t>(_new.size()));
+	for (GC_Object *obj: _new)
+	{
+		WriteVarint(*_buffer, obj->GetType());
+		_pointers->RegPointer(obj);
+	}
+	for (GC_Object *obj: _new)
+	{
+		obj->Serialize(_world, *_pointers);
+		_sent[obj] = GetState(*obj);
+	}
+
+	// objects that were just sent in full are compared against themselves and skipped
+	std::vector<std::pair<GC_Object*, uint8_t>> changed;
+	for (auto &sent: _sent)
+	{
+		SnapshotState state = GetState(*sent.first);
+		if (uint8_t mask = GetChangedFields(sent.second, state))
+		{
+			changed.emplace_back(sent.first, mask);
+			sent.second = state;
+		}
+	}
+	_new.clear();
+
+	WriteVarint(*_buffer, static_cast<uint32_t>(changed.size()));
+	for (auto &c: changed)
+	{
+		WriteVarint(*_buffer, static_cast<uint32_t>(_pointers->GetPointerId(c.first)));
+		WriteFields(*_buffer, _sent[c.first], c.second);
+	}
+
+	return Finish(KIND_DELTA);
+}
+
+std::vector<char> SnapshotEncoder::Finish(uint8_t kind)
+{
+	return Compress(_buffer->data, kind, _sequence++);
+}
+
+void SnapshotEncoder::OnKill(GC_Object &obj)
+{
+	auto it = std::find(_new.begin(), _new.end(), &obj);
+	if (_new.end() != it)
+	{
+		_new.erase(it);
+	}
+	else if (_sent.erase(&obj))
+	{
+		_killed.push_back(static_cast<uint32_t>(_pointers->GetPointerId(&obj)));
+		_pointers->UnregPointer(&obj);
+	}
+}
+
+void SnapshotEncoder::OnClear()
+{
+	_new.clear();
+	for (auto &sent: _sent)
+	{
+		_killed.push_back(static_cast<uint32_t>(_pointers->GetPointerId(sent.first)));
+		_pointers->UnregPointer(sent.first);
+	}
+	_sent.clear();
+	_decalsEnd = 0;
+}
+
+void SnapshotEncoder::OnNewObject(GC_Object &obj)
+{
+	if (_pointers)
+		_new.push_back(&obj);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SnapshotDecoder::SnapshotDecoder()
+	: _buffer(new detail::SnapshotBuffer())
+{
+}
+
+SnapshotDecoder::~SnapshotDecoder()
+{
+}
+
+bool SnapshotDecoder::Apply(const void *data, size_t size)
+{
+	if (size < c_headerSize)
+		throw std::runtime_error("snapshot is too short");
+
+	auto bytes = static_cast<const char*>(data);
+	uint8_t kind = bytes[0];
+	uint32_t sequence;
+	uint32_t rawSize;
+	memcpy(&sequence, bytes + 1, 4);
+	memcpy(&rawSize, bytes + 5, 4);
+
+	if (KIND_BASELINE != kind && (!_synced || sequence != _sequence + 1))
+		return false;
+
+	_buffer->Reset();
+	_buffer->data.resize(rawSize);
+	uLongf unpackedSize = rawSize;
+	if (Z_OK != uncompress(reinterpret_cast<Bytef*>(_buffer->data.data()), &unpackedSize,
+	                       reinterpret_cast<const Bytef*>(bytes + c_headerSize), static_cast<uLong>(size - c_headerSize)) ||
+	    unpackedSize != rawSize)
+	{
+		throw std::runtime_error("corrupted snapshot");
+	}
+
+	if (KIND_BASELINE == kind)
+	{
+		_synced = false;
+		_world.reset();
+		_pointers.reset(new SaveFile(*_buffer, true /*loading*/));
+
+		RectRB bounds;
+		_pointers->Serialize(bounds);
+		_world.reset(new World(bounds, false /*initField*/));
+		_world->Serialize(*_pointers);
+	}
+	else if (KIND_DELTA == kind)
+	{
+		_pointers->Serialize(SnapshotAccess::Time(*_world));
+
+		for (uint32_t count = ReadVarint(*_buffer); count; --count)
+		{
+			Decal decal;
+			if (1 != _buffer->Read(&decal, sizeof(Decal), 1))
+				throw std::runtime_error("unexpected end of snapshot");
+			_world->_decals.Add(decal);
+		}
+
+		for (uint32_t count = ReadVarint(*_buffer); count; --count)
+		{
+			GC_Object *obj = _pointers->RestorePointer(ReadVarint(*_buffer));
+			if (!obj)
+				throw std::runtime_error("snapshot kills unknown object");
+			_pointers->UnregPointer(obj);
+			obj->Kill(*_world);
+		}
+
+		std::vector<GC_Object*> created(ReadVarint(*_buffer));
+		for (GC_Object *&obj: created)
+		{
+			obj = RTTypes::Inst().CreateFromFile(*_world, ReadVarint(*_buffer));
+			if (!obj)
+				throw std::runtime_error("snapshot contains unknown object type");
+			_pointers->RegPointer(obj);
+		}
+		for (GC_Object *obj: created)
+			obj->Serialize(*_world, *_pointers);
+		// listeners see new objects only once all of them are filled in
+		for (GC_Object *obj: created)
+			SnapshotAccess::OnNewObject(*_world, *obj);
+
+		for (uint32_t count = ReadVarint(*_buffer); count; --count)
+		{
+			GC_Object *obj = _pointers->RestorePointer(ReadVarint(*_buffer));
+			if (!obj)
+				throw std::runtime_error("snapshot updates unknown object");
+			ApplyFields(*_buffer, *_world, *obj);
+		}
+	}
+	else
+	{
+		throw std::runtime_error("unknown snapshot kind");
+	}
+
+	_sequence = sequence;
+	_synced = true;
+	return true;
+}
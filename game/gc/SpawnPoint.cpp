@@ -52,54 +52,14 @@ void GC_SpawnPoint::MapExchange(MapFile &f)
 }
 
 
-PropertySet* GC_SpawnPoint::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_MovingObject, GC_SpawnPoint)
 {
-	return new MyPropertySet(this);
-}
-
-GC_SpawnPoint::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTeam( ObjectProperty::TYPE_INTEGER, "team" )
-  , _propDir( ObjectProperty::TYPE_FLOAT, "dir" )
-{
-	_propTeam.SetIntRange(0, MAX_TEAMS - 1);
-	_propDir.SetFloatRange(0, PI2);
-}
-
-int GC_SpawnPoint::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 2;
-}
-
-ObjectProperty* GC_SpawnPoint::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propTeam;
-	case 1: return &_propDir;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_SpawnPoint::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_SpawnPoint *tmp = static_cast<GC_SpawnPoint *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->_team = _propTeam.GetIntValue();
-		tmp->SetDirection(Vec2dDirection(_propDir.GetFloatValue()));
-	}
-	else
-	{
-		_propTeam.SetIntValue(tmp->_team);
-		_propDir.SetFloatValue(tmp->GetDirection().Angle());
-	}
+	return {
+		IntProperty("team", 0, MAX_TEAMS - 1,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_SpawnPoint&>(obj)._team; },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_SpawnPoint&>(obj)._team = value; }),
+		FloatProperty("dir", 0, PI2,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_SpawnPoint&>(obj).GetDirection().Angle(); },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_SpawnPoint&>(obj).SetDirection(Vec2dDirection(value)); }),
+	};
 }
@@ -0,0 +1,55 @@
+#include "inc/gc/detail/TimerWheel.h"
+
+void TimerWheel::Schedule(TimerNode &node, uint32_t tick)
+{
+	assert(!node.IsLinked());
+	// outside of Advance the current tick has already been processed
+	uint32_t first = _firing ? _current : _current + 1;
+	node.tick = (int32_t) (tick - first) < 0 ? first : tick;
+	Insert(node);
+}
+
+void TimerWheel::Restore(int level, int slot, TimerNode &node)
+{
+	assert(!_firing);
+	assert(level >= 0 && level < LEVEL_COUNT && slot >= 0 && slot < SLOT_COUNT);
+	Append(_slots[level][slot], node);
+}
+
+void TimerWheel::Append(TimerNode &slot, TimerNode &node)
+{
+	node.prev = slot.prev;
+	node.next = &slot;
+	slot.prev->next = &node;
+	slot.prev = &node;
+	node._count = &_count;
+	++_count;
+}
+
+void TimerWheel::Insert(TimerNode &node)
+{
+	uint32_t delta = node.tick - _current;
+	int level = 0;
+	while( level < LEVEL_COUNT - 1 && delta >= (1u << (SLOT_BITS * (level + 1))) )
+		++level;
+	Append(_slots[level][(node.tick >> (SLOT_BITS * level)) & (SLOT_COUNT - 1)], node);
+}
+
+// Moves the items of the level slot the current tick has just entered one or
+// more levels down. Returns the slot index; zero means the next level is due too.
+int TimerWheel::Cascade(int level)
+{
+	int index = (_current >> (SLOT_BITS * level)) & (SLOT_COUNT - 1);
+	if( 0 == (_current & ((1u << (SLOT_BITS * level)) - 1)) )
+	{
+		TimerNode &slot = _slots[level][index];
+		while( slot.IsLinked() )
+		{
+			TimerNode *node = slot.next;
+			node->Unlink();
+			Insert(*node);
+		}
+		return index;
+	}
+	return -1;
+}
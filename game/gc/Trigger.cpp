@@ -139,84 +139,34 @@ void GC_Trigger::TimeStep(World &world, float dt)
 	}
 }
 
-PropertySet* GC_Trigger::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_MovingObject, GC_Trigger)
 {
-	return new MyPropertySet(this);
+	return {
+		IntProperty("active", 0, 1,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Trigger&>(obj).CheckFlags(GC_FLAG_TRIGGER_ENABLED) ? 1 : 0; },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Trigger&>(obj).SetFlags(GC_FLAG_TRIGGER_ENABLED, 0 != value); }),
+		IntProperty("only_human", 0, 1,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Trigger&>(obj).CheckFlags(GC_FLAG_TRIGGER_ONLYHUMAN) ? 1 : 0; },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Trigger&>(obj).SetFlags(GC_FLAG_TRIGGER_ONLYHUMAN, 0 != value); }),
+		IntProperty("only_visible", 0, 1,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Trigger&>(obj).CheckFlags(GC_FLAG_TRIGGER_ONLYVISIBLE) ? 1 : 0; },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Trigger&>(obj).SetFlags(GC_FLAG_TRIGGER_ONLYVISIBLE, 0 != value); }),
+		IntProperty("team", 0, MAX_TEAMS,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Trigger&>(obj)._team; },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Trigger&>(obj)._team = value; }),
+		FloatProperty("radius", 0, 100,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Trigger&>(obj)._radius; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_Trigger&>(obj)._radius = value; }),
+		FloatProperty("radius_delta", 0, 100,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Trigger&>(obj)._radiusDelta; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_Trigger&>(obj)._radiusDelta = value; }),
+		StringProperty("on_enter",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Trigger&>(obj)._onEnter; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Trigger&>(obj)._onEnter = value; }),
+		StringProperty("on_leave",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Trigger&>(obj)._onLeave; },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Trigger&>(obj)._onLeave = value; }),
+	};
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-
-GC_Trigger::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propActive(ObjectProperty::TYPE_INTEGER, "active")
-  , _propTeam(ObjectProperty::TYPE_INTEGER, "team")
-  , _propRadius(ObjectProperty::TYPE_FLOAT, "radius")
-  , _propRadiusDelta(ObjectProperty::TYPE_FLOAT, "radius_delta")
-  , _propOnlyVisible(ObjectProperty::TYPE_INTEGER, "only_visible")
-  , _propOnlyHuman(ObjectProperty::TYPE_INTEGER, "only_human")
-  , _propOnEnter(ObjectProperty::TYPE_STRING, "on_enter")
-  , _propOnLeave(ObjectProperty::TYPE_STRING, "on_leave")
-{
-	_propActive.SetIntRange(0, 1);
-	_propOnlyHuman.SetIntRange(0, 1);
-	_propOnlyVisible.SetIntRange(0, 1);
-	_propTeam.SetIntRange(0, MAX_TEAMS);
-	_propRadius.SetFloatRange(0, 100);
-	_propRadiusDelta.SetFloatRange(0, 100);
-}
-
-int GC_Trigger::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 8;
-}
-
-ObjectProperty* GC_Trigger::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-		case 0: return &_propActive;
-		case 1: return &_propOnlyHuman;
-		case 2: return &_propOnlyVisible;
-		case 3: return &_propTeam;
-		case 4: return &_propRadius;
-		case 5: return &_propRadiusDelta;
-		case 6: return &_propOnEnter;
-		case 7: return &_propOnLeave;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Trigger::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Trigger *tmp = static_cast<GC_Trigger *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->SetFlags(GC_FLAG_TRIGGER_ONLYHUMAN, 0!=_propOnlyHuman.GetIntValue());
-		tmp->SetFlags(GC_FLAG_TRIGGER_ONLYVISIBLE, 0!=_propOnlyVisible.GetIntValue());
-		tmp->SetFlags(GC_FLAG_TRIGGER_ENABLED, 0!=_propActive.GetIntValue());
-		tmp->_team = _propTeam.GetIntValue();
-		tmp->_radius = _propRadius.GetFloatValue();
-		tmp->_radiusDelta = _propRadiusDelta.GetFloatValue();
-		tmp->_onEnter = _propOnEnter.GetStringValue();
-		tmp->_onLeave = _propOnLeave.GetStringValue();
-	}
-	else
-	{
-		_propOnlyHuman.SetIntValue(tmp->CheckFlags(GC_FLAG_TRIGGER_ONLYHUMAN) ? 1 : 0);
-		_propOnlyVisible.SetIntValue(tmp->CheckFlags(GC_FLAG_TRIGGER_ONLYVISIBLE) ? 1 : 0);
-		_propActive.SetIntValue(tmp->CheckFlags(GC_FLAG_TRIGGER_ENABLED) ? 1 : 0);
-		_propTeam.SetIntValue(tmp->_team);
-		_propRadius.SetFloatValue(tmp->_radius);
-		_propRadiusDelta.SetFloatValue(tmp->_radiusDelta);
-		_propOnEnter.SetStringValue(tmp->_onEnter);
-		_propOnLeave.SetStringValue(tmp->_onLeave);
-	}
-}
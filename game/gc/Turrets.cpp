@@ -261,61 +261,19 @@ void GC_Turret::Shoot(World &world)
 	OnShoot(world);
 }
 
-PropertySet* GC_Turret::NewPropertySet()
-{
-	return new MyPropertySet(this);
-}
-
-GC_Turret::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTeam(  ObjectProperty::TYPE_INTEGER, "team"  )
-  , _propSight( ObjectProperty::TYPE_INTEGER, "sight" )
-  , _propDir(   ObjectProperty::TYPE_FLOAT,   "dir" )
-{
-	_propTeam.SetIntRange(0, MAX_TEAMS - 1);
-	_propSight.SetIntRange(0, 100);
-	_propDir.SetFloatRange(0, PI2);
-}
-
-int GC_Turret::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 3;
-}
-
-ObjectProperty* GC_Turret::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-		case 0: return &_propTeam;
-		case 1: return &_propSight;
-		case 2: return &_propDir;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Turret::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Turret *tmp = static_cast<GC_Turret *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->_team  = _propTeam.GetIntValue();
-		tmp->_sight = (float) (_propSight.GetIntValue() * WORLD_BLOCK_SIZE);
-		tmp->SetInitialDir(_propDir.GetFloatValue());
-	}
-	else
-	{
-		_propTeam.SetIntValue(tmp->_team);
-		_propSight.SetIntValue(int(tmp->_sight / WORLD_BLOCK_SIZE + 0.5f));
-		_propDir.SetFloatValue(tmp->_initialDir);
-	}
+IMPLEMENT_PROPERTY_TABLE(GC_RigidBodyStatic, GC_Turret)
+{
+	return {
+		IntProperty("team", 0, MAX_TEAMS - 1,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Turret&>(obj)._team; },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Turret&>(obj)._team = value; }),
+		IntProperty("sight", 0, 100,
+			[](const GC_Object &obj, World &) { return int(static_cast<const GC_Turret&>(obj)._sight / WORLD_BLOCK_SIZE + 0.5f); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Turret&>(obj)._sight = (float) (value * WORLD_BLOCK_SIZE); }),
+		FloatProperty("dir", 0, PI2,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Turret&>(obj)._initialDir; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_Turret&>(obj).SetInitialDir(value); }),
+	};
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
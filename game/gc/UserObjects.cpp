@@ -53,53 +53,14 @@ void GC_UserObject::MapExchange(MapFile &f)
 	MAP_EXCHANGE_STRING(texture, _textureName, "");
 }
 
-PropertySet* GC_UserObject::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_RigidBodyStatic, GC_UserObject)
 {
-	return new MyPropertySet(this);
-}
-
-GC_UserObject::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTexture( ObjectProperty::TYPE_TEXTURE, "texture" )
-{
-}
-
-int GC_UserObject::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 1;
-}
-
-ObjectProperty* GC_UserObject::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propTexture;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_UserObject::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_UserObject *tmp = static_cast<GC_UserObject *>(GetObject());
-
-	if( applyToObject )
-	{
-//		world._field.ProcessObject(tmp, false);
-		tmp->SetTextureName(std::string(_propTexture.GetStringValue()));
-//		tmp->AlignToTexture();
-//		world._field.ProcessObject(tmp, true);
-	}
-	else
-	{
-		_propTexture.SetStringValue(tmp->GetTextureName());
-	}
+	return {
+		StringProperty("texture",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_UserObject&>(obj).GetTextureName(); },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_UserObject&>(obj).SetTextureName(std::string(value)); },
+			ObjectProperty::TYPE_TEXTURE),
+	};
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -182,73 +143,26 @@ void GC_Decoration::TimeStep(World &world, float dt)
 	}
 }
 
-PropertySet* GC_Decoration::NewPropertySet()
-{
-	return new MyPropertySet(this);
-}
-
-GC_Decoration::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTexture(ObjectProperty::TYPE_TEXTURE, "texture")
-  , _propLayer(ObjectProperty::TYPE_INTEGER, "layer")
-  , _propAnimate(ObjectProperty::TYPE_FLOAT, "animate")
-  , _propFrame(ObjectProperty::TYPE_INTEGER, "frame")
-  , _propRotation(ObjectProperty::TYPE_FLOAT, "rotation")
-{
-	_propLayer.SetIntRange(0, Z_COUNT-1);
-	_propAnimate.SetFloatRange(0, 100);
-	_propFrame.SetIntRange(0, 1000);
-	_propRotation.SetFloatRange(0, PI2);
-}
-
-int GC_Decoration::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 5;
-}
-
-ObjectProperty* GC_Decoration::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propTexture;
-	case 1: return &_propLayer;
-	case 2: return &_propAnimate;
-	case 3: return &_propFrame;
-	case 4: return &_propRotation;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Decoration::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Decoration *tmp = static_cast<GC_Decoration *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->SetTextureName(std::string(_propTexture.GetStringValue()));
-		tmp->SetZ((enumZOrder) _propLayer.GetIntValue());
-//		tmp->SetFrame(_propFrame.GetIntValue() % tmp->GetFrameCount());
-		tmp->SetDirection(Vec2dDirection(_propRotation.GetFloatValue()));
-		tmp->_frameRate = _propAnimate.GetFloatValue();
-
-        // TODO: animation
-//		tmp->SetEvents(world, tmp->_frameRate > 0 ? GC_FLAG_OBJECT_EVENTS_TS_FIXED : 0);
-	}
-	else
-	{
-		_propTexture.SetStringValue(tmp->GetTextureName());
-		_propLayer.SetIntValue(tmp->GetZ());
-		_propRotation.SetFloatValue(tmp->GetDirection().Angle());
-		_propFrame.SetIntValue(0); //tmp->GetCurrentFrame());
-		_propAnimate.SetFloatValue(tmp->_frameRate);
-	}
+IMPLEMENT_PROPERTY_TABLE(GC_MovingObject, GC_Decoration)
+{
+	return {
+		StringProperty("texture",
+			[](const GC_Object &obj, World &) -> std::string_view { return static_cast<const GC_Decoration&>(obj).GetTextureName(); },
+			[](GC_Object &obj, World &, std::string_view value) { static_cast<GC_Decoration&>(obj).SetTextureName(std::string(value)); },
+			ObjectProperty::TYPE_TEXTURE),
+		IntProperty("layer", 0, Z_COUNT - 1,
+			[](const GC_Object &obj, World &) { return (int) static_cast<const GC_Decoration&>(obj).GetZ(); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Decoration&>(obj).SetZ((enumZOrder) value); }),
+		FloatProperty("animate", 0, 100,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Decoration&>(obj)._frameRate; },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_Decoration&>(obj)._frameRate = value; }),
+		IntProperty("frame", 0, 1000,
+			[](const GC_Object &obj, World &) { return 0; }, // TODO: animation
+			[](GC_Object &obj, World &, int value) {}),
+		FloatProperty("rotation", 0, PI2,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Decoration&>(obj).GetDirection().Angle(); },
+			[](GC_Object &obj, World &, float value) { static_cast<GC_Decoration&>(obj).SetDirection(Vec2dDirection(value)); }),
+	};
 }
 
 // end of file
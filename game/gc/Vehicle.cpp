@@ -41,19 +41,19 @@ void GC_Vehicle::Init(World &world)
 
 	_light_ambient = &world.New<GC_Light>(GetPos(), GC_Light::LIGHT_POINT);
 	_light_ambient->SetIntensity(0.8f);
-	_light_ambient->SetRadius(150);
+	_light_ambient->SetRadius(world, 150);
 
 	_light1 = &world.New<GC_Light>(GetLightPos1(), GC_Light::LIGHT_SPOT);
 	_light2 = &world.New<GC_Light>(GetLightPos2(), GC_Light::LIGHT_SPOT);
 
-	_light1->SetRadius(300);
-	_light2->SetRadius(300);
+	_light1->SetRadius(world, 300);
+	_light2->SetRadius(world, 300);
 
 	_light1->SetIntensity(0.9f);
 	_light2->SetIntensity(0.9f);
 
-	_light1->SetOffset(290);
-	_light2->SetOffset(290);
+	_light1->SetOffset(world, 290);
+	_light2->SetOffset(world, 290);
 
 	_light1->SetAspect(0.4f);
 	_light2->SetAspect(0.4f);
@@ -120,7 +120,7 @@ void GC_Vehicle::ApplyState(World &world, const VehicleState &vs)
 		float maxForce = _Ny / _inv_m;
 		float sign = vs.gas > 0 ? 1.f : -1.f;
 		float force = throttledPower < maxForce * absVx ? throttledPower / absVx : maxForce;
-		ApplyForce(GetDirection() * force * sign);
+		ApplyForce(world, GetDirection() * force * sign);
 	}
 
 	float throttledRotatePower = _rotatePower * vs.steering.len();
@@ -130,7 +130,7 @@ void GC_Vehicle::ApplyState(World &world, const VehicleState &vs)
 		float maxTorque = _Nw / _inv_i * 2;
 		float torqueSign = Vec2dCross(eventualDirection, vs.steering) > 0 ? 1.f : -1.f;
 		float absTorque = throttledRotatePower < maxTorque * std::abs(_av) ? throttledRotatePower / std::abs(_av) : maxTorque;
-		ApplyTorque(absTorque * torqueSign);
+		ApplyTorque(world, absTorque * torqueSign);
 	}
 
 	if (CheckFlags(GC_FLAG_VEHICLE_KNOWNLIGHT) && _light1->GetActive() != _state.light)
@@ -347,9 +347,7 @@ void GC_Vehicle::TimeStep(World &world, float dt)
 	e /= len;
 	while( _trackPathL < len )
 	{
-		auto &p = world.New<GC_Decal>(trackL + e * _trackPathL, PARTICLE_CATTRACK, 12.0f);
-		p.SetDirection(e);
-		p.SetFade(true);
+		world._decals.Add({ trackL + e * _trackPathL, e, PARTICLE_CATTRACK, world.GetTime(), 12.0f });
 		_trackPathL += trackDensity;
 	}
 	_trackPathL -= len;
@@ -360,9 +358,7 @@ void GC_Vehicle::TimeStep(World &world, float dt)
 	e  /= len;
 	while( _trackPathR < len )
 	{
-		auto &p = world.New<GC_Decal>(trackR + e * _trackPathR, PARTICLE_CATTRACK, 12.0f);
-		p.SetDirection(e);
-		p.SetFade(true);
+		world._decals.Add({ trackR + e * _trackPathR, e, PARTICLE_CATTRACK, world.GetTime(), 12.0f });
 		_trackPathR += trackDensity;
 	}
 	_trackPathR -= len;
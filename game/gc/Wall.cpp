@@ -539,56 +539,16 @@ int GC_Wall::GetStyle() const
 	return 0;
 }
 
-PropertySet* GC_Wall::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_RigidBodyStatic, GC_Wall)
 {
-	return new MyPropertySet(this);
-}
-
-GC_Wall::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propCorner( ObjectProperty::TYPE_INTEGER,   "corner"  )
-  , _propStyle(  ObjectProperty::TYPE_INTEGER,   "style"   )
-{
-	_propCorner.SetIntRange(0, 4);
-	_propStyle.SetIntRange(0, 3);
-}
-
-int GC_Wall::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 2;
-}
-
-ObjectProperty* GC_Wall::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propCorner;
-	case 1: return &_propStyle;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Wall::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Wall *tmp = static_cast<GC_Wall *>(GetObject());
-
-	if( applyToObject )
-	{
-		tmp->SetCorner(world, _propCorner.GetIntValue());
-		tmp->SetStyle(_propStyle.GetIntValue());
-	}
-	else
-	{
-		_propCorner.SetIntValue(tmp->GetCorner());
-		_propStyle.SetIntValue(tmp->GetStyle());
-	}
+	return {
+		IntProperty("corner", 0, 4,
+			[](const GC_Object &obj, World &) { return (int) static_cast<const GC_Wall&>(obj).GetCorner(); },
+			[](GC_Object &obj, World &world, int value) { static_cast<GC_Wall&>(obj).SetCorner(world, value); }),
+		IntProperty("style", 0, 3,
+			[](const GC_Object &obj, World &) { return static_cast<const GC_Wall&>(obj).GetStyle(); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Wall&>(obj).SetStyle(value); }),
+	};
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -59,6 +59,17 @@ void GC_Water::Kill(World &world)
 	GC_RigidBodyStatic::Kill(world);
 }
 
+void GC_Water::Serialize(World &world, SaveFile &f)
+{
+	GC_RigidBodyStatic::Serialize(world, f);
+
+	int tileIndex = world.GetTileIndex(GetPos());
+	if (f.loading() && -1 != tileIndex)
+	{
+		world._waterTiles[tileIndex] = true;
+	}
+}
+
 static const int dx[8] = { 1,   1,   0,  -1,  -1,  -1,   0,   1 };
 static const int dy[8] = { 0,   1,   1,   1,   0,  -1,  -1,  -1 };
 static const int nf[8] = { 131,   2,  14,   8,  56,  32, 224, 128 };
@@ -14,50 +14,13 @@
 #define TOWER_ROT_SLOWDOWN  30.1f   // braking
 
 
-PropertySet* GC_Weapon::NewPropertySet()
+IMPLEMENT_PROPERTY_TABLE(GC_Pickup, GC_Weapon)
 {
-	return new MyPropertySet(this);
-}
-
-GC_Weapon::MyPropertySet::MyPropertySet(GC_Object *object)
-  : BASE(object)
-  , _propTimeStay(ObjectProperty::TYPE_INTEGER, "stay_time")
-{
-	_propTimeStay.SetIntRange(0, 1000000);
-}
-
-int GC_Weapon::MyPropertySet::GetCount() const
-{
-	return BASE::GetCount() + 1;
-}
-
-ObjectProperty* GC_Weapon::MyPropertySet::GetProperty(int index)
-{
-	if( index < BASE::GetCount() )
-		return BASE::GetProperty(index);
-
-	switch( index - BASE::GetCount() )
-	{
-	case 0: return &_propTimeStay; break;
-	}
-
-	assert(false);
-	return nullptr;
-}
-
-void GC_Weapon::MyPropertySet::MyExchange(World &world, bool applyToObject)
-{
-	BASE::MyExchange(world, applyToObject);
-
-	GC_Weapon *obj = static_cast<GC_Weapon*>(GetObject());
-	if( applyToObject )
-	{
-		obj->_stayTimeout = (float) _propTimeStay.GetIntValue() / 1000.0f;
-	}
-	else
-	{
-		_propTimeStay.SetIntValue(int(obj->GetStayTimeout() * 1000.0f + 0.5f));
-	}
+	return {
+		IntProperty("stay_time", 0, 1000000,
+			[](const GC_Object &obj, World &) { return int(static_cast<const GC_Weapon&>(obj).GetStayTimeout() * 1000.0f + 0.5f); },
+			[](GC_Object &obj, World &, int value) { static_cast<GC_Weapon&>(obj)._stayTimeout = (float) value / 1000.0f; }),
+	};
 }
 
 IMPLEMENT_1LIST_MEMBER(GC_Pickup, GC_Weapon, LIST_timestep);
@@ -75,7 +38,7 @@ void GC_Weapon::Fire(World &world, bool fire)
 	SetFlags(GC_FLAG_WEAPON_FIRING, fire);
 }
 
-AIPRIORITY GC_Weapon::GetPriority(World &world, const GC_Vehicle &veh) const
+AIPRIORITY GC_Weapon::GetPriority(const World &world, const GC_Vehicle &veh) const
 {
 	if( veh.GetWeapon() )
 	{
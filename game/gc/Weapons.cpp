@@ -207,7 +207,7 @@ void GC_Weap_Cannon::OnShoot(World &world)
 
 	if( !GetBooster() )
 	{
-		GetVehicle()->ApplyImpulse( dir * (-80.0f) );
+		GetVehicle()->ApplyImpulse(world, dir * (-80.0f));
 	}
 }
 
@@ -357,7 +357,7 @@ void GC_Weap_Ram::OnAttached(World &world, GC_Vehicle &vehicle)
 {
 	_engineLight = &world.New<GC_Light>(GetEngineLightPos(), GC_Light::LIGHT_POINT);
 	_engineLight->SetIntensity(1.0f);
-	_engineLight->SetRadius(120);
+	_engineLight->SetRadius(world, 120);
 	_engineLight->SetActive(false);
 
 	_fuel_max  = _fuel = 1.0f;
@@ -413,7 +413,7 @@ void GC_Weap_Ram::Fire(World &world, bool fire)
 	GC_Weapon::Fire(world, fire);
 	if( GetFire() )
 	{
-		GetVehicle()->ApplyForce(GetDirection() * 2500);
+		GetVehicle()->ApplyForce(world, GetDirection() * 2500);
 	}
 }
 
@@ -667,7 +667,7 @@ void GC_Weap_Minigun::OnShoot(World &world)
 		if( world.net_frand(WEAP_MG_TIME_RELAX * 5.0f) < _heat - WEAP_MG_TIME_RELAX * 0.2f )
 		{
 			float m = 3000;//veh->_inv_i; // FIXME
-			GetVehicle()->ApplyMomentum(m * (world.net_frand(1.0f) - 0.5f));
+			GetVehicle()->ApplyMomentum(world, m * (world.net_frand(1.0f) - 0.5f));
 		}
 	}
 
@@ -4,7 +4,10 @@
 #include "inc/gc/WorldCfg.h"
 #include "inc/gc/WorldEvents.h"
 #include "inc/gc/RigidBodyDynamic.h"
+#include "inc/gc/Pickup.h"
 #include "inc/gc/Player.h"
+#include "inc/gc/Projectiles.h"
+#include "inc/gc/Turrets.h"
 #include "inc/gc/Macros.h"
 #include "inc/gc/TypeSystem.h"
 
@@ -12,7 +15,9 @@
 
 #include <fs/FileSystem.h>
 #include <MapFile.h>
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <sstream>
 
 static int DivFloor(int number, unsigned int denominator)
@@ -27,6 +32,14 @@ static int DivFloor(int number, unsigned int denominator)
 	}
 }
 
+static const double c_timerTicksPerSecond = 1000;
+
+// first timer tick not earlier than time
+static uint32_t TimeToTick(double time)
+{
+	return (uint32_t) (uint64_t) std::ceil(time * c_timerTicksPerSecond);
+}
+
 static int DivCeil(int number, unsigned int denominator)
 {
 	if (number > 0)
@@ -52,6 +65,7 @@ World::World(RectRB blockBounds, bool initField)
 		DivFloor(blockBounds.top * WORLD_BLOCK_SIZE, WORLD_LOCATION_SIZE),
 		DivCeil(blockBounds.right * WORLD_BLOCK_SIZE, WORLD_LOCATION_SIZE),
 		DivCeil(blockBounds.bottom * WORLD_BLOCK_SIZE, WORLD_LOCATION_SIZE) }
+	, _taskPool(nullptr)
 #ifdef NETWORK_DEBUG
 	, _checksum(0)
 	, _frame(0)
@@ -64,6 +78,8 @@ World::World(RectRB blockBounds, bool initField)
 	grid_walls.resize(_locationBounds);
 	grid_pickup.resize(_locationBounds);
 	grid_moving.resize(_locationBounds);
+	grid_lights.resize(_locationBounds);
+	_decals.Resize(_locationBounds);
 
 	if (initField)
 	{
@@ -89,21 +105,139 @@ int World::GetTileIndex(int blockX, int blockY) const
 		return -1;
 }
 
+// Update order across types. Whatever moves on its own goes first, so that
+// attached items, turrets and followers see positions of the current step.
+static int GetTimeStepPhase(const GC_Object &obj)
+{
+	if (dynamic_cast<const GC_RigidBodyDynamic*>(&obj))
+		return 0;
+	if (dynamic_cast<const GC_Pickup*>(&obj))
+		return 1;
+	if (dynamic_cast<const GC_Turret*>(&obj))
+		return 2;
+	if (dynamic_cast<const GC_Projectile*>(&obj))
+		return 3;
+	return 4;
+}
+
+World::TimeStepGroup& World::GetTimeStepGroup(const GC_Object &obj)
+{
+	ObjectType type = obj.GetType();
+	if (type >= _timeStepGroupByType.size())
+		_timeStepGroupByType.resize(type + 1);
+	if (!_timeStepGroupByType[type])
+	{
+		assert(!_timeStepping);
+		auto group = std::make_unique<TimeStepGroup>();
+		group->phase = GetTimeStepPhase(obj);
+		group->name = RTTypes::Inst().GetTypeName(type);
+		group->proc = RTTypes::Inst().GetTimeStepProc(type);
+		auto where = std::upper_bound(_timeStepGroups.begin(), _timeStepGroups.end(), group,
+			[](const std::unique_ptr<TimeStepGroup> &a, const std::unique_ptr<TimeStepGroup> &b)
+			{
+				return a->phase != b->phase ? a->phase < b->phase : a->name < b->name;
+			});
+		_timeStepGroupByType[type] = group.get();
+		_timeStepGroups.insert(where, std::move(group));
+	}
+	return *_timeStepGroupByType[type];
+}
+
+// groups hand out their own dense ids, so each one stays as small as its type
+void World::TimeStepJoin(GC_Object &obj)
+{
+	int index = obj.GetId().index();
+	if (index >= (int) _timeStepIds.size())
+		_timeStepIds.resize(index + 1);
+	_timeStepIds[index] = GetTimeStepGroup(obj).objects.insert(&obj);
+}
+
+void World::ListInsert(GlobalListID id, GC_Object &obj, ObjectList::id_type pos)
+{
+	GetList(id).insert(&obj, pos);
+	if (LIST_timestep == id)
+	{
+		// objects created during the update loop start with the next step
+		if (_timeStepping)
+			_timeStepPending.push_back(&obj);
+		else
+			TimeStepJoin(obj);
+	}
+}
+
+void World::ListErase(GlobalListID id, GC_Object &obj, ObjectList::id_type pos)
+{
+	GetList(id).erase(pos);
+	if (LIST_timestep == id)
+	{
+		auto pending = std::find(_timeStepPending.rbegin(), _timeStepPending.rend(), &obj);
+		if (_timeStepPending.rend() != pending)
+			_timeStepPending.erase(std::next(pending).base());
+		else
+			GetTimeStepGroup(obj).objects.erase(_timeStepIds[pos.index()]);
+	}
+}
+
 void World::OnKill(GC_Object &obj)
 {
 	for( auto ls: eWorld._listeners )
 		ls->OnKill(obj);
 }
 
+void World::OnNewObject(GC_Object &obj)
+{
+	for( auto ls: eWorld._listeners )
+		ls->OnNewObject(obj);
+}
+
 void World::Clear()
 {
 	assert(IsSafeMode());
 
+	for( auto ls: eWorld._listeners )
+		ls->OnClear();
+
+	// Everything goes away, so none of the per-object Kill bookkeeping is
+	// needed. Destroying objects grouped by type keeps each pool busy with
+	// its own blocks and releases them as they empty.
+	std::vector<GC_Object*> objects;
 	ObjectList &ls = GetList(LIST_objects);
-	while( !ls.empty() )
+	objects.reserve(ls.size());
+	for( auto it = ls.begin(); it != ls.end(); it = ls.next(it) )
+		objects.push_back(ls.at(it));
+	std::stable_sort(objects.begin(), objects.end(), [](const GC_Object *a, const GC_Object *b)
+	{
+		return a->GetType() < b->GetType();
+	});
+
+	for( auto &list: _objectLists )
+		list.clear();
+	for( auto &slot: _handles )
 	{
-		ls.at(ls.begin())->Kill(*this);
+		if( slot.obj )
+			CloseHandle(slot.obj->GetId());
 	}
+	for( auto &group: _timeStepGroups )
+		group->objects.clear();
+	_timeStepPending.clear();
+	grid_rigid_s.clear();
+	grid_walls.clear();
+	grid_pickup.clear();
+	grid_moving.clear();
+	grid_lights.clear();
+	if( _field )
+		_field->Resize(_field->GetWidth(), _field->GetHeight());
+	std::fill(_waterTiles.begin(), _waterTiles.end(), false);
+	std::fill(_woodTiles.begin(), _woodTiles.end(), false);
+	_jobManager.Clear();
+	_objectToStringMap.clear();
+	_nameToObjectMap.clear();
+	_decals.Clear();
+	eContacts.Clear();
+	_timers.Clear([](TimerNode *node) { delete static_cast<ResumableObject*>(node); });
+
+	for( GC_Object *obj: objects )
+		delete obj;
 
 	// reset info
 	_infoAuthor.clear();
@@ -116,6 +250,7 @@ void World::Clear()
 	// reset variables
 	_time = 0;
 	_gameStarted = false;
+	_contactImpulses.clear();
 #ifdef NETWORK_DEBUG
 	_checksum = 0;
 	_frame = 0;
@@ -143,7 +278,10 @@ void World::Serialize(SaveFile &f)
 	f.Serialize(_gameStarted);
 	f.Serialize(_time);
 	f.Serialize(_nightMode);
+	_decals.Serialize(f);
 
+	// the object list iterates newest first, so a loaded list comes out reversed
+	std::vector<GC_Object*> order;
 	ObjectList &objects = GetList(LIST_objects);
 	if (f.loading())
 	{
@@ -155,7 +293,10 @@ void World::Serialize(SaveFile &f)
 			if (INVALID_OBJECT_TYPE == type) // end of list signal
 				break;
 			if (GC_Object *obj = RTTypes::Inst().CreateFromFile(*this, type))
+			{
 				f.RegPointer(obj);
+				order.push_back(obj);
+			}
 			else
 				throw std::runtime_error("Load error: unknown object type");
 		}
@@ -169,15 +310,55 @@ void World::Serialize(SaveFile &f)
 			ObjectType type = object->GetType();
 			f.Serialize(type);
 			f.RegPointer(object);
+			order.push_back(object);
 		}
 		ObjectType terminator(INVALID_OBJECT_TYPE);
 		f.Serialize(terminator);
 	}
 
 	// serialize objects contents in the same order as pointers
-	for (ObjectList::id_type it = objects.begin(); it != objects.end(); it = objects.next(it))
+	for (GC_Object *object: order)
 	{
-		objects.at(it)->Serialize(*this, f);
+		object->Serialize(*this, f);
+	}
+
+	// pending timeouts are stored slot by slot so that they fire in the same order after loading
+	uint32_t currentTick = _timers.GetCurrentTick();
+	f.Serialize(currentTick);
+	uint32_t count = (uint32_t) _timers.GetCount();
+	f.Serialize(count);
+	if (f.loading())
+	{
+		_timers.SetCurrentTick(currentTick);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			int level;
+			int slot;
+			ObjPtr<GC_Object> obj;
+			uint32_t tick;
+			f.Serialize(level);
+			f.Serialize(slot);
+			f.Serialize(obj);
+			f.Serialize(tick);
+			if (level < 0 || level >= TimerWheel::LEVEL_COUNT || slot < 0 || slot >= TimerWheel::SLOT_COUNT)
+				throw std::runtime_error("Load error: invalid timeout");
+			auto ro = new ResumableObject(obj);
+			ro->tick = tick;
+			_timers.Restore(level, slot, *ro);
+		}
+	}
+	else
+	{
+		_timers.ForEach([&f](int level, int slot, const TimerNode &node)
+		{
+			auto &ro = static_cast<const ResumableObject&>(node);
+			ObjPtr<GC_Object> obj = ro.ptr;
+			uint32_t tick = ro.tick;
+			f.Serialize(level);
+			f.Serialize(slot);
+			f.Serialize(obj);
+			f.Serialize(tick);
+		});
 	}
 }
 
@@ -193,16 +374,28 @@ void World::Import(MapFile &file)
 	file.getMapAttribute("theme",    _infoTheme);
 	file.getMapAttribute("on_init",  _infoOnInit);
 
-	while( file.ReadNextObject() )
+	const std::vector<MapFile::ObjectRun> &runs = file.GetObjectRuns();
+
+	// class names are resolved once per file, not once per object
+	std::vector<ObjectType> types(file.GetClassCount());
+	for( int i = 0; i < file.GetClassCount(); ++i )
+		types[i] = RTTypes::Inst().GetTypeByName(file.GetClassName(i));
+
+	for( const MapFile::ObjectRun &run: runs )
 	{
-		ObjectType t = RTTypes::Inst().GetTypeByName(file.GetCurrentClassName());
-		if( INVALID_OBJECT_TYPE != t )
+		ObjectType t = types[run.classIndex];
+		if( INVALID_OBJECT_TYPE == t )
+			continue;
+
+		const RTTypes::EdItem &ei = RTTypes::Inst().GetTypeInfo(t);
+		for( int row = run.first; row != run.first + run.count; ++row )
 		{
+			file.SelectObject(run.classIndex, row);
+
 			GC_Object *obj;
-			const RTTypes::EdItem &ei = RTTypes::Inst().GetTypeInfo(t);
 			if (ei.service)
 			{
-				obj = &ei.CreateDetachedService();
+				obj = &ei.CreateDetachedService(*this);
 			}
 			else
 			{
@@ -210,7 +403,7 @@ void World::Import(MapFile &file)
 				float y = 0;
 				file.getObjectAttribute("x", x);
 				file.getObjectAttribute("y", y);
-				obj = &ei.CreateDetachedObject({ x, y });
+				obj = &ei.CreateDetachedObject(*this, { x, y });
 			}
 			obj->MapExchange(file);
 			std::string name;
@@ -319,7 +512,7 @@ bool World::CalcOutstrip( vec2d origin,
                           float projectileSpeed,
                           vec2d targetPos,
                           vec2d targetVelocity,
-                          vec2d &out_fake) // out: fake target position
+                          vec2d &out_fake) const // out: fake target position
 {
 	float vt = targetVelocity.len();
 
@@ -438,8 +631,9 @@ IMPLEMENT_POOLED_ALLOCATION(ResumableObject);
 ResumableObject* World::Timeout(GC_Object &obj, float timeout)
 {
 	assert(GetTime() + timeout >= GetTime());
-	auto id = new ResumableObject(obj);
-	_resumables.emplace(std::unique_ptr<ResumableObject>(id), GetTime() + timeout);
+	double ticks = std::ceil(((double) GetTime() + timeout) * c_timerTicksPerSecond) - _timers.GetCurrentTick();
+	auto id = new ResumableObject(&obj);
+	_timers.Schedule(*id, _timers.GetCurrentTick() + (uint32_t) std::min<double>(std::max<double>(ticks, 0), INT32_MAX));
 	return id;
 }
 
@@ -453,22 +647,28 @@ void World::Step(float dt)
 	}
 
 	float nextTime = _time + dt;
-	while (!_resumables.empty() && _resumables.top().time < nextTime)
+	_timers.Advance(TimeToTick(nextTime) - 1, [this](TimerNode &node)
 	{
-		_time = _resumables.top().time;
-		GC_Object *obj = _resumables.top().obj->ptr;
-		_resumables.pop();
+		auto ro = static_cast<ResumableObject*>(&node);
+		_time = (float) (ro->tick / c_timerTicksPerSecond);
+		ObjPtr<GC_Object> obj = ro->ptr;
+		delete ro;
 		if (obj)
 			obj->Resume(*this);
-	}
+	});
 
 	_time = nextTime;
+	_decals.Expire(_time);
 
 	_safeMode = false;
-	ObjectList &ls = GetList(LIST_timestep);
-	ls.for_each([=](ObjectList::id_type id, GC_Object *o){
-		o->TimeStep(*this, dt);
-	});
+	_timeStepping = true;
+	for (auto &group: _timeStepGroups)
+		group->proc(*this, group->objects, dt);
+	_timeStepping = false;
+	for (GC_Object *obj: _timeStepPending)
+		TimeStepJoin(*obj);
+	_timeStepPending.clear();
+	GC_RigidBodyDynamic::DetectCollisions(*this, _taskPool);
 	GC_RigidBodyDynamic::ProcessResponse(*this);
 	_safeMode = true;
 
@@ -501,6 +701,46 @@ void World::Step(float dt)
 	_checksum = dwCheckSum;
 	fflush(_dump);
 #endif
+
+	eContacts.Flush();
+}
+
+ObjectHandle World::GetHandle(const GC_Object *obj) const
+{
+	if( !obj )
+		return {};
+	uint32_t index = obj->GetId().index();
+	assert(index < _handles.size() && obj == _handles[index].obj);
+	return ObjectHandle{ index, _handles[index].generation };
+}
+
+void World::OpenHandle(GC_Object &obj)
+{
+	size_t index = obj.GetId().index();
+	if( index >= _handles.size() )
+		_handles.resize(index + 1);
+	assert(!_handles[index].obj);
+	_handles[index].obj = &obj;
+}
+
+void World::CloseHandle(PtrList<GC_Object>::id_type id)
+{
+	HandleSlot &slot = _handles[id.index()];
+	assert(slot.obj);
+	slot.obj = nullptr;
+	if( 0 == ++slot.generation )
+		slot.generation = 1;
+}
+
+std::vector<ArenaStats> World::GetArenaStats() const
+{
+	std::vector<ArenaStats> result;
+	for( size_t type = 0; type < _arenas.size(); ++type )
+	{
+		if( _arenas[type] )
+			result.push_back(ArenaStats{ (ObjectType) type, _arenas[type]->GetStats() });
+	}
+	return result;
 }
 
 GC_Object* World::FindObject(std::string_view name) const
@@ -1,35 +1,7 @@
 #pragma once
+#include "DecalStore.h"
 #include "MovingObject.h"
 
-enum DecalType
-{
-	PARTICLE_FIRE1,
-	PARTICLE_FIRE2,
-	PARTICLE_FIRE3,
-	PARTICLE_FIRE4,
-	PARTICLE_FIRESPARK,
-	PARTICLE_TYPE1,
-	PARTICLE_TYPE2,
-	PARTICLE_TYPE3,
-	PARTICLE_TRACE1,
-	PARTICLE_TRACE2,
-	PARTICLE_SMOKE,
-	PARTICLE_EXPLOSION1,
-	PARTICLE_EXPLOSION2,
-	PARTICLE_EXPLOSION_G,
-	PARTICLE_EXPLOSION_E,
-	PARTICLE_EXPLOSION_S,
-	PARTICLE_EXPLOSION_P,
-	PARTICLE_BIGBLAST,
-	PARTICLE_SMALLBLAST,
-	PARTICLE_GAUSS1,
-	PARTICLE_GAUSS2,
-	PARTICLE_GAUSS_HIT,
-	PARTICLE_GREEN,
-	PARTICLE_YELLOW,
-	PARTICLE_CATTRACK,
-};
-
 #define GC_FLAG_DECAL_FADE            (GC_FLAG_MO_ << 0)
 #define GC_FLAG_DECAL_                (GC_FLAG_MO_ << 1)
 
@@ -63,17 +35,3 @@ private:
 	float _timeLife;
 	float _rotationSpeed;
 };
-
-///////////////////////////////////////////////////////////////////////////////
-// Workaround to assign different renderers
-
-#define DECLARE_DECAL(clsname)                                          \
-    class clsname : public GC_Decal                                     \
-    {                                                                   \
-        DECLARE_SELF_REGISTRATION(clsname);                             \
-    public:                                                             \
-        using GC_Decal::GC_Decal;                                       \
-    };
-
-DECLARE_DECAL(GC_DecalExplosion);
-DECLARE_DECAL(GC_DecalGauss);
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <math/MyMath.h>
+#include <cstdint>
+#include <vector>
+
+class SaveFile;
+
+enum DecalType
+{
+	PARTICLE_FIRE1,
+	PARTICLE_FIRE2,
+	PARTICLE_FIRE3,
+	PARTICLE_FIRE4,
+	PARTICLE_FIRESPARK,
+	PARTICLE_TYPE1,
+	PARTICLE_TYPE2,
+	PARTICLE_TYPE3,
+	PARTICLE_TRACE1,
+	PARTICLE_TRACE2,
+	PARTICLE_SMOKE,
+	PARTICLE_EXPLOSION1,
+	PARTICLE_EXPLOSION2,
+	PARTICLE_EXPLOSION_G,
+	PARTICLE_EXPLOSION_E,
+	PARTICLE_EXPLOSION_S,
+	PARTICLE_EXPLOSION_P,
+	PARTICLE_BIGBLAST,
+	PARTICLE_SMALLBLAST,
+	PARTICLE_GAUSS1,
+	PARTICLE_GAUSS2,
+	PARTICLE_GAUSS_HIT,
+	PARTICLE_GREEN,
+	PARTICLE_YELLOW,
+	PARTICLE_CATTRACK,
+};
+
+// A mark that stays where it was made and never interacts with anything.
+// Saved as raw bytes, so keep it free of padding.
+struct Decal
+{
+	vec2d pos;
+	vec2d direction;
+	DecalType type;
+	float timeCreated;
+	float lifeTime;
+};
+
+// Fixed-capacity ring of decals in creation order. The oldest record is
+// dropped once the ring is full. Records are linked into location cells so
+// that drawing only walks the visible part of the world.
+class DecalStore final
+{
+public:
+	static constexpr uint32_t CAPACITY = 8192;
+
+	DecalStore() = default;
+	DecalStore(const DecalStore&) = delete;
+	DecalStore& operator=(const DecalStore&) = delete;
+
+	void Resize(RectRB locationBounds); // also clears
+	void Clear();
+
+	void Add(const Decal &decal);
+
+	// Drops expired records from the oldest end. A record that outlives its
+	// neighbours keeps the younger ones behind it until it expires too, so
+	// readers still have to check the age.
+	void Expire(float time);
+
+	void Serialize(SaveFile &f);
+
+	// Records carry running sequence numbers: [GetBegin(), GetEnd()).
+	uint32_t GetBegin() const { return _begin; }
+	uint32_t GetEnd() const { return _end; }
+	uint32_t GetCount() const { return _end - _begin; }
+	const Decal& GetDecal(uint32_t seq) const { return _records[seq % CAPACITY].decal; }
+
+	const RectRB& GetBounds() const { return _bounds; }
+
+	template <class F>
+	void ForEachInCell(int x, int y, F &&f) const
+	{
+		for( int i = _cells[GetCellIndex(x, y)].first; -1 != i; i = _records[i].next )
+			f(_records[i].decal);
+	}
+
+private:
+	struct Record
+	{
+		Decal decal;
+		int cell;
+		int next; // next record in the same cell, -1 for the last
+	};
+
+	struct Cell
+	{
+		int first = -1;
+		int last = -1;
+	};
+
+	std::vector<Record> _records; // grows up to CAPACITY
+	std::vector<Cell> _cells;
+	RectRB _bounds = {};
+	uint32_t _begin = 0;
+	uint32_t _end = 0;
+
+	int GetCellIndex(int x, int y) const { return (y - _bounds.top) * WIDTH(_bounds) + x - _bounds.left; }
+	int GetCellIndex(vec2d pos) const;
+	void PopFront();
+};
@@ -8,9 +8,6 @@
 class FieldCell final
 {
 public:
-	static unsigned int _sessionId;
-	unsigned int _mySession = 0xffffffff;
-	//-----------------------------
 	union X
 	{
 		ObjectList::id_type* _objects;
@@ -22,14 +19,16 @@ public:
 	//-----------------------------
 	void UpdateProperties(const World &world);
 
-	int _before; // actual path cost to this node
-
 	// each bit describes a separate obstacle group: 0 - passable, 1 - occupied
 	uint8_t _obstacleFlags = 0;
-	int8_t _prev = -1;
 
 public:
 	FieldCell() = default;
+	~FieldCell()
+	{
+		if (_objCount > 1)
+			delete[] _storage._objects;
+	}
 	FieldCell(const FieldCell &other) = delete;
 	FieldCell& operator = (const FieldCell &other) = delete;
 
@@ -39,15 +38,10 @@ public:
 		return _objCount > 1 ? _storage._objects[index] : _storage._singleObject;
 	}
 
-	bool IsChecked() const { return _mySession == _sessionId; }
-	void Check()           { _mySession = _sessionId;         }
-
 	void AddObject(const World& world, ObjectList::id_type object);
 	void RemoveObject(const World& world, ObjectList::id_type object);
 
 	uint8_t ObstacleFlags() const { return _obstacleFlags; }
-
-	int Before() const { return _before; }
 };
 
 struct RefFieldCell
@@ -70,11 +64,12 @@ class GC_RigidBodyStatic;
 class Field final
 {
 public:
-	static void NewSession() { ++FieldCell::_sessionId; }
-
 	void Resize(int width, int height);
 	void ProcessObject(const World& world, GC_RigidBodyStatic *object, bool add);
 
+	int GetWidth() const { return _width; }
+	int GetHeight() const { return _height; }
+
 	const FieldCell& operator() (int x, int y) const
 	{
 		assert(x >= 0 && x < _width && y >= 0 && y < _height);
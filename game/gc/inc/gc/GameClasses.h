@@ -52,6 +52,7 @@ public:
 	// GC_Object
 	void Init(World &world) override;
 	void Kill(World &world) override;
+	void Serialize(World &world, SaveFile &f) override;
 };
 
 /////////////////////////////////////////////////////////////
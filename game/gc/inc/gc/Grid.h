@@ -32,6 +32,12 @@ public:
 		_bounds = bounds;
 	}
 
+	void clear()
+	{
+		for( int i = 0; i < WIDTH(_bounds) * HEIGHT(_bounds); ++i )
+			_data[i] = T();
+	}
+
 	inline T& element(int x, int y)
 	{
 		assert(PtInRect(_bounds, x, y));
@@ -48,14 +54,22 @@ public:
 
 	void OverlapRect(std::vector<T*> &receive, const FRECT &rect)
 	{
-		int xmin = std::max(_bounds.left, (int)std::floor(rect.left - 0.5f));
-		int ymin = std::max(_bounds.top, (int)std::floor(rect.top - 0.5f));
-		int xmax = std::min(_bounds.right - 1, (int)std::floor(rect.right + 0.5f));
-		int ymax = std::min(_bounds.bottom - 1, (int)std::floor(rect.bottom + 0.5f));
+		RectRB cells = GetOverlappedCells(rect);
+		for( int y = cells.top; y < cells.bottom; ++y )
+		{
+			for( int x = cells.left; x < cells.right; ++x )
+			{
+				receive.push_back(&element(x, y));
+			}
+		}
+	}
 
-		for( int y = ymin; y <= ymax; ++y )
+	void OverlapRect(std::vector<const T*> &receive, const FRECT &rect) const
+	{
+		RectRB cells = GetOverlappedCells(rect);
+		for( int y = cells.top; y < cells.bottom; ++y )
 		{
-			for( int x = xmin; x <= xmax; ++x )
+			for( int x = cells.left; x < cells.right; ++x )
 			{
 				receive.push_back(&element(x, y));
 			}
@@ -64,14 +78,22 @@ public:
 
 	void OverlapPoint(std::vector<T*> &receive, const vec2d &pt)
 	{
-		int xmin = std::min(std::max((int)std::floor(pt.x - 0.5f), _bounds.left), _bounds.right - 1);
-		int ymin = std::min(std::max((int)std::floor(pt.y - 0.5f), _bounds.top), _bounds.bottom - 1);
-		int xmax = std::min(std::max((int)std::floor(pt.x + 0.5f), _bounds.left), _bounds.right - 1);
-		int ymax = std::min(std::max((int)std::floor(pt.y + 0.5f), _bounds.top), _bounds.bottom - 1);
+		RectRB cells = GetPointCells(pt);
+		for( int y = cells.top; y < cells.bottom; ++y )
+		{
+			for( int x = cells.left; x < cells.right; ++x )
+			{
+				receive.push_back(&element(x, y));
+			}
+		}
+	}
 
-		for( int y = ymin; y <= ymax; ++y )
+	void OverlapPoint(std::vector<const T*> &receive, const vec2d &pt) const
+	{
+		RectRB cells = GetPointCells(pt);
+		for( int y = cells.top; y < cells.bottom; ++y )
 		{
-			for( int x = xmin; x <= xmax; ++x )
+			for( int x = cells.left; x < cells.right; ++x )
 			{
 				receive.push_back(&element(x, y));
 			}
@@ -81,4 +103,24 @@ public:
 private:
 	T * _data;
 	RectRB _bounds;
+
+	RectRB GetOverlappedCells(const FRECT &rect) const
+	{
+		return {
+			std::max(_bounds.left, (int)std::floor(rect.left - 0.5f)),
+			std::max(_bounds.top, (int)std::floor(rect.top - 0.5f)),
+			std::min(_bounds.right, (int)std::floor(rect.right + 0.5f) + 1),
+			std::min(_bounds.bottom, (int)std::floor(rect.bottom + 0.5f) + 1)
+		};
+	}
+
+	RectRB GetPointCells(const vec2d &pt) const
+	{
+		return {
+			std::min(std::max((int)std::floor(pt.x - 0.5f), _bounds.left), _bounds.right - 1),
+			std::min(std::max((int)std::floor(pt.y - 0.5f), _bounds.top), _bounds.bottom - 1),
+			std::min(std::max((int)std::floor(pt.x + 0.5f), _bounds.left), _bounds.right - 1) + 1,
+			std::min(std::max((int)std::floor(pt.y + 0.5f), _bounds.top), _bounds.bottom - 1) + 1
+		};
+	}
 };
@@ -4,7 +4,8 @@
 
 #define GC_FLAG_LIGHT_ACTIVE        (GC_FLAG_MO_ << 0)
 #define GC_FLAG_LIGHT_FADE          (GC_FLAG_MO_ << 1)
-#define GC_FLAG_LIGHT_              (GC_FLAG_MO_ << 2)
+#define GC_FLAG_LIGHT_STATIC        (GC_FLAG_MO_ << 2)
+#define GC_FLAG_LIGHT_              (GC_FLAG_MO_ << 3)
 
 class GC_Light : public GC_MovingObject
 {
@@ -31,30 +32,16 @@ public:
 	void SetAspect(float a) { _aspect = a; }
 	float GetAspect() const { return _aspect; }
 
-	void SetRadius(float r)
-	{
-		if( LIGHT_DIRECT == _type )
-			_offset = r;
-		else
-			_radius = r;
-	}
+	void SetRadius(World &world, float r);
 	void SetLightDirection(const vec2d &d) { _lightDirection = d; }
 	vec2d GetLightDirection() const { return _lightDirection; }
-	void SetOffset(float o)
-	{
-		assert(LIGHT_DIRECT != _type);
-		_offset = o;
-	}
+	void SetOffset(World &world, float o);
 	float GetOffset() const
 	{
 		assert(LIGHT_DIRECT != _type);
 		return _offset;
 	}
-	void SetLength(float l)
-	{
-		assert(LIGHT_DIRECT == _type);
-		_radius = l;
-	}
+	void SetLength(World &world, float l);
 	float GetLength() const
 	{
 		assert(LIGHT_DIRECT == _type);
@@ -86,10 +73,26 @@ public:
 	bool GetActive() const { return CheckFlags(GC_FLAG_LIGHT_ACTIVE); }
 	void SetActive(bool activate);
 
+	// a static light rarely changes and never fades; its geometry may be cached by the view
+	bool GetStatic() const { return CheckFlags(GC_FLAG_LIGHT_STATIC); }
+	void SetStatic(bool isStatic);
+
+	// location cells of World::grid_lights covered by the render radius
+	RectRB GetCells() const { return _cells; }
+
+	// GC_MovingObject
+	void MoveTo(World &world, const vec2d &pos) override;
+
+	// GC_Object
+	void Init(World &world) override;
+	void Kill(World &world) override;
 	void Resume(World &world) override;
 	void Serialize(World &world, SaveFile &f) override;
 
 private:
+	void UpdateCells(World &world);
+
+	RectRB _cells;
 	float  _startTime;
 	float  _timeout;
 	float  _aspect;
@@ -108,6 +111,7 @@ private:
 class GC_Spotlight : public GC_MovingObject
 {
 	DECLARE_SELF_REGISTRATION(GC_Spotlight);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_Spotlight(vec2d pos);
@@ -123,20 +127,6 @@ public:
 	void MapExchange(MapFile &f) override;
 	void Serialize(World &world, SaveFile &f) override;
 
-protected:
-	class MyPropertySet : public GC_MovingObject::MyPropertySet
-	{
-		typedef GC_MovingObject::MyPropertySet BASE;
-		ObjectProperty _propActive;
-		ObjectProperty _propDir;
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
-
 private:
 	ObjPtr<GC_Light> _light;
 };
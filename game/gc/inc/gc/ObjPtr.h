@@ -2,6 +2,11 @@
 
 #include <cassert>
 
+// The reference count lives in front of the object. It is not atomic, so
+// ObjPtrs may only be copied on the thread that owns the world; code that
+// reads the world from other threads keeps ObjectHandles or plain pointers.
+typedef unsigned int ObjRefCount;
+
 template <class T>
 class ObjPtr
 {
@@ -10,33 +15,32 @@ public:
 	ObjPtr(T *f)
 		: _ptr(f)
 	{
-		if( _ptr ) ++((unsigned int *) _ptr)[-1];
+		if( _ptr ) AddRef(_ptr);
 	}
 	ObjPtr(const ObjPtr &f)
 		: _ptr(f._ptr)
 	{
-		if( _ptr ) ++((unsigned int *) _ptr)[-1];
+		if( _ptr ) AddRef(_ptr);
 	}
 
 	~ObjPtr()
 	{
-		if( _ptr && 0 == --((unsigned int *) _ptr)[-1] )
-			(*(ObjFinalizerProc*) _ptr)((unsigned int *) _ptr - 1);
+		if( _ptr ) Release(_ptr);
 	}
 
 	const ObjPtr& operator = (T *p)
 	{
 		if( p )
-			++*((unsigned int *) p - 1);
-		if( _ptr && 0 == --((unsigned int *) _ptr)[-1] )
-			(*(ObjFinalizerProc*) _ptr)((unsigned int *) _ptr - 1);
+			AddRef(p);
+		if( _ptr )
+			Release(_ptr);
 		_ptr = p;
 		return *this;
 	}
 
 	operator T* () const
 	{
-		return (_ptr && (((unsigned int *)_ptr)[-1] & 0x80000000)) ? _ptr : nullptr;
+		return (_ptr && (RefCount(_ptr) & 0x80000000)) ? _ptr : nullptr;
 	}
 
 	T* operator -> () const
@@ -48,6 +52,20 @@ public:
 private:
 	typedef void(*ObjFinalizerProc) (void *);
 	T *_ptr;
+
+	static ObjRefCount& RefCount(T *p)
+	{
+		return ((ObjRefCount *) p)[-1];
+	}
+	static void AddRef(T *p)
+	{
+		++RefCount(p);
+	}
+	static void Release(T *p)
+	{
+		if( 0 == --RefCount(p) )
+			(*(ObjFinalizerProc*) p)(&RefCount(p));
+	}
 };
 
 template<class U, class T>
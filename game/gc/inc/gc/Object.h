@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ObjectProperty.h"
+#include "PropertyTable.h"
 #include "Serialization.h"
 #include "detail/GlobalListHelper.h"
 #include "detail/MemoryManager.h"
@@ -35,24 +36,23 @@ typedef unsigned int ObjectType;
     private:
 
 
-class PropertySet
+// Detached copy of object properties for editing; changes are applied back with Exchange.
+class PropertySet final
 {
 public:
-	PropertySet(GC_Object *object);
-	virtual ~PropertySet() = default;
+	PropertySet(GC_Object &object, const PropertyTable &table);
 
 	GC_Object* GetObject() const { return &_object; }
+	const PropertyTable& GetTable() const { return _table; }
 	void Exchange(World &world, bool applyToObject);
 
-	virtual int GetCount() const;
-	virtual ObjectProperty* GetProperty(int index);
-
-protected:
-	virtual void MyExchange(World &world, bool applyToObject);
+	int GetCount() const;
+	ObjectProperty* GetProperty(int index);
 
 private:
-	GC_Object & _object;
-	ObjectProperty   _propName;
+	GC_Object &_object;
+	const PropertyTable &_table;
+	std::vector<ObjectProperty> _properties;
 };
 
 ////////////////////////////////////////////////////////////
@@ -78,6 +78,8 @@ public:
 	void SetName(World &world, std::string name);
 
 	std::shared_ptr<PropertySet> GetProperties(World &world);
+	static const PropertyTable& GetPropertyTableStatic();
+	virtual const PropertyTable& GetPropertyTable() const;
 
 	virtual void Kill(World &world);
 	virtual void MapExchange(MapFile &f);
@@ -97,10 +99,8 @@ protected:
 	unsigned int GetFlags() const { return _flags; }
 	bool CheckFlags(unsigned int flags) const { return 0 != (_flags & flags); }
 
-	typedef PropertySet MyPropertySet;
-	virtual PropertySet* NewPropertySet();
-
 private:
+	friend struct SnapshotAccess;
 	unsigned int _flags = 0;
 	ObjectList::id_type _posLIST_objects;
 };
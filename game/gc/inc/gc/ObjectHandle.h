@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Weak reference to an object of a world, resolved with World::GetObject.
+// Unlike ObjPtr it does not keep the object memory around: once the object
+// is gone the slot moves on to the next generation and the handle no longer
+// resolves.
+struct ObjectHandle
+{
+	uint32_t index = 0;
+	uint32_t generation = 0; // zero never resolves
+
+	explicit operator bool() const { return 0 != generation; }
+	bool operator==(ObjectHandle other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(ObjectHandle other) const { return !(*this == other); }
+};
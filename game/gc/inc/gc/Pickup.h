@@ -46,6 +46,7 @@ class GC_Pickup : public GC_MovingObject
 {
 	DECLARE_LIST_MEMBER(override);
 	DECLARE_GRID_MEMBER();
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	using GC_MovingObject::GC_MovingObject;
@@ -77,7 +78,7 @@ public:
 	bool GetBlinking() const { return CheckFlags(GC_FLAG_PICKUP_BLINK); }
 
 	// if 0 then item considered useless and will not be taken
-	virtual AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const { return AIP_NORMAL; }
+	virtual AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const { return AIP_NORMAL; }
 	virtual bool ShouldPickup(const GC_Vehicle& veh) const { return true; }
 
 	virtual void Detach(World &world);
@@ -100,22 +101,6 @@ public:
 	}
 #endif
 
-protected:
-	class MyPropertySet : public GC_MovingObject::MyPropertySet
-	{
-		typedef GC_MovingObject::MyPropertySet BASE;
-		ObjectProperty _propTimeRespawn;
-		ObjectProperty _propOnPickup;
-
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-
-	PropertySet* NewPropertySet() override;
-
 private:
 	std::string _scriptOnPickup;   // on_pickup(who)
 	float _timeLastStateChange = 0;
@@ -137,7 +122,7 @@ public:
 
 	// GC_Pickup
 	float GetDefaultRespawnTime() const override { return 15.0f; }
-	AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const override;
+	AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const override;
 
 protected:
 	void OnAttached(World &world, GC_Vehicle &vehicle) override;
@@ -154,7 +139,7 @@ public:
 	GC_pu_Mine(FromFile);
 
 	float GetDefaultRespawnTime() const override { return 15.0f; }
-	AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const override;
+	AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const override;
 
 protected:
 	void OnAttached(World &world, GC_Vehicle &vehicle) override;
@@ -178,7 +163,7 @@ public:
 	// GC_Pickup
 	void Detach(World &world) override;
 	float GetDefaultRespawnTime() const override { return 30.0f; }
-	AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const override;
+	AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const override;
 
 	// GC_Object
 	void Serialize(World &world, SaveFile &f) override;
@@ -216,7 +201,7 @@ public:
 	// GC_Pickup
 	void Detach(World &world) override;
 	float GetDefaultRespawnTime() const override { return 15.0f; }
-	AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const override;
+	AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const override;
 
 	// GC_Object
 	void Kill(World &world) override;
@@ -231,7 +216,7 @@ private:
 	ObjPtr<GC_Vehicle> _vehicle;
 	vec2d _targetPos;
 
-	GC_Vehicle *FindNearVehicle(World &world, const GC_RigidBodyStatic *ignore) const;
+	GC_Vehicle *FindNearVehicle(const World &world, const GC_RigidBodyStatic *ignore) const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -251,7 +236,7 @@ public:
 	// GC_Pickup
 	void Detach(World &world) override;
 	float GetDefaultRespawnTime() const override { return 30.0f; }
-	AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const override;
+	AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const override;
 
 	// GC_Object
 	void Serialize(World &world, SaveFile &f) override;
@@ -16,6 +16,7 @@ class GC_Player : public GC_Service
 {
 	DECLARE_SELF_REGISTRATION(GC_Player);
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	GC_Player();
@@ -58,27 +59,6 @@ public:
 	void Init(World &world) override;
 	void Resume(World &world) override;
 
-protected:
-	class MyPropertySet : public GC_Service::MyPropertySet
-	{
-		typedef GC_Service::MyPropertySet BASE;
-
-		ObjectProperty _propTeam;
-		ObjectProperty _propScore;
-		ObjectProperty _propNick;
-		ObjectProperty _propClass;
-		ObjectProperty _propSkin;
-		ObjectProperty _propOnDie;
-		ObjectProperty _propOnRespawn;
-		ObjectProperty _propVehName;
-
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
 
 private:
 	int _team = 0;
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "ObjectProperty.h"
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class GC_Object;
+class World;
+
+constexpr uint32_t PropertyNameHash(std::string_view name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for( char c: name )
+		hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+	return hash;
+}
+
+// Describes a single property of a game class. Accessors work directly on the
+// object so that reading or writing one property does not need a PropertySet.
+struct PropertyDesc
+{
+	typedef int (*GetIntProc)(const GC_Object &, World &);
+	typedef void (*SetIntProc)(GC_Object &, World &, int);
+	typedef float (*GetFloatProc)(const GC_Object &, World &);
+	typedef void (*SetFloatProc)(GC_Object &, World &, float);
+	typedef std::string_view (*GetStringProc)(const GC_Object &, World &);
+	typedef void (*SetStringProc)(GC_Object &, World &, std::string_view);
+	typedef const char* (*ListItemProc)(unsigned int index); // returns nullptr past the end
+
+	std::string_view name;
+	uint32_t hash;
+	ObjectProperty::PropertyType type;
+
+	int intMin;
+	int intMax;
+	float floatMin;
+	float floatMax;
+
+	GetIntProc getInt;       // TYPE_INTEGER; current index for TYPE_MULTISTRING
+	SetIntProc setInt;
+	GetFloatProc getFloat;   // TYPE_FLOAT
+	SetFloatProc setFloat;
+	GetStringProc getString; // TYPE_STRING, TYPE_SKIN, TYPE_TEXTURE
+	SetStringProc setString;
+	ListItemProc listItem;   // TYPE_MULTISTRING
+
+	bool applyLast;          // PropertySet applies it after all other properties
+};
+
+constexpr PropertyDesc IntProperty(std::string_view name, int min, int max,
+                                   PropertyDesc::GetIntProc get, PropertyDesc::SetIntProc set)
+{
+	return { name, PropertyNameHash(name), ObjectProperty::TYPE_INTEGER, min, max, 0, 0,
+	         get, set, nullptr, nullptr, nullptr, nullptr, nullptr, false };
+}
+
+constexpr PropertyDesc FloatProperty(std::string_view name, float min, float max,
+                                     PropertyDesc::GetFloatProc get, PropertyDesc::SetFloatProc set)
+{
+	return { name, PropertyNameHash(name), ObjectProperty::TYPE_FLOAT, 0, 0, min, max,
+	         nullptr, nullptr, get, set, nullptr, nullptr, nullptr, false };
+}
+
+constexpr PropertyDesc StringProperty(std::string_view name,
+                                      PropertyDesc::GetStringProc get, PropertyDesc::SetStringProc set,
+                                      ObjectProperty::PropertyType type = ObjectProperty::TYPE_STRING)
+{
+	return { name, PropertyNameHash(name), type, 0, 0, 0, 0,
+	         nullptr, nullptr, nullptr, nullptr, get, set, nullptr, false };
+}
+
+constexpr PropertyDesc ListProperty(std::string_view name, PropertyDesc::ListItemProc items,
+                                    PropertyDesc::GetIntProc get, PropertyDesc::SetIntProc set)
+{
+	return { name, PropertyNameHash(name), ObjectProperty::TYPE_MULTISTRING, 0, 0, 0, 0,
+	         get, set, nullptr, nullptr, nullptr, nullptr, items, false };
+}
+
+// Use for a property whose setter depends on the values of the others
+constexpr PropertyDesc ApplyLast(PropertyDesc desc)
+{
+	desc.applyLast = true;
+	return desc;
+}
+
+// Flattened list of class properties, base class properties first.
+// Built once per class; lookup by name is a binary search over hashes.
+class PropertyTable final
+{
+public:
+	PropertyTable(const PropertyTable *base, std::vector<PropertyDesc> own);
+	PropertyTable(const PropertyTable&) = delete;
+	PropertyTable& operator=(const PropertyTable&) = delete;
+
+	int GetCount() const { return static_cast<int>(_properties.size()); }
+	const PropertyDesc& GetProperty(int index) const { return _properties[index]; }
+
+	// returns -1 if not found
+	int Find(std::string_view name) const;
+
+private:
+	std::vector<PropertyDesc> _properties;
+	std::vector<std::pair<uint32_t, int>> _hashToIndex; // sorted by hash
+};
+
+#define DECLARE_PROPERTY_TABLE()                                            \
+    public:                                                                 \
+        static const PropertyTable& GetPropertyTableStatic();               \
+        const PropertyTable& GetPropertyTable() const override;             \
+    private:                                                                \
+        static std::vector<PropertyDesc> DescribePropertiesImpl();
+
+#define IMPLEMENT_PROPERTY_TABLE(base, cls)                                 \
+    const PropertyTable& cls::GetPropertyTableStatic()                      \
+    {                                                                       \
+        static const PropertyTable table(&base::GetPropertyTableStatic(),   \
+                                         DescribePropertiesImpl());         \
+        return table;                                                       \
+    }                                                                       \
+    const PropertyTable& cls::GetPropertyTable() const                      \
+    {                                                                       \
+        return GetPropertyTableStatic();                                    \
+    }                                                                       \
+    std::vector<PropertyDesc> cls::DescribePropertiesImpl()
@@ -17,6 +17,7 @@ struct DamageDesc
 class GC_RigidBodyStatic : public GC_MovingObject
 {
 	DECLARE_GRID_MEMBER();
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_RigidBodyStatic(vec2d pos);
@@ -70,20 +71,6 @@ public:
 #endif
 
 protected:
-	class MyPropertySet : public GC_MovingObject::MyPropertySet
-	{
-		typedef GC_MovingObject::MyPropertySet BASE;
-		ObjectProperty _propOnDestroy;
-		ObjectProperty _propOnDamage;
-		ObjectProperty _propHealth;
-		ObjectProperty _propMaxHealth;
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
 	virtual void OnDestroy(World &world, const DamageDesc &dd);
 	virtual void OnDamage(World &world, DamageDesc &damageDesc);
 
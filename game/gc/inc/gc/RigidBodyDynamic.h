@@ -2,14 +2,19 @@
 #include "RigidBody.h"
 #include "ObjPtr.h"
 #include <stack>
+#include <vector>
 
-#define GC_FLAG_RBDYMAMIC_ACTIVE    (GC_FLAG_RBSTATIC_ << 0)
+#define GC_FLAG_RBDYMAMIC_SLEEPING  (GC_FLAG_RBSTATIC_ << 0)
 #define GC_FLAG_RBDYMAMIC_PARITY    (GC_FLAG_RBSTATIC_ << 1)
 #define GC_FLAG_RBDYMAMIC_          (GC_FLAG_RBSTATIC_ << 2)
 
+class TaskPool;
+struct DetectedContact;
 
 class GC_RigidBodyDynamic : public GC_RigidBodyStatic
 {
+	DECLARE_PROPERTY_TABLE();
+
 public:
 	float GetSpinup() const;
 	vec2d GetBrakingLength() const;
@@ -18,11 +23,19 @@ public:
 	explicit GC_RigidBodyDynamic(vec2d pos);
 	explicit GC_RigidBodyDynamic(FromFile);
 
-	PropertySet* NewPropertySet() override;
 	void MapExchange(MapFile &f) override;
+	void MoveTo(World &world, const vec2d &pos) override;
 	void Serialize(World &world, SaveFile &f) override;
 	void TimeStep(World &world, float dt) override;
 
+	// A body at rest drops out of LIST_timestep together with every awake body
+	// it touches. Impulses, forces, MoveTo and hits by moving bodies wake it up.
+	virtual bool CanSleep() const { return true; }
+	bool IsSleeping() const { return CheckFlags(GC_FLAG_RBDYMAMIC_SLEEPING); }
+	void Wake(World &world);
+
+	// narrow phase for every body moved by TimeStep since the previous call
+	static void DetectCollisions(World &world, TaskPool *taskPool);
 	static void ProcessResponse(World &world);
 	static void PushState();
 	static void PopState();
@@ -50,13 +63,13 @@ public:
 
 	//--------------------------------
 
-	void ApplyTorque(float torque);
-	void ApplyForce(const vec2d &force);
-	void ApplyForce(const vec2d &force, const vec2d &origin);
+	void ApplyTorque(World &world, float torque);
+	void ApplyForce(World &world, const vec2d &force);
+	void ApplyForce(World &world, const vec2d &force, const vec2d &origin);
 
-	void ApplyMomentum(float momentum);
-	void ApplyImpulse(const vec2d &impulse);
-	void ApplyImpulse(const vec2d &impulse, const vec2d &origin);
+	void ApplyMomentum(World &world, float momentum);
+	void ApplyImpulse(World &world, const vec2d &impulse);
+	void ApplyImpulse(World &world, const vec2d &impulse, const vec2d &origin);
 
 	//--------------------------------
 
@@ -91,20 +104,30 @@ public:
 private:
 	DECLARE_LIST_MEMBER(override);
 
-	struct Contact
+	// Contacts are stored column-wise; the solver passes walk only the columns
+	// they need. ObjPtr columns keep bodies addressable if they die mid-solve.
+	struct ContactList
 	{
-		ObjPtr<GC_RigidBodyDynamic> obj1_d;
-		ObjPtr<GC_RigidBodyStatic>  obj2_s;
-		GC_RigidBodyDynamic *obj2_d;
-		vec2d origin;
-		vec2d normal;
-		vec2d tangent;
-		float total_np, total_tp;
-		float depth;
-//		bool  inactive;
+		std::vector<ObjPtr<GC_RigidBodyDynamic>> obj1_d;
+		std::vector<ObjPtr<GC_RigidBodyStatic>> obj2_s;
+		std::vector<GC_RigidBodyDynamic*> obj2_d;
+		std::vector<vec2d> origin;
+		std::vector<vec2d> normal;
+		std::vector<float> depth;
+
+		// solver state
+		std::vector<GC_RigidBodyDynamic*> body1; // null once dead
+		std::vector<GC_RigidBodyStatic*> body2;  // null once dead
+		std::vector<float> total_np;
+		std::vector<float> warm_np;  // warm start impulse not yet taken back
+		std::vector<float> warm_damage; // share of warm_np not yet dealt as damage
+
+		size_t size() const { return origin.size(); }
+		void push_back(GC_RigidBodyDynamic *obj1, GC_RigidBodyStatic *obj2, vec2d origin, vec2d normal, float depth);
+		void clear();
+		void swap(ContactList &other);
 	};
 
-	typedef std::vector<Contact> ContactList;
 	static ContactList _contacts;
 	static std::stack<ContactList> _contactsStack;
 	static bool _glob_parity;
@@ -113,6 +136,11 @@ private:
 	float geta_d(const vec2d &n, const vec2d &c, const GC_RigidBodyDynamic *obj) const;
 
 	void impulse(const vec2d &origin, const vec2d &impulse);
+	void CollectContacts(const World &world, std::vector<DetectedContact> &contacts);
+	void Sleep(World &world);
+	static void WarmStartContacts(const World &world);
+	static void UpdateWarmStart(World &world);
+	static void UpdateIslands(World &world);
 
 	bool parity() { return CheckFlags(GC_FLAG_RBDYMAMIC_PARITY); }
 
@@ -122,24 +150,6 @@ private:
 	vec2d _external_impulse;
 	float _external_torque;
 
-
-	class MyPropertySet : public GC_RigidBodyStatic::MyPropertySet
-	{
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-
-	private:
-		typedef GC_RigidBodyStatic::MyPropertySet BASE;
-		ObjectProperty _propM;  // mass
-		ObjectProperty _propI;  // scalar moment of inertia
-		ObjectProperty _propPercussion;
-		ObjectProperty _propFragility;
-		ObjectProperty _propNx;
-		ObjectProperty _propNy;
-		ObjectProperty _propNw;
-		ObjectProperty _propRotation;
-	};
+	float _restTime;  // how long the body has been slower than the sleep thresholds
+	int _island;      // index into World::_movedBodies while islands are being built, otherwise -1
 };
@@ -37,6 +37,8 @@ public:
 	void SerializeArray(T *p, size_t count);
 
 	void RegPointer(GC_Object *ptr);
+	void UnregPointer(GC_Object *ptr); // the id goes to the next RegPointer, last freed first
+	size_t GetPointerTableSize() const { return _indexToPtr.size(); }
 	size_t GetPointerId(GC_Object *ptr) const;
 	GC_Object* RestorePointer(size_t id) const;
 
@@ -53,6 +55,7 @@ private:
 
 	PtrToIndex _ptrToIndex;
 	IndexToPtr _indexToPtr;
+	std::vector<size_t> _freeIndices;
 
 	FS::Stream &_stream;
 	bool _load;
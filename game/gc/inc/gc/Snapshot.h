@@ -0,0 +1,87 @@
+#pragma once
+#include "WorldEvents.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class GC_Object;
+class SaveFile;
+class World;
+
+namespace detail
+{
+	class SnapshotBuffer;
+}
+
+// Quantized part of an object state sent every tick it changes.
+struct SnapshotState
+{
+	int32_t posX;   // 1/16 world units
+	int32_t posY;
+	uint16_t angle; // direction, full turn is 65536
+	int32_t lvX;    // 1/16 units per second
+	int32_t lvY;
+	int32_t av;     // 1/256 radians per second
+	int32_t health; // 1/16 hit points
+	uint32_t flags;
+};
+
+// Produces a compressed baseline of the whole world followed by per-tick deltas:
+// killed objects, new objects in full, and the fields of SnapshotState that
+// changed for everything else. Other object state only converges on the next
+// baseline, so feeds should send one periodically.
+class SnapshotEncoder final
+	: ObjectListener<World>
+{
+public:
+	explicit SnapshotEncoder(World &world);
+	~SnapshotEncoder();
+
+	// Restarts the stream; late joiners begin from here.
+	std::vector<char> EncodeBaseline();
+
+	// Changes since the previous baseline or delta.
+	std::vector<char> EncodeDelta();
+
+private:
+	World &_world;
+	std::unique_ptr<detail::SnapshotBuffer> _buffer;
+	std::unique_ptr<SaveFile> _pointers;
+	std::unordered_map<GC_Object*, SnapshotState> _sent;
+	std::vector<GC_Object*> _new;
+	std::vector<uint32_t> _killed;
+	uint32_t _decalsEnd = 0; // first decal not sent yet
+	uint32_t _sequence = 0;
+
+	std::vector<char> Finish(uint8_t kind);
+
+	// ObjectListener<World>
+	void OnKill(GC_Object &obj) override;
+	void OnNewObject(GC_Object &obj) override;
+	void OnClear() override;
+	void OnGameStarted() override {}
+	void OnGameFinished() override {}
+};
+
+// Rebuilds the world on the receiving side. Deltas that arrive before the
+// first baseline, or after a gap in the sequence, are ignored until the next
+// baseline.
+class SnapshotDecoder final
+{
+public:
+	SnapshotDecoder();
+	~SnapshotDecoder();
+
+	// Returns false if the snapshot was skipped.
+	bool Apply(const void *data, size_t size);
+
+	World* GetWorld() const { return _world.get(); }
+
+private:
+	std::unique_ptr<World> _world;
+	std::unique_ptr<detail::SnapshotBuffer> _buffer;
+	std::unique_ptr<SaveFile> _pointers;
+	uint32_t _sequence = 0;
+	bool _synced = false;
+};
@@ -7,6 +7,7 @@ class GC_SpawnPoint : public GC_MovingObject
 {
 	DECLARE_SELF_REGISTRATION(GC_SpawnPoint);
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	int _team;    // 0 - no team
@@ -18,18 +19,4 @@ public:
 	// GC_Object
 	void Serialize(World &world, SaveFile &f) override;
 	void MapExchange(MapFile &f) override;
-
-protected:
-	class MyPropertySet : public GC_MovingObject::MyPropertySet
-	{
-		typedef GC_MovingObject::MyPropertySet BASE;
-		ObjectProperty _propTeam;
-		ObjectProperty _propDir;
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
 };
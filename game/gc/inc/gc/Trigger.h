@@ -14,6 +14,7 @@ class GC_Trigger : public GC_MovingObject
 {
 	DECLARE_SELF_REGISTRATION(GC_Trigger);
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_Trigger(vec2d pos);
@@ -29,28 +30,6 @@ public:
 	void TimeStep(World &world, float dt) override;
 
 private:
-	class MyPropertySet : public GC_MovingObject::MyPropertySet
-	{
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-
-	private:
-		typedef GC_MovingObject::MyPropertySet BASE;
-		ObjectProperty _propActive;
-		ObjectProperty _propTeam;
-		ObjectProperty _propRadius;
-		ObjectProperty _propRadiusDelta;
-		ObjectProperty _propOnlyVisible;
-		ObjectProperty _propOnlyHuman;
-		ObjectProperty _propOnEnter;
-		ObjectProperty _propOnLeave;
-	};
-
-	PropertySet* NewPropertySet() override;
-
 	float    _radius;
 	float    _radiusDelta;
 	int      _team;
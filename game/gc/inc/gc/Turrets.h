@@ -21,6 +21,7 @@ enum TurretState
 class GC_Turret : public GC_RigidBodyStatic
 {
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	GC_Turret(vec2d pos, TurretState state);
@@ -60,20 +61,6 @@ protected:
 	void SetFire(World &world, bool fire);
 
 protected:
-	class MyPropertySet : public GC_RigidBodyStatic::MyPropertySet
-	{
-		typedef GC_RigidBodyStatic::MyPropertySet BASE;
-		ObjectProperty _propTeam;
-		ObjectProperty _propSight;
-		ObjectProperty _propDir;
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
-
 	void SetState(World &world, TurretState state);
 
 protected:
@@ -23,8 +23,8 @@ public:
 		};
 		union
 		{
-			GC_MovingObject& (*CreateDetachedObject)(vec2d pos);
-			GC_Service& (*CreateDetachedService)();
+			GC_MovingObject& (*CreateDetachedObject)(World &, vec2d pos);
+			GC_Service& (*CreateDetachedService)(World &);
 		};
 		int           layer;
 		float         align;
@@ -42,15 +42,15 @@ private:
 	typedef std::vector<ObjectType> index2type;
 
 	template<class T>
-	static GC_MovingObject& DetachedObjectCtor(vec2d pos)
+	static GC_MovingObject& DetachedObjectCtor(World &world, vec2d pos)
 	{
-		return *new T(pos);
+		return world.NewDetached<T>(pos);
 	}
 
 	template<class T>
-	static GC_Service& DetachedServiceCtor()
+	static GC_Service& DetachedServiceCtor(World &world)
 	{
-		return *new T();
+		return world.NewDetached<T>();
 	}
 
 	template<class T>
@@ -68,10 +68,22 @@ private:
 	template<class T>
 	static GC_Object& FromFileCtor(World &world)
 	{
-		return world.New<T>(::FromFile());
+		return world.NewFromFile<T>();
+	}
+
+	// the qualified call is resolved at compile time
+	template<class T>
+	static void TimeStepAll(World &world, PtrList<GC_Object> &objects, float dt)
+	{
+		objects.for_each([&world, dt](PtrList<GC_Object>::id_type, GC_Object *obj)
+		{
+			static_cast<T*>(obj)->T::TimeStep(world, dt);
+		});
 	}
 
 public:
+	typedef void (*TimeStepProc)(World &world, PtrList<GC_Object> &objects, float dt);
+
 	// access to singleton instance
 	static RTTypes& Inst()
 	{
@@ -132,6 +144,9 @@ public:
 		// for serialization
 		assert(!_ffm.count(type));
 		_ffm[type] = FromFileCtor<T>;
+		// for the update loop
+		_typeNames.push_back(name);
+		_timeStepProcs.push_back(TimeStepAll<T>);
 		return type;
 	}
 
@@ -166,6 +181,14 @@ public:
 	{
 		return _t2i.find(type) != _t2i.end();
 	}
+	const char* GetTypeName(ObjectType type) const
+	{
+		return _typeNames.at(type);
+	}
+	TimeStepProc GetTimeStepProc(ObjectType type) const
+	{
+		return _timeStepProcs.at(type);
+	}
 
 
 	//
@@ -187,6 +210,9 @@ private:
 	index2type _i2t; // sort by desc
 	// for serialization
 	std::map<ObjectType, GC_Object& (*) (World&)> _ffm;
+	// for the update loop, by type
+	std::vector<const char*> _typeNames;
+	std::vector<TimeStepProc> _timeStepProcs;
 	// common
 	std::set<std::string> _types;
 	// use as singleton only
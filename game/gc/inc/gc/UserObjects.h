@@ -5,6 +5,7 @@
 class GC_UserObject : public GC_RigidBodyStatic
 {
 	DECLARE_SELF_REGISTRATION(GC_UserObject);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_UserObject(vec2d pos);
@@ -24,19 +25,6 @@ public:
 
 	void MapExchange(MapFile &f) override;
 
-protected:
-	class MyPropertySet : public GC_RigidBodyStatic::MyPropertySet
-	{
-		typedef GC_RigidBodyStatic::MyPropertySet BASE;
-		ObjectProperty _propTexture;
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
-
 private:
 	std::string _textureName;
 	enumZOrder _zOrder;
@@ -47,6 +35,7 @@ private:
 class GC_Decoration : public GC_MovingObject
 {
 	DECLARE_SELF_REGISTRATION(GC_Decoration);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_Decoration(vec2d pos);
@@ -63,24 +52,6 @@ public:
 	void Serialize(World &world, SaveFile &f) override;
 	void TimeStep(World &world, float dt) override;
 
-protected:
-	class MyPropertySet : public GC_MovingObject::MyPropertySet
-	{
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	private:
-		typedef GC_MovingObject::MyPropertySet BASE;
-		ObjectProperty _propTexture;
-		ObjectProperty _propLayer;
-		ObjectProperty _propAnimate;
-		ObjectProperty _propFrame;
-		ObjectProperty _propRotation;
-	};
-	PropertySet* NewPropertySet() override;
-
 private:
 	std::string _textureName;
 	float _frameRate;
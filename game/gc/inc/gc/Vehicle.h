@@ -63,6 +63,9 @@ public:
 	uint8_t GetObstacleFlags() const override { return 0; } // not an obstacle
 	GC_Player* GetOwner() const override { return _player; }
 
+	// GC_RigidBodyDynamic
+	bool CanSleep() const override { return false; } // driven from its own TimeStep
+
 	// GC_MovingObject
 	void MoveTo(World &world, const vec2d &pos) override;
 
@@ -19,6 +19,7 @@ class GC_Wall : public GC_RigidBodyStatic
 {
 	DECLARE_GRID_MEMBER();
 	DECLARE_SELF_REGISTRATION(GC_Wall);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_Wall(vec2d pos);
@@ -44,19 +45,6 @@ public:
 	void Serialize(World &world, SaveFile &f) override;
 
 protected:
-	class MyPropertySet : public GC_RigidBodyStatic::MyPropertySet
-	{
-		typedef GC_RigidBodyStatic::MyPropertySet BASE;
-		ObjectProperty _propCorner;
-		ObjectProperty _propStyle;
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
-
 	void OnDestroy(World &world, const DamageDesc &dd) override;
 	void OnDamage(World &world, DamageDesc &dd) override;
 };
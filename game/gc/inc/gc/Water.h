@@ -17,6 +17,7 @@ public:
 	// GC_Object
 	void Init(World &world) override;
 	void Kill(World &world) override;
+	void Serialize(World &world, SaveFile &f) override;
 
 	// GC_MovingObject
 	void MoveTo(World &world, const vec2d &pos) override;
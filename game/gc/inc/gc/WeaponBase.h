@@ -22,6 +22,7 @@ struct AIWEAPSETTINGS
 class GC_Weapon : public GC_Pickup
 {
 	DECLARE_LIST_MEMBER(override);
+	DECLARE_PROPERTY_TABLE();
 
 public:
 	explicit GC_Weapon(vec2d pos);
@@ -46,7 +47,7 @@ public:
 	void Detach(World &world) override;
 	void Disappear(World &world) override;
 	float GetDefaultRespawnTime() const override { return 6.0f; }
-	AIPRIORITY GetPriority(World &world, const GC_Vehicle &veh) const override;
+	AIPRIORITY GetPriority(const World &world, const GC_Vehicle &veh) const override;
 	bool ShouldPickup(const GC_Vehicle& veh) const override;
 
 	// GC_MovingObject
@@ -67,18 +68,6 @@ public:
 #endif
 
 protected:
-	class MyPropertySet : public GC_Pickup::MyPropertySet
-	{
-		typedef GC_Pickup::MyPropertySet BASE;
-		ObjectProperty _propTimeStay;
-
-	public:
-		MyPropertySet(GC_Object *object);
-		virtual int GetCount() const;
-		virtual ObjectProperty* GetProperty(int index);
-		virtual void MyExchange(World &world, bool applyToObject);
-	};
-	PropertySet* NewPropertySet() override;
 	void OnAttached(World &world, GC_Vehicle &vehicle) override;
 
 private:
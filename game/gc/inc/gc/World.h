@@ -1,14 +1,18 @@
 #pragma once
+#include "DecalStore.h"
 #include "Grid.h"
 #include "ObjPtr.h"
+#include "ObjectHandle.h"
+#include "Serialization.h"
 #include "WorldEvents.h"
 #include "detail/GlobalListHelper.h"
 #include "detail/JobManager.h"
 #include "detail/MemoryManager.h"
 #include "detail/PtrList.h"
+#include "detail/TimerWheel.h"
+#include <algorithm>
 #include <map>
 #include <memory>
-#include <queue>
 #include <set>
 #include <string>
 #include <vector>
@@ -22,10 +26,32 @@ class MapFile;
 class SaveFile;
 class GC_Object;
 class GC_Player;
+class GC_RigidBodyDynamic;
 class GC_RigidBodyStatic;
+class TaskPool;
 
 template<class> struct ObjectListener;
 
+// normal impulse a contact needed in the previous step; warm starts the solver
+struct ContactImpulse
+{
+	PtrList<GC_Object>::id_type id1;
+	PtrList<GC_Object>::id_type id2;
+	vec2d normal;
+	float np;
+};
+
+// contact found by a collision detection task; plain pointers, since the
+// tasks must not touch reference counts
+struct DetectedContact
+{
+	GC_RigidBodyDynamic *obj1;
+	GC_RigidBodyStatic *obj2;
+	vec2d origin;
+	vec2d normal;
+	float depth;
+};
+
 template<class T>
 class EventsHub
 {
@@ -50,24 +76,98 @@ private:
 
 #define DECLARE_EVENTS(cls) EventsHub<::cls> e##cls;
 
-class ResumableObject
+// Events are copied into a queue per listener as they happen and delivered
+// by Flush. A listener may pass a filter to keep unwanted events out of its
+// queue without paying for a virtual call on each of them.
+template<class E>
+class EventQueue
+{
+public:
+	typedef bool (*Filter)(const E &e);
+
+	void AddListener(DeferredListener<E> &ls, Filter filter = nullptr)
+	{
+		_subscribers.push_back(Subscriber{ &ls, filter, {} });
+	}
+
+	void RemoveListener(DeferredListener<E> &ls)
+	{
+		assert(!_flushing);
+		auto it = std::find_if(_subscribers.begin(), _subscribers.end(), [&](const Subscriber &s) { return s.listener == &ls; });
+		assert(_subscribers.end() != it);
+		*it = std::move(_subscribers.back());
+		_subscribers.pop_back();
+	}
+
+	void Push(const E &e)
+	{
+		for( auto &s: _subscribers )
+		{
+			if( !s.filter || s.filter(e) )
+				s.events.push_back(e);
+		}
+	}
+
+	void Flush()
+	{
+		assert(!_flushing);
+		_flushing = true;
+		for( auto &s: _subscribers )
+		{
+			if( !s.events.empty() )
+			{
+				s.listener->OnEvents(s.events.data(), s.events.size());
+				s.events.clear();
+			}
+		}
+		_flushing = false;
+	}
+
+	void Clear()
+	{
+		for( auto &s: _subscribers )
+			s.events.clear();
+	}
+
+private:
+	struct Subscriber
+	{
+		DeferredListener<E> *listener;
+		Filter filter;
+		std::vector<E> events;
+	};
+	std::vector<Subscriber> _subscribers;
+	bool _flushing = false;
+};
+
+class ResumableObject : private TimerNode
 {
 	DECLARE_POOLED_ALLOCATION(ResumableObject);
 	ResumableObject(const ResumableObject&) = delete;
 	ResumableObject& operator = (const ResumableObject&) = delete;
 public:
-	void Cancel() { ptr = nullptr; }
+	void Cancel() { Unlink(); delete this; }
 
 private:
 	friend class World;
-	explicit ResumableObject(GC_Object &obj) : ptr(&obj) {}
+	explicit ResumableObject(GC_Object *obj) : ptr(obj) {}
 	ObjPtr<GC_Object> ptr;
 };
 
 #define SAFE_CANCEL(ro) if(ro) { ro->Cancel(); ro = nullptr; } else (void)0
 
+struct ArenaStats
+{
+	unsigned int type; // ObjectType
+	MemoryPoolStats stats;
+};
+
 class World
 {
+	// Objects of this world live here. Declared first so that it is destroyed
+	// after every member that may still reference an object.
+	std::vector<std::unique_ptr<MemoryPoolBase>> _arenas; // by ObjectType
+
 public:
 	DECLARE_EVENTS(GC_Explosion);
 	DECLARE_EVENTS(GC_Pickup);
@@ -82,6 +182,9 @@ public:
 	DECLARE_EVENTS(GC_Vehicle);
 	DECLARE_EVENTS(World);
 
+	// delivered at the end of Step
+	EventQueue<ContactEvent> eContacts;
+
 #ifdef NETWORK_DEBUG
 	uint32_t _checksum;
 	int _frame;
@@ -93,12 +196,19 @@ public:
 	PtrList<GC_Object>& GetList(GlobalListID id) { return _objectLists[id]; }
 	const PtrList<GC_Object>& GetList(GlobalListID id) const { return _objectLists[id]; }
 
+	// list membership changes that also keep the update groups of LIST_timestep in sync
+	void ListInsert(GlobalListID id, GC_Object &obj, PtrList<GC_Object>::id_type pos);
+	void ListErase(GlobalListID id, GC_Object &obj, PtrList<GC_Object>::id_type pos);
+
 	JobManager<GC_Turret> _jobManager;
 
 	Grid<PtrList<GC_Object>>  grid_rigid_s;
 	Grid<PtrList<GC_Object>>  grid_walls;
 	Grid<PtrList<GC_Object>>  grid_pickup;
 	Grid<PtrList<GC_Object>>  grid_moving;
+	Grid<PtrList<GC_Object>>  grid_lights;
+
+	DecalStore _decals;
 
 	std::vector<bool> _waterTiles;
 	std::vector<bool> _woodTiles;
@@ -113,6 +223,11 @@ public:
 	unsigned long _seed;
 
 	std::unique_ptr<Field> _field;
+	std::vector<ContactImpulse> _contactImpulses; // sorted by ids
+	std::vector<ObjPtr<GC_RigidBodyDynamic>> _movedBodies; // stepped this frame, in step order
+	std::vector<std::vector<DetectedContact>> _detectedContacts; // per collision detection chunk
+	bool _warmStartContacts = true;
+	int _solverPasses = 0;
 	bool  _safeMode;
 
 public:
@@ -127,14 +242,41 @@ public:
 	template<class T, class ...Args>
 	T& New(Args && ... args)
 	{
-		auto t = new T(std::forward<Args>(args)...);
+		auto t = new (GetArena<T>()) T(std::forward<Args>(args)...);
 		t->Register(*this);
 		t->Init(*this);
-		for( auto ls: eWorld._listeners )
-			ls->OnNewObject(*t);
+		OnNewObject(*t);
 		return *t;
 	}
 
+	// allocated in this world, but left to the caller to set up, register and initialize
+	template<class T, class ...Args>
+	T& NewDetached(Args && ... args)
+	{
+		return *new (GetArena<T>()) T(std::forward<Args>(args)...);
+	}
+
+	// a blank object for Serialize to fill in, so it is neither initialized nor
+	// announced here; a loader that has listeners announces it once it is complete
+	template<class T>
+	T& NewFromFile()
+	{
+		auto t = new (GetArena<T>()) T(FromFile());
+		t->Register(*this);
+		return *t;
+	}
+
+	// null handle for null
+	ObjectHandle GetHandle(const GC_Object *obj) const;
+	GC_Object* GetObject(ObjectHandle handle) const
+	{
+		return handle.index < _handles.size() && _handles[handle.index].generation == handle.generation ?
+			_handles[handle.index].obj : nullptr;
+	}
+
+	// one entry per object type allocated in this world so far
+	std::vector<ArenaStats> GetArenaStats() const;
+
 	void Serialize(SaveFile &f);
 
 	FRECT GetOccupiedBounds() const;
@@ -153,7 +295,7 @@ public:
 	                   float projectileSpeed,
 	                   vec2d targetPos,
 	                   vec2d targetVelocity,
-	                   vec2d &out_fake );  // out: fake target position
+	                   vec2d &out_fake ) const;  // out: fake target position
 
 	int GetTileIndex(vec2d pos) const;
 	int GetTileIndex(int blockX, int blockY) const;
@@ -191,6 +333,14 @@ public:
 	GC_Player* GetPlayerByIndex(size_t playerIndex);
 	void Seed(unsigned long seed);
 
+	// optional workers for the collision detection phase of Step
+	void SetTaskPool(TaskPool *taskPool) { _taskPool = taskPool; }
+	TaskPool* GetTaskPool() const { return _taskPool; }
+
+	// without warm start every contact is solved from zero, as it was before the cache
+	void SetWarmStartContacts(bool enable) { _warmStartContacts = enable; }
+	int GetSolverPasses() const { return _solverPasses; } // in the last step
+
 	float GetTime() const { return _time; }
 	const RectRB& GetLocationBounds() const { return _locationBounds; }
 	const RectRB& GetBlockBounds() const { return _blockBounds; }
@@ -202,23 +352,10 @@ public:
 #endif
 
 	ResumableObject* Timeout(GC_Object &obj, float timeout);
-	size_t GetResumableCount() const { return _resumables.size(); }
+	size_t GetResumableCount() const { return _timers.GetCount(); }
 
 private:
-	struct Resumable
-	{
-		std::unique_ptr<ResumableObject> obj;
-		float time;
-		bool operator<(const Resumable &other) const
-		{
-			return time > other.time;
-		}
-		Resumable(std::unique_ptr<ResumableObject> obj_, float time_)
-			: obj(std::move(obj_))
-			, time(time_)
-		{}
-	};
-	std::priority_queue<Resumable> _resumables;
+	TimerWheel _timers; // one tick per millisecond
 	float _time;
 
 	bool _gameStarted;
@@ -226,14 +363,55 @@ private:
 	FRECT _bounds;
 	RectRB _blockBounds;
 	RectRB _locationBounds;
+	TaskPool *_taskPool;
 
 	friend class GC_Object;
+	friend struct SnapshotAccess;
 
 	void OnKill(GC_Object &obj);
+	void OnNewObject(GC_Object &obj);
 
 	std::map<std::string, const GC_Object*, std::less<>> _nameToObjectMap;
 	std::map<const GC_Object*, std::string_view> _objectToStringMap; // string owned by _nameToObjectMap
 
 	PtrList<GC_Object> _objectLists[GLOBAL_LIST_COUNT];
+
+	// indexed by object id; never shrinks so that stale handles keep failing
+	struct HandleSlot
+	{
+		GC_Object *obj = nullptr;
+		uint32_t generation = 1;
+	};
+	std::vector<HandleSlot> _handles;
+	void OpenHandle(GC_Object &obj);
+	void CloseHandle(PtrList<GC_Object>::id_type id);
+
+	// LIST_timestep split by object type, in update order
+	struct TimeStepGroup
+	{
+		int phase;
+		std::string_view name;
+		void (*proc)(World &world, PtrList<GC_Object> &objects, float dt);
+		PtrList<GC_Object> objects;
+	};
+	std::vector<std::unique_ptr<TimeStepGroup>> _timeStepGroups;
+	std::vector<TimeStepGroup*> _timeStepGroupByType;
+	std::vector<PtrList<GC_Object>::id_type> _timeStepIds; // position in the group, by object id
+	std::vector<GC_Object*> _timeStepPending; // joined while the groups were running
+	bool _timeStepping = false;
+
+	TimeStepGroup& GetTimeStepGroup(const GC_Object &obj);
+	void TimeStepJoin(GC_Object &obj);
+
+	template<class T>
+	typename T::Pool& GetArena()
+	{
+		auto type = T::GetTypeStatic();
+		if( type >= _arenas.size() )
+			_arenas.resize(type + 1);
+		if( !_arenas[type] )
+			_arenas[type].reset(new typename T::Pool());
+		return static_cast<typename T::Pool&>(*_arenas[type]);
+	}
 };
 
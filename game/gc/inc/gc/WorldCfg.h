@@ -4,4 +4,4 @@
 #define WORLD_MAXBLOCKS        512
 #define WORLD_BLOCK_SIZE        32
 #define WORLD_LOCATION_SIZE    (WORLD_BLOCK_SIZE*4)  // should be bigger the largest sprite object
-#define VERSION    0x1520
+#define VERSION    0x1523
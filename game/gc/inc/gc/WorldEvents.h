@@ -1,9 +1,16 @@
 #pragma once
 
 #include <math/MyMath.h>
+#include <stddef.h>
 
 template <class T> struct ObjectListener;
 
+// Receives events of type E queued during World::Step, in bulk once the step is over.
+template <class E> struct DeferredListener
+{
+	virtual void OnEvents(const E *events, size_t count) = 0;
+};
+
 class GC_Explosion;
 template<> struct ObjectListener<GC_Explosion>
 {
@@ -72,6 +79,13 @@ template<> struct ObjectListener<GC_RigidBodyDynamic>
 	virtual void OnContact(vec2d pos, float np, float tp) = 0;
 };
 
+struct ContactEvent
+{
+	vec2d pos;
+	float np;
+	float tp;
+};
+
 class GC_Vehicle;
 template<> struct ObjectListener<GC_Vehicle>
 {
@@ -93,6 +107,7 @@ template<> struct ObjectListener<World>
 {
 	virtual void OnKill(GC_Object &obj) = 0;
 	virtual void OnNewObject(GC_Object &obj) = 0;
+	virtual void OnClear() = 0; // all objects are destroyed at once without OnKill
 
 	// TODO: these functions should not be here
 	virtual void OnGameStarted() = 0;
@@ -33,12 +33,12 @@ private:                                                                \
     PtrList<GC_Object>::id_type cls::Register(World &world)             \
     {                                                                   \
         auto pos = base::Register(world);                               \
-        world.GetList(list).insert(this, pos);                          \
+        world.ListInsert(list, *this, pos);                             \
         return pos;                                                     \
     }                                                                   \
     void cls::Unregister(World &world, PtrList<GC_Object>::id_type pos) \
     {                                                                   \
-        world.GetList(list).erase(pos);                                 \
+        world.ListErase(list, *this, pos);                              \
         base::Unregister(world, pos);                                   \
     }
 
@@ -46,13 +46,13 @@ private:                                                                \
     PtrList<GC_Object>::id_type cls::Register(World &world)             \
     {                                                                   \
         auto pos = base::Register(world);                               \
-        world.GetList(list1).insert(this, pos);                         \
-        world.GetList(list2).insert(this, pos);                         \
+        world.ListInsert(list1, *this, pos);                            \
+        world.ListInsert(list2, *this, pos);                            \
         return pos;                                                     \
     }                                                                   \
     void cls::Unregister(World &world, PtrList<GC_Object>::id_type pos) \
     {                                                                   \
-        world.GetList(list2).erase(pos);                                \
-        world.GetList(list1).erase(pos);                                \
+        world.ListErase(list2, *this, pos);                             \
+        world.ListErase(list1, *this, pos);                             \
         base::Unregister(world, pos);                                   \
     }
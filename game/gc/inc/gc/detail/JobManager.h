@@ -28,6 +28,12 @@ public:
 			_active = _members.begin();
 	}
 
+	void Clear()
+	{
+		_members.clear();
+		_active = _members.begin();
+	}
+
 	bool TakeJob(const T *member)
 	{
 		if( *_active == member )
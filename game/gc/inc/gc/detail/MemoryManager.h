@@ -2,13 +2,29 @@
 
 #pragma once
 
+#include "../ObjPtr.h"
 #include <cassert>
 #include <cstring> // memset
 #include <new>
 #include <typeinfo>
-#ifndef NDEBUG
-#include <cstdio>  // printf
-#endif
+
+struct MemoryPoolStats
+{
+	size_t live;   // allocations not returned yet, including dead objects still referenced
+	size_t peak;
+	size_t blocks;
+	size_t bytes;  // held by blocks
+};
+
+class MemoryPoolBase
+{
+public:
+	virtual ~MemoryPoolBase() {}
+	const MemoryPoolStats& GetStats() const { return _stats; }
+
+protected:
+	MemoryPoolStats _stats = {};
+};
 
 template
 <
@@ -16,7 +32,7 @@ template
 	size_t extra_bytes = 0,
 	size_t block_size = 128
 >
-class MemoryPool final
+class MemoryPool final : public MemoryPoolBase
 {
 	struct Block;
 
@@ -39,6 +55,7 @@ class MemoryPool final
 
 	struct Block
 	{
+		MemoryPool *_pool; // null once the pool is gone
 		Block *_prevFree;
 		Block *_nextFree;
 
@@ -48,8 +65,9 @@ class MemoryPool final
 
 		size_t _thisBlockIdx;
 
-		Block(size_t idx)
-		  : _prevFree(nullptr)
+		Block(MemoryPool *pool, size_t idx)
+		  : _pool(pool)
+		  , _prevFree(nullptr)
 		  , _nextFree(nullptr)
 		  , _firstFreeBlank(_blanks)
 		  , _used(0)
@@ -144,22 +162,12 @@ class MemoryPool final
 	size_t _firstEmptyIdx;
 	Block *_freeBlock;
 
-
-#ifndef NDEBUG
-	size_t _allocatedCount;
-	size_t _allocatedPeak;
-#endif
-
 public:
 	MemoryPool()
 	  : _blocks((BlockPtr*) malloc(sizeof(BlockPtr)))
 	  , _blockCount(1)
 	  , _firstEmptyIdx(0)
 	  , _freeBlock(nullptr)
-#ifndef NDEBUG
-	  , _allocatedCount(0)
-	  , _allocatedPeak(0)
-#endif
 	{
 		if( !_blocks )
 			throw std::bad_alloc();
@@ -169,21 +177,39 @@ public:
 
 	~MemoryPool()
 	{
-#ifndef NDEBUG
-        assert(0 == _allocatedCount);
-        for( size_t i = 0; i < _blockCount; ++i )
-            assert(!_blocks[i]._block);
-//        printf("MemoryPool<%s>: peak allocation is %zu\n", typeid(T).name(), _allocatedPeak);
-#endif
+		// Whatever is left is kept by outstanding references to dead objects.
+		// Such blocks live on their own until the last of them is released.
+		for( size_t i = 0; i < _blockCount; ++i )
+		{
+			if( Block *block = _blocks[i]._block )
+			{
+				assert(block->_used);
+				block->_pool = nullptr;
+			}
+		}
 		free(_blocks);
 	}
 
+	// returns memory to the pool it came from
+	static void FreeAny(void *p)
+	{
+		Block *block = ((BlankObject*) p)->_block;
+		if( block->_pool )
+		{
+			block->_pool->Free(p);
+		}
+		else
+		{
+			block->Free((BlankObject *) p);
+			if( 0 == block->_used )
+				delete block;
+		}
+	}
+
 	void* Alloc()
 	{
-#ifndef NDEBUG
-        if( ++_allocatedCount > _allocatedPeak )
-            _allocatedPeak = _allocatedCount;
-#endif
+		if( ++_stats.live > _stats.peak )
+			_stats.peak = _stats.live;
 
 		if( !_freeBlock )
 		{
@@ -201,7 +227,9 @@ public:
 				_blockCount *= 2;
 			}
 
-			_freeBlock = new Block(_firstEmptyIdx);
+			_freeBlock = new Block(this, _firstEmptyIdx);
+			++_stats.blocks;
+			_stats.bytes += sizeof(Block);
 
 			size_t tmp = _firstEmptyIdx;
 			_firstEmptyIdx = _blocks[tmp]._nextEmptyIdx;
@@ -232,9 +260,11 @@ public:
 
 	void Free(void* p)
 	{
-		assert(_allocatedCount--);
+		assert(_stats.live > 0);
+		--_stats.live;
 
 		Block *block = ((BlankObject*) p)->_block;
+		assert(this == block->_pool);
 		if( !block->_firstFreeBlank )
 		{
 			// block just became free
@@ -268,6 +298,8 @@ public:
 			_firstEmptyIdx = block->_thisBlockIdx;
 
 			delete block;
+			--_stats.blocks;
+			_stats.bytes -= sizeof(Block);
 		}
 	}
 
@@ -285,31 +317,43 @@ public:
 #endif
 
 
+// Objects come from the static pool of the class unless a pool is given
+// to new, as in new (pool) T(). Either way delete returns the memory to
+// the pool it came from.
 #define DECLARE_POOLED_ALLOCATION(cls)          \
 private:                                        \
     static MemoryPool<cls, sizeof(int)> __pool; \
-    static void __fin(void *allocated)          \
+    static void* __alloc(MemoryPool<cls, sizeof(int)> &pool, size_t count) \
     {                                           \
-        __pool.Free(allocated);                 \
+        assert(sizeof(cls) == count);           \
+        void *_ptr = pool.Alloc();              \
+        *(ObjRefCount*) _ptr = 0x80000000;      \
+        return (ObjRefCount*) _ptr + 1;         \
     }                                           \
 public:                                         \
+    typedef MemoryPool<cls, sizeof(int)> Pool;  \
     void* operator new(size_t count)            \
     {                                           \
-        assert(sizeof(cls) == count);           \
-        void *_ptr = __pool.Alloc();            \
-        *(unsigned int*) _ptr = 0x80000000;     \
-        return (unsigned int*) _ptr + 1;        \
+        return __alloc(__pool, count);          \
+    }                                           \
+    void* operator new(size_t count, Pool &pool) \
+    {                                           \
+        return __alloc(pool, count);            \
     }                                           \
     void operator delete(void *p)               \
     {                                           \
         _DBG_FILL_FREE_PATTERN(p, sizeof(cls)); \
-        unsigned int&cnt(*((unsigned int*)p-1));\
+        ObjRefCount &cnt(*((ObjRefCount*)p-1)); \
         cnt &= 0x7fffffff;                      \
         typedef void (*ObjFinalizerProc) (void *); \
         if( !cnt )                              \
-            __pool.Free((unsigned int*) p - 1); \
+            Pool::FreeAny((ObjRefCount*) p - 1); \
         else                                    \
-            *(ObjFinalizerProc*) p = __fin;     \
+            *(ObjFinalizerProc*) p = &Pool::FreeAny; \
+    }                                           \
+    void operator delete(void *p, Pool &)       \
+    {                                           \
+        operator delete(p);                     \
     }
 
 #define IMPLEMENT_POOLED_ALLOCATION(cls)        \
@@ -14,6 +14,7 @@ public:
 		bool operator==(id_type other) const { return _id == other._id; }
 		bool operator!=(id_type other) const { return _id != other._id; }
 		bool operator<(id_type other) const { return _id < other._id; }
+		int index() const { return _id; }
 
 	private:
 		friend class PtrList<T>;
@@ -119,6 +120,16 @@ public:
 
 	size_t size() const { return _size; }
 
+	// drops all nodes at once; ids start over from zero
+	void clear()
+	{
+		assert(!_dbgInLoop);
+		_data.clear();
+		_size = 0;
+		_dataTail = -1;
+		_freeTail = -1;
+	}
+
 private:
 	struct Node
 	{
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// Link embedded in every scheduled item. Unlinking is O(1) and does not need
+// the wheel, so the owner of a handle may cancel it on its own.
+struct TimerNode
+{
+	TimerNode *prev = this;
+	TimerNode *next = this;
+	uint32_t tick = 0;
+
+	bool IsLinked() const { return next != this; }
+	void Unlink()
+	{
+		if( IsLinked() )
+			--*_count;
+		prev->next = next;
+		next->prev = prev;
+		prev = next = this;
+	}
+
+private:
+	friend class TimerWheel;
+	size_t *_count = nullptr; // of the wheel the node is linked into
+};
+
+// Hierarchical timing wheel with four levels of 256 slots each. Level 0 holds
+// items due within 256 ticks, every next level covers a 256 times longer span
+// and is cascaded down as the wheel turns. Items due in the same tick fire in
+// the order they reached level 0.
+class TimerWheel final
+{
+public:
+	static const int LEVEL_COUNT = 4;
+	static const int SLOT_BITS = 8;
+	static const int SLOT_COUNT = 1 << SLOT_BITS;
+
+	TimerWheel() = default;
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+	~TimerWheel() { assert(IsEmpty()); }
+
+	uint32_t GetCurrentTick() const { return _current; }
+	void SetCurrentTick(uint32_t tick) { assert(IsEmpty()); _current = tick; }
+	bool IsEmpty() const { return 0 == _count; }
+	size_t GetCount() const { return _count; }
+
+	// Items scheduled in the past or for an already processed tick are moved to
+	// the first tick that is still to be processed.
+	void Schedule(TimerNode &node, uint32_t tick);
+
+	// Processes ticks up to and including target. The node is unlinked before
+	// fire is called, so the callback may free it and schedule new items.
+	template <class F>
+	void Advance(uint32_t target, F &&fire);
+
+	// Exact layout access for saving and restoring a wheel.
+	template <class F>
+	void ForEach(F &&f) const; // f(level, slot, node)
+	void Restore(int level, int slot, TimerNode &node);
+
+	template <class F>
+	void Clear(F &&destroy);
+
+private:
+	TimerNode _slots[LEVEL_COUNT][SLOT_COUNT];
+	size_t _count = 0;
+	uint32_t _current = 0;
+	bool _firing = false;
+
+	void Append(TimerNode &slot, TimerNode &node);
+	void Insert(TimerNode &node);
+	int Cascade(int level);
+};
+
+template <class F>
+void TimerWheel::Advance(uint32_t target, F &&fire)
+{
+	assert(!_firing);
+	if( IsEmpty() )
+	{
+		_current = target;
+		return;
+	}
+
+	_firing = true;
+	while( (int32_t) (target - _current) > 0 )
+	{
+		++_current;
+		int level = 1;
+		while( level < LEVEL_COUNT && 0 == Cascade(level) )
+			++level;
+
+		TimerNode &slot = _slots[0][_current & (SLOT_COUNT - 1)];
+		while( slot.IsLinked() )
+		{
+			TimerNode *node = slot.next;
+			node->Unlink();
+			fire(*node);
+		}
+	}
+	_firing = false;
+}
+
+template <class F>
+void TimerWheel::ForEach(F &&f) const
+{
+	for( int level = 0; level < LEVEL_COUNT; ++level )
+	{
+		for( int slot = 0; slot < SLOT_COUNT; ++slot )
+		{
+			const TimerNode &head = _slots[level][slot];
+			for( TimerNode *node = head.next; node != &head; node = node->next )
+				f(level, slot, *node);
+		}
+	}
+}
+
+template <class F>
+void TimerWheel::Clear(F &&destroy)
+{
+	for( auto &level: _slots )
+	{
+		for( TimerNode &slot: level )
+		{
+			while( slot.IsLinked() )
+			{
+				TimerNode *node = slot.next;
+				node->Unlink();
+				destroy(node);
+			}
+		}
+	}
+	_current = 0;
+}
@@ -0,0 +1,79 @@
+#include <fsmem/FileSystemMemory.h>
+#include <gc/DecalStore.h>
+#include <gc/SaveFile.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+static std::vector<float> GetCellTimes(const DecalStore &store, int x, int y)
+{
+	std::vector<float> result;
+	store.ForEachInCell(x, y, [&](const Decal &decal) { result.push_back(decal.timeCreated); });
+	return result;
+}
+
+TEST(DecalStore, BucketsByLocation)
+{
+	DecalStore store;
+	store.Resize({ 0, 0, 4, 4 });
+	store.Add({ vec2d{ 10, 10 }, vec2d{ 1, 0 }, PARTICLE_CATTRACK, 0, 1 });
+	store.Add({ vec2d{ WORLD_LOCATION_SIZE * 2.5f, 10 }, vec2d{ 1, 0 }, PARTICLE_CATTRACK, 1, 1 });
+	store.Add({ vec2d{ 20, 20 }, vec2d{ 1, 0 }, PARTICLE_CATTRACK, 2, 1 });
+	store.Add({ vec2d{ -1000, 1e6f }, vec2d{ 1, 0 }, PARTICLE_CATTRACK, 3, 1 }); // clamped to the edge
+
+	EXPECT_EQ(4, store.GetCount());
+	EXPECT_EQ((std::vector<float>{ 0, 2 }), GetCellTimes(store, 0, 0));
+	EXPECT_EQ((std::vector<float>{ 1 }), GetCellTimes(store, 2, 0));
+	EXPECT_EQ((std::vector<float>{ 3 }), GetCellTimes(store, 0, 3));
+	EXPECT_TRUE(GetCellTimes(store, 1, 1).empty());
+}
+
+TEST(DecalStore, ExpiresOldestAndOverwritesWhenFull)
+{
+	DecalStore store;
+	store.Resize({ 0, 0, 4, 4 });
+	store.Add({ vec2d{}, vec2d{ 1, 0 }, PARTICLE_BIGBLAST, 0, 10 });
+	store.Add({ vec2d{}, vec2d{ 1, 0 }, PARTICLE_GAUSS1, 1, 1 });
+	store.Add({ vec2d{}, vec2d{ 1, 0 }, PARTICLE_GAUSS1, 2, 1 });
+
+	store.Expire(5);
+	EXPECT_EQ(3, store.GetCount()); // held back by the long-lived oldest one
+	store.Expire(10);
+	EXPECT_EQ(0, store.GetCount());
+	EXPECT_TRUE(GetCellTimes(store, 0, 0).empty());
+
+	for (uint32_t i = 0; i < DecalStore::CAPACITY + 10; ++i)
+		store.Add({ vec2d{}, vec2d{ 1, 0 }, PARTICLE_CATTRACK, (float) i, 1e6f });
+	EXPECT_EQ(DecalStore::CAPACITY, store.GetCount());
+	EXPECT_EQ(13, store.GetBegin());
+	EXPECT_EQ(10, store.GetDecal(store.GetBegin()).timeCreated);
+	EXPECT_EQ(DecalStore::CAPACITY, GetCellTimes(store, 0, 0).size());
+	EXPECT_EQ(10, GetCellTimes(store, 0, 0).front());
+}
+
+TEST(DecalStore, SerializesInCreationOrder)
+{
+	FS::MemoryStream stream;
+	{
+		DecalStore store;
+		store.Resize({ 0, 0, 4, 4 });
+		for (int i = 0; i < 5; ++i)
+			store.Add({ vec2d{ 100.f * i, 0 }, vec2d{ 0, 1 }, PARTICLE_SMALLBLAST, (float) i, 2 });
+		store.Expire(3);
+		SaveFile f(stream, false /*loading*/);
+		store.Serialize(f);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	DecalStore store;
+	store.Resize({ 0, 0, 4, 4 });
+	SaveFile f(stream, true /*loading*/);
+	store.Serialize(f);
+	ASSERT_EQ(3, store.GetCount());
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		const Decal &decal = store.GetDecal(store.GetBegin() + i);
+		EXPECT_EQ(i + 2, decal.timeCreated);
+		EXPECT_EQ(100.f * (i + 2), decal.pos.x);
+	}
+}
@@ -0,0 +1,37 @@
+#include <gc/Light.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+
+static int CountCellsWith(const World &world, const GC_Light &light)
+{
+	int count = 0;
+	RectRB bounds = world.GetLocationBounds();
+	for (int y = bounds.top; y < bounds.bottom; ++y)
+	for (int x = bounds.left; x < bounds.right; ++x)
+	{
+		auto &cell = world.grid_lights.element(x, y);
+		for (auto id = cell.begin(); id != cell.end(); id = cell.next(id))
+			count += cell.at(id) == &light;
+	}
+	return count;
+}
+
+TEST(Light, GridFollowsRenderRadius)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &light = world.New<GC_Light>(vec2d{ WORLD_LOCATION_SIZE * 1.5f, WORLD_LOCATION_SIZE * 1.5f }, GC_Light::LIGHT_POINT);
+
+	light.SetRadius(world, WORLD_LOCATION_SIZE / 4);
+	EXPECT_EQ(1, CountCellsWith(world, light));
+	EXPECT_EQ(1, WIDTH(light.GetCells()));
+
+	light.SetRadius(world, WORLD_LOCATION_SIZE);
+	EXPECT_EQ(9, CountCellsWith(world, light));
+
+	light.MoveTo(world, vec2d{ 0, 0 });
+	EXPECT_EQ(4, CountCellsWith(world, light)); // clamped to the world bounds
+
+	light.Kill(world);
+	EXPECT_EQ(0, CountCellsWith(world, light));
+}
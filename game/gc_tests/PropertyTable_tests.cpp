@@ -0,0 +1,64 @@
+#include <gc/SpawnPoint.h>
+#include <gc/UserObjects.h>
+#include <gc/World.h>
+#include <gtest/gtest.h>
+
+TEST(PropertyTable, FindIncludesBaseClassProperties)
+{
+	const PropertyTable &table = GC_SpawnPoint::GetPropertyTableStatic();
+	ASSERT_EQ(3, table.GetCount());
+
+	int nameIndex = table.Find("name");
+	ASSERT_NE(-1, nameIndex);
+	EXPECT_EQ(0, nameIndex); // base class properties go first
+
+	int teamIndex = table.Find("team");
+	ASSERT_NE(-1, teamIndex);
+	EXPECT_EQ(ObjectProperty::TYPE_INTEGER, table.GetProperty(teamIndex).type);
+	EXPECT_EQ(PropertyNameHash("team"), table.GetProperty(teamIndex).hash);
+
+	EXPECT_EQ(-1, table.Find("nonexistent"));
+	EXPECT_EQ(-1, table.Find(""));
+}
+
+TEST(PropertyTable, AccessorsWorkWithoutPropertySet)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &sp = world.New<GC_SpawnPoint>(vec2d{});
+
+	const PropertyTable &table = sp.GetPropertyTable();
+	const PropertyDesc &team = table.GetProperty(table.Find("team"));
+	team.setInt(sp, world, 3);
+	EXPECT_EQ(3, sp._team);
+	EXPECT_EQ(3, team.getInt(sp, world));
+
+	const PropertyDesc &name = table.GetProperty(table.Find("name"));
+	name.setString(sp, world, "abc");
+	EXPECT_EQ(&sp, world.FindObject("abc"));
+	EXPECT_EQ("abc", name.getString(sp, world));
+}
+
+TEST(PropertyTable, PropertySetAppliesHealthAndMaxHealthTogether)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &obj = world.New<GC_UserObject>(vec2d{});
+	ASSERT_LT(obj.GetHealthMax(), 800);
+
+	std::shared_ptr<PropertySet> ps = obj.GetProperties(world);
+	ps->GetProperty(ps->GetTable().Find("health"))->SetFloatValue(800);
+	ps->GetProperty(ps->GetTable().Find("max_health"))->SetFloatValue(1000);
+	ps->Exchange(world, true);
+
+	EXPECT_EQ(800, obj.GetHealth());
+	EXPECT_EQ(1000, obj.GetHealthMax());
+}
+
+TEST(PropertyTable, HealthIsListedBeforeMaxHealth)
+{
+	const PropertyTable &table = GC_RigidBodyStatic::GetPropertyTableStatic();
+	int health = table.Find("health");
+	int maxHealth = table.Find("max_health");
+	ASSERT_NE(-1, health);
+	ASSERT_NE(-1, maxHealth);
+	EXPECT_EQ(health + 1, maxHealth);
+}
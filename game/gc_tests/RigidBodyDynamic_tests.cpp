@@ -0,0 +1,176 @@
+#include <gc/Crate.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldEvents.h>
+#include <gc/WorldCfg.h>
+#include <tasks/TaskPool.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+static void PopulateCrates(World &world)
+{
+	for (int y = 0; y < 8; ++y)
+		for (int x = 0; x < 12; ++x)
+			world.New<GC_Crate>(vec2d{ 64.f + x * 28.f + (y & 1) * 10.f, 64.f + y * 30.f });
+	for (int x = 0; x < 16; ++x)
+		world.New<GC_Wall>(vec2d{ 48.f + x * WORLD_BLOCK_SIZE, 40.f });
+}
+
+static std::vector<vec2d> GetPositions(World &world)
+{
+	std::vector<vec2d> result;
+	auto &objects = world.GetList(LIST_objects);
+	for (auto it = objects.begin(); it != objects.end(); it = objects.next(it))
+		if (auto crate = dynamic_cast<GC_Crate*>(objects.at(it)))
+			result.push_back(crate->GetPos());
+	return result;
+}
+
+TEST(RigidBodyDynamic, ParallelDetectionMatchesSerial)
+{
+	World serial({ 0, 0, 16, 16 }, false /*initField*/);
+	World parallel({ 0, 0, 16, 16 }, false /*initField*/);
+	PopulateCrates(serial);
+	PopulateCrates(parallel);
+
+	TaskPool taskPool(3);
+	parallel.SetTaskPool(&taskPool);
+
+	auto initial = GetPositions(serial);
+	for (int i = 0; i < 30; ++i)
+	{
+		serial.Step(1.f / 60);
+		parallel.Step(1.f / 60);
+	}
+
+	auto expected = GetPositions(serial);
+	EXPECT_NE(initial, expected); // overlapping crates push each other apart
+	EXPECT_EQ(expected, GetPositions(parallel));
+}
+
+TEST(RigidBodyDynamic, RestingPileSleepsUntilHit)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	PopulateCrates(world);
+
+	for (int i = 0; i < 300; ++i)
+		world.Step(1.f / 60);
+	EXPECT_TRUE(world.GetList(LIST_timestep).empty());
+
+	auto &crate = world.New<GC_Crate>(vec2d{ 400, 400 });
+	EXPECT_FALSE(world.GetList(LIST_timestep).empty());
+	for (int i = 0; i < 120; ++i)
+		world.Step(1.f / 60);
+	ASSERT_TRUE(crate.IsSleeping());
+
+	auto resting = GetPositions(world);
+	crate.ApplyImpulse(world, vec2d{ 50, 0 });
+	EXPECT_FALSE(crate.IsSleeping());
+	world.Step(1.f / 60);
+	world.Step(1.f / 60);
+	EXPECT_GT(crate.GetPos().x, 400);
+	EXPECT_EQ(resting.size(), GetPositions(world).size());
+}
+
+namespace
+{
+	struct ContactImpulseSum : DeferredListener<ContactEvent>
+	{
+		float np = 0;
+		void OnEvents(const ContactEvent *events, size_t count) override
+		{
+			for (size_t i = 0; i != count; ++i)
+				np += events[i].np;
+		}
+	};
+
+	// a row of crates pushed into a wall keeps its contacts from step to step
+	struct PressedRow
+	{
+		World world{ { 0, 0, 16, 16 }, false /*initField*/ };
+		ContactImpulseSum contacts;
+		std::vector<GC_RigidBodyStatic*> bodies;
+
+		PressedRow()
+		{
+			world.eContacts.AddListener(contacts);
+			bodies.push_back(&world.New<GC_Wall>(vec2d{ 400, 200 }));
+			for (int i = 0; i < 5; ++i)
+				bodies.push_back(&world.New<GC_Crate>(vec2d{ 368 - 33.f * i, 200 }));
+			for (auto body: bodies)
+				body->SetHealth(100000, 100000);
+		}
+
+		~PressedRow()
+		{
+			world.eContacts.RemoveListener(contacts);
+		}
+
+		float GetDamage() const
+		{
+			float damage = 0;
+			for (auto body: bodies)
+				damage += body->GetHealthMax() - body->GetHealth();
+			return damage;
+		}
+
+		void Step()
+		{
+			for (size_t i = 1; i < bodies.size(); ++i)
+				static_cast<GC_Crate*>(bodies[i])->ApplyForce(world, vec2d{ 6000, 0 });
+			world.Step(1.f / 60);
+		}
+	};
+}
+
+TEST(RigidBodyDynamic, WarmStartConvergesInFewerPasses)
+{
+	PressedRow cold;
+	PressedRow warm;
+	cold.world.SetWarmStartContacts(false);
+	for (int i = 0; i < 60; ++i)
+	{
+		cold.Step();
+		warm.Step();
+	}
+
+	int passes[2] = {};
+	for (int i = 0; i < 6; ++i)
+	{
+		cold.Step();
+		warm.Step();
+		EXPECT_GT(128, warm.world.GetSolverPasses());
+		passes[0] += cold.world.GetSolverPasses();
+		passes[1] += warm.world.GetSolverPasses();
+	}
+	EXPECT_LT(passes[1], passes[0]);
+}
+
+TEST(RigidBodyDynamic, WarmStartKeepsDamageAndContactImpulse)
+{
+	// both rows settle with warm start, then one solves its contacts from zero
+	PressedRow cold;
+	PressedRow warm;
+	for (int i = 0; i < 60; ++i)
+	{
+		cold.Step();
+		warm.Step();
+	}
+	cold.world.SetWarmStartContacts(false);
+
+	float damage[2] = { -cold.GetDamage(), -warm.GetDamage() };
+	float impulse[2] = { -cold.contacts.np, -warm.contacts.np };
+	for (int i = 0; i < 6; ++i)
+	{
+		cold.Step();
+		warm.Step();
+	}
+	damage[0] += cold.GetDamage();
+	damage[1] += warm.GetDamage();
+	impulse[0] += cold.contacts.np;
+	impulse[1] += warm.contacts.np;
+
+	EXPECT_LT(0, damage[0]);
+	EXPECT_NEAR(damage[0], damage[1], damage[0] * 0.1f);
+	EXPECT_NEAR(impulse[0], impulse[1], impulse[0] * 0.1f);
+}
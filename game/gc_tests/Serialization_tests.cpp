@@ -1,7 +1,12 @@
 #include <fsmem/FileSystemMemory.h>
+#include <gc/GameClasses.h>
+#include <gc/Light.h>
 #include <gc/SpawnPoint.h>
 #include <gc/SaveFile.h>
+#include <gc/Water.h>
+#include <gc/Weapons.h>
 #include <gc/World.h>
+#include <gc/WorldCfg.h>
 #include <gtest/gtest.h>
 
 TEST(Serialization, CanSerializeEmptyWorld)
@@ -11,7 +16,7 @@ TEST(Serialization, CanSerializeEmptyWorld)
 		SaveFile f(stream, false /*loading*/);
 		World world({ 0, 0, 16, 16 }, false /*initField*/);
 		world.Serialize(f);
-		EXPECT_EQ(10, stream.Tell());
+		EXPECT_EQ(22, stream.Tell());
 	}
 
 	stream.Seek(0, SEEK_SET);
@@ -19,7 +24,7 @@ TEST(Serialization, CanSerializeEmptyWorld)
 		World world({ 0, 0, 16, 16 }, false /*initField*/); // FIXME: restore bounds from file
 		SaveFile f(stream, true /*loading*/);
 		world.Serialize(f);
-		EXPECT_EQ(10, stream.Tell());
+		EXPECT_EQ(22, stream.Tell());
 	}
 }
 
@@ -48,3 +53,104 @@ TEST(Serialization, CanSerializeNamedObject)
 
 
 
+
+TEST(Serialization, KeepsPendingTimeouts)
+{
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		auto &weapon = world.New<GC_Weap_Cannon>(vec2d{});
+		weapon.SetName(world, "weapon");
+		weapon.Disappear(world);
+
+		SaveFile f(stream, false /*loading*/);
+		world.Serialize(f);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		SaveFile f(stream, true /*loading*/);
+		world.Serialize(f);
+		EXPECT_EQ(1u, world.GetResumableCount());
+
+		auto weapon = static_cast<GC_Weap_Cannon*>(world.FindObject("weapon"));
+		ASSERT_TRUE(weapon != nullptr);
+		EXPECT_FALSE(weapon->GetVisible());
+		world.Step(10);
+		EXPECT_TRUE(weapon->GetVisible());
+	}
+}
+
+TEST(Serialization, RestoresWaterAndWoodTiles)
+{
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		world.New<GC_Water>(vec2d{ WORLD_BLOCK_SIZE * 5.5f, WORLD_BLOCK_SIZE * 5.5f });
+		world.New<GC_Wood>(vec2d{ WORLD_BLOCK_SIZE * 7.5f, WORLD_BLOCK_SIZE * 3.5f });
+
+		SaveFile f(stream, false /*loading*/);
+		world.Serialize(f);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		SaveFile f(stream, true /*loading*/);
+		world.Serialize(f);
+		EXPECT_TRUE(world._waterTiles[world.GetTileIndex(5, 5)]);
+		EXPECT_TRUE(world._woodTiles[world.GetTileIndex(7, 3)]);
+	}
+}
+
+TEST(Serialization, LoadedObjectsAreNotInitialized)
+{
+	FS::MemoryStream stream;
+	size_t objectCount;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		world.New<GC_Spotlight>(vec2d{ 100, 100 }); // Init adds the light it carries
+		objectCount = world.GetList(LIST_objects).size();
+
+		SaveFile f(stream, false /*loading*/);
+		world.Serialize(f);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		SaveFile f(stream, true /*loading*/);
+		world.Serialize(f);
+		EXPECT_EQ(objectCount, world.GetList(LIST_objects).size());
+		EXPECT_EQ(1, world.GetList(LIST_lights).size());
+	}
+}
+
+TEST(Serialization, ReusesFreedPointerIds)
+{
+	FS::MemoryStream stream;
+	SaveFile f(stream, false);
+	GC_Object *a = reinterpret_cast<GC_Object*>(0x10);
+	GC_Object *b = reinterpret_cast<GC_Object*>(0x20);
+	GC_Object *c = reinterpret_cast<GC_Object*>(0x30);
+
+	f.RegPointer(a);
+	f.RegPointer(b);
+	size_t idA = f.GetPointerId(a);
+	size_t tableSize = f.GetPointerTableSize();
+
+	f.UnregPointer(a);
+	EXPECT_EQ(nullptr, f.RestorePointer(idA));
+	f.RegPointer(c);
+	EXPECT_EQ(idA, f.GetPointerId(c));
+	EXPECT_EQ(c, f.RestorePointer(idA));
+	EXPECT_EQ(tableSize, f.GetPointerTableSize());
+
+	for (int i = 0; i != 100; ++i)
+	{
+		f.UnregPointer(b);
+		f.RegPointer(b);
+	}
+	EXPECT_EQ(tableSize, f.GetPointerTableSize());
+}
@@ -0,0 +1,147 @@
+#include <gc/Light.h>
+#include <gc/Snapshot.h>
+#include <gc/SpawnPoint.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldEvents.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+TEST(Snapshot, DeltaFollowsBaseline)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &wall = world.New<GC_Wall>(vec2d{ 32, 32 });
+	auto &spawn = world.New<GC_SpawnPoint>(vec2d{ 64, 64 });
+	spawn.SetName(world, "spawn");
+
+	SnapshotEncoder encoder(world);
+	SnapshotDecoder decoder;
+
+	auto baseline = encoder.EncodeBaseline();
+	ASSERT_TRUE(decoder.Apply(baseline.data(), baseline.size()));
+	ASSERT_TRUE(decoder.GetWorld() != nullptr);
+	EXPECT_TRUE(decoder.GetWorld()->FindObject("spawn") != nullptr);
+
+	wall.MoveTo(world, vec2d{ 48, 40 });
+	wall.SetHealth(wall.GetHealthMax() / 2);
+	spawn.Kill(world);
+	world.New<GC_Light>(vec2d{ 100, 100 }, GC_Light::LIGHT_POINT).SetName(world, "light");
+
+	auto delta = encoder.EncodeDelta();
+	EXPECT_LT(delta.size(), baseline.size());
+	ASSERT_TRUE(decoder.Apply(delta.data(), delta.size()));
+
+	World &remote = *decoder.GetWorld();
+	EXPECT_TRUE(remote.FindObject("spawn") == nullptr);
+	EXPECT_TRUE(remote.FindObject("light") != nullptr);
+
+	auto &objects = remote.GetList(LIST_objects);
+	GC_Wall *remoteWall = nullptr;
+	for (auto it = objects.begin(); it != objects.end(); it = objects.next(it))
+		if (auto w = dynamic_cast<GC_Wall*>(objects.at(it)))
+			remoteWall = w;
+	ASSERT_TRUE(remoteWall != nullptr);
+	EXPECT_EQ((vec2d{ 48, 40 }), remoteWall->GetPos());
+	EXPECT_EQ(wall.GetHealth(), remoteWall->GetHealth());
+}
+
+TEST(Snapshot, SkipsDeltaAfterGap)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	auto &wall = world.New<GC_Wall>(vec2d{ 32, 32 });
+
+	SnapshotEncoder encoder(world);
+	SnapshotDecoder decoder;
+
+	auto delta = encoder.EncodeBaseline(); // first delta needs a baseline
+	delta = encoder.EncodeDelta();
+	EXPECT_FALSE(decoder.Apply(delta.data(), delta.size()));
+
+	auto baseline = encoder.EncodeBaseline();
+	ASSERT_TRUE(decoder.Apply(baseline.data(), baseline.size()));
+
+	wall.MoveTo(world, vec2d{ 40, 32 });
+	encoder.EncodeDelta(); // lost
+	delta = encoder.EncodeDelta();
+	EXPECT_FALSE(decoder.Apply(delta.data(), delta.size()));
+}
+
+TEST(Snapshot, ReusesIdsOfKilledObjects)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	world.New<GC_Wall>(vec2d{ 32, 32 });
+
+	SnapshotEncoder encoder(world);
+	SnapshotDecoder decoder;
+	auto baseline = encoder.EncodeBaseline();
+	ASSERT_TRUE(decoder.Apply(baseline.data(), baseline.size()));
+
+	// objects come and go between baselines; every delta must resolve to the same objects
+	std::vector<GC_Light*> lights;
+	for (int frame = 0; frame != 50; ++frame)
+	{
+		if (lights.size() > 2)
+		{
+			lights.front()->Kill(world);
+			lights.erase(lights.begin());
+		}
+		auto &light = world.New<GC_Light>(vec2d{ 16.f + frame, 100 }, GC_Light::LIGHT_POINT);
+		light.SetName(world, "light" + std::to_string(frame));
+		lights.push_back(&light);
+		for (GC_Light *l: lights)
+			l->MoveTo(world, l->GetPos() + vec2d{ 0, 1 });
+
+		auto delta = encoder.EncodeDelta();
+		ASSERT_TRUE(decoder.Apply(delta.data(), delta.size()));
+	}
+
+	World &remote = *decoder.GetWorld();
+	EXPECT_EQ(1 + lights.size(), remote.GetList(LIST_objects).size());
+	for (GC_Light *l: lights)
+	{
+		auto remoteLight = dynamic_cast<GC_Light*>(remote.FindObject(l->GetName(world)));
+		ASSERT_TRUE(remoteLight != nullptr);
+		EXPECT_EQ(l->GetPos(), remoteLight->GetPos());
+	}
+}
+
+namespace
+{
+	struct NewObjectRecorder : ObjectListener<World>
+	{
+		std::vector<vec2d> positions;
+
+		void OnKill(GC_Object &) override {}
+		void OnNewObject(GC_Object &obj) override
+		{
+			if (auto mo = dynamic_cast<GC_MovingObject*>(&obj))
+				positions.push_back(mo->GetPos());
+		}
+		void OnClear() override {}
+		void OnGameStarted() override {}
+		void OnGameFinished() override {}
+	};
+}
+
+TEST(Snapshot, AnnouncesObjectsCreatedByDelta)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	world.New<GC_Wall>(vec2d{ 32, 32 });
+
+	SnapshotEncoder encoder(world);
+	SnapshotDecoder decoder;
+	auto baseline = encoder.EncodeBaseline();
+	ASSERT_TRUE(decoder.Apply(baseline.data(), baseline.size()));
+
+	NewObjectRecorder recorder;
+	decoder.GetWorld()->eWorld.AddListener(recorder);
+	world.New<GC_Light>(vec2d{ 100, 120 }, GC_Light::LIGHT_POINT);
+	auto delta = encoder.EncodeDelta();
+	ASSERT_TRUE(decoder.Apply(delta.data(), delta.size()));
+	decoder.GetWorld()->eWorld.RemoveListener(recorder);
+
+	// announced once it has its state
+	ASSERT_EQ(1, recorder.positions.size());
+	EXPECT_EQ((vec2d{ 100, 120 }), recorder.positions[0]);
+}
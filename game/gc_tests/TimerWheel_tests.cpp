@@ -0,0 +1,59 @@
+#include <gc/detail/TimerWheel.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(TimerWheel, FiresInTickOrderAcrossLevels)
+{
+	TimerWheel wheel;
+	TimerNode nodes[5];
+	uint32_t ticks[5] = { 70000, 5, 300, 5, 1000000 };
+	for (int i = 0; i < 5; ++i)
+		wheel.Schedule(nodes[i], ticks[i]);
+
+	std::vector<uint32_t> fired;
+	wheel.Advance(4, [&](TimerNode &node) { fired.push_back(node.tick); });
+	EXPECT_TRUE(fired.empty());
+	EXPECT_EQ(5u, wheel.GetCount());
+
+	wheel.Advance(2000000, [&](TimerNode &node)
+	{
+		EXPECT_EQ(wheel.GetCurrentTick(), node.tick);
+		fired.push_back(node.tick);
+		EXPECT_EQ(5u - fired.size(), wheel.GetCount()); // cascades keep the count
+	});
+	EXPECT_EQ((std::vector<uint32_t>{ 5, 5, 300, 70000, 1000000 }), fired);
+	EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(TimerWheel, CancelledNodeDoesNotFire)
+{
+	TimerWheel wheel;
+	TimerNode a, b;
+	wheel.Schedule(a, 1000);
+	wheel.Schedule(b, 1000);
+	EXPECT_EQ(2u, wheel.GetCount());
+
+	a.Unlink();
+	EXPECT_EQ(1u, wheel.GetCount());
+
+	std::vector<TimerNode*> fired;
+	wheel.Advance(2000, [&](TimerNode &node) { fired.push_back(&node); });
+	EXPECT_EQ(std::vector<TimerNode*>{ &b }, fired);
+}
+
+TEST(TimerWheel, PastTicksFireWithoutDelay)
+{
+	TimerWheel wheel;
+	TimerNode first, second;
+	wheel.SetCurrentTick(100);
+	wheel.Schedule(first, 50); // already processed, moves to tick 101
+
+	std::vector<uint32_t> fired;
+	wheel.Advance(101, [&](TimerNode &node)
+	{
+		fired.push_back(node.tick);
+		if (&node == &first)
+			wheel.Schedule(second, 0); // due in the tick being processed
+	});
+	EXPECT_EQ((std::vector<uint32_t>{ 101, 101 }), fired);
+}
@@ -0,0 +1,427 @@
+#include <MapFile.h>
+#include <fsmem/FileSystemMemory.h>
+#include <gc/Crate.h>
+#include <gc/Field.h>
+#include <gc/GameClasses.h>
+#include <gc/Light.h>
+#include <gc/Player.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gc/WorldEvents.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	struct CountingListener : ObjectListener<World>
+	{
+		int killed = 0;
+		int cleared = 0;
+
+		void OnKill(GC_Object &) override { ++killed; }
+		void OnNewObject(GC_Object &) override {}
+		void OnClear() override { ++cleared; }
+		void OnGameStarted() override {}
+		void OnGameFinished() override {}
+	};
+}
+
+static bool IsGridEmpty(const World &world, const Grid<PtrList<GC_Object>> &grid)
+{
+	RectRB bounds = world.GetLocationBounds();
+	for (int y = bounds.top; y < bounds.bottom; ++y)
+	for (int x = bounds.left; x < bounds.right; ++x)
+	{
+		if (!grid.element(x, y).empty())
+			return false;
+	}
+	return true;
+}
+
+TEST(World, ClearDestroysEverythingAtOnce)
+{
+	World world({ 0, 0, 16, 16 }, true /*initField*/);
+	CountingListener listener;
+	world.eWorld.AddListener(listener);
+
+	for (int x = 0; x < 8; ++x)
+		world.New<GC_Wall>(vec2d{ 48.f + x * WORLD_BLOCK_SIZE, 48.f });
+	auto &crate = world.New<GC_Crate>(vec2d{ 100, 200 });
+	crate.SetName(world, "crate");
+	world.New<GC_Light>(vec2d{ 300, 300 }, GC_Light::LIGHT_POINT).SetTimeout(world, 5);
+	ObjPtr<GC_Object> watched(&crate);
+
+	world.Clear();
+
+	EXPECT_EQ(1, listener.cleared);
+	EXPECT_EQ(0, listener.killed);
+	EXPECT_EQ(nullptr, (GC_Object*) watched);
+	for (int i = 0; i < GLOBAL_LIST_COUNT; ++i)
+		EXPECT_TRUE(world.GetList(static_cast<GlobalListID>(i)).empty());
+	EXPECT_TRUE(IsGridEmpty(world, world.grid_rigid_s));
+	EXPECT_TRUE(IsGridEmpty(world, world.grid_walls));
+	EXPECT_TRUE(IsGridEmpty(world, world.grid_moving));
+	EXPECT_TRUE(IsGridEmpty(world, world.grid_lights));
+	EXPECT_EQ(0, (*world._field)(2, 2).GetObjectsCount());
+	EXPECT_EQ(0, (*world._field)(2, 2).ObstacleFlags());
+	EXPECT_EQ(nullptr, world.FindObject("crate"));
+	EXPECT_EQ(0, world.GetResumableCount());
+
+	// the world is as good as new
+	auto &wall = world.New<GC_Wall>(vec2d{ 48.f, 48.f });
+	EXPECT_EQ(&wall, world.GetList(LIST_objects).at(world.GetList(LIST_objects).begin()));
+	EXPECT_NE(0, (*world._field)(2, 2).ObstacleFlags());
+	wall.Kill(world);
+	EXPECT_EQ(1, listener.killed);
+
+	world.eWorld.RemoveListener(listener);
+}
+
+// Used to depend on creation order: LIST_timestep ran newest first, so a
+// daemon created after its victim lagged one step behind it.
+static void CheckDaemonFollowsCrate(bool daemonFirst)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	GC_HealthDaemon *daemon = nullptr;
+	if (daemonFirst)
+		daemon = &world.New<GC_HealthDaemon>(vec2d{ 200, 200 }, nullptr, 0.f, 10.f);
+	auto &crate = world.New<GC_Crate>(vec2d{ 200, 200 });
+	if (!daemonFirst)
+		daemon = &world.New<GC_HealthDaemon>(vec2d{ 200, 200 }, nullptr, 0.f, 10.f);
+	daemon->SetVictim(world, &crate);
+
+	crate.ApplyImpulse(world, vec2d{ 500, 0 });
+	for (int i = 0; i < 3; ++i)
+	{
+		world.Step(1.f / 60);
+		EXPECT_EQ(crate.GetPos().x, daemon->GetPos().x);
+		EXPECT_EQ(crate.GetPos().y, daemon->GetPos().y);
+	}
+	EXPECT_GT(crate.GetPos().x, 200);
+}
+
+TEST(World, FollowersStepAfterWhatTheyFollow)
+{
+	CheckDaemonFollowsCrate(false);
+	CheckDaemonFollowsCrate(true);
+}
+
+TEST(World, TimeStepSurvivesObjectChurn)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	for (int i = 0; i < 100; ++i)
+		world.New<GC_Wall>(vec2d{ 24.f + (i % 10) * WORLD_BLOCK_SIZE, 24.f + (i / 10) * WORLD_BLOCK_SIZE });
+
+	// the crates get high object ids and share their group with nothing else
+	std::vector<GC_Crate*> crates;
+	for (int i = 0; i < 4; ++i)
+		crates.push_back(&world.New<GC_Crate>(vec2d{ 50.f + 100 * i, 400 }));
+	crates[1]->Kill(world);
+	crates[2]->Kill(world);
+	auto &late = world.New<GC_Crate>(vec2d{ 150, 460 });
+
+	for (GC_Crate *crate: { crates[0], crates[3], &late })
+		crate->ApplyImpulse(world, vec2d{ 500, 0 });
+	for (int i = 0; i < 3; ++i)
+		world.Step(1.f / 60);
+	EXPECT_LT(50, crates[0]->GetPos().x);
+	EXPECT_LT(350, crates[3]->GetPos().x);
+	EXPECT_LT(150, late.GetPos().x);
+}
+
+namespace
+{
+	struct ContactCollector : DeferredListener<ContactEvent>
+	{
+		std::vector<ContactEvent> events;
+		int batches = 0;
+
+		void OnEvents(const ContactEvent *e, size_t count) override
+		{
+			events.insert(events.end(), e, e + count);
+			++batches;
+		}
+	};
+}
+
+TEST(World, EventQueueFiltersPerListener)
+{
+	EventQueue<ContactEvent> queue;
+	ContactCollector all;
+	ContactCollector strong;
+	queue.AddListener(all);
+	queue.AddListener(strong, [](const ContactEvent &e) { return e.np > 1; });
+
+	queue.Push(ContactEvent{ vec2d{ 1, 1 }, 0.5f, 0 });
+	queue.Push(ContactEvent{ vec2d{ 2, 2 }, 5.f, 0 });
+	EXPECT_EQ(0, all.batches);
+
+	queue.Flush();
+	EXPECT_EQ(1, all.batches);
+	EXPECT_EQ(2, all.events.size());
+	ASSERT_EQ(1, strong.events.size());
+	EXPECT_EQ(2, strong.events[0].pos.x);
+
+	queue.Flush(); // nothing queued, nothing delivered
+	EXPECT_EQ(1, all.batches);
+
+	queue.RemoveListener(strong);
+	queue.RemoveListener(all);
+}
+
+TEST(World, ContactsAreDeliveredAfterStep)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	ContactCollector collector;
+	world.eContacts.AddListener(collector);
+
+	world.New<GC_Crate>(vec2d{ 200, 200 });
+	world.New<GC_Crate>(vec2d{ 210, 200 }); // overlapping crates push each other apart
+	for (int i = 0; i < 30; ++i)
+	{
+		int batches = collector.batches;
+		world.Step(1.f / 60);
+		EXPECT_LE(collector.batches, batches + 1);
+	}
+	EXPECT_FALSE(collector.events.empty());
+
+	world.eContacts.RemoveListener(collector);
+}
+
+static MemoryPoolStats GetArenaStats(const World &world, ObjectType type)
+{
+	for (const ArenaStats &arena: world.GetArenaStats())
+		if (arena.type == type)
+			return arena.stats;
+	return MemoryPoolStats{};
+}
+
+TEST(World, ObjectsLiveInWorldArenas)
+{
+	ObjPtr<GC_Object> survivor;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		World other({ 0, 0, 16, 16 }, false /*initField*/);
+		for (int i = 0; i < 200; ++i)
+			world.New<GC_Crate>(vec2d{ 100, 100 });
+		auto &crate = other.New<GC_Crate>(vec2d{ 100, 100 });
+
+		MemoryPoolStats stats = GetArenaStats(world, GC_Crate::GetTypeStatic());
+		EXPECT_EQ(200, stats.live);
+		EXPECT_EQ(200, stats.peak);
+		EXPECT_EQ(2, stats.blocks);
+		EXPECT_LT(0, stats.bytes);
+		EXPECT_EQ(1, GetArenaStats(other, GC_Crate::GetTypeStatic()).live);
+		EXPECT_EQ(0, GetArenaStats(other, GC_Wall::GetTypeStatic()).blocks);
+
+		survivor = &crate;
+		crate.Kill(other);
+		EXPECT_EQ(nullptr, (GC_Object*) survivor);
+		EXPECT_EQ(1, GetArenaStats(other, GC_Crate::GetTypeStatic()).live); // held by the reference
+
+		world.Clear();
+		stats = GetArenaStats(world, GC_Crate::GetTypeStatic());
+		EXPECT_EQ(0, stats.live);
+		EXPECT_EQ(200, stats.peak);
+		EXPECT_EQ(0, stats.blocks);
+		EXPECT_EQ(0, stats.bytes);
+	}
+	// the block outlives its world until the reference goes away
+	EXPECT_EQ(nullptr, (GC_Object*) survivor);
+	survivor = nullptr;
+}
+
+TEST(World, HandlesStopResolvingWhenObjectDies)
+{
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	EXPECT_EQ(nullptr, world.GetObject(ObjectHandle{}));
+	EXPECT_FALSE(world.GetHandle(nullptr));
+
+	auto &first = world.New<GC_Crate>(vec2d{ 100, 100 });
+	ObjectHandle firstHandle = world.GetHandle(&first);
+	EXPECT_EQ(&first, world.GetObject(firstHandle));
+
+	first.Kill(world);
+	EXPECT_EQ(nullptr, world.GetObject(firstHandle));
+
+	// the slot is taken again, but by a new generation
+	auto &second = world.New<GC_Crate>(vec2d{ 100, 100 });
+	ObjectHandle secondHandle = world.GetHandle(&second);
+	EXPECT_EQ(firstHandle.index, secondHandle.index);
+	EXPECT_NE(firstHandle, secondHandle);
+	EXPECT_EQ(nullptr, world.GetObject(firstHandle));
+	EXPECT_EQ(&second, world.GetObject(secondHandle));
+
+	world.Clear();
+	EXPECT_EQ(nullptr, world.GetObject(secondHandle));
+	auto &third = world.New<GC_Crate>(vec2d{ 100, 100 });
+	EXPECT_EQ(nullptr, world.GetObject(secondHandle));
+	EXPECT_EQ(&third, world.GetObject(world.GetHandle(&third)));
+}
+
+TEST(World, ExportedMapImportsBack)
+{
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		for (int i = 0; i < 10; ++i)
+			world.New<GC_Wall>(vec2d{ 16.f + i * WORLD_BLOCK_SIZE, 48.f });
+		world.New<GC_Crate>(vec2d{ 100, 200 }).SetName(world, "crate");
+		world.New<GC_Wall>(vec2d{ 16.f, 80.f });
+		world.Export(stream);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	MapFile file(stream, false);
+	ASSERT_EQ(3, file.GetObjectRuns().size()); // a table per run of walls and one for the crate
+	EXPECT_EQ(2, file.GetClassCount());
+
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	world.Import(file);
+	EXPECT_EQ(12, world.GetList(LIST_objects).size());
+	auto crate = dynamic_cast<GC_Crate*>(world.FindObject("crate"));
+	ASSERT_NE(nullptr, crate);
+	EXPECT_EQ(100, crate->GetPos().x);
+	EXPECT_EQ(200, crate->GetPos().y);
+}
+
+TEST(World, ImportedObjectsLiveInWorldArenas)
+{
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		for (int i = 0; i < 10; ++i)
+			world.New<GC_Wall>(vec2d{ 16.f + i * WORLD_BLOCK_SIZE, 48.f });
+		world.New<GC_Player>().SetNick("player");
+		world.Export(stream);
+	}
+
+	stream.Seek(0, SEEK_SET);
+	MapFile file(stream, false);
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	world.Import(file);
+	EXPECT_EQ(10, GetArenaStats(world, GC_Wall::GetTypeStatic()).live);
+	EXPECT_EQ(1, GetArenaStats(world, GC_Player::GetTypeStatic()).live);
+
+	world.Clear();
+	EXPECT_EQ(0, GetArenaStats(world, GC_Wall::GetTypeStatic()).live);
+	EXPECT_EQ(0, GetArenaStats(world, GC_Player::GetTypeStatic()).live);
+}
+
+static void WriteChunk(FS::Stream &s, const char type[5], uint32_t size = 0)
+{
+	s.Write(type, 4);
+	s.Write(&size, 4);
+}
+
+static void WriteString(FS::Stream &s, const char *str)
+{
+	uint16_t len = static_cast<uint16_t>(strlen(str));
+	s.Write(&len, 2);
+	s.Write(str, len);
+}
+
+TEST(World, ImportsObjectByObjectMaps)
+{
+	// the format maps were written in before tables
+	FS::MemoryStream stream;
+	int32_t count = 3;
+	int32_t typeFloat = 2;
+	int32_t typeString = 3;
+	int32_t classIndex = 0;
+	WriteChunk(stream, "hdr{");
+	WriteChunk(stream, "}hdr");
+	WriteChunk(stream, "dfn:");
+	WriteString(stream, "crate");
+	stream.Write(&count, 4);
+	stream.Write(&typeFloat, 4);
+	WriteString(stream, "x");
+	stream.Write(&typeFloat, 4);
+	WriteString(stream, "y");
+	stream.Write(&typeString, 4);
+	WriteString(stream, "name");
+	for (float x: { 100.f, 300.f })
+	{
+		float y = 200;
+		WriteChunk(stream, "obj:");
+		stream.Write(&classIndex, 4);
+		stream.Write(&x, 4);
+		stream.Write(&y, 4);
+		WriteString(stream, x < 200 ? "first" : "second");
+	}
+
+	stream.Seek(0, SEEK_SET);
+	MapFile file(stream, false);
+	World world({ 0, 0, 16, 16 }, false /*initField*/);
+	world.Import(file);
+	EXPECT_EQ(2, world.GetList(LIST_objects).size());
+	auto first = dynamic_cast<GC_Crate*>(world.FindObject("first"));
+	auto second = dynamic_cast<GC_Crate*>(world.FindObject("second"));
+	ASSERT_NE(nullptr, first);
+	ASSERT_NE(nullptr, second);
+	EXPECT_EQ(100, first->GetPos().x);
+	EXPECT_EQ(300, second->GetPos().x);
+}
+
+namespace
+{
+	struct CountingStream : FS::Stream
+	{
+		FS::Stream &inner;
+		size_t bytesRead = 0;
+
+		explicit CountingStream(FS::Stream &inner_) : inner(inner_) {}
+
+		size_t Read(void *dst, size_t size, size_t count) override
+		{
+			size_t result = inner.Read(dst, size, count);
+			bytesRead += result * size;
+			return result;
+		}
+		void Write(const void *src, size_t size) override { inner.Write(src, size); }
+		void Seek(long long amount, unsigned int origin) override { inner.Seek(amount, origin); }
+		long long Tell() const override { return inner.Tell(); }
+	};
+}
+
+TEST(World, MapHeaderIsReadWithoutObjects)
+{
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		for (int i = 0; i < 100; ++i)
+			world.New<GC_Wall>(vec2d{ 16.f + (i % 10) * WORLD_BLOCK_SIZE, 16.f + (i / 10) * WORLD_BLOCK_SIZE });
+		world.Export(stream);
+	}
+	size_t fileSize = static_cast<size_t>(stream.Tell());
+
+	stream.Seek(0, SEEK_SET);
+	CountingStream counting(stream);
+	MapFile file(counting, false);
+	int width = 0;
+	EXPECT_TRUE(file.getMapAttribute("width", width));
+	EXPECT_LT(counting.bytesRead, fileSize / 2);
+
+	ASSERT_EQ(1, file.GetObjectRuns().size());
+	EXPECT_EQ(100, file.GetObjectRuns()[0].count);
+	EXPECT_EQ(fileSize, counting.bytesRead);
+}
+
+TEST(World, TableMapsUseTheirOwnHeader)
+{
+	// readers from before tables skip tbl: chunks and would load such maps empty
+	FS::MemoryStream stream;
+	{
+		World world({ 0, 0, 16, 16 }, false /*initField*/);
+		world.New<GC_Wall>(vec2d{ 16.f, 16.f });
+		world.Export(stream);
+	}
+
+	char signature[4];
+	stream.Seek(0, SEEK_SET);
+	ASSERT_EQ(1, stream.Read(signature, sizeof(signature), 1));
+	EXPECT_NE(0, memcmp(signature, "hdr{", 4));
+}
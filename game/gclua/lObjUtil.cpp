@@ -1,6 +1,7 @@
 #include "inc/gclua/lObjUtil.h"
 #include <gc/Object.h>
-#include <gc/ObjPtr.h>
+#include <gc/World.h>
+#include <cstring>
 extern "C"
 {
 #include <lua.h>
@@ -18,44 +19,36 @@ World& luaT_getworld(lua_State *L)
 
 void luaT_pushobject(lua_State *L, GC_Object *obj)
 {
-	ObjPtr<GC_Object> *ppObj = (ObjPtr<GC_Object> *) lua_newuserdata(L, sizeof(ObjPtr<GC_Object>));
+	ObjectHandle *handle = (ObjectHandle *) lua_newuserdata(L, sizeof(ObjectHandle));
 	luaL_getmetatable(L, "object");
 	lua_setmetatable(L, -2);
-	new (ppObj) ObjPtr<GC_Object>(obj);
+	*handle = luaT_getworld(L).GetHandle(obj);
 }
 
 GC_Object* luaT_checkobject(lua_State *L, int n)
 {
-	ObjPtr<GC_Object> *ppObj = (ObjPtr<GC_Object> *) luaL_checkudata(L, n, "object");
-	if( !*ppObj )
+	ObjectHandle *handle = (ObjectHandle *) luaL_checkudata(L, n, "object");
+	GC_Object *obj = luaT_getworld(L).GetObject(*handle);
+	if( !obj )
 		luaL_argerror(L, n, "reference to dead object");
-	return *ppObj;
+	return obj;
 }
 
-// prop name at -2; prop value at -1; return 0 if property not found
-int luaT_setproperty(lua_State *L, PropertySet &properties)
+namespace
 {
-	const char *pname = lua_tostring(L, -2);
-
-	ObjectProperty *p = nullptr;
-
-	for( int i = 0; i < properties.GetCount(); ++i )
+	struct PropertyValue
 	{
-		p = properties.GetProperty(i);
-		if( p->GetName() == pname )
-		{
-			break;
-		}
-		p = nullptr;
-	}
-
-	if( nullptr == p )
-	{
-		return 0;  // property not found
-	}
-
+		int intValue = 0; // TYPE_INTEGER; list index for TYPE_MULTISTRING
+		float floatValue = 0;
+		std::string_view stringValue;
+	};
+}
 
-	switch( p->GetType() )
+// value at -1; raises a Lua error if it does not match the property type or range
+static PropertyValue checkpropvalue(lua_State *L, const char *pname, const PropertyDesc &desc)
+{
+	PropertyValue result;
+	switch( desc.type )
 	{
 		case ObjectProperty::TYPE_INTEGER:
 		{
@@ -65,12 +58,12 @@ int luaT_setproperty(lua_State *L, PropertySet &properties)
 				           pname, lua_typename(L, lua_type(L, -1)));
 			}
 			lua_Integer v = lua_tointeger(L, -1);
-			if( v < p->GetIntMin() || v > p->GetIntMax() )
+			if( v < desc.intMin || v > desc.intMax )
 			{
-				return luaL_error(L, "property '%s' - value %d is out of range [%d, %d]",
-				                  pname, v, p->GetIntMin(), p->GetIntMax());
+				luaL_error(L, "property '%s' - value %d is out of range [%d, %d]",
+				           pname, (int) v, desc.intMin, desc.intMax);
 			}
-			p->SetIntValue(static_cast<int>(v));
+			result.intValue = static_cast<int>(v);
 			break;
 		}
 		case ObjectProperty::TYPE_FLOAT:
@@ -81,12 +74,12 @@ int luaT_setproperty(lua_State *L, PropertySet &properties)
 				           pname, lua_typename(L, lua_type(L, -1)));
 			}
 			float v = (float) lua_tonumber(L, -1);
-			if( v < p->GetFloatMin() || v > p->GetFloatMax() )
+			if( v < desc.floatMin || v > desc.floatMax )
 			{
-				return luaL_error(L, "property '%s' - value %g is out of range [%g, %g]",
-								  pname, v, p->GetFloatMin(), p->GetFloatMax());
+				luaL_error(L, "property '%s' - value %g is out of range [%g, %g]",
+				           pname, v, desc.floatMin, desc.floatMax);
 			}
-			p->SetFloatValue(v);
+			result.floatValue = v;
 			break;
 		}
 		case ObjectProperty::TYPE_STRING:
@@ -98,7 +91,9 @@ int luaT_setproperty(lua_State *L, PropertySet &properties)
 				luaL_error(L, "property '%s' - expected string value; got %s",
 				           pname, lua_typename(L, lua_type(L, -1)));
 			}
-			p->SetStringValue(lua_tostring(L, -1));
+			size_t len;
+			const char *v = lua_tolstring(L, -1, &len);
+			result.stringValue = std::string_view(v, len);
 			break;
 		}
 		case ObjectProperty::TYPE_MULTISTRING:
@@ -110,24 +105,97 @@ int luaT_setproperty(lua_State *L, PropertySet &properties)
 			}
 			const char *v = lua_tostring(L, -1);
 			bool ok = false;
-			for( size_t i = 0; i < p->GetListSize(); ++i )
+			for( unsigned int i = 0; desc.listItem(i); ++i )
 			{
-				if( p->GetListValue(i) == v )
+				if( !strcmp(desc.listItem(i), v) )
 				{
-					p->SetCurrentIndex(i);
+					result.intValue = static_cast<int>(i);
 					ok = true;
 					break;
 				}
 			}
 			if( !ok )
 			{
-				return luaL_error(L, "property '%s' - attempt to set invalid value '%s'", pname, v);
+				luaL_error(L, "property '%s' - attempt to set invalid value '%s'", pname, v);
 			}
 			break;
 		}
 		default:
 			assert(false);
 	}
+	return result;
+}
+
+// prop name at -2; prop value at -1; return 0 if property not found
+int luaT_setproperty(lua_State *L, PropertySet &properties)
+{
+	const char *pname = lua_tostring(L, -2);
+
+	int index = properties.GetTable().Find(pname);
+	if( -1 == index )
+	{
+		return 0;  // property not found
+	}
+
+	const PropertyDesc &desc = properties.GetTable().GetProperty(index);
+	PropertyValue value = checkpropvalue(L, pname, desc);
+	ObjectProperty *p = properties.GetProperty(index);
+
+	switch( desc.type )
+	{
+		case ObjectProperty::TYPE_INTEGER:
+			p->SetIntValue(value.intValue);
+			break;
+		case ObjectProperty::TYPE_FLOAT:
+			p->SetFloatValue(value.floatValue);
+			break;
+		case ObjectProperty::TYPE_STRING:
+		case ObjectProperty::TYPE_SKIN:
+		case ObjectProperty::TYPE_TEXTURE:
+			p->SetStringValue(std::string(value.stringValue));
+			break;
+		case ObjectProperty::TYPE_MULTISTRING:
+			p->SetCurrentIndex(value.intValue);
+			break;
+		default:
+			assert(false);
+	}
+
+	return 1;
+}
+
+// prop name at -2; prop value at -1; return 0 if property not found
+int luaT_setproperty(lua_State *L, World &world, GC_Object &obj)
+{
+	const char *pname = lua_tostring(L, -2);
+
+	const PropertyTable &table = obj.GetPropertyTable();
+	int index = table.Find(pname);
+	if( -1 == index )
+	{
+		return 0;  // property not found
+	}
+
+	const PropertyDesc &desc = table.GetProperty(index);
+	PropertyValue value = checkpropvalue(L, pname, desc);
+
+	switch( desc.type )
+	{
+		case ObjectProperty::TYPE_INTEGER:
+		case ObjectProperty::TYPE_MULTISTRING:
+			desc.setInt(obj, world, value.intValue);
+			break;
+		case ObjectProperty::TYPE_FLOAT:
+			desc.setFloat(obj, world, value.floatValue);
+			break;
+		case ObjectProperty::TYPE_STRING:
+		case ObjectProperty::TYPE_SKIN:
+		case ObjectProperty::TYPE_TEXTURE:
+			desc.setString(obj, world, value.stringValue);
+			break;
+		default:
+			assert(false);
+	}
 
 	return 1;
 }
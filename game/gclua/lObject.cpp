@@ -1,7 +1,6 @@
 #include "inc/gclua/lObject.h"
 #include "inc/gclua/lObjUtil.h"
 //#include "SaveFile.h"
-#include <gc/ObjPtr.h>
 #include <gc/Object.h>
 #include <gc/Pickup.h>
 #include <gc/RigidBody.h>
@@ -22,19 +21,12 @@ extern "C"
 // Object methamethods
 //
 
-static int objfinalizer(lua_State *L)
-{
-	assert(1 == lua_gettop(L));
-	((ObjPtr<GC_Object> *) lua_touserdata(L, 1))->~ObjPtr();
-	return 0;
-}
-
 // TODO: persistence
 /*
 static int objpersist(lua_State *L)
 {
 	assert(3 == lua_gettop(L));
-	ObjPtr<GC_Object> *ppObj = (ObjPtr<GC_Object> *) lua_touserdata(L, 1);
+	ObjectHandle *handle = (ObjectHandle *) lua_touserdata(L, 1);
 	auto f = (SaveFile *) lua_touserdata(L, 3);
 	assert(f);
 
@@ -46,29 +38,32 @@ static int objpersist(lua_State *L)
 	lua_call(L, 0, 1);
 
 	lua_getfield(L, LUA_REGISTRYINDEX, "restore_ptr");
-	lua_pushlightuserdata(L, (void *) f->GetPointerId(*ppObj));
+	lua_pushlightuserdata(L, (void *) f->GetPointerId(luaT_getworld(L).GetObject(*handle)));
 	lua_call(L, 2, 1);
 	return 1;
 }*/
 
-static void pushprop(lua_State *L, ObjectProperty *p)
+static void pushprop(lua_State *L, World &world, const GC_Object &obj, const PropertyDesc &p)
 {
-	assert(L && p);
-	switch( p->GetType() )
+	assert(L);
+	switch( p.type )
 	{
 	case ObjectProperty::TYPE_INTEGER:
-		lua_pushinteger(L, p->GetIntValue());
+		lua_pushinteger(L, p.getInt(obj, world));
 		break;
 	case ObjectProperty::TYPE_FLOAT:
-		lua_pushnumber(L, p->GetFloatValue());
+		lua_pushnumber(L, p.getFloat(obj, world));
 		break;
 	case ObjectProperty::TYPE_STRING:
 	case ObjectProperty::TYPE_SKIN:
 	case ObjectProperty::TYPE_TEXTURE:
-		lua_pushlstring(L, p->GetStringValue().data(), p->GetStringValue().size());
+	{
+		std::string_view value = p.getString(obj, world);
+		lua_pushlstring(L, value.data(), value.size());
 		break;
+	}
 	case ObjectProperty::TYPE_MULTISTRING:
-		lua_pushlstring(L, p->GetListValue(p->GetCurrentIndex()).data(), p->GetListValue(p->GetCurrentIndex()).size());
+		lua_pushstring(L, p.listItem(p.getInt(obj, world)));
 		break;
 	default:
 		assert(false);
@@ -80,53 +75,33 @@ static int objnextprop(lua_State *L)
 {
 	lua_settop(L, 2);
 
-	ObjPtr<GC_Object> *ppObj = (ObjPtr<GC_Object> *) luaL_checkudata(L, 1, "object");
-	if( !*ppObj )
-	{
-		luaL_argerror(L, 1, "reference to a dead object");
-	}
-
-    World &world = luaT_getworld(L);
-	std::shared_ptr<PropertySet> properties = (*ppObj)->GetProperties(world);
-	assert(properties);
-
-	if( lua_isnil(L, 2) )
-	{
-		// begin iteration
-		ObjectProperty *p = properties->GetProperty(0);
-		lua_pushlstring(L, p->GetName().data(), p->GetName().size()); // key
-		pushprop(L, p); // value
-		return 2;
-	}
-
-	const char *key = luaL_checkstring(L, 2);
+	World &world = luaT_getworld(L);
+	GC_Object &obj = *luaT_checkobject(L, 1);
+	const PropertyTable &table = obj.GetPropertyTable();
 
-	bool found = false;
-	int count = properties->GetCount();
-	for( int i = 0; i < count; ++i )
+	int next = 0; // begin iteration
+	if( !lua_isnil(L, 2) )
 	{
-		ObjectProperty *p = properties->GetProperty(i);
-		if( found )
+		int current = table.Find(luaL_checkstring(L, 2));
+		if( -1 == current )
 		{
-			// return next pair
-			lua_pushlstring(L, p->GetName().data(), p->GetName().size()); // key
-			pushprop(L, p); // value
-			return 2;
-		}
-		else if( p->GetName() == key )
-		{
-			found = true;
+			return luaL_error(L, "invalid key to 'next'");
 		}
+		next = current + 1;
 	}
 
-	if( found )
+	if( next < table.GetCount() )
 	{
-		// end of list
-		lua_pushnil(L);
-		return 1;
+		// return next pair
+		const PropertyDesc &p = table.GetProperty(next);
+		lua_pushlstring(L, p.name.data(), p.name.size()); // key
+		pushprop(L, world, obj, p); // value
+		return 2;
 	}
 
-	return luaL_error(L, "invalid key to 'next'");
+	// end of list
+	lua_pushnil(L);
+	return 1;
 }
 
 static int pget(lua_State *L)
@@ -141,17 +116,12 @@ static int pget(lua_State *L)
 	const char *prop = luaL_checkstring(L, 2);
 
 	World &world = luaT_getworld(L);
-	std::shared_ptr<PropertySet> properties = obj->GetProperties(world);
-	assert(properties);
-
-	for( int i = 0; i < properties->GetCount(); ++i )
+	const PropertyTable &table = obj->GetPropertyTable();
+	int index = table.Find(prop);
+	if( -1 != index )
 	{
-		ObjectProperty *p = properties->GetProperty(i);
-		if( p->GetName() == prop )
-		{
-			pushprop(L, p);
-			return 1;
-		}
+		pushprop(L, world, *obj, table.GetProperty(index));
+		return 1;
 	}
 
 	return luaL_error(L, "object of type '%s' does not have property '%s'",
@@ -171,16 +141,14 @@ static int pset(lua_State *L)
 	luaL_checkany(L, 3);  // prop value should be here
 
 	World &world = luaT_getworld(L);
-	std::shared_ptr<PropertySet> properties = obj->GetProperties(world);
 
 	// prop name at -2; prop value at -1
-	if( !luaT_setproperty(L, *properties) )
+	if( !luaT_setproperty(L, world, *obj) )
 	{
 		return luaL_error(L, "object of type '%s' has no property '%s'",
 		                  RTTypes::Inst().GetTypeInfo(obj->GetType()).name, prop);
 	}
 
-	properties->Exchange(world, true);
 	return 0;
 }
 
@@ -384,7 +352,6 @@ static const luaL_Reg objectlib[] = {
 };
 
 static const luaL_Reg objectmt[] = {
-	{"__gc", objfinalizer},
 //	{"__persist", objpersist},  // TODO: persistence
 	{"__newindex", pset},
 	{"__index", pget},
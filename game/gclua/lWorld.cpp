@@ -137,11 +137,41 @@ int world_exists(lua_State *L)
 	return 1;
 }
 
+// memstats()  -- object memory of the world by type
+int world_memstats(lua_State *L)
+{
+	int n = lua_gettop(L);
+	if( 0 != n )
+	{
+		return luaL_error(L, "no arguments expected; got %d", n);
+	}
+
+	World &world = luaT_getworld(L);
+	MemoryPoolStats total = {};
+	luaL_Buffer b;
+	luaL_buffinit(L, &b);
+	for( const ArenaStats &arena: world.GetArenaStats() )
+	{
+		const MemoryPoolStats &stats = arena.stats;
+		lua_pushfstring(L, "%s: live %d, peak %d, blocks %d, bytes %d\n",
+			RTTypes::Inst().GetTypeName(arena.type), (int) stats.live, (int) stats.peak, (int) stats.blocks, (int) stats.bytes);
+		luaL_addvalue(&b);
+		total.live += stats.live;
+		total.blocks += stats.blocks;
+		total.bytes += stats.bytes;
+	}
+	lua_pushfstring(L, "total: live %d, blocks %d, bytes %d", (int) total.live, (int) total.blocks, (int) total.bytes);
+	luaL_addvalue(&b);
+	luaL_pushresult(&b);
+	return 1;
+}
+
 static const luaL_Reg worldlib[] = {
 	{"actor", world_actor},
 	{"service", world_service},
 	{"object", world_object},
 	{"exists", world_exists},
+	{"memstats", world_memstats},
 	{nullptr, nullptr}
 };
 
@@ -5,6 +5,7 @@
 #include <gc/Player.h>
 #include <gc/Vehicle.h>
 #include <gc/World.h>
+#include <render/RenderList.h>
 #include <render/WorldView.h>
 #include <video/RenderContext.h>
 #include <cassert>
@@ -54,6 +55,7 @@ RectRB GetCameraViewport(int screenW, int screenH, unsigned int camCount, unsign
 
 GameViewHarness::GameViewHarness(World &world, WorldController &worldController)
   : _world(world)
+  , _renderList(new RenderList(world))
 {
 	_world.eGC_RigidBodyStatic.AddListener(*this);
 	_world.eGC_Explosion.AddListener(*this);
@@ -121,37 +123,51 @@ void GameViewHarness::RenderGame(RenderContext &rc, const WorldView &worldView,
 	options.visualizeField = visualizeField;
 	options.visualizePath = !!aiManager;
 
+	struct View
+	{
+		RectRB viewport;
+		vec2d eye;
+		float zoom;
+	};
+	std::vector<View> views;
+
 	if( !_cameras.empty() )
 	{
 		if (IsSingleCamera())
 		{
-			vec2d eye = GetMaxShakeCamera().GetCameraPos();
-			rc.PushClippingRect(GetMaxShakeCamera().GetViewport());
-			rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(GetMaxShakeCamera().GetViewport()), eye, _scale), _scale, 1);
-			worldView.Render(rc, _world, options, aiManager);
-			rc.PopTransform();
-			rc.PopClippingRect();
+			views.push_back({ GetMaxShakeCamera().GetViewport(), GetMaxShakeCamera().GetCameraPos(), _scale });
 		}
 		else
 		for( auto &camera: _cameras )
 		{
-			vec2d eye = camera.GetCameraPos();
-			rc.PushClippingRect(camera.GetViewport());
-			rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(camera.GetViewport()), eye, _scale), _scale, 1);
-			worldView.Render(rc, _world, options, aiManager);
-			rc.PopTransform();
-			rc.PopClippingRect();
+			views.push_back({ camera.GetViewport(), camera.GetCameraPos(), _scale });
 		}
 	}
 	else
 	{
 		vec2d eye = Center(_world.GetBounds());
 		float zoom = std::max(_pxWidth / WIDTH(_world.GetBounds()), _pxHeight / HEIGHT(_world.GetBounds()));
+		views.push_back({ RectRB{ 0, 0, _pxWidth, _pxHeight }, eye, zoom });
+	}
 
-		RectRB viewport{ 0, 0, _pxWidth, _pxHeight };
-		rc.PushClippingRect(viewport);
-		rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(viewport), eye, zoom), zoom, 1);
-		worldView.Render(rc, _world, options, aiManager);
+	// one gather over the visible regions of all cameras
+	std::vector<FRECT> regions;
+	for( auto &view: views )
+	{
+		rc.PushClippingRect(view.viewport);
+		rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(view.viewport), view.eye, view.zoom), view.zoom, 1);
+		regions.push_back(rc.GetVisibleRegion());
+		rc.PopTransform();
+		rc.PopClippingRect();
+	}
+	worldView.Gather(*_renderList, regions, options);
+
+	for( unsigned int i = 0; i < views.size(); ++i )
+	{
+		auto &view = views[i];
+		rc.PushClippingRect(view.viewport);
+		rc.PushWorldTransform(ComputeWorldTransformOffset(RectToFRect(view.viewport), view.eye, view.zoom), view.zoom, 1);
+		worldView.Render(rc, *_renderList, i, options, aiManager);
 		rc.PopTransform();
 		rc.PopClippingRect();
 	}
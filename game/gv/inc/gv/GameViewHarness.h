@@ -2,12 +2,14 @@
 #include "Camera.h"
 #include <gc/WorldEvents.h>
 #include <math/MyMath.h>
+#include <memory>
 #include <stddef.h>
 #include <vector>
 
 class GC_Player;
 class AIManager;
 class RenderContext;
+class RenderList;
 class World;
 class WorldController;
 class WorldView;
@@ -38,6 +40,7 @@ public:
 
 private:
 	World &_world;
+	std::unique_ptr<RenderList> _renderList;
 	std::vector<Camera> _cameras;
 	int _pxWidth = 0;
 	int _pxHeight = 0;
@@ -8,13 +8,32 @@
 bool MapFile::_read_chunk_header(ChunkHeader &chdr)
 {
 	assert(!_modeWrite);
-	return 1 == _file.Read(&chdr, sizeof(ChunkHeader), 1);
+	if( _dataSize - _readPos < sizeof(ChunkHeader) )
+		return false;
+	ReadData(&chdr, sizeof(ChunkHeader));
+	return true;
 }
 
 void MapFile::_skip_block(size_t size)
 {
 	assert(!_modeWrite);
-	_file.Seek(size, SEEK_CUR);
+	_fill(size);
+	_readPos += size;
+}
+
+// makes sure that size bytes past the read position are in the buffer
+void MapFile::_fill(size_t size)
+{
+	assert(!_modeWrite);
+	if( _dataSize - _readPos < size )
+		throw std::runtime_error("unexpected end of file");
+	size_t loaded = _data.size();
+	if( loaded - _readPos < size )
+	{
+		_data.resize(_readPos + size);
+		if( 1 != _file.Read(_data.data() + loaded, _data.size() - loaded, 1) )
+			throw std::runtime_error("unexpected end of file");
+	}
 }
 
 static const unsigned int MAX_BUFFER_SIZE = 0x10000;
@@ -26,18 +45,25 @@ MapFile::MapFile(FS::Stream &stream, bool write)
 	, _headerWritten(false)
 	, _isNewClass(true)
 	, _objType(-1)
+	, _objRow(-1)
 {
 	if( !write )
 	{
+		long long begin = _file.Tell();
+		_file.Seek(0, SEEK_END);
+		_dataSize = static_cast<size_t>(_file.Tell() - begin);
+		_file.Seek(begin, SEEK_SET);
+
 		ChunkHeader ch;
 
-		_read_chunk_header(ch);
-		if( CHUNK_HEADER_OPEN != ch.chunkType )
+		if( !_read_chunk_header(ch) ||
+		    (CHUNK_HEADER_OPEN != ch.chunkType && CHUNK_HEADER_OPEN_TABLES != ch.chunkType) )
 			throw std::runtime_error("invalid file");
 
 		do
 		{
-			_read_chunk_header(ch);
+			if( !_read_chunk_header(ch) )
+				throw std::runtime_error("unexpected end of file");
 
 			if( CHUNK_ATTRIB == ch.chunkType )
 			{
@@ -116,7 +142,7 @@ void MapFile::WriteHeader()
 	ChunkHeader ch;
 
 	// open header
-	ch.chunkType = CHUNK_HEADER_OPEN;
+	ch.chunkType = CHUNK_HEADER_OPEN_TABLES;
 	ch.chunkSize = 0;
 	GetWriteBuffer<ChunkHeader>() = ch;
 
@@ -180,17 +206,29 @@ void MapFile::WriteString(std::string_view value)
 void MapFile::WriteData(const void *data, size_t size)
 {
 	assert(_modeWrite);
-	memcpy(GetWriteBuffer(size), data, size);
+	if (size > MAX_BUFFER_SIZE)
+	{
+		FlushWriteBuffer();
+		_file.Write(data, size);
+	}
+	else if (size)
+	{
+		memcpy(GetWriteBuffer(size), data, size);
+	}
+}
+
+void MapFile::FlushWriteBuffer()
+{
+	if (_bufferSize)
+		_file.Write(_buffer.get(), _bufferSize);
+	_bufferSize = 0;
 }
 
 inline void* MapFile::GetWriteBuffer(size_t size)
 {
 	assert(size <= MAX_BUFFER_SIZE);
 	if (_bufferSize + size > MAX_BUFFER_SIZE)
-	{
-		_file.Write(_buffer.get(), _bufferSize);
-		_bufferSize = 0;
-	}
+		FlushWriteBuffer();
 	void *result = _buffer.get() + _bufferSize;
 	_bufferSize += size;
 	return result;
@@ -198,31 +236,33 @@ inline void* MapFile::GetWriteBuffer(size_t size)
 
 void MapFile::ReadInt(int &value)
 {
-	assert(!_modeWrite);
 	int32_t tmp;
-	if( 1 != _file.Read(&tmp, 4, 1) )
-		throw std::runtime_error("unexpected end of file");
+	ReadData(&tmp, 4);
 	value = tmp;
 }
 
 void MapFile::ReadFloat(float &value)
 {
 	static_assert(sizeof(value) == 4, "size of float is not 4");
-	assert(!_modeWrite);
-	if( 1 != _file.Read(&value, 4, 1) )
-		throw std::runtime_error("unexpected end of file");
+	ReadData(&value, 4);
 }
 
 void MapFile::ReadString(std::string &value)
 {
-	assert(!_modeWrite);
 	uint16_t len;
-	if( 1 != _file.Read(&len, 2, 1) )
-		throw std::runtime_error("unexpected end of file");
-	value.resize(len);
-	if( len )
-		if( 1 != _file.Read(&value[0], len, 1) )
-			throw std::runtime_error("unexpected end of file");
+	ReadData(&len, 2);
+	_fill(len);
+	value.assign(_data.data() + _readPos, len);
+	_readPos += len;
+}
+
+void MapFile::ReadData(void *data, size_t size)
+{
+	assert(!_modeWrite);
+	_fill(size);
+	if( size )
+		memcpy(data, _data.data() + _readPos, size);
+	_readPos += size;
 }
 
 bool MapFile::getMapAttribute(std::string_view name, int &value) const
@@ -277,14 +317,23 @@ void MapFile::setMapAttribute(std::string name, std::string value)
 	_mapAttrs.attrs_str[std::move(name)] = std::move(value);
 }
 
-bool MapFile::getObjectAttribute(std::string_view name, int &value) const
+const MapFile::Column* MapFile::FindColumn(std::string_view name, enumDataTypes type) const
 {
 	assert(!_modeWrite);
-	auto &pd = _managed_classes[_objType].propertyDefinitions;
-	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p.name == name; });
-	if (it != pd.end())
+	assert(_objType >= 0 && _objRow >= 0);
+	for( auto &column: _classes[_objType].columns )
+	{
+		if( column.name == name )
+			return column.type == type ? &column : nullptr;
+	}
+	return nullptr;
+}
+
+bool MapFile::getObjectAttribute(std::string_view name, int &value) const
+{
+	if( const Column *column = FindColumn(name, DATATYPE_INT) )
 	{
-		value = it->value_int;
+		value = column->ints[_objRow];
 		return true;
 	}
 	return false;
@@ -292,12 +341,9 @@ bool MapFile::getObjectAttribute(std::string_view name, int &value) const
 
 bool MapFile::getObjectAttribute(std::string_view name, float &value) const
 {
-	assert(!_modeWrite);
-	auto &pd = _managed_classes[_objType].propertyDefinitions;
-	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p.name == name; });
-	if (it != pd.end())
+	if( const Column *column = FindColumn(name, DATATYPE_FLOAT) )
 	{
-		value = it->value_float;
+		value = column->floats[_objRow];
 		return true;
 	}
 	return false;
@@ -305,74 +351,53 @@ bool MapFile::getObjectAttribute(std::string_view name, float &value) const
 
 bool MapFile::getObjectAttribute(std::string_view name, std::string &value) const
 {
-	assert(!_modeWrite);
-	auto &pd = _managed_classes[_objType].propertyDefinitions;
-	auto it = std::find_if(begin(pd), end(pd), [&](auto &p) { return p.name == name; });
-	if (it != pd.end())
+	if( const Column *column = FindColumn(name, DATATYPE_STRING) )
 	{
-		value = it->value_string;
+		value = column->strings[_objRow];
 		return true;
 	}
 	return false;
 }
 
-void MapFile::setObjectAttribute(std::string_view name, int value)
+MapFile::Column& MapFile::GetWriteColumn(std::string_view name, enumDataTypes type)
 {
+	assert(_modeWrite);
+	auto &columns = _classes[_objType].columns;
 	if( _isNewClass )
 	{
 #ifndef NDEBUG
 		// check that given name is unique
-		for( size_t i = 0; i < _managed_classes.back().propertyDefinitions.size(); i++ )
-			assert(_managed_classes.back().propertyDefinitions[i].name != name);
+		for( auto &column: columns )
+			assert(column.name != name);
 #endif
-
-		ObjectDefinition::Property p(DATATYPE_INT);
-		p.name = name;
-		_managed_classes.back().propertyDefinitions.push_back(std::move(p));
+		columns.emplace_back(type, name);
 	}
-	_managed_classes[_objType].propertyDefinitions[_numProperties++].value_int = value;
+	assert(_numProperties < (int) columns.size());
+	Column &column = columns[_numProperties++];
+	assert(column.name == name && column.type == type);
+	return column;
 }
 
-void MapFile::setObjectAttribute(std::string_view name, float value)
+void MapFile::setObjectAttribute(std::string_view name, int value)
 {
-	if( _isNewClass )
-	{
-#ifndef NDEBUG
-		// check that given name is unique
-		for( size_t i = 0; i < _managed_classes.back().propertyDefinitions.size(); i++ )
-			assert(_managed_classes.back().propertyDefinitions[i].name != name);
-#endif
+	GetWriteColumn(name, DATATYPE_INT).ints.push_back(value);
+}
 
-		ObjectDefinition::Property p(DATATYPE_FLOAT);
-		p.name = name;
-		_managed_classes.back().propertyDefinitions.push_back(std::move(p));
-	}
-	_managed_classes[_objType].propertyDefinitions[_numProperties++].value_float = value;
+void MapFile::setObjectAttribute(std::string_view name, float value)
+{
+	GetWriteColumn(name, DATATYPE_FLOAT).floats.push_back(value);
 }
 
 void MapFile::setObjectAttribute(std::string_view name, std::string_view value)
 {
-	if( _isNewClass )
-	{
-#ifndef NDEBUG
-		// check that given name is unique
-		for( size_t i = 0; i < _managed_classes.back().propertyDefinitions.size(); i++ )
-			assert(_managed_classes.back().propertyDefinitions[i].name != name);
-#endif
-
-		ObjectDefinition::Property p(DATATYPE_STRING);
-		p.name = name;
-		_managed_classes.back().propertyDefinitions.push_back(std::move(p));
-	}
-
-	_managed_classes[_objType].propertyDefinitions[_numProperties++].value_string = value;
+	GetWriteColumn(name, DATATYPE_STRING).strings.emplace_back(value);
 }
 
 std::string_view MapFile::GetCurrentClassName() const
 {
 	assert(!_modeWrite);
-	assert(_objType >= 0 && _objType < (int) _managed_classes.size());
-	return _managed_classes[_objType].className;
+	assert(_objType >= 0 && _objType < (int) _classes.size());
+	return _classes[_objType].className;
 }
 
 void MapFile::BeginObject(std::string_view classname)
@@ -385,19 +410,26 @@ void MapFile::BeginObject(std::string_view classname)
 		_headerWritten = true;
 	}
 
+	int objType;
 	auto it = _name_to_index.find(classname);
 	if( _name_to_index.end() == it )
 	{
 		_isNewClass = true;
-		_objType = (int)_managed_classes.size();
-		_name_to_index.emplace(classname, _objType);
-		_managed_classes.emplace_back();
-		_managed_classes.back().className = classname;
+		objType = (int)_classes.size();
+		_name_to_index.emplace(classname, objType);
+		_classes.emplace_back();
+		_classes.back().className = classname;
 	}
 	else
 	{
 		_isNewClass = false;
-		_objType = it->second;
+		objType = it->second;
+	}
+
+	if( objType != _objType )
+	{
+		WriteRun();
+		_objType = objType;
 	}
 
 	_numProperties = 0;
@@ -406,118 +438,253 @@ void MapFile::BeginObject(std::string_view classname)
 void MapFile::WriteCurrentObject()
 {
 	assert(_modeWrite);
-	assert(_numProperties == _managed_classes[_objType].propertyDefinitions.size());
+	assert(_numProperties == (int) _classes[_objType].columns.size());
 
+	if( _isNewClass )
+	{
+		WriteClass(_classes[_objType]);
+		_isNewClass = false;
+	}
+	++_runCount;
+}
+
+void MapFile::WriteClass(const ClassTable &table)
+{
 	ChunkHeader ch;
+	ch.chunkType = CHUNK_OBJDEF;
+	ch.chunkSize = 0;
+	GetWriteBuffer<ChunkHeader>() = ch;
+	WriteString(table.className);
+	WriteInt((int)table.columns.size());
+	for( auto &column: table.columns )
+	{
+		WriteInt(column.type);
+		WriteString(column.name);
+	}
+}
 
-	// object class
-	if( _isNewClass )
+// Objects of the same class that come in a row go into one chunk, column by column.
+void MapFile::WriteRun()
+{
+	if( !_runCount )
+		return;
+
+	ClassTable &table = _classes[_objType];
+	size_t size = sizeof(int32_t) * 2;
+	for( auto &column: table.columns )
 	{
-		const ObjectDefinition &od = _managed_classes.back();
-		ch.chunkType = CHUNK_OBJDEF;
-		ch.chunkSize = 0;
-		GetWriteBuffer<ChunkHeader>() = ch;
-		WriteString(od.className);
-		WriteInt((int)od.propertyDefinitions.size());
-		for( auto &prop: od.propertyDefinitions )
+		if( DATATYPE_STRING == column.type )
+		{
+			for( auto &str: column.strings )
+				size += sizeof(uint16_t) + str.length();
+		}
+		else
 		{
-			WriteInt(prop._type);
-			WriteString(prop.name);
+			size += 4 * _runCount;
 		}
 	}
 
-	// object data
-	ch.chunkType = CHUNK_OBJECT;
-	ch.chunkSize = 0;
+	ChunkHeader ch;
+	ch.chunkType = CHUNK_TABLE;
+	ch.chunkSize = static_cast<uint32_t>(size); // lets older readers skip it
 	GetWriteBuffer<ChunkHeader>() = ch;
-
 	WriteInt(_objType);
+	WriteInt(_runCount);
 
-	for (auto &prop : _managed_classes[_objType].propertyDefinitions)
+	for( auto &column: table.columns )
 	{
-		switch (prop._type)
+		switch( column.type )
 		{
 		case DATATYPE_INT:
-			WriteInt(prop.value_int);
+			static_assert(sizeof(int) == 4, "size of int is not 4");
+			WriteData(column.ints.data(), column.ints.size() * 4);
+			column.ints.clear();
 			break;
 		case DATATYPE_FLOAT:
-			WriteFloat(prop.value_float);
+			WriteData(column.floats.data(), column.floats.size() * 4);
+			column.floats.clear();
 			break;
 		case DATATYPE_STRING:
-			WriteString(prop.value_string);
+			for( auto &str: column.strings )
+				WriteString(str);
+			column.strings.clear();
 			break;
 		default:
 			assert(false);
 		}
 	}
+
+	_runCount = 0;
 }
 
 void MapFile::WriteEndOfFile()
 {
 	assert(_modeWrite);
-	_file.Write(_buffer.get(), _bufferSize);
-	_bufferSize = 0;
+	if( !_headerWritten )
+	{
+		WriteHeader();
+		_headerWritten = true;
+	}
+	WriteRun();
+	FlushWriteBuffer();
 }
 
-bool MapFile::ReadNextObject()
+void MapFile::ReadClass()
+{
+	ClassTable &table = _classes.emplace_back();
+	ReadString(table.className);
+	int propertyCount;
+	ReadInt(propertyCount);
+	if( propertyCount < 0 || propertyCount > 0xffff )
+		throw std::runtime_error("invalid class");
+	table.columns.reserve(propertyCount);
+	for( int i = 0; i < propertyCount; i++ )
+	{
+		int propType;
+		ReadInt(propType);
+		if( DATATYPE_INT != propType && DATATYPE_FLOAT != propType && DATATYPE_STRING != propType )
+			throw std::runtime_error("unknown data type");
+		std::string name;
+		ReadString(name);
+		table.columns.emplace_back(static_cast<enumDataTypes>(propType), name);
+	}
+}
+
+void MapFile::ReadObject()
+{
+	int classIndex;
+	ReadInt(classIndex);
+	if( classIndex < 0 || classIndex >= (int) _classes.size() )
+		throw std::runtime_error("invalid class");
+
+	for( auto &column: _classes[classIndex].columns )
+	{
+		switch( column.type )
+		{
+		case DATATYPE_INT:
+			ReadInt(column.ints.emplace_back());
+			break;
+		case DATATYPE_FLOAT:
+			ReadFloat(column.floats.emplace_back());
+			break;
+		case DATATYPE_STRING:
+			ReadString(column.strings.emplace_back());
+			break;
+		default:
+			assert(false);
+		}
+	}
+	AddRun(classIndex, 1);
+}
+
+void MapFile::ReadTable(size_t end)
+{
+	int classIndex;
+	int count;
+	ReadInt(classIndex);
+	ReadInt(count);
+	if( classIndex < 0 || classIndex >= (int) _classes.size() )
+		throw std::runtime_error("invalid class");
+	if( count < 0 || (size_t) count > end - _readPos )
+		throw std::runtime_error("invalid object count");
+
+	for( auto &column: _classes[classIndex].columns )
+	{
+		switch( column.type )
+		{
+		case DATATYPE_INT:
+			column.ints.resize(column.ints.size() + count);
+			ReadData(column.ints.data() + column.ints.size() - count, count * 4);
+			break;
+		case DATATYPE_FLOAT:
+			column.floats.resize(column.floats.size() + count);
+			ReadData(column.floats.data() + column.floats.size() - count, count * 4);
+			break;
+		case DATATYPE_STRING:
+			column.strings.reserve(column.strings.size() + count);
+			for( int i = 0; i < count; i++ )
+				ReadString(column.strings.emplace_back());
+			break;
+		default:
+			assert(false);
+		}
+	}
+	if( _readPos != end )
+		throw std::runtime_error("invalid table size");
+	AddRun(classIndex, count);
+}
+
+void MapFile::AddRun(int classIndex, int count)
+{
+	ClassTable &table = _classes[classIndex];
+	if( !_runs.empty() && _runs.back().classIndex == classIndex )
+		_runs.back().count += count;
+	else if( count )
+		_runs.push_back({ classIndex, table.rowCount, count });
+	table.rowCount += count;
+}
+
+void MapFile::ReadObjects()
 {
 	assert(!_modeWrite);
+	_objectsRead = true;
+	_fill(_dataSize - _readPos); // one read instead of one per value
 
 	for( ChunkHeader ch; _read_chunk_header(ch); )
 	{
 		switch( ch.chunkType )
 		{
 			case CHUNK_OBJDEF:
-			{
-				_managed_classes.emplace_back();
-				ObjectDefinition &od = _managed_classes.back();
-				ReadString(od.className);
-				int propertyCount;
-				ReadInt(propertyCount);
-				od.propertyDefinitions.reserve(propertyCount);
-				for (int i = 0; i < propertyCount; i++)
-				{
-					int propType;
-					ReadInt(propType);
-					auto &prop = od.propertyDefinitions.emplace_back(static_cast<enumDataTypes>(propType));
-					ReadString(prop.name);
-				}
+				ReadClass();
 				break;
-			}
 
 			case CHUNK_OBJECT:
-			{
-				ReadInt(_objType);
-				if( _objType < 0 || _objType >= (int) _managed_classes.size() )
-					throw std::runtime_error("invalid class");
+				ReadObject();
+				break;
 
-				for( auto &prop: _managed_classes[_objType].propertyDefinitions )
-				{
-					switch(prop._type)
-					{
-					case DATATYPE_INT:
-						ReadInt(prop.value_int);
-						break;
-					case DATATYPE_FLOAT:
-						ReadFloat(prop.value_float);
-						break;
-					case DATATYPE_STRING:
-						ReadString(prop.value_string);
-						break;
-					default:
-						assert(false);
-					}
-				}
-				return true;
-			}
+			case CHUNK_TABLE:
+				if( _dataSize - _readPos < ch.chunkSize )
+					throw std::runtime_error("unexpected end of file");
+				ReadTable(_readPos + ch.chunkSize);
+				break;
 
 			default:
 				// skip everything we don't understand
 				_skip_block(ch.chunkSize);
 		}
 	}
+}
 
-	return false;
+const std::vector<MapFile::ObjectRun>& MapFile::GetObjectRuns()
+{
+	if( !_objectsRead )
+		ReadObjects();
+	return _runs;
+}
+
+void MapFile::SelectObject(int classIndex, int row)
+{
+	assert(!_modeWrite);
+	assert(classIndex >= 0 && classIndex < (int) _classes.size());
+	assert(row >= 0 && row < _classes[classIndex].rowCount);
+	_objType = classIndex;
+	_objRow = row;
+}
+
+bool MapFile::ReadNextObject()
+{
+	GetObjectRuns();
+	if( _nextRun == _runs.size() )
+		return false;
+
+	const ObjectRun &run = _runs[_nextRun];
+	SelectObject(run.classIndex, run.first + _nextRow);
+	if( ++_nextRow == run.count )
+	{
+		++_nextRun;
+		_nextRow = 0;
+	}
+	return true;
 }
 
 bool MapFile::loading() const
@@ -68,10 +68,12 @@ class MapFile
 	enum enumChunkTypes : uint32_t
 	{
 		CHUNK_HEADER_OPEN  = detail::MakeSignature("hdr{"),
+		CHUNK_HEADER_OPEN_TABLES = detail::MakeSignature("hdt{"), // tbl: chunks follow, older readers reject it
 		CHUNK_ATTRIB       = detail::MakeSignature("attr"),
 		CHUNK_HEADER_CLOSE = detail::MakeSignature("}hdr"),
 		CHUNK_OBJDEF       = detail::MakeSignature("dfn:"),
 		CHUNK_OBJECT       = detail::MakeSignature("obj:"),
+		CHUNK_TABLE        = detail::MakeSignature("tbl:"),
 		CHUNK_TEXTURE      = detail::MakeSignature("tex:"),
 	};
 #pragma warning(pop)
@@ -103,69 +105,31 @@ class MapFile
 		}
 	};
 
-	struct ObjectDefinition
+	// values of one property for every object of a class, only the vector of its type is used
+	struct Column
 	{
-		struct Property
-		{
-			Property(Property &&other)
-				: _type(other._type)
-				, name(std::move(other.name))
-			{
-				switch (_type)
-				{
-					case DATATYPE_INT:
-						value_int = other.value_int;
-						break;
-					case DATATYPE_FLOAT:
-						value_float = other.value_float;
-						break;
-					case DATATYPE_STRING:
-						new (&value_string) std::string(std::move(other.value_string));
-						break;
-				}
-			}
-			Property(enumDataTypes type)
-				: _type(type)
-			{
-				switch (_type)
-				{
-					case DATATYPE_INT:
-						value_int = 0;
-						break;
-					case DATATYPE_FLOAT:
-						value_float = 0;
-						break;
-					case DATATYPE_STRING:
-						new (&value_string) std::string();
-						break;
-					default:
-						throw std::runtime_error("Unknown data type");
-				}
-			}
-			~Property()
-			{
-				switch (_type)
-				{
-					case DATATYPE_INT:
-					case DATATYPE_FLOAT:
-						break;
-					case DATATYPE_STRING:
-						value_string.~basic_string();
-						break;
-				}
-			}
-			const enumDataTypes _type;
-			std::string   name;
-			union
-			{
-				int value_int;
-				float value_float;
-				std::string value_string;
-			};
-		};
-
-		std::string           className;
-		std::vector<Property> propertyDefinitions;
+		Column(enumDataTypes type_, std::string_view name_) : type(type_), name(name_) {}
+		enumDataTypes type;
+		std::string name;
+		std::vector<int> ints;
+		std::vector<float> floats;
+		std::vector<std::string> strings;
+	};
+
+	struct ClassTable
+	{
+		std::string className;
+		std::vector<Column> columns;
+		int rowCount = 0;
+	};
+
+public:
+	// Consecutive objects of one class. Rows index the class columns.
+	struct ObjectRun
+	{
+		int classIndex;
+		int first;
+		int count;
 	};
 
 private:
@@ -176,23 +140,46 @@ private:
 	bool _headerWritten = false;
 	bool _isNewClass = false;
 
+	// the header is read on open, the objects at once when first needed
+	std::vector<char> _data;
+	size_t _dataSize = 0; // of the whole file
+	size_t _readPos = 0;
+	bool _objectsRead = false;
+
 	AttributeSet _mapAttrs;
 
-	std::vector<ObjectDefinition> _managed_classes;
-	std::map<std::string, int, std::less<>> _name_to_index; // map classname to index in _managed_classes
+	std::vector<ClassTable> _classes;
+	std::map<std::string, int, std::less<>> _name_to_index; // map classname to index in _classes
+	std::vector<ObjectRun> _runs;
+	size_t _nextRun = 0;
+	int _nextRow = 0;
 
-	int _objType; // index in _managed_classes
+	int _objType; // index in _classes
+	int _objRow;  // current object in the class columns when loading
 	int _numProperties; // in current object
+	int _runCount = 0; // objects of _objType not written yet
 
 	bool _read_chunk_header(ChunkHeader &chdr);
 	void _skip_block(size_t size);
+	void _fill(size_t size);
+
+	void ReadObjects();
+	void ReadClass();
+	void ReadObject();
+	void ReadTable(size_t end);
+	void AddRun(int classIndex, int count);
+	const Column* FindColumn(std::string_view name, enumDataTypes type) const;
+	Column& GetWriteColumn(std::string_view name, enumDataTypes type);
 
 	void WriteHeader();
+	void WriteClass(const ClassTable &table);
+	void WriteRun();
 
 	void WriteInt(int value);
 	void WriteFloat(float value);
 	void WriteString(std::string_view value);
 	void WriteData(const void *data, size_t size);
+	void FlushWriteBuffer();
 	inline void* GetWriteBuffer(size_t size);
 	template<class T> T& GetWriteBuffer()
 	{
@@ -202,6 +189,7 @@ private:
 	void ReadInt(int &value);
 	void ReadFloat(float &value);
 	void ReadString(std::string &value);
+	void ReadData(void *data, size_t size);
 
 public:
 	MapFile(FS::Stream &stream, bool write);
@@ -214,6 +202,14 @@ public:
 	bool ReadNextObject();
 	std::string_view GetCurrentClassName() const;
 
+	// Random access to the objects for loaders that handle a class at a time.
+	// Runs follow the file order; a map written as a table per class has one
+	// run per class.
+	const std::vector<ObjectRun>& GetObjectRuns();
+	int GetClassCount() const { return static_cast<int>(_classes.size()); }
+	std::string_view GetClassName(int classIndex) const { return _classes[classIndex].className; }
+	void SelectObject(int classIndex, int row);
+
 	void BeginObject(std::string_view classname);
 	void WriteCurrentObject();
 	void WriteEndOfFile();
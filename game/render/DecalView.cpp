@@ -0,0 +1,94 @@
+#include "inc/render/DecalView.h"
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <video/RenderContext.h>
+#include <video/TextureManager.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	struct DecalTypeDesc
+	{
+		DecalType type;
+		const char *texture;
+		enumZOrder z;
+		bool fade;
+	};
+}
+
+static const DecalTypeDesc decalTypes[] = {
+	{ PARTICLE_EXPLOSION1, "explosion_o", Z_EXPLODE, false },
+	{ PARTICLE_EXPLOSION2, "explosion_big", Z_EXPLODE, false },
+	{ PARTICLE_BIGBLAST, "bigblast", Z_WATER, true },
+	{ PARTICLE_SMALLBLAST, "smallblast", Z_WATER, true },
+	{ PARTICLE_GAUSS1, "particle_gauss1", Z_GAUSS_RAY, true },
+	{ PARTICLE_GAUSS2, "particle_gauss2", Z_GAUSS_RAY, true },
+	{ PARTICLE_CATTRACK, "cat_track", Z_WATER, true },
+};
+
+DecalView::DecalView(TextureManager &tm)
+	: _tm(tm)
+{
+	int maxType = 0;
+	for (auto &desc: decalTypes)
+		maxType = std::max(maxType, (int) desc.type);
+	_types.resize(maxType + 1, TypeView{ 0, Z_NONE, false });
+	for (auto &desc: decalTypes)
+	{
+		_types[desc.type] = TypeView{ tm.FindSprite(desc.texture), desc.z, desc.fade };
+		_layers[desc.z] = true;
+	}
+}
+
+void DecalView::Draw(RenderContext &rc, const World &world, FRECT visibleRegion, enumZOrder z) const
+{
+	if (!_layers[z])
+		return;
+
+	const DecalStore &store = world._decals;
+	RectRB bounds = store.GetBounds();
+	int xmin = std::max(bounds.left, (int)std::floor(visibleRegion.left / WORLD_LOCATION_SIZE - 0.5f));
+	int ymin = std::max(bounds.top, (int)std::floor(visibleRegion.top / WORLD_LOCATION_SIZE - 0.5f));
+	int xmax = std::min(bounds.right - 1, (int)std::floor(visibleRegion.right / WORLD_LOCATION_SIZE + 0.5f));
+	int ymax = std::min(bounds.bottom - 1, (int)std::floor(visibleRegion.bottom / WORLD_LOCATION_SIZE + 0.5f));
+
+	float time = world.GetTime();
+	std::vector<const Decal*> visible;
+	for (int y = ymin; y <= ymax; ++y)
+	for (int x = xmin; x <= xmax; ++x)
+	{
+		store.ForEachInCell(x, y, [&](const Decal &decal)
+		{
+			if (decal.type < (int) _types.size() && _types[decal.type].z == z && time - decal.timeCreated < decal.lifeTime)
+				visible.push_back(&decal);
+		});
+	}
+
+	// keep the draws of one texture together
+	std::stable_sort(visible.begin(), visible.end(), [](const Decal *a, const Decal *b)
+	{
+		return a->type < b->type;
+	});
+
+	for (const Decal *decal: visible)
+	{
+		const TypeView &view = _types[decal->type];
+		float state = (time - decal->timeCreated) / decal->lifeTime;
+		auto frame = std::min(_tm.GetFrameCount(view.texId) - 1, (int) ((float) _tm.GetFrameCount(view.texId) * state));
+		SpriteColor color;
+		if (view.fade)
+		{
+			unsigned char op = (unsigned char) int(255.0f * (1.0f - state));
+			color.r = op;
+			color.g = op;
+			color.b = op;
+			color.a = op;
+		}
+		else
+		{
+			color = 0xffffffff;
+		}
+		rc.DrawSprite(view.texId, frame, color, decal->pos, decal->direction);
+	}
+}
@@ -0,0 +1,183 @@
+#include "inc/render/LightCache.h"
+#include <gc/Light.h>
+#include <gc/Macros.h>
+#include <gc/World.h>
+#include <video/RenderContext.h>
+#include <algorithm>
+
+namespace
+{
+	// what the cached geometry of a light was built from
+	struct CachedLight
+	{
+		const GC_Light *light;
+		vec2d pos;
+		vec2d dir;
+		float radius;
+		float extent; // offset or length
+		float aspect;
+		float intensity;
+		bool active;
+
+		explicit CachedLight(const GC_Light &l)
+			: light(&l)
+			, pos(l.GetPos())
+			, dir(l.GetLightDirection())
+			, radius(l.GetRadius())
+			, extent(GC_Light::LIGHT_DIRECT == l.GetLightType() ? l.GetLength() : l.GetOffset())
+			, aspect(l.GetAspect())
+			, intensity(l.GetIntensity())
+			, active(l.GetActive())
+		{}
+
+		bool operator==(const CachedLight &other) const
+		{
+			return light == other.light && pos == other.pos && dir == other.dir &&
+				radius == other.radius && extent == other.extent && aspect == other.aspect &&
+				intensity == other.intensity && active == other.active;
+		}
+	};
+}
+
+struct LightCache::Cell
+{
+	std::vector<CachedLight> lights;
+	LightFans fans;
+	unsigned int checked = 0; // stamp of the Update that validated the cell
+	unsigned int listed = 0; // stamp of the region that listed the cell for drawing
+};
+
+static bool IsAnchoredAt(const GC_Light &light, int x, int y)
+{
+	return light.GetStatic() && light.GetCells().left == x && light.GetCells().top == y;
+}
+
+static void AddLight(LightFans &fans, const GC_Light &light)
+{
+	switch (light.GetLightType())
+	{
+		case GC_Light::LIGHT_POINT:
+			fans.AddPointLight(light.GetIntensity(), light.GetRadius(), light.GetPos());
+			break;
+		case GC_Light::LIGHT_SPOT:
+			fans.AddSpotLight(light.GetIntensity(), light.GetRadius(), light.GetPos(),
+			                  light.GetLightDirection(), light.GetOffset(), light.GetAspect());
+			break;
+		case GC_Light::LIGHT_DIRECT:
+			fans.AddDirectLight(light.GetIntensity(), light.GetRadius(), light.GetPos(),
+			                    light.GetLightDirection(), light.GetLength());
+			break;
+		default:
+			assert(false);
+	}
+}
+
+LightCache::LightCache()
+{
+}
+
+LightCache::~LightCache()
+{
+}
+
+void LightCache::Update(const World &world, const std::vector<RectRB> &regionCells)
+{
+	RectRB bounds = world.GetLocationBounds();
+	if (bounds.left != _bounds.left || bounds.top != _bounds.top ||
+		bounds.right != _bounds.right || bounds.bottom != _bounds.bottom)
+	{
+		_cells.clear();
+		_cells.resize(WIDTH(bounds) * HEIGHT(bounds));
+		_bounds = bounds;
+	}
+
+	unsigned int updateStamp = ++_stamp;
+	_drawCells.resize(regionCells.size());
+	for (size_t i = 0; i < regionCells.size(); ++i)
+	{
+		unsigned int regionStamp = ++_stamp;
+		const RectRB &cells = regionCells[i];
+		auto &drawCells = _drawCells[i];
+		drawCells.clear();
+
+		for (int y = cells.top; y < cells.bottom; ++y)
+		for (int x = cells.left; x < cells.right; ++x)
+		{
+			FOREACH(world.grid_lights.element(x, y), const GC_Light, light)
+			{
+				// a light covering several cells of the region is seen from the first one only
+				RectRB lightCells = light->GetCells();
+				if (!light->GetStatic() ||
+					x != std::max(lightCells.left, cells.left) || y != std::max(lightCells.top, cells.top))
+				{
+					continue;
+				}
+
+				unsigned int index = (lightCells.top - _bounds.top) * WIDTH(_bounds) + lightCells.left - _bounds.left;
+				Cell &cell = _cells[index];
+				if (cell.checked != updateStamp)
+				{
+					Validate(world, lightCells.left, lightCells.top, cell);
+					cell.checked = updateStamp;
+				}
+				if (cell.listed != regionStamp)
+				{
+					cell.listed = regionStamp;
+					drawCells.push_back(index);
+				}
+			}
+		}
+	}
+}
+
+void LightCache::Validate(const World &world, int x, int y, Cell &cell)
+{
+	auto &lights = world.grid_lights.element(x, y);
+
+	size_t count = 0;
+	bool changed = false;
+	FOREACH(lights, const GC_Light, light)
+	{
+		if (IsAnchoredAt(*light, x, y))
+		{
+			if (count == cell.lights.size() || !(cell.lights[count] == CachedLight(*light)))
+			{
+				changed = true;
+				break;
+			}
+			++count;
+		}
+	}
+	if (!changed && count == cell.lights.size())
+		return;
+
+	cell.lights.clear();
+	cell.fans.Clear();
+	FOREACH(lights, const GC_Light, light)
+	{
+		if (IsAnchoredAt(*light, x, y))
+		{
+			cell.lights.emplace_back(*light);
+			if (light->GetActive())
+				AddLight(cell.fans, *light);
+		}
+	}
+	++_rebuildCount;
+}
+
+void LightCache::Draw(RenderContext &rc, unsigned int region) const
+{
+	assert(region < _drawCells.size());
+	for (unsigned int index: _drawCells[region])
+	{
+		if (!_cells[index].fans.Empty())
+			rc.DrawLightFans(_cells[index].fans);
+	}
+}
+
+void LightCache::Clear()
+{
+	_cells.clear();
+	_drawCells.clear();
+	_bounds = {};
+}
@@ -0,0 +1,216 @@
+#include "inc/render/RenderList.h"
+#include "inc/render/ObjectView.h"
+#include "inc/render/RenderScheme.h"
+#include <gc/Macros.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <algorithm>
+#include <climits>
+
+RenderList::RenderList(World &world)
+	: _world(world)
+{
+	_world.eWorld.AddListener(*this);
+}
+
+RenderList::~RenderList()
+{
+	_world.eWorld.RemoveListener(*this);
+}
+
+void RenderList::Update(const RenderScheme &rs, bool editorMode, bool nightMode)
+{
+	if (_renderScheme == &rs && _editorMode == editorMode && _nightMode == nightMode)
+		return;
+
+	_renderScheme = &rs;
+	_editorMode = editorMode;
+	_nightMode = nightMode;
+
+	_entries.clear();
+	_batches.clear();
+	_batchRank.clear();
+	for (auto &layer: _visible)
+		layer.clear();
+
+	FOREACH(_world.GetList(LIST_objects), GC_Object, object)
+	{
+		if (auto mo = dynamic_cast<const GC_MovingObject*>(object))
+			Add(*mo);
+	}
+}
+
+void RenderList::Add(const GC_MovingObject &mo)
+{
+	std::vector<Entry> entries;
+	for (auto &view: _renderScheme->GetViews(mo, _editorMode, _nightMode))
+	{
+		if (view.zfunc->IsConst())
+		{
+			enumZOrder z = view.zfunc->GetZ(_world, mo);
+			if (Z_NONE != z)
+				entries.push_back({ nullptr, view.rfunc.get(), z, GetBatch(view.rfunc->GetBatchKey()) });
+		}
+		else
+		{
+			entries.push_back({ view.zfunc.get(), view.rfunc.get(), Z_NONE, GetBatch(view.rfunc->GetBatchKey()) });
+		}
+	}
+	if (!entries.empty())
+	{
+		size_t index = mo.GetId().index();
+		if (_entries.size() <= index)
+			_entries.resize(index + 1);
+		_entries[index] = std::move(entries);
+	}
+}
+
+unsigned int RenderList::GetBatch(size_t batchKey)
+{
+	auto inserted = _batches.emplace(batchKey, static_cast<unsigned int>(_batches.size()));
+	if (inserted.second)
+	{
+		// a new texture is rare, so the ranks are simply computed again
+		std::vector<std::pair<size_t, unsigned int>> keys(_batches.begin(), _batches.end());
+		std::sort(keys.begin(), keys.end());
+		_batchRank.resize(keys.size());
+		for (unsigned int rank = 0; rank < keys.size(); ++rank)
+			_batchRank[keys[rank].second] = rank;
+	}
+	return inserted.first->second;
+}
+
+static RectRB GetVisibleCells(const World &world, FRECT region)
+{
+	RectRB bounds = world.GetLocationBounds();
+	return RectRB{
+		std::max(bounds.left, (int)std::floor(region.left / WORLD_LOCATION_SIZE - 0.5f)),
+		std::max(bounds.top, (int)std::floor(region.top / WORLD_LOCATION_SIZE - 0.5f)),
+		std::min(bounds.right - 1, (int)std::floor(region.right / WORLD_LOCATION_SIZE + 0.5f)) + 1,
+		std::min(bounds.bottom - 1, (int)std::floor(region.bottom / WORLD_LOCATION_SIZE + 0.5f)) + 1 };
+}
+
+void RenderList::GatherObject(const GC_MovingObject &mo, int locX, int locY, uint32_t regions)
+{
+	size_t index = mo.GetId().index();
+	if (_entries.size() <= index)
+		return;
+
+	const Entry *first[Z_COUNT] = {};
+	for (auto &entry: _entries[index])
+	{
+		enumZOrder z = entry.zfunc ? entry.zfunc->GetZ(_world, mo) : entry.z;
+		if (Z_NONE == z)
+			continue;
+		if (!first[z])
+			first[z] = &entry; // keep views of one object together and in the scheme order
+		_visible[z].push_back({ &mo, entry.rfunc, first[z]->rfunc->GetBatchKey(), first[z]->batch, locX, locY, regions });
+	}
+}
+
+// Stable counting sort by batch rank; the gather order is kept within a batch.
+void RenderList::SortByBatch(std::vector<VisibleEntry> &layer)
+{
+	if (layer.size() < 2)
+		return;
+
+	_batchStart.assign(_batches.size() + 1, 0);
+	for (auto &entry: layer)
+		++_batchStart[_batchRank[entry.batch] + 1];
+	for (size_t i = 1; i < _batchStart.size(); ++i)
+		_batchStart[i] += _batchStart[i - 1];
+
+	_sortBuffer.resize(layer.size());
+	for (auto &entry: layer)
+		_sortBuffer[_batchStart[_batchRank[entry.batch]]++] = entry;
+	layer.swap(_sortBuffer);
+}
+
+void RenderList::Gather(const std::vector<FRECT> &regions)
+{
+	assert(_renderScheme);
+	assert(regions.size() <= 32);
+	_killedSinceGather = false;
+
+	for (auto &layer: _visible)
+		layer.clear();
+
+	_regionCells.clear();
+	for (auto &region: regions)
+		_regionCells.push_back(GetVisibleCells(_world, region));
+
+	// cells shared by several cameras are visited with the first of them only
+	for (size_t i = 0; i < _regionCells.size(); ++i)
+	{
+		const RectRB &cells = _regionCells[i];
+		for (int x = cells.left; x < cells.right; ++x)
+		for (int y = cells.top; y < cells.bottom; ++y)
+		{
+			uint32_t inRegions = 0;
+			for (size_t j = 0; j < _regionCells.size(); ++j)
+			{
+				if (PtInRect(_regionCells[j], x, y))
+					inRegions |= 1u << j;
+			}
+			if (inRegions & ((1u << i) - 1))
+				continue;
+
+			FOREACH(_world.grid_moving.element(x, y), const GC_MovingObject, object)
+			{
+				if (object->GetGridSet())
+					GatherObject(*object, x, y, inRegions);
+			}
+		}
+	}
+
+	// objects out of the grid are always drawn
+	FOREACH(_world.GetList(LIST_gsprites), const GC_MovingObject, object)
+	{
+		if (!object->GetGridSet())
+			GatherObject(*object, INT_MIN, INT_MIN, UINT32_MAX);
+	}
+
+	for (auto &layer: _visible)
+		SortByBatch(layer);
+
+	if (_nightMode)
+		_lightCache.Update(_world, _regionCells);
+}
+
+void RenderList::Draw(RenderContext &rc, unsigned int region, enumZOrder z) const
+{
+	assert(!_killedSinceGather);
+	assert(region < _regionCells.size());
+	for (auto &entry: _visible[z])
+	{
+		if (entry.regions & (1u << region))
+			entry.rfunc->Draw(_world, *entry.mo, rc);
+	}
+}
+
+void RenderList::OnKill(GC_Object &obj)
+{
+	size_t index = obj.GetId().index();
+	if (index < _entries.size() && !_entries[index].empty())
+	{
+		_entries[index].clear();
+		_killedSinceGather = true;
+	}
+}
+
+void RenderList::OnClear()
+{
+	_entries.clear();
+	_lightCache.Clear();
+	for (auto &layer: _visible)
+		layer.clear();
+}
+
+void RenderList::OnNewObject(GC_Object &obj)
+{
+	if (!_renderScheme)
+		return;
+
+	if (auto mo = dynamic_cast<const GC_MovingObject*>(&obj))
+		Add(*mo);
+}
@@ -155,9 +155,6 @@ public:
 
 		AddView<GC_BrickFragment>(Make<Z_Const>(Z_PARTICLE), Make<R_BrickFragment>(tm));
 		AddView<GC_Particle>(Make<Z_Const>(Z_PARTICLE), Make<R_Particle>(tm));
-		AddView<GC_Decal>(Make<Z_Const>(Z_WATER), Make<R_Particle>(tm));
-		AddView<GC_DecalExplosion>(Make<Z_Const>(Z_EXPLODE), Make<R_Particle>(tm));
-		AddView<GC_DecalGauss>(Make<Z_Const>(Z_GAUSS_RAY), Make<R_Particle>(tm));
 
 		AddView<GC_UserObject>(Make<Z_UserObject>(), Make<R_UserObject>(tm));
 		AddView<GC_Decoration>(Make<Z_Decoration>(), Make<R_Decoration>(tm));
@@ -184,9 +181,16 @@ public:
 };
 
 RenderScheme::RenderScheme(TextureManager &tm)
-	: _gameViews(GameViewsBuilder(tm))
-	, _editorViews(EditorViewsBuilder(tm))
-	, _nightViews(NightViewsBuilder(tm))
+	: RenderScheme(GameViewsBuilder(tm), EditorViewsBuilder(tm), NightViewsBuilder(tm))
+{
+}
+
+RenderScheme::RenderScheme(ObjectViewsSelectorBuilder &&gameViews,
+                           ObjectViewsSelectorBuilder &&editorViews,
+                           ObjectViewsSelectorBuilder &&nightViews)
+	: _gameViews(std::move(gameViews))
+	, _editorViews(std::move(editorViews))
+	, _nightViews(std::move(nightViews))
 {
 }
 
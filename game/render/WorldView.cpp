@@ -1,4 +1,6 @@
 #include "inc/render/WorldView.h"
+#include "inc/render/LightCache.h"
+#include "inc/render/RenderList.h"
 #include "inc/render/RenderScheme.h"
 #include <ai/ai.h>
 #include <ctx/AIManager.h>
@@ -14,6 +16,7 @@
 WorldView::WorldView(TextureManager &tm, RenderScheme &rs)
 	: _renderScheme(rs)
 	, _terrain(tm)
+	, _decals(tm)
 	, _lineTex(tm.FindSprite("dotted_line"))
 	, _texField(tm.FindSprite("ui/window"))
 {
@@ -23,6 +26,32 @@ WorldView::~WorldView()
 {
 }
 
+static void DrawLight(RenderContext &rc, const World &world, const GC_Light &light)
+{
+	float intensity = light.GetIntensity();
+	if (light.GetFade())
+	{
+		float age = (world.GetTime() - light.GetStartTime()) / light.GetTimeout();
+		intensity *= 1.0f - age*age*age;
+	}
+	switch (light.GetLightType())
+	{
+		case GC_Light::LIGHT_POINT:
+			rc.DrawPointLight(intensity, light.GetRadius(), light.GetPos());
+			break;
+		case GC_Light::LIGHT_SPOT:
+			rc.DrawSpotLight(intensity, light.GetRadius(), light.GetPos(),
+			                 light.GetLightDirection(), light.GetOffset(), light.GetAspect());
+			break;
+		case GC_Light::LIGHT_DIRECT:
+			rc.DrawDirectLight(intensity, light.GetRadius(), light.GetPos(),
+			                   light.GetLightDirection(), light.GetLength());
+			break;
+		default:
+			assert(false);
+	}
+}
+
 void WorldView::Render(RenderContext &rc,
                        const World &world,
                        WorldViewRenderOptions options,
@@ -30,52 +59,9 @@ void WorldView::Render(RenderContext &rc,
 {
 	FRECT visibleRegion = rc.GetVisibleRegion();
 
-	// draw lights to alpha channel
-	rc.SetAmbient(options.nightMode ? (options.editorMode ? 0.5f : 0) : 1);
-	rc.SetMode(RM_LIGHT); // this will clear the render target with the ambient set above
-	if( options.nightMode )
-	{
-		float xmin = std::max(world.GetBounds().left, visibleRegion.left);
-		float ymin = std::max(world.GetBounds().top, visibleRegion.top);
-		float xmax = std::min(world.GetBounds().right, visibleRegion.right);
-		float ymax = std::min(world.GetBounds().bottom, visibleRegion.bottom);
-
-		FOREACH( world.GetList(LIST_lights), const GC_Light, pLight )
-		{
-			if( pLight->GetActive() &&
-				pLight->GetPos().x + pLight->GetRenderRadius() > xmin &&
-				pLight->GetPos().x - pLight->GetRenderRadius() < xmax &&
-				pLight->GetPos().y + pLight->GetRenderRadius() > ymin &&
-				pLight->GetPos().y - pLight->GetRenderRadius() < ymax )
-			{
-				float intensity = pLight->GetIntensity();
-				if (pLight->GetFade())
-				{
-					float age = (world.GetTime() - pLight->GetStartTime()) / pLight->GetTimeout();
-					intensity *= 1.0f - age*age*age;
-				}
-				switch (pLight->GetLightType())
-				{
-					case GC_Light::LIGHT_POINT:
-						rc.DrawPointLight(intensity, pLight->GetRadius(), pLight->GetPos());
-						break;
-					case GC_Light::LIGHT_SPOT:
-						rc.DrawSpotLight(intensity, pLight->GetRadius(), pLight->GetPos(),
-						                 pLight->GetLightDirection(), pLight->GetOffset(), pLight->GetAspect());
-						break;
-					case GC_Light::LIGHT_DIRECT:
-						rc.DrawDirectLight(intensity, pLight->GetRadius(), pLight->GetPos(),
-						                   pLight->GetLightDirection(), pLight->GetLength());
-						break;
-					default:
-						assert(false);
-				}
-			}
-		}
-	}
-
+	RenderLights(rc, world, options, nullptr, 0);
 
-	static std::vector<std::pair<const GC_MovingObject*, const ObjectRFunc*>> zLayers[Z_COUNT];
+	std::vector<std::pair<const GC_MovingObject*, const ObjectRFunc*>> zLayers[Z_COUNT];
 
 	int xmin = std::max(world.GetLocationBounds().left, (int)std::floor(visibleRegion.left / WORLD_LOCATION_SIZE - 0.5f));
 	int ymin = std::max(world.GetLocationBounds().top, (int)std::floor(visibleRegion.top / WORLD_LOCATION_SIZE - 0.5f));
@@ -118,11 +104,95 @@ void WorldView::Render(RenderContext &rc,
 	{
 		for( auto &moWithView: zLayers[z] )
 			moWithView.second->Draw(world, *moWithView.first, rc);
-		zLayers[z].clear();
+		_decals.Draw(rc, world, visibleRegion, (enumZOrder) z);
+	}
+
+	rc.SetMode(RM_INTERFACE);
+	RenderOverlays(rc, world, options, aiManager);
+}
+
+void WorldView::Gather(RenderList &renderList, const std::vector<FRECT> &regions, WorldViewRenderOptions options) const
+{
+	renderList.Update(_renderScheme, options.editorMode, options.nightMode);
+	renderList.Gather(regions);
+}
+
+void WorldView::Render(RenderContext &rc,
+                       const RenderList &renderList,
+                       unsigned int region,
+                       WorldViewRenderOptions options,
+                       const AIManager *aiManager) const
+{
+	const World &world = renderList.GetWorld();
+
+	RenderLights(rc, world, options, &renderList.GetLightCache(), region);
+
+	rc.SetMode(RM_WORLD);
+	_terrain.Draw(rc, world, options.drawGrid, !options.noBackground);
+	FRECT visibleRegion = rc.GetVisibleRegion();
+	for (int z = 0; z < Z_COUNT; ++z)
+	{
+		renderList.Draw(rc, region, (enumZOrder) z);
+		_decals.Draw(rc, world, visibleRegion, (enumZOrder) z);
 	}
 
 	rc.SetMode(RM_INTERFACE);
+	RenderOverlays(rc, world, options, aiManager);
+}
+
+void WorldView::RenderLights(RenderContext &rc, const World &world, WorldViewRenderOptions options,
+                             const LightCache *staticLights, unsigned int region) const
+{
+	FRECT visibleRegion = rc.GetVisibleRegion();
+
+	// draw lights to alpha channel
+	rc.SetAmbient(options.nightMode ? (options.editorMode ? 0.5f : 0) : 1);
+	rc.SetMode(RM_LIGHT); // this will clear the render target with the ambient set above
+	if( options.nightMode )
+	{
+		RectRB cells = RectClamp(RectRB{
+			(int)std::floor(visibleRegion.left / WORLD_LOCATION_SIZE),
+			(int)std::floor(visibleRegion.top / WORLD_LOCATION_SIZE),
+			(int)std::floor(visibleRegion.right / WORLD_LOCATION_SIZE) + 1,
+			(int)std::floor(visibleRegion.bottom / WORLD_LOCATION_SIZE) + 1 }, world.GetLocationBounds());
+
+		float xmin = std::max(world.GetBounds().left, visibleRegion.left);
+		float ymin = std::max(world.GetBounds().top, visibleRegion.top);
+		float xmax = std::min(world.GetBounds().right, visibleRegion.right);
+		float ymax = std::min(world.GetBounds().bottom, visibleRegion.bottom);
+
+		if( staticLights )
+			staticLights->Draw(rc, region);
+
+		for( int y = cells.top; y < cells.bottom; ++y )
+		for( int x = cells.left; x < cells.right; ++x )
+		{
+			FOREACH( world.grid_lights.element(x, y), const GC_Light, pLight )
+			{
+				// a light covering several visible cells is drawn from the first one only
+				RectRB lightCells = pLight->GetCells();
+				if( x != std::max(lightCells.left, cells.left) || y != std::max(lightCells.top, cells.top) )
+					continue;
+
+				if( staticLights && pLight->GetStatic() )
+					continue;
+
+				if( pLight->GetActive() &&
+					pLight->GetPos().x + pLight->GetRenderRadius() > xmin &&
+					pLight->GetPos().x - pLight->GetRenderRadius() < xmax &&
+					pLight->GetPos().y + pLight->GetRenderRadius() > ymin &&
+					pLight->GetPos().y - pLight->GetRenderRadius() < ymax )
+				{
+					DrawLight(rc, world, *pLight);
+				}
+			}
+		}
+	}
+}
 
+void WorldView::RenderOverlays(RenderContext &rc, const World &world, WorldViewRenderOptions options, const AIManager *aiManager) const
+{
+	FRECT visibleRegion = rc.GetVisibleRegion();
 
 	if (world._field && options.visualizeField)
 	{
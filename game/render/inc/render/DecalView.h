@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gc/Z.h>
+#include <math/MyMath.h>
+#include <stddef.h>
+#include <vector>
+
+class RenderContext;
+class TextureManager;
+class World;
+
+// Draws the decal store of a world, one z-layer at a time.
+// Visible decals of a layer are grouped by texture before drawing.
+class DecalView final
+{
+public:
+	explicit DecalView(TextureManager &tm);
+	void Draw(RenderContext &rc, const World &world, FRECT visibleRegion, enumZOrder z) const;
+
+private:
+	struct TypeView
+	{
+		size_t texId;
+		enumZOrder z;
+		bool fade;
+	};
+
+	TextureManager &_tm;
+	std::vector<TypeView> _types; // by DecalType
+	bool _layers[Z_COUNT] = {};
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <math/MyMath.h>
+#include <vector>
+
+class GC_Light;
+class RenderContext;
+class World;
+
+// Fan geometry of static lights, kept per location cell of World::grid_lights.
+// A static light belongs to the first cell it covers; the geometry of a cell
+// is rebuilt only when one of its static lights is created, killed, moved or
+// changed, and is replayed as is every other frame. Dynamic lights are drawn
+// on top by the caller.
+class LightCache final
+{
+public:
+	LightCache();
+	~LightCache();
+
+	// Brings the cells of static lights reaching into each of the given
+	// regions up to date and remembers them for Draw. At most one region per
+	// split-screen camera.
+	void Update(const World &world, const std::vector<RectRB> &regionCells);
+
+	// Draws the static lights reaching into a region of the last Update.
+	void Draw(RenderContext &rc, unsigned int region) const;
+
+	void Clear();
+
+	// Number of times the geometry of a cell was rebuilt so far.
+	unsigned int GetRebuildCount() const { return _rebuildCount; }
+
+private:
+	struct Cell;
+
+	std::vector<Cell> _cells; // by location, see _bounds
+	std::vector<std::vector<unsigned int>> _drawCells; // by region, indices in _cells
+	RectRB _bounds = {};
+	unsigned int _stamp = 0;
+	unsigned int _rebuildCount = 0;
+
+	void Validate(const World &world, int x, int y, Cell &cell);
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <gc/Z.h>
+#include <cstddef>
 
 class RenderContext;
 class GC_MovingObject;
@@ -8,11 +9,13 @@ class World;
 struct ObjectZFunc
 {
 	virtual enumZOrder GetZ(const World &world, const GC_MovingObject &mo) const = 0;
+	virtual bool IsConst() const { return false; } // same Z for the whole object lifetime
 	virtual ~ObjectZFunc() {}
 };
 
 struct ObjectRFunc
 {
 	virtual void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const = 0;
+	virtual size_t GetBatchKey() const { return static_cast<size_t>(-1); } // views drawing the same texture share the key
 	virtual ~ObjectRFunc() {}
 };
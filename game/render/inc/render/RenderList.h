@@ -0,0 +1,98 @@
+#pragma once
+#include "LightCache.h"
+#include <gc/WorldEvents.h>
+#include <gc/Z.h>
+#include <math/MyMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class GC_MovingObject;
+class GC_Object;
+class RenderContext;
+class RenderScheme;
+class World;
+struct ObjectRFunc;
+struct ObjectZFunc;
+
+// Retained set of object views of a single world. Entries are added and
+// removed as objects are created and killed; gathering walks the moving
+// object grid over the visible cells only and groups each z-layer by the
+// batch key of the views so that draws sharing a texture go together.
+// Batch keys are numbered once, when a view is added, and the numbers are
+// ranked in key order only when a new key shows up, so grouping a layer is
+// a single counting pass per frame. Static lights of the gathered cells are
+// brought up to date in the light cache along the way.
+class RenderList final
+	: ObjectListener<World>
+{
+public:
+	explicit RenderList(World &world);
+	~RenderList();
+
+	const World& GetWorld() const { return _world; }
+
+	// Rebuilds the entries if the scheme or the mode has changed since the last call.
+	void Update(const RenderScheme &rs, bool editorMode, bool nightMode);
+
+	// Collects the views of objects overlapping any of the regions, one per
+	// split-screen camera, and evaluates their Z. Each object is visited once
+	// and remembers which regions it is in.
+	void Gather(const std::vector<FRECT> &regions);
+
+	// Draws gathered views of a single z-layer that are in the given region.
+	void Draw(RenderContext &rc, unsigned int region, enumZOrder z) const;
+
+	struct VisibleEntry
+	{
+		const GC_MovingObject *mo;
+		const ObjectRFunc *rfunc;
+		size_t batchKey; // batch key of the first view of the object in the layer
+		unsigned int batch; // number of batchKey, see _batchRank
+		int locX; // INT_MIN for objects out of the grid
+		int locY;
+		uint32_t regions; // bit per gathered region the object is in
+	};
+
+	// Gathered views of a single z-layer in draw order.
+	const std::vector<VisibleEntry>& GetVisible(enumZOrder z) const { return _visible[z]; }
+
+	const LightCache& GetLightCache() const { return _lightCache; }
+
+private:
+	struct Entry
+	{
+		const ObjectZFunc *zfunc; // nullptr if the Z is constant
+		const ObjectRFunc *rfunc;
+		enumZOrder z;
+		unsigned int batch;
+	};
+
+	World &_world;
+	const RenderScheme *_renderScheme = nullptr;
+	bool _editorMode = false;
+	bool _nightMode = false;
+
+	std::vector<std::vector<Entry>> _entries; // by object id
+	std::unordered_map<size_t, unsigned int> _batches; // batch key to its number
+	std::vector<unsigned int> _batchRank; // by batch number, position of its key in key order
+	std::vector<VisibleEntry> _visible[Z_COUNT];
+	std::vector<VisibleEntry> _sortBuffer;
+	std::vector<unsigned int> _batchStart;
+	std::vector<RectRB> _regionCells;
+	LightCache _lightCache;
+	bool _killedSinceGather = false;
+
+	void Add(const GC_MovingObject &mo);
+	unsigned int GetBatch(size_t batchKey);
+	void SortByBatch(std::vector<VisibleEntry> &layer);
+	void GatherObject(const GC_MovingObject &mo, int locX, int locY, uint32_t regions);
+
+	// ObjectListener<World>
+	void OnKill(GC_Object &obj) override;
+	void OnNewObject(GC_Object &obj) override;
+	void OnClear() override;
+	void OnGameStarted() override {}
+	void OnGameFinished() override {}
+};
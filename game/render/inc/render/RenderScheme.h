@@ -8,6 +8,9 @@ class RenderScheme final
 {
 public:
 	RenderScheme(TextureManager &tm);
+	RenderScheme(ObjectViewsSelectorBuilder &&gameViews,
+	             ObjectViewsSelectorBuilder &&editorViews,
+	             ObjectViewsSelectorBuilder &&nightViews);
 	ViewCollection GetViews(const GC_MovingObject &mo, bool editorMode, bool nightMode) const;
 
 private:
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "DecalView.h"
 #include "Terrain.h"
 #include <math/MyMath.h>
+#include <vector>
 
 class AIManager;
+class LightCache;
 class RenderContext;
+class RenderList;
 class TextureManager;
 class RenderScheme;
 class World;
@@ -28,13 +32,28 @@ public:
 	            const World &world,
 	            WorldViewRenderOptions options = {},
 	            const AIManager *aiManager = nullptr) const;
+
+	// Retained mode: gather once per frame over the visible regions of all
+	// views of the world, then render each view from the same list.
+	void Gather(RenderList &renderList, const std::vector<FRECT> &regions, WorldViewRenderOptions options = {}) const;
+	void Render(RenderContext &rc,
+	            const RenderList &renderList,
+	            unsigned int region, // index in the gathered regions
+	            WorldViewRenderOptions options = {},
+	            const AIManager *aiManager = nullptr) const;
 	RenderScheme &GetRenderScheme() const { return _renderScheme; }
 
 private:
 	RenderScheme &_renderScheme;
 	Terrain _terrain;
+	DecalView _decals;
 	size_t _lineTex;
 	size_t _texField;
+
+	// Static lights are drawn from the cache if one is given, and one by one otherwise.
+	void RenderLights(RenderContext &rc, const World &world, WorldViewRenderOptions options,
+	                  const LightCache *staticLights, unsigned int region) const;
+	void RenderOverlays(RenderContext &rc, const World &world, WorldViewRenderOptions options, const AIManager *aiManager) const;
 };
 
 vec2d ComputeWorldTransformOffset(const FRECT &canvasViewport, vec2d eye, float zoom);
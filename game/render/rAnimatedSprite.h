@@ -11,6 +11,7 @@ class R_AnimatedSprite : public ObjectRFunc
 public:
 	R_AnimatedSprite(TextureManager &tm, const char *tex, float frameRate);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	TextureManager &_tm;
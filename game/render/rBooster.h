@@ -9,6 +9,7 @@ class R_Booster : public ObjectRFunc
 public:
 	R_Booster(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
@@ -9,6 +9,7 @@ class R_BrickFragment : public ObjectRFunc
 public:
 	R_BrickFragment(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	TextureManager &_tm;
@@ -10,6 +10,7 @@ class R_HealthIndicator : public ObjectRFunc
 public:
 	R_HealthIndicator(TextureManager &tm, bool dynamic);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	TextureManager &_tm;
@@ -22,6 +23,7 @@ class R_AmmoIndicator : public ObjectRFunc
 public:
 	R_AmmoIndicator(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	TextureManager &_tm;
@@ -33,6 +35,7 @@ class R_FuelIndicator : public ObjectRFunc
 public:
 	R_FuelIndicator(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	TextureManager &_tm;
@@ -11,6 +11,7 @@ class R_Light : public ObjectRFunc
 public:
 	R_Light(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
@@ -11,6 +11,7 @@ public:
 
 	// ObjectView
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId1; }
 
 private:
 	size_t _texId1;
@@ -22,6 +23,7 @@ class R_Crosshair2 : public ObjectRFunc
 public:
 	R_Crosshair2(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
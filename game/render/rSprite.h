@@ -9,6 +9,7 @@ class R_Sprite : public ObjectRFunc
 public:
 	R_Sprite(TextureManager &tm, const char *tex);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
@@ -19,6 +20,7 @@ class Z_Const : public ObjectZFunc
 public:
 	Z_Const(enumZOrder z) : _z(z) {}
 	enumZOrder GetZ(const World &world, const GC_MovingObject &mo) const override { return _z; }
+	bool IsConst() const override { return true; }
 
 private:
 	enumZOrder _z;
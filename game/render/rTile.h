@@ -10,6 +10,7 @@ class R_Tile : public ObjectRFunc
 public:
 	R_Tile(TextureManager &tm, const char *tex, SpriteColor color, vec2d offset, bool anyLOD);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
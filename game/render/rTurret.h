@@ -9,6 +9,7 @@ class R_Turret : public ObjectRFunc
 public:
 	R_Turret(TextureManager &tm, const char *texPlatform, const char *texWeapon);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texPlatform; }
 
 private:
 	TextureManager &_tm;
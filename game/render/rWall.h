@@ -9,6 +9,7 @@ class R_Wall : public ObjectRFunc
 public:
 	R_Wall(TextureManager &tm, const char *tex);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId[0]; }
 
 private:
 	enum {WALL, LT, RT, RB, LB};
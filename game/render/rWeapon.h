@@ -9,6 +9,7 @@ class R_Weapon : public ObjectRFunc
 public:
 	R_Weapon(TextureManager &tm, const char *tex);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
@@ -19,6 +20,7 @@ class R_WeapFireEffect : public ObjectRFunc
 public:
 	R_WeapFireEffect(TextureManager &tm, const char *tex, float duration, float offsetX, bool oriented);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	TextureManager &_tm;
@@ -43,6 +45,7 @@ class R_RipperDisk : public ObjectRFunc
 public:
 	R_RipperDisk(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
@@ -53,6 +56,7 @@ class R_Crosshair : public ObjectRFunc
 public:
 	R_Crosshair(TextureManager &tm);
 	void Draw(const World &world, const GC_MovingObject &mo, RenderContext &rc) const override;
+	size_t GetBatchKey() const override { return _texId; }
 
 private:
 	size_t _texId;
@@ -0,0 +1,248 @@
+#include <render/ObjectView.h>
+#include <render/ObjectViewsSelector.h>
+#include <render/RenderList.h>
+#include <render/RenderScheme.h>
+#include <gc/Light.h>
+#include <gc/SpawnPoint.h>
+#include <gc/UserObjects.h>
+#include <gc/Wall.h>
+#include <gc/World.h>
+#include <gc/WorldCfg.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+	struct TestZConst : ObjectZFunc
+	{
+		enumZOrder z;
+		explicit TestZConst(enumZOrder z_) : z(z_) {}
+		enumZOrder GetZ(const World &, const GC_MovingObject &) const override { return z; }
+		bool IsConst() const override { return true; }
+	};
+
+	struct TestZDynamic : ObjectZFunc
+	{
+		const enumZOrder &z;
+		explicit TestZDynamic(const enumZOrder &z_) : z(z_) {}
+		enumZOrder GetZ(const World &, const GC_MovingObject &) const override { return z; }
+	};
+
+	struct TestR : ObjectRFunc
+	{
+		size_t key;
+		explicit TestR(size_t key_) : key(key_) {}
+		void Draw(const World &, const GC_MovingObject &, RenderContext &) const override {}
+		size_t GetBatchKey() const override { return key; }
+	};
+
+	ObjectViewsSelectorBuilder UnusedViews()
+	{
+		ObjectViewsSelectorBuilder builder;
+		builder.AddView<GC_SpawnPoint>(std::make_unique<TestZConst>(Z_EDITOR), std::make_unique<TestR>(0));
+		return builder;
+	}
+
+	vec2d CellCenter(int x, int y)
+	{
+		return vec2d{ (x + 0.5f) * WORLD_LOCATION_SIZE, (y + 0.5f) * WORLD_LOCATION_SIZE };
+	}
+
+	FRECT CellRect(int x, int y)
+	{
+		return MakeRectWH(vec2d{ (float) x, (float) y } * WORLD_LOCATION_SIZE, vec2d{ WORLD_LOCATION_SIZE, WORLD_LOCATION_SIZE });
+	}
+}
+
+TEST(RenderList, GatherSkipsObjectsOutsideVisibleCells)
+{
+	ObjectViewsSelectorBuilder gameViews;
+	gameViews.AddView<GC_Wall>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(1));
+	RenderScheme rs(std::move(gameViews), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/); // 16x16 locations
+	auto &nearWall = world.New<GC_Wall>(CellCenter(1, 1));
+	world.New<GC_Wall>(CellCenter(14, 14));
+
+	RenderList renderList(world);
+	renderList.Update(rs, false, false);
+	renderList.Gather({ CellRect(1, 1) });
+
+	auto &visible = renderList.GetVisible(Z_WALLS);
+	ASSERT_EQ(1, visible.size());
+	EXPECT_EQ(&nearWall, visible[0].mo);
+	EXPECT_EQ(1, visible[0].locX);
+	EXPECT_EQ(1, visible[0].locY);
+}
+
+TEST(RenderList, GatherFollowsCreatedKilledAndMovedObjects)
+{
+	ObjectViewsSelectorBuilder gameViews;
+	gameViews.AddView<GC_UserObject>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(1));
+	RenderScheme rs(std::move(gameViews), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	RenderList renderList(world);
+	renderList.Update(rs, false, false);
+
+	auto &obj = world.New<GC_UserObject>(CellCenter(2, 2));
+	renderList.Gather({ CellRect(2, 2) });
+	EXPECT_EQ(1, renderList.GetVisible(Z_WALLS).size());
+
+	obj.MoveTo(world, CellCenter(10, 10));
+	renderList.Gather({ CellRect(2, 2) });
+	EXPECT_TRUE(renderList.GetVisible(Z_WALLS).empty());
+	renderList.Gather({ CellRect(10, 10) });
+	EXPECT_EQ(1, renderList.GetVisible(Z_WALLS).size());
+
+	obj.Kill(world);
+	renderList.Gather({ CellRect(10, 10) });
+	EXPECT_TRUE(renderList.GetVisible(Z_WALLS).empty());
+}
+
+TEST(RenderList, GatherEvaluatesDynamicZ)
+{
+	enumZOrder z = Z_VEHICLES;
+	ObjectViewsSelectorBuilder gameViews;
+	gameViews.AddView<GC_UserObject>(std::make_unique<TestZDynamic>(z), std::make_unique<TestR>(1));
+	RenderScheme rs(std::move(gameViews), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	world.New<GC_UserObject>(CellCenter(3, 3));
+
+	RenderList renderList(world);
+	renderList.Update(rs, false, false);
+	renderList.Gather({ CellRect(3, 3) });
+	EXPECT_EQ(1, renderList.GetVisible(Z_VEHICLES).size());
+
+	z = Z_NONE;
+	renderList.Gather({ CellRect(3, 3) });
+	EXPECT_TRUE(renderList.GetVisible(Z_VEHICLES).empty());
+}
+
+TEST(RenderList, GatherGroupsLayerByBatchKey)
+{
+	ObjectViewsSelectorBuilder gameViews;
+	gameViews.AddView<GC_Wall>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(2));
+	// two views of one object with different keys stay together and in order
+	gameViews.AddView<GC_UserObject>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(3));
+	gameViews.AddView<GC_UserObject>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(1));
+	RenderScheme rs(std::move(gameViews), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	for (int i = 0; i < 4; ++i)
+	{
+		world.New<GC_Wall>(CellCenter(i, 0));
+		world.New<GC_UserObject>(CellCenter(i, 1));
+	}
+
+	RenderList renderList(world);
+	renderList.Update(rs, false, false);
+	renderList.Gather({ FRECT{ 0, 0, 4 * WORLD_LOCATION_SIZE, 2 * WORLD_LOCATION_SIZE } });
+
+	auto &visible = renderList.GetVisible(Z_WALLS);
+	ASSERT_EQ(12, visible.size());
+	for (size_t i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(2, visible[i].batchKey);
+		EXPECT_EQ(2, visible[i].rfunc->GetBatchKey());
+	}
+	for (size_t i = 4; i < visible.size(); i += 2)
+	{
+		EXPECT_EQ(visible[i].mo, visible[i + 1].mo);
+		EXPECT_EQ(3, visible[i].rfunc->GetBatchKey());
+		EXPECT_EQ(1, visible[i + 1].rfunc->GetBatchKey());
+	}
+}
+
+TEST(RenderList, BatchOrderIsKeptBetweenGathers)
+{
+	ObjectViewsSelectorBuilder gameViews;
+	gameViews.AddView<GC_Wall>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(5));
+	gameViews.AddView<GC_UserObject>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(1));
+	RenderScheme rs(std::move(gameViews), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	RenderList renderList(world);
+	renderList.Update(rs, false, false);
+
+	world.New<GC_Wall>(CellCenter(0, 0));
+	world.New<GC_UserObject>(CellCenter(1, 0));
+	world.New<GC_Wall>(CellCenter(2, 0));
+	FRECT region = MakeRectWH(vec2d{ 4 * WORLD_LOCATION_SIZE, WORLD_LOCATION_SIZE });
+	renderList.Gather({ region });
+	{
+		auto &visible = renderList.GetVisible(Z_WALLS);
+		ASSERT_EQ(3, visible.size());
+		EXPECT_EQ(1, visible[0].batchKey);
+		EXPECT_EQ(5, visible[1].batchKey);
+		EXPECT_EQ(5, visible[2].batchKey);
+	}
+
+	world.New<GC_UserObject>(CellCenter(3, 0)).MoveTo(world, CellCenter(0, 0));
+	renderList.Gather({ region });
+	{
+		auto &visible = renderList.GetVisible(Z_WALLS);
+		ASSERT_EQ(4, visible.size());
+		EXPECT_EQ(1, visible[0].batchKey);
+		EXPECT_EQ(1, visible[1].batchKey);
+		EXPECT_EQ(5, visible[2].batchKey);
+		EXPECT_EQ(5, visible[3].batchKey);
+	}
+}
+
+TEST(RenderList, GatherSkipsCellsBetweenCameras)
+{
+	ObjectViewsSelectorBuilder gameViews;
+	gameViews.AddView<GC_Wall>(std::make_unique<TestZConst>(Z_WALLS), std::make_unique<TestR>(1));
+	RenderScheme rs(std::move(gameViews), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	auto &left = world.New<GC_Wall>(CellCenter(1, 1));
+	world.New<GC_Wall>(CellCenter(7, 7)); // between the cameras
+	auto &right = world.New<GC_Wall>(CellCenter(14, 14));
+
+	RenderList renderList(world);
+	renderList.Update(rs, false, false);
+	renderList.Gather({ CellRect(1, 1), CellRect(14, 14), CellRect(1, 1) });
+
+	auto &visible = renderList.GetVisible(Z_WALLS);
+	ASSERT_EQ(2, visible.size());
+	auto &leftEntry = visible[0].mo == &left ? visible[0] : visible[1];
+	auto &rightEntry = visible[0].mo == &left ? visible[1] : visible[0];
+	EXPECT_EQ(&left, leftEntry.mo);
+	EXPECT_EQ(&right, rightEntry.mo);
+	EXPECT_EQ(5u, leftEntry.regions); // the first and the third camera
+	EXPECT_EQ(2u, rightEntry.regions);
+}
+
+TEST(RenderList, StaticLightsAreRebuiltOnlyWhenChanged)
+{
+	RenderScheme rs(UnusedViews(), UnusedViews(), UnusedViews());
+
+	World world({ 0, 0, 64, 64 }, false /*initField*/);
+	world.New<GC_Spotlight>(CellCenter(2, 2));
+	auto &spotlight = world.New<GC_Spotlight>(CellCenter(12, 12));
+	auto &dynamic = world.New<GC_Light>(CellCenter(7, 7), GC_Light::LIGHT_POINT);
+
+	RenderList renderList(world);
+	FRECT region = MakeRectWH(vec2d{}, vec2d{ 16, 16 } * WORLD_LOCATION_SIZE);
+
+	renderList.Update(rs, false, false);
+	renderList.Gather({ region });
+	EXPECT_EQ(0, renderList.GetLightCache().GetRebuildCount()); // no lights by day
+
+	renderList.Update(rs, false, true /*nightMode*/);
+	renderList.Gather({ region, CellRect(2, 2) });
+	EXPECT_EQ(2, renderList.GetLightCache().GetRebuildCount());
+
+	dynamic.MoveTo(world, CellCenter(8, 8));
+	renderList.Gather({ region, CellRect(2, 2) });
+	EXPECT_EQ(2, renderList.GetLightCache().GetRebuildCount());
+
+	spotlight.MoveTo(world, CellCenter(13, 12));
+	renderList.Gather({ region, CellRect(2, 2) });
+	EXPECT_EQ(3, renderList.GetLightCache().GetRebuildCount());
+
+	renderList.Gather({ region, CellRect(2, 2) });
+	EXPECT_EQ(3, renderList.GetLightCache().GetRebuildCount());
+}
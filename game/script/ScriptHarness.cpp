@@ -98,6 +98,7 @@ void ScriptHarness::Serialize(SaveFile &f)
 		lua_pop(_L.get(), 1);
 		throw std::runtime_error(err);
 	}
+	lua_pushnil(_L.get());
 	lua_setfield(_L.get(), LUA_REGISTRYINDEX, "restore_ptr");
 }
 
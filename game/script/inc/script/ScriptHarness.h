@@ -42,4 +42,5 @@ private:
 	void OnGameFinished() override {}
 	void OnKill(GC_Object &) override {}
 	void OnNewObject(GC_Object &) override {}
+	void OnClear() override {}
 };
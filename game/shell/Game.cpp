@@ -283,7 +283,7 @@ void GameLayout::OnTimeStep(const Plat::Input &input, bool focused, float dt)
 
 	if (gameplayActive)
 	{
-		WorldController::ControllerStateMap controlStates;
+		WorldController::ControllerStates controlStates;
 
 		vec2d dragDirection = GetDragDirection();
 		bool reversing = GetEffectiveDragCount() > 1;
@@ -297,12 +297,12 @@ void GameLayout::OnTimeStep(const Plat::Input &input, bool focused, float dt)
 				{
 					VehicleState vs;
 					vehicleStateReader->ReadVehicleState(_gameViewHarness, *vehicle, playerIndex, input, dragDirection, reversing, vs);
-					controlStates.insert(std::make_pair(vehicle->GetId(), vs));
+					controlStates.emplace_back(vehicle->GetId(), vs);
 				}
 			}
 		}
 
-		_worldController.SendControllerStates(std::move(controlStates));
+		_worldController.SendControllerStates(controlStates);
 	}
 }
 